@@ -0,0 +1,143 @@
+/*****************************************************************************
+* | File      	:   adc_convert.c
+* | Author      :   PicoFFT Project
+* | Function    :   ADC sample format and windowing kernels (samples -> FFT input)
+* | Info        :
+*   - One DC pass and one window pass per frame; the 8-bit kernel moves the
+*     per-sample subtract and scale into a 256-entry level table built once
+*     per frame, so its window pass is a table load and one multiply
+*   - Both kernels round the DC offset the same way, so 8-bit output is
+*     bit-identical to 12-bit output of the same levels
+*----------------
+******************************************************************************/
+
+#include "adc_convert.h"
+#include <string.h>
+
+#define ADC_CONVERT_LEVELS 256              // 8-bit sample levels
+#define ADC_CONVERT_LANE_WORDS 128          // Words per 16-bit lane flush (128 x 2 x 255 < 65536)
+
+// Level table entry: centered sample in FFT input units
+#ifdef FIXED_POINT
+typedef int32_t adc_convert_level_t;        // 12-bit LSBs << ADC_FIXED_INPUT_SHIFT
+#else
+typedef float adc_convert_level_t;          // 12-bit LSBs
+#endif
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Sum 8-bit samples four per word (two 16-bit lanes of byte pairs)
+ */
+static uint32_t _adc_convert_sum_u8(const uint8_t* samples, int count) {
+    uint32_t sum = 0;
+    int i = 0;
+    
+    while (count - i >= 4) {
+        int words = (count - i) / 4;
+        if (words > ADC_CONVERT_LANE_WORDS) words = ADC_CONVERT_LANE_WORDS;
+        uint32_t lanes = 0;
+        for (int w = 0; w < words; w++, i += 4) {
+            uint32_t word;
+            memcpy(&word, &samples[i], sizeof(word));  // Single (unaligned) load on Cortex-M33
+            lanes += (word & 0x00FF00FFu) + ((word >> 8) & 0x00FF00FFu);
+        }
+        sum += (lanes & 0xFFFFu) + (lanes >> 16);
+    }
+    for (; i < count; i++) {
+        sum += samples[i];
+    }
+    return sum;
+}
+
+// ========================================
+// 🔧 Window Conversion API Implementation
+// ========================================
+
+/**
+ * Remove DC and apply a window to 12-bit samples
+ */
+void adc_convert_window_u16(const uint16_t* samples, int count, const adc_window_coef_t* window,
+                            kiss_fft_scalar* out, int stride) {
+    uint32_t dc_sum = 0;
+    for (int i = 0; i < count; i++) {
+        dc_sum += samples[i];
+    }
+    
+#ifdef FIXED_POINT
+    // Integer DC removal and Q15 window multiply
+    int32_t dc_offset = (int32_t)((dc_sum + count / 2) / count);
+    for (int i = 0; i < count; i++) {
+        adc_fixed_product_t centered =
+            (adc_fixed_product_t)((int32_t)samples[i] - dc_offset) * (1 << ADC_FIXED_INPUT_SHIFT);
+        out[i * stride] = (kiss_fft_scalar)((centered * window[i] + (1 << 14)) >> 15);
+    }
+#else
+    // Remove DC offset and apply the window (fused multiply pass)
+    float dc_offset = (float)dc_sum / count;
+    for (int i = 0; i < count; i++) {
+        out[i * stride] = ((float)samples[i] - dc_offset) * window[i];
+    }
+#endif
+}
+
+/**
+ * Remove DC and apply a window to 8-bit samples
+ */
+void adc_convert_window_u8(const uint8_t* samples, int count, const adc_window_coef_t* window,
+                           kiss_fft_scalar* out, int stride) {
+    const int shift = ADC_RESOLUTION_BITS - 8;
+    uint32_t dc_sum = _adc_convert_sum_u8(samples, count);
+    
+    // Level table: every 8-bit level centered and scaled once per frame
+    // (same DC rounding as the 12-bit kernel on level << shift)
+    adc_convert_level_t level[ADC_CONVERT_LEVELS];
+#ifdef FIXED_POINT
+    int32_t dc_offset = (int32_t)(((dc_sum << shift) + (uint32_t)count / 2) / (uint32_t)count);
+    for (int v = 0; v < ADC_CONVERT_LEVELS; v++) {
+        level[v] = ((v << shift) - dc_offset) * (1 << ADC_FIXED_INPUT_SHIFT);
+    }
+#else
+    float dc_offset = (float)dc_sum / count;
+    for (int v = 0; v < ADC_CONVERT_LEVELS; v++) {
+        level[v] = ((float)v - dc_offset) * (float)(1 << shift);
+    }
+#endif
+    
+    // Four samples per word load (little endian: the first sample is the low byte)
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32_t word;
+        memcpy(&word, &samples[i], sizeof(word));
+        for (int k = 0; k < 4; k++, word >>= 8) {
+#ifdef FIXED_POINT
+            adc_fixed_product_t product = (adc_fixed_product_t)level[word & 0xFFu] * window[i + k];
+            out[(i + k) * stride] = (kiss_fft_scalar)((product + (1 << 14)) >> 15);
+#else
+            out[(i + k) * stride] = level[word & 0xFFu] * window[i + k];
+#endif
+        }
+    }
+    for (; i < count; i++) {
+#ifdef FIXED_POINT
+        adc_fixed_product_t product = (adc_fixed_product_t)level[samples[i]] * window[i];
+        out[i * stride] = (kiss_fft_scalar)((product + (1 << 14)) >> 15);
+#else
+        out[i * stride] = level[samples[i]] * window[i];
+#endif
+    }
+}
+
+/**
+ * Remove DC and apply a window to samples of the capture format
+ */
+void adc_convert_window(const adc_sample_t* samples, int count, const adc_window_coef_t* window,
+                        kiss_fft_scalar* out, int stride) {
+#if ADC_CAPTURE_8BIT
+    adc_convert_window_u8(samples, count, window, out, stride);
+#else
+    adc_convert_window_u16(samples, count, window, out, stride);
+#endif
+}
@@ -0,0 +1,93 @@
+/*****************************************************************************
+* | File      	:   adc_convert.h
+* | Author      :   PicoFFT Project
+* | Function    :   ADC sample format and windowing kernels (samples -> FFT input)
+* | Info        :
+*   - adc_sample_t is the capture format: 12-bit conversions in uint16_t,
+*     or their upper 8 bits in uint8_t with ADC_CAPTURE_8BIT (ADC FIFO
+*     byte shift, DMA_SIZE_8 transfers, half the buffer memory)
+*   - Stream stages center samples with ADC_SAMPLE_CENTER(), which yields
+*     12-bit LSB units for both formats, so no dB calibration changes
+*   - The window kernels fuse DC removal, scaling and the window multiply
+*     into FFT scalars (float, or Q15/Q31 in FIXED_POINT builds); the 8-bit
+*     kernel reads four samples per word and maps levels through a table
+*   - Plain C without SDK dependencies (host benchmark tools/adc_convert_bench.c)
+*----------------
+******************************************************************************/
+
+#ifndef __ADC_CONVERT_H
+#define __ADC_CONVERT_H
+
+#include <stdint.h>
+#include "config_settings.h"
+#include "kiss_fft.h"   // FIXED_POINT build selection
+
+// Capture sample format
+#if ADC_CAPTURE_8BIT
+typedef uint8_t adc_sample_t;
+#define ADC_SAMPLE_BITS 8
+#else
+typedef uint16_t adc_sample_t;
+#define ADC_SAMPLE_BITS ADC_RESOLUTION_BITS
+#endif
+#define ADC_SAMPLE_MIDSCALE (1 << (ADC_SAMPLE_BITS - 1))
+#define ADC_SAMPLE_SHIFT (ADC_RESOLUTION_BITS - ADC_SAMPLE_BITS)  // log2(12-bit LSBs per sample LSB)
+#define ADC_SAMPLE_VOLTAGE_PER_LSB (ADC_VOLTAGE_PER_BIT * (1 << ADC_SAMPLE_SHIFT))
+
+// Sample around midscale in 12-bit LSB units (int32_t)
+#define ADC_SAMPLE_CENTER(sample) (((int32_t)(sample) - ADC_SAMPLE_MIDSCALE) * (1 << ADC_SAMPLE_SHIFT))
+
+#ifdef FIXED_POINT
+// Fixed-point pipeline: left shift that places DC-removed 12-bit samples in
+// the FFT scalar range (±4095 << 3 fits Q15, ±4095 << 19 fits Q31)
+#if (FIXED_POINT == 32)
+#define ADC_FIXED_INPUT_SHIFT 19
+typedef int64_t adc_fixed_product_t;        // Q31 sample x Q15 window product
+#else
+#define ADC_FIXED_INPUT_SHIFT 3
+typedef int32_t adc_fixed_product_t;        // Q15 sample x Q15 window product
+#endif
+typedef int16_t adc_window_coef_t;          // Q15 table (fft_window_get_coefficients_q15)
+#else
+typedef float adc_window_coef_t;            // Float table (fft_window_get_coefficients)
+#endif
+
+// ========================================
+// 🔧 Window Conversion API
+// ========================================
+
+/**
+ * Remove DC and apply a window to 12-bit samples
+ * @param samples Raw samples (count)
+ * @param count Samples (FFT size)
+ * @param window Window coefficients of the same size
+ * @param out First output scalar
+ * @param stride Scalars between outputs (1 = real input, 2 = real or imaginary parts)
+ */
+void adc_convert_window_u16(const uint16_t* samples, int count, const adc_window_coef_t* window,
+                            kiss_fft_scalar* out, int stride);
+
+/**
+ * Remove DC and apply a window to 8-bit samples (upper 8 bits of the conversion)
+ * Output equals adc_convert_window_u16() on the samples shifted back to 12 bits
+ * @param samples Raw samples (count)
+ * @param count Samples (FFT size)
+ * @param window Window coefficients of the same size
+ * @param out First output scalar
+ * @param stride Scalars between outputs (1 = real input, 2 = real or imaginary parts)
+ */
+void adc_convert_window_u8(const uint8_t* samples, int count, const adc_window_coef_t* window,
+                           kiss_fft_scalar* out, int stride);
+
+/**
+ * Remove DC and apply a window to samples of the capture format
+ * @param samples Raw samples (count)
+ * @param count Samples (FFT size)
+ * @param window Window coefficients of the same size
+ * @param out First output scalar
+ * @param stride Scalars between outputs
+ */
+void adc_convert_window(const adc_sample_t* samples, int count, const adc_window_coef_t* window,
+                        kiss_fft_scalar* out, int stride);
+
+#endif // __ADC_CONVERT_H
@@ -0,0 +1,195 @@
+/*****************************************************************************
+* | File      	:   adc_frame_queue.c
+* | Author      :   PicoFFT Project
+* | Function    :   Lock-free SPSC frame queue between acquisition and processing
+* | Info        :
+*   - Single producer, single consumer: the producer never reads consumer
+*     state, so no lock or interrupt masking is needed
+*   - The consumer re-checks the published count after reading a descriptor
+*     (seqlock style), so a descriptor rewritten during the read is never used
+*   - All distances are unsigned sequence differences (valid across wrap)
+*   - Intact checks measure from the sequence DMA is writing: the published
+*     count, or further on when the DMA slot source shows the capture has
+*     already moved into the next slot
+*----------------
+******************************************************************************/
+
+#include "adc_frame_queue.h"
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Sequence DMA is writing: the published count, moved on to the slot the
+ * hardware reports while completion IRQs are still pending
+ */
+static uint32_t _frame_queue_writing(const adc_frame_queue_t* queue, uint32_t completed) {
+    if (queue->dma_slot == NULL) {
+        return completed;
+    }
+    uint32_t slot = (uint32_t)queue->dma_slot();
+    return completed + ((slot - completed) & ((uint32_t)queue->slot_count - 1));
+}
+
+// ========================================
+// 🔧 Frame Queue API Implementation
+// ========================================
+
+/**
+ * Reset the queue before the DMA cycle starts
+ */
+bool adc_frame_queue_reset(adc_frame_queue_t* queue, int slot_count) {
+    // Power of two: sequence % count stays continuous across the 2^32 wrap
+    if (slot_count < 2 || slot_count > ADC_FRAME_QUEUE_MAX_SLOTS ||
+        (slot_count & (slot_count - 1)) != 0) {
+        return false;
+    }
+    
+    for (int slot = 0; slot < ADC_FRAME_QUEUE_MAX_SLOTS; slot++) {
+        atomic_init(&queue->desc[slot].sequence, 0);
+        atomic_init(&queue->desc[slot].timestamp_us, 0);
+        atomic_init(&queue->desc[slot].flags, 0);
+    }
+    atomic_init(&queue->completed, 0);
+    queue->next = 0;
+    queue->acquired = 0;
+    queue->in_use = false;
+    queue->dropped = 0;
+    queue->unreported = 0;
+    queue->torn = 0;
+    queue->slot_count = slot_count;
+    queue->dma_slot = NULL;
+    return true;
+}
+
+/**
+ * Set the DMA slot source
+ */
+void adc_frame_queue_set_dma_slot(adc_frame_queue_t* queue, adc_frame_queue_dma_slot_fn dma_slot) {
+    queue->dma_slot = dma_slot;
+}
+
+/**
+ * Push one completed frame
+ */
+void adc_frame_queue_push(adc_frame_queue_t* queue, uint32_t timestamp_us, uint32_t flags) {
+    // Only the producer writes the count: a relaxed load reads its own store
+    uint32_t sequence = atomic_load_explicit(&queue->completed, memory_order_relaxed);
+    adc_frame_desc_t* desc = &queue->desc[sequence % (uint32_t)queue->slot_count];
+    
+    atomic_store_explicit(&desc->sequence, sequence, memory_order_relaxed);
+    atomic_store_explicit(&desc->timestamp_us, timestamp_us, memory_order_relaxed);
+    atomic_store_explicit(&desc->flags, flags, memory_order_relaxed);
+    
+    // Release: descriptor (and DMA'd samples) visible before the count
+    atomic_store_explicit(&queue->completed, sequence + 1, memory_order_release);
+}
+
+/**
+ * Pop the oldest intact completed frame
+ */
+bool adc_frame_queue_pop(adc_frame_queue_t* queue, adc_frame_info_t* frame) {
+    const uint32_t slot_count = (uint32_t)queue->slot_count;
+    
+    if (queue->in_use) {
+        return false;
+    }
+    
+    for (;;) {
+        uint32_t completed = atomic_load_explicit(&queue->completed, memory_order_acquire);
+    
+        // DMA is filling sequence `writing`, i.e. slot writing % count: only
+        // the slot_count - 1 frames before it are intact
+        uint32_t pending = _frame_queue_writing(queue, completed) - queue->next;
+        if (pending > slot_count - 1) {
+            uint32_t skipped = pending - (slot_count - 1);
+            queue->next += skipped;
+            queue->dropped += skipped;
+            queue->unreported += skipped;
+        }
+        if (completed == queue->next) {
+            return false;
+        }
+    
+        uint32_t sequence = queue->next;
+        const adc_frame_desc_t* desc = &queue->desc[sequence % slot_count];
+        uint32_t desc_sequence = atomic_load_explicit(&desc->sequence, memory_order_relaxed);
+        uint32_t timestamp_us = atomic_load_explicit(&desc->timestamp_us, memory_order_relaxed);
+        uint32_t flags = atomic_load_explicit(&desc->flags, memory_order_relaxed);
+    
+        // Re-check after the reads: the descriptor is only rewritten once the
+        // frame slot_count after it completes
+        atomic_thread_fence(memory_order_acquire);
+        completed = atomic_load_explicit(&queue->completed, memory_order_relaxed);
+        if (_frame_queue_writing(queue, completed) - sequence > slot_count - 1 || desc_sequence != sequence) {
+            queue->next++;
+            queue->dropped++;
+            queue->unreported++;
+            continue;
+        }
+    
+        queue->next = sequence + 1;
+        queue->acquired = sequence;
+        queue->in_use = true;
+    
+        frame->slot = (int)(sequence % slot_count);
+        frame->sequence = sequence;
+        frame->timestamp_us = timestamp_us;
+        frame->flags = flags | (queue->unreported > 0 ? ADC_FRAME_FLAG_DROPPED : 0);
+        frame->dropped = queue->unreported;
+        queue->unreported = 0;
+        return true;
+    }
+}
+
+/**
+ * Check whether the popped frame is still intact
+ */
+bool adc_frame_queue_intact(const adc_frame_queue_t* queue) {
+    if (!queue->in_use) {
+        return false;
+    }
+    
+    // Same test as at pop: the slot was overwritten once DMA started the
+    // frame slot_count after it (the fence keeps the sample reads before it)
+    atomic_thread_fence(memory_order_acquire);
+    uint32_t completed = atomic_load_explicit(&queue->completed, memory_order_relaxed);
+    return _frame_queue_writing(queue, completed) - queue->acquired <= (uint32_t)queue->slot_count - 1;
+}
+
+/**
+ * Return the popped frame's slot to the DMA cycle
+ */
+bool adc_frame_queue_release(adc_frame_queue_t* queue) {
+    if (!queue->in_use) {
+        return false;
+    }
+    bool intact = adc_frame_queue_intact(queue);
+    queue->in_use = false;
+    if (!intact) {
+        queue->torn++;
+    }
+    return intact;
+}
+
+/**
+ * Get the number of completed frames
+ */
+uint32_t adc_frame_queue_get_completed(const adc_frame_queue_t* queue) {
+    return atomic_load_explicit(&queue->completed, memory_order_relaxed);
+}
+
+/**
+ * Get the number of completed frames not popped yet
+ */
+uint32_t adc_frame_queue_get_backlog(const adc_frame_queue_t* queue) {
+    return atomic_load_explicit(&queue->completed, memory_order_relaxed) - queue->next;
+}
+
+/**
+ * Get the number of lost frames
+ */
+uint32_t adc_frame_queue_get_overruns(const adc_frame_queue_t* queue) {
+    return queue->dropped + queue->torn;
+}
@@ -0,0 +1,152 @@
+/*****************************************************************************
+* | File      	:   adc_frame_queue.h
+* | Author      :   PicoFFT Project
+* | Function    :   Lock-free SPSC frame queue between acquisition and processing
+* | Info        :
+*   - Chained DMA fills slot 0, 1, ..., slot_count-1, 0, ... without
+*     stopping; the producer (capture IRQ) pushes one descriptor per
+*     completed frame, the consumer (main loop) pops and releases frames
+*   - Each frame carries a sequence number, its capture timestamp and flags;
+*     frames lost to a lagging consumer are reported on the next frame
+*   - Sequence numbers count completed frames (wrap at 2^32): frame s is
+*     intact while fewer than slot_count frames completed after it, so the
+*     consumer may lag by up to slot_count - 1 frames
+*   - The chained DMA re-enters a slot before its completion IRQ publishes
+*     the count: an optional DMA slot source (the capture position read
+*     from the hardware) closes that window for IRQs delayed by up to
+*     slot_count - 1 frames
+*   - C11 atomics: the descriptor is written before the count is published
+*     with release order, and the consumer loads the count with acquire
+*     order, so the queue is also safe across cores
+*   - Plain C without SDK dependencies, so the queue can be stress-tested on
+*     the host (tools/frame_queue_stress.c)
+*----------------
+******************************************************************************/
+
+#ifndef __ADC_FRAME_QUEUE_H
+#define __ADC_FRAME_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Frame queue configuration
+#define ADC_FRAME_QUEUE_MAX_SLOTS 8         // Largest slot count (power of two)
+
+// Frame flags
+#define ADC_FRAME_FLAG_DROPPED      0x01u   // Frames were lost right before this one (consumer lag)
+#define ADC_FRAME_FLAG_ADC_OVERFLOW 0x02u   // ADC FIFO overflowed while this frame was captured
+
+// Per-slot descriptor (written by the producer only)
+typedef struct {
+    atomic_uint_least32_t sequence;
+    atomic_uint_least32_t timestamp_us;     // Capture completion time
+    atomic_uint_least32_t flags;            // ADC_FRAME_FLAG_* set by the producer
+} adc_frame_desc_t;
+
+// One popped frame
+typedef struct {
+    int slot;                               // Slot index (buffer = base + slot * frame length)
+    uint32_t sequence;                      // Completed-frame sequence number
+    uint32_t timestamp_us;                  // Capture completion time
+    uint32_t flags;                         // ADC_FRAME_FLAG_*
+    uint32_t dropped;                       // Frames lost right before this one
+} adc_frame_info_t;
+
+// Slot the capture DMA is writing now (read from the hardware)
+typedef int (*adc_frame_queue_dma_slot_fn)(void);
+
+// Queue state (the producer writes desc and completed, the consumer the rest)
+typedef struct {
+    adc_frame_desc_t desc[ADC_FRAME_QUEUE_MAX_SLOTS];
+    atomic_uint_least32_t completed;        // Frames completed (published last, release)
+    uint32_t next;                          // Sequence of the next frame to pop
+    uint32_t acquired;                      // Sequence of the frame in use
+    bool in_use;
+    uint32_t dropped;                       // Frames lost to consumer lag
+    uint32_t unreported;                    // Dropped since the last pop (reported on the next frame)
+    uint32_t torn;                          // Frames overwritten while in use
+    int slot_count;
+    adc_frame_queue_dma_slot_fn dma_slot;   // NULL: the published count only
+} adc_frame_queue_t;
+
+// ========================================
+// 🔧 Frame Queue API
+// ========================================
+
+/**
+ * Reset the queue before the DMA cycle starts at slot 0
+ * @param queue Queue state
+ * @param slot_count Slots in the DMA cycle (power of two, 2 to ADC_FRAME_QUEUE_MAX_SLOTS)
+ * @return true if successful, false on an invalid slot count
+ */
+bool adc_frame_queue_reset(adc_frame_queue_t* queue, int slot_count);
+
+/**
+ * Set the DMA slot source used by pop and intact checks (after the reset)
+ * Without it a frame counts as intact until the completion that moves DMA
+ * into its slot is pushed, which lags the hardware by the IRQ latency
+ * @param queue Queue state
+ * @param dma_slot Slot the capture channel is writing now, or NULL
+ */
+void adc_frame_queue_set_dma_slot(adc_frame_queue_t* queue, adc_frame_queue_dma_slot_fn dma_slot);
+
+/**
+ * Push one completed frame (producer: capture IRQ)
+ * @param queue Queue state
+ * @param timestamp_us Completion time
+ * @param flags ADC_FRAME_FLAG_* observed by the producer
+ */
+void adc_frame_queue_push(adc_frame_queue_t* queue, uint32_t timestamp_us, uint32_t flags);
+
+/**
+ * Pop the oldest completed frame that DMA has not started to overwrite
+ * Older frames are skipped, counted as dropped and reported through
+ * ADC_FRAME_FLAG_DROPPED on the returned frame
+ * @param queue Queue state
+ * @param frame Output: slot, sequence, timestamp and flags
+ * @return true if a frame was popped, false if none is ready or one is still in use
+ */
+bool adc_frame_queue_pop(adc_frame_queue_t* queue, adc_frame_info_t* frame);
+
+/**
+ * Check whether the popped frame is still intact (it stays popped)
+ * Samples read before a true result were read intact: call it after the
+ * last read and before any result of the frame is published
+ * @param queue Queue state
+ * @return true if DMA has not reached the frame's slot again, false if it
+ *         has or none was popped
+ */
+bool adc_frame_queue_intact(const adc_frame_queue_t* queue);
+
+/**
+ * Return the popped frame's slot to the DMA cycle
+ * @param queue Queue state
+ * @return true if the frame stayed intact while in use, false if DMA
+ *         reached its slot again (counted as torn) or none was popped
+ */
+bool adc_frame_queue_release(adc_frame_queue_t* queue);
+
+/**
+ * Get the number of completed frames
+ * @param queue Queue state
+ * @return Frames completed since the reset
+ */
+uint32_t adc_frame_queue_get_completed(const adc_frame_queue_t* queue);
+
+/**
+ * Get the number of completed frames not popped yet
+ * @param queue Queue state
+ * @return Backlog in frames (may exceed slot_count - 1 before the next pop drops)
+ */
+uint32_t adc_frame_queue_get_backlog(const adc_frame_queue_t* queue);
+
+/**
+ * Get the number of lost frames
+ * @param queue Queue state
+ * @return Frames dropped plus frames torn since the reset
+ */
+uint32_t adc_frame_queue_get_overruns(const adc_frame_queue_t* queue);
+
+#endif // __ADC_FRAME_QUEUE_H
@@ -11,13 +11,30 @@
 ******************************************************************************/
 
 #include "adc_sampling.h"
+#include "fft_baseband.h"
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
 
+_Static_assert((1u << ADC_RING_SIZE_BITS) == ADC_RING_BYTES,
+               "ADC_RING_SIZE_BITS must match the ring size in bytes");
+_Static_assert(ADC_RING_SIZE % ADC_RING_DMA_BLOCK == 0,
+               "DMA block must divide the ring");
+_Static_assert(!DUAL_CHANNEL_ENABLED || FFT_DEFAULT_SIZE <= FFT_CROSS_MAX_SIZE,
+               "Two-channel mode starts at an FFT size above FFT_CROSS_MAX_SIZE");
+_Static_assert(ADC_CAPTURE_SLOTS >= 2 && ADC_CAPTURE_SLOTS <= ADC_FRAME_QUEUE_MAX_SLOTS &&
+               (ADC_CAPTURE_SLOTS & (ADC_CAPTURE_SLOTS - 1)) == 0,
+               "FRAME_QUEUE_SLOTS must be 2, 4 or 8");
+
 // Global unified analyzer instance
 unified_fft_analyzer_t g_unified_analyzer = {0};
 
+static void _adc_update_db_offset(void);
+static void _adc_apply_sample_rate(float rate_hz);
+static void _adc_measure_rate(uint32_t timestamp_us, uint32_t conversions);
+static void _adc_window_samples(const adc_sample_t* adc_buffer, kiss_fft_scalar* out, int stride);
+static void _adc_process_dual_fft(adc_sample_t* channel_a);
+
 // ========================================
 // 🔧 Core ADC Sampling API Implementation
 // ========================================
@@ -27,7 +44,7 @@ unified_fft_analyzer_t g_unified_analyzer = {0};
  */
 bool adc_sampling_init(adc_sampling_mode_t mode) {
     printf("Initializing ADC sampling system in %s mode...\n", 
-           mode == ADC_MODE_DMA ? "DMA" : "Manual");
+           adc_sampling_get_mode_name(mode));
     
     // Reset analyzer state
     memset(&g_unified_analyzer, 0, sizeof(unified_fft_analyzer_t));
@@ -37,28 +54,50 @@ bool adc_sampling_init(adc_sampling_mode_t mode) {
     // Initialize common ADC hardware
     adc_init();
     adc_gpio_init(26);  // GP26 as ADC input
+    if (ADC_SAMPLING_CHANNELS > 1) {
+        adc_gpio_init(27);  // GP27 as channel B
+    }
     adc_select_input(ADC_SAMPLING_CHANNEL);
+    adc_set_round_robin(ADC_ROUND_ROBIN_MASK);
     
-    // Set ADC clock divider for target sampling rate
-    // ADC clock = 48MHz, target = 128kHz, divider = 48MHz/128kHz = 375
-    float adc_clkdiv = 48000000.0f / (float)ADC_SAMPLING_RATE;
-    adc_set_clkdiv(adc_clkdiv);
+    // Set ADC clock divider for the startup rate
+    // (one conversion per 1 + divider clocks: 48MHz / 128kHz -> 374)
+    _adc_apply_sample_rate((float)ADC_SAMPLING_RATE);
     
     // Initialize buffer pointers
     g_unified_analyzer.current_buffer = g_unified_analyzer.buffer_ping;
     g_unified_analyzer.ready_buffer = NULL;
     g_unified_analyzer.buffer_selector = false;  // Start with ping buffer
     
-    // Initialize kiss_fft configuration
-    g_unified_analyzer.fft_cfg = kiss_fft_alloc(ADC_SAMPLING_FFT_SIZE, 0, NULL, NULL);
-    if (g_unified_analyzer.fft_cfg == NULL) {
-        printf("ERROR: Failed to allocate kiss_fft configuration!\n");
+    // Build cached FFT plans and window tables for every supported size
+    if (!fft_plan_init(ADC_SAMPLING_DEFAULT_FFT_SIZE, (fft_window_type_t)FFT_WINDOW_TYPE)) {
+        printf("ERROR: Failed to initialize FFT plan registry!\n");
+        return false;
+    }
+    g_unified_analyzer.fft_plan = fft_plan_get_active();
+    g_unified_analyzer.fft_size = g_unified_analyzer.fft_plan->size;
+    
+    // Decimated baseband stage (enabled with adc_sampling_set_baseband_enabled())
+    if (!fft_baseband_init()) {
         return false;
     }
     
+    // Frame hop for ring mode (overlapped STFT)
+    g_unified_analyzer.hop_divisor = ADC_STFT_HOP_DIVISOR;
+    g_unified_analyzer.hop_size = g_unified_analyzer.fft_size / ADC_STFT_HOP_DIVISOR;
+    
+    // Cross spectrum of channel B against channel A
+    if (ADC_SAMPLING_CHANNELS > 1 &&
+        !fft_cross_init(CROSS_SPECTRUM_AVERAGES, adc_sampling_get_channel_skew())) {
+        return false;
+    }
+    
+    // Fold all constant scaling terms into the dB stage offset
+    _adc_update_db_offset();
+    
     // Initialize mode-specific components
     bool init_success = false;
-    if (mode == ADC_MODE_DMA) {
+    if (mode == ADC_MODE_DMA || mode == ADC_MODE_DMA_RING) {
         init_success = _adc_dma_init();
     } else {
         init_success = _adc_manual_init();
@@ -66,10 +105,28 @@ bool adc_sampling_init(adc_sampling_mode_t mode) {
     
     if (init_success) {
         printf("ADC sampling system initialized successfully\n");
-        printf("  Mode: %s\n", mode == ADC_MODE_DMA ? "DMA" : "Manual");
-        printf("  Sampling Rate: %d Hz\n", ADC_SAMPLING_RATE);
-        printf("  FFT Size: %d\n", ADC_SAMPLING_FFT_SIZE);
-        printf("  Buffer Size: %d samples\n", ADC_SAMPLING_FFT_SIZE);
+        printf("  Mode: %s\n", adc_sampling_get_mode_name(mode));
+        printf("  Sampling Rate: %.1f Hz (ADC divider %.3f, runtime range %.0f - %.0f Hz)\n",
+               g_unified_analyzer.sample_rate, g_unified_analyzer.adc_clkdiv,
+               ADC_SAMPLE_RATE_MIN_HZ, ADC_SAMPLE_RATE_MAX_HZ);
+        printf("  Sample Format: %d-bit (%d bytes per sample)\n", ADC_SAMPLE_BITS,
+               (int)sizeof(adc_sample_t));
+        if (ADC_SAMPLING_CHANNELS > 1) {
+            printf("  Channels: A = ADC0 (GP26), B = ADC1 (GP27), round robin at %.0f Hz, B skew %.3f samples\n",
+                   g_unified_analyzer.sample_rate * ADC_SAMPLING_CHANNELS, adc_sampling_get_channel_skew());
+        }
+        printf("  FFT Size: %d (%s)\n", g_unified_analyzer.fft_size,
+               FFT_REAL_INPUT_ENABLED ? "real-input kiss_fftr" : "complex kiss_fft");
+#ifdef FFT_BACKEND_GENERATED
+        printf("  FFT Backend: generated kernels (kiss_fft for other sizes)\n");
+#endif
+        printf("  Buffer Size: %d samples (max %d)\n", g_unified_analyzer.fft_size,
+               ADC_SAMPLING_MAX_FFT_SIZE);
+        if (mode == ADC_MODE_DMA_RING) {
+            printf("  Ring: %d samples, hop %d (%.1f%% overlap)\n", ADC_RING_SIZE,
+                   g_unified_analyzer.hop_size,
+                   100.0f * (1.0f - 1.0f / g_unified_analyzer.hop_divisor));
+        }
     } else {
         printf("ERROR: Failed to initialize ADC sampling system!\n");
     }
@@ -88,12 +145,13 @@ bool adc_sampling_start(void) {
     
     printf("Starting ADC sampling...\n");
     
-    // Reset performance counters
+    // Reset performance counters (the rate measurement starts a new window)
     adc_sampling_reset_counters();
+    g_unified_analyzer.rate_anchored = false;
     g_unified_analyzer.sampling_start_time = get_absolute_time();
     
     // Start mode-specific sampling
-    if (g_unified_analyzer.mode == ADC_MODE_DMA) {
+    if (g_unified_analyzer.mode != ADC_MODE_MANUAL) {
         _adc_dma_start();
     }
     // Manual mode starts sampling on first call to adc_sampling_is_ready()
@@ -102,7 +160,7 @@ bool adc_sampling_start(void) {
     g_unified_analyzer.sampling_active = true;
     
     printf("ADC sampling started in %s mode\n", 
-           g_unified_analyzer.mode == ADC_MODE_DMA ? "DMA" : "Manual");
+           adc_sampling_get_mode_name(g_unified_analyzer.mode));
     return true;
 }
 
@@ -118,7 +176,7 @@ bool adc_sampling_stop(void) {
     printf("Stopping ADC sampling...\n");
     
     // Stop mode-specific sampling
-    if (g_unified_analyzer.mode == ADC_MODE_DMA) {
+    if (g_unified_analyzer.mode != ADC_MODE_MANUAL) {
         _adc_dma_stop();
     }
     
@@ -131,13 +189,13 @@ bool adc_sampling_stop(void) {
         g_unified_analyzer.sampling_start_time, get_absolute_time());
     if (total_time > 0) {
         g_unified_analyzer.actual_sample_rate = 
-            (float)g_unified_analyzer.sample_count * 1000000.0f / (float)total_time;
+            (float)adc_sampling_get_sample_count() * 1000000.0f / (float)total_time;
     }
     
     printf("ADC sampling stopped\n");
-    printf("  Total samples: %lu\n", g_unified_analyzer.sample_count);
+    printf("  Total samples: %lu\n", adc_sampling_get_sample_count());
     printf("  Actual rate: %.1f Hz\n", g_unified_analyzer.actual_sample_rate);
-    printf("  Buffer overruns: %lu\n", g_unified_analyzer.buffer_overruns);
+    printf("  Buffer overruns: %lu\n", adc_sampling_get_overrun_count());
     
     return true;
 }
@@ -153,13 +211,49 @@ bool adc_sampling_is_ready(void) {
         _adc_manual_sample_buffer();
     }
     
+    // For DMA mode, claim the next buffer the IRQ published
+    if (g_unified_analyzer.mode == ADC_MODE_DMA && 
+        g_unified_analyzer.sampling_active && 
+        !g_unified_analyzer.data_ready) {
+        _adc_dma_acquire_buffer();
+    }
+    
+    // For ring mode, cut the next overlapped frame out of the ring
+    if (g_unified_analyzer.mode == ADC_MODE_DMA_RING && 
+        g_unified_analyzer.sampling_active && 
+        !g_unified_analyzer.data_ready) {
+        _adc_ring_acquire_frame();
+    }
+    
+    // Two-channel ping/pong and manual frames: split the channels once
+    // (ring mode deinterleaves while copying out of the ring)
+    if (ADC_SAMPLING_CHANNELS > 1 && g_unified_analyzer.data_ready &&
+        g_unified_analyzer.ready_buffer != g_unified_analyzer.frame_buffer) {
+        _adc_deinterleave_frame(g_unified_analyzer.ready_buffer, 0, UINT32_MAX);
+        g_unified_analyzer.ready_buffer = g_unified_analyzer.frame_buffer;
+    }
+    
+    // Multirate: decimate the new part of each frame once, whatever the analysis mode
+    if (g_unified_analyzer.data_ready && g_unified_analyzer.baseband_enabled && 
+        !g_unified_analyzer.baseband_fed) {
+        int new_count = 0;
+        const adc_sample_t* new_samples = adc_sampling_get_new_samples(&new_count);
+        fft_baseband_process(new_samples, new_count);
+        g_unified_analyzer.baseband_fed = true;
+        
+        // A torn frame leaves neither decimator history nor a spectrum behind
+        if (!adc_sampling_check_frame()) {
+            fft_baseband_reset();
+        }
+    }
+    
     return g_unified_analyzer.data_ready;
 }
 
 /**
  * Get pointer to buffer with ready ADC data
  */
-uint16_t* adc_sampling_get_buffer(void) {
+adc_sample_t* adc_sampling_get_buffer(void) {
     if (!g_unified_analyzer.data_ready) {
         return NULL;
     }
@@ -170,15 +264,26 @@ uint16_t* adc_sampling_get_buffer(void) {
 /**
  * Signal that processing of current buffer is complete
  */
-void adc_sampling_complete_processing(void) {
-    if (g_unified_analyzer.data_ready) {
-        g_unified_analyzer.data_ready = false;
-        g_unified_analyzer.fft_ready = false;
-        g_unified_analyzer.ready_buffer = NULL;
-        
-        // For manual mode, we can immediately start next buffer
-        // For DMA mode, next buffer is already being filled automatically
+bool adc_sampling_complete_processing(void) {
+    if (!g_unified_analyzer.data_ready) {
+        return false;
     }
+    bool intact = !g_unified_analyzer.frame_torn;
+    g_unified_analyzer.data_ready = false;
+    g_unified_analyzer.fft_ready = false;
+    g_unified_analyzer.magnitude_ready = false;
+    g_unified_analyzer.baseband_fed = false;
+    g_unified_analyzer.frame_torn = false;
+    g_unified_analyzer.ready_buffer = NULL;
+    
+    // For manual mode, we can immediately start next buffer
+    // For DMA mode, the slot returns to the DMA cycle (an overwrite
+    // while it was processed counts as an overrun)
+    // For ring mode, the next frame starts one hop later
+    if (g_unified_analyzer.mode == ADC_MODE_DMA && !adc_frame_queue_release(&g_unified_analyzer.capture)) {
+        intact = false;
+    }
+    return intact;
 }
 
 /**
@@ -195,6 +300,113 @@ adc_sampling_mode_t adc_sampling_get_mode(void) {
     return g_unified_analyzer.mode;
 }
 
+/**
+ * Get sampling mode name as string
+ */
+const char* adc_sampling_get_mode_name(adc_sampling_mode_t mode) {
+    switch (mode) {
+        case ADC_MODE_MANUAL:   return "Manual";
+        case ADC_MODE_DMA:      return "DMA";
+        case ADC_MODE_DMA_RING: return "DMA Ring";
+        default:                return "Unknown";
+    }
+}
+
+/**
+ * Set the frame hop of ring mode
+ */
+bool adc_sampling_set_hop_divisor(int hop_divisor) {
+    if (hop_divisor != 1 && hop_divisor != 2 && hop_divisor != 4 && hop_divisor != 8) {
+        return false;
+    }
+    g_unified_analyzer.hop_divisor = hop_divisor;
+    g_unified_analyzer.hop_size = g_unified_analyzer.fft_size / hop_divisor;
+    return true;
+}
+
+/**
+ * Get the frame hop in samples
+ */
+int adc_sampling_get_hop_size(void) {
+    return (g_unified_analyzer.mode == ADC_MODE_DMA_RING) ? 
+           g_unified_analyzer.hop_size : g_unified_analyzer.fft_size;
+}
+
+/**
+ * Get the capture time of the ready buffer
+ */
+uint32_t adc_sampling_get_ready_timestamp(void) {
+    return g_unified_analyzer.ready_frame.timestamp_us;
+}
+
+/**
+ * Get the queue information of the ready buffer
+ */
+bool adc_sampling_get_frame_info(adc_frame_info_t* frame) {
+    if (!g_unified_analyzer.data_ready || frame == NULL) {
+        return false;
+    }
+    *frame = g_unified_analyzer.ready_frame;
+    return true;
+}
+
+/**
+ * Get the depth and backlog of the DMA frame queue
+ */
+int adc_sampling_get_queue_slots(uint32_t* backlog) {
+    bool queued = (g_unified_analyzer.mode == ADC_MODE_DMA && g_unified_analyzer.capture_slots > 0);
+    if (backlog != NULL) {
+        *backlog = queued ? adc_frame_queue_get_backlog(&g_unified_analyzer.capture) : 0;
+    }
+    return queued ? g_unified_analyzer.capture_slots : 0;
+}
+
+/**
+ * Get the number of captured channels
+ */
+int adc_sampling_get_channel_count(void) {
+    return ADC_SAMPLING_CHANNELS;
+}
+
+/**
+ * Get one channel of the ready frame
+ */
+const adc_sample_t* adc_sampling_get_channel_buffer(int channel) {
+    if (!g_unified_analyzer.data_ready || g_unified_analyzer.ready_buffer == NULL ||
+        channel < 0 || channel >= ADC_SAMPLING_CHANNELS) {
+        return NULL;
+    }
+    return g_unified_analyzer.ready_buffer + channel * g_unified_analyzer.fft_size;
+}
+
+/**
+ * Get the delay of channel B behind channel A
+ */
+float adc_sampling_get_channel_skew(void) {
+    if (ADC_SAMPLING_CHANNELS < 2) {
+        return 0.0f;
+    }
+    if (g_unified_analyzer.mode == ADC_MODE_MANUAL) {
+        return (float)ADC_CONVERSION_CYCLES * g_unified_analyzer.sample_rate / ADC_CLOCK_HZ;
+    }
+    return 1.0f / (float)ADC_SAMPLING_CHANNELS;
+}
+
+/**
+ * Get the samples of the ready buffer that no earlier frame contained
+ */
+const adc_sample_t* adc_sampling_get_new_samples(int* count) {
+    if (!g_unified_analyzer.data_ready || g_unified_analyzer.ready_buffer == NULL) {
+        *count = 0;
+        return NULL;
+    }
+    
+    // Overlapped frames: only the trailing hop is new
+    int new_count = adc_sampling_get_hop_size();
+    *count = new_count;
+    return g_unified_analyzer.ready_buffer + (g_unified_analyzer.fft_size - new_count);
+}
+
 // ========================================
 // 🔧 Performance Monitoring API Implementation
 // ========================================
@@ -210,14 +422,56 @@ float adc_sampling_get_actual_rate(void) {
  * Get buffer overrun count
  */
 uint32_t adc_sampling_get_overrun_count(void) {
+    if (g_unified_analyzer.mode == ADC_MODE_DMA) {
+        return adc_frame_queue_get_overruns(&g_unified_analyzer.capture);
+    }
     return g_unified_analyzer.buffer_overruns;
 }
 
+/**
+ * Get the number of frames dropped as torn
+ */
+uint32_t adc_sampling_get_torn_count(void) {
+    return g_unified_analyzer.torn_frames;
+}
+
+/**
+ * Check whether the ready frame was dropped as torn
+ */
+bool adc_sampling_is_frame_torn(void) {
+    return g_unified_analyzer.frame_torn;
+}
+
+/**
+ * Check the ready frame after a stage read the capture slot for the last time
+ */
+bool adc_sampling_check_frame(void) {
+    if (!g_unified_analyzer.data_ready || g_unified_analyzer.frame_torn) {
+        return false;
+    }
+    if (g_unified_analyzer.mode == ADC_MODE_DMA && !adc_frame_queue_intact(&g_unified_analyzer.capture)) {
+        g_unified_analyzer.frame_torn = true;
+        g_unified_analyzer.torn_frames++;
+        g_unified_analyzer.fft_ready = false;
+        return false;
+    }
+    return true;
+}
+
 /**
  * Get total sample count
  */
 uint32_t adc_sampling_get_sample_count(void) {
-    return g_unified_analyzer.sample_count;
+    // DMA modes derive the count from what the IRQ published
+    switch (g_unified_analyzer.mode) {
+        case ADC_MODE_DMA:
+            return adc_frame_queue_get_completed(&g_unified_analyzer.capture) * 
+                   (uint32_t)g_unified_analyzer.fft_size;
+        case ADC_MODE_DMA_RING:
+            return g_unified_analyzer.ring_write_count / ADC_SAMPLING_CHANNELS;
+        default:
+            return g_unified_analyzer.sample_count;
+    }
 }
 
 /**
@@ -226,6 +480,9 @@ uint32_t adc_sampling_get_sample_count(void) {
 void adc_sampling_reset_counters(void) {
     g_unified_analyzer.sample_count = 0;
     g_unified_analyzer.buffer_overruns = 0;
+    g_unified_analyzer.frame_sequence = 0;
+    g_unified_analyzer.frame_dropped = 0;
+    g_unified_analyzer.torn_frames = 0;
     g_unified_analyzer.actual_sample_rate = 0.0f;
 }
 
@@ -237,47 +494,37 @@ void adc_sampling_reset_counters(void) {
  * Process current ADC buffer through FFT with windowing
  */
 bool adc_sampling_process_fft(void) {
-    uint16_t* buffer = adc_sampling_get_buffer();
-    if (buffer == NULL) {
+    adc_sample_t* buffer = adc_sampling_get_buffer();
+    if (buffer == NULL || g_unified_analyzer.frame_torn) {
         return false;
     }
     
-    // Apply window function and convert to complex
-    _adc_apply_window_function(buffer, g_unified_analyzer.fft_input);
+    if (ADC_SAMPLING_CHANNELS > 1) {
+        _adc_process_dual_fft(buffer);
+    } else {
+        // Apply window function and convert to FFT input format
+        _adc_apply_window_function(buffer, g_unified_analyzer.fft_input);
+    }
     
-    // Perform FFT
-    kiss_fft(g_unified_analyzer.fft_cfg, 
-             g_unified_analyzer.fft_input, 
-             g_unified_analyzer.fft_output);
+    // The capture slot has been read for the last time: a frame DMA reached
+    // meanwhile is dropped before anything is averaged or published
+    if (!adc_sampling_check_frame()) {
+        return false;
+    }
     
-    // Calculate magnitude spectrum
-    for (int i = 0; i < ADC_SAMPLING_FFT_SIZE/2; i++) {
-        float real = g_unified_analyzer.fft_output[i].r;
-        float imag = g_unified_analyzer.fft_output[i].i;
-        
-        // Calculate magnitude
-        float magnitude = sqrtf(real * real + imag * imag);
-        
-        // Normalize by FFT size
-        magnitude /= ADC_SAMPLING_FFT_SIZE;
-        
-        // Convert ADC digital magnitude to voltage
-        // ADC reading (0-4095) -> voltage (0-3.3V)
-        float voltage_magnitude = magnitude * ADC_VOLTAGE_PER_BIT;
-        
-        // Convert to dBm scale relative to 0.274V @ 0dBm for 75Ω system
-        // dBm = 20 * log10(Vmeasured / V0dBm)
-        float db_magnitude;
-        if (voltage_magnitude > 1e-10f) {
-            db_magnitude = 20.0f * log10f(voltage_magnitude / DB_REFERENCE_VOLTAGE_0DBM);
-        } else {
-            db_magnitude = -200.0f;  // Very low value
-        }
-        
-        g_unified_analyzer.magnitude[i] = db_magnitude;
+    if (ADC_SAMPLING_CHANNELS > 1) {
+        fft_cross_accumulate(g_unified_analyzer.fft_output, g_unified_analyzer.fft_size);
+    } else {
+        // Perform FFT (kiss_fft plan or generated kernel of the active size); in
+        // real-input builds fft_input and fft_output are the same memory
+        fft_plan_forward(g_unified_analyzer.fft_plan,
+                         g_unified_analyzer.fft_input,
+                         g_unified_analyzer.fft_output);
     }
     
+    // The dB reduction runs on demand: Welch mode consumes the complex bins
     g_unified_analyzer.fft_ready = true;
+    g_unified_analyzer.magnitude_ready = false;
     return true;
 }
 
@@ -295,20 +542,232 @@ float* adc_sampling_get_magnitude_spectrum(void) {
     if (!g_unified_analyzer.fft_ready) {
         return NULL;
     }
+    if (!g_unified_analyzer.magnitude_ready) {
+        // |X|^2 -> dBm in one pass (window correction and scaling are in the
+        // offset), written over the bins it reads
+        fft_db_convert_spectrum(g_unified_analyzer.fft_output, 
+                                g_unified_analyzer.magnitude, 
+                                g_unified_analyzer.fft_size/2);
+        g_unified_analyzer.magnitude_ready = true;
+    }
     return g_unified_analyzer.magnitude;
 }
 
+/**
+ * Get raw FFT output of the last processed frame
+ */
+const kiss_fft_cpx* adc_sampling_get_fft_output(void) {
+    if (!g_unified_analyzer.fft_ready || g_unified_analyzer.magnitude_ready) {
+        return NULL;
+    }
+    return g_unified_analyzer.fft_output;
+}
+
 /**
  * Convert FFT bin to frequency in Hz
  */
 float adc_sampling_bin_to_frequency(int bin) {
-    return (float)bin * ADC_SAMPLING_RATE / (float)ADC_SAMPLING_FFT_SIZE;
+    return (float)bin * adc_sampling_get_sample_rate() / (float)g_unified_analyzer.fft_size;
+}
+
+/**
+ * Change the sample rate at runtime
+ */
+bool adc_sampling_set_sample_rate(float rate_hz) {
+    if (!(rate_hz >= ADC_SAMPLE_RATE_MIN_HZ && rate_hz <= ADC_SAMPLE_RATE_MAX_HZ)) {
+        printf("ERROR: Sample rate %.1f Hz out of range (%.0f - %.0f Hz)\n",
+               rate_hz, ADC_SAMPLE_RATE_MIN_HZ, ADC_SAMPLE_RATE_MAX_HZ);
+        return false;
+    }
+    
+    // Frames in flight were taken at the old rate; restart sampling
+    bool was_active = g_unified_analyzer.sampling_active;
+    if (was_active) {
+        adc_sampling_stop();
+    }
+    
+    _adc_apply_sample_rate(rate_hz);
+    g_unified_analyzer.actual_sample_rate = 0.0f;
+    g_unified_analyzer.rate_anchored = false;
+    g_unified_analyzer.fft_ready = false;
+    g_unified_analyzer.magnitude_ready = false;
+    g_unified_analyzer.ready_buffer = NULL;
+    
+    // Decimator history and cross averages belong to the old rate (the
+    // manual-mode channel skew follows it)
+    fft_baseband_reset();
+    if (ADC_SAMPLING_CHANNELS > 1 &&
+        !fft_cross_init(CROSS_SPECTRUM_AVERAGES, adc_sampling_get_channel_skew())) {
+        return false;
+    }
+    
+    if (was_active) {
+        adc_sampling_start();
+    }
+    return true;
+}
+
+/**
+ * Get the calibrated sample rate for frequency mapping
+ */
+float adc_sampling_get_sample_rate(void) {
+    float measured = g_unified_analyzer.actual_sample_rate;
+    return (measured > 0.0f) ? measured : g_unified_analyzer.sample_rate;
+}
+
+/**
+ * Get the nominal sample rate of the programmed divider
+ */
+float adc_sampling_get_nominal_rate(void) {
+    return g_unified_analyzer.sample_rate;
+}
+
+/**
+ * Enable the decimated baseband spectrum
+ */
+void adc_sampling_set_baseband_enabled(bool enabled) {
+    if (enabled && !g_unified_analyzer.baseband_enabled) {
+        fft_baseband_reset();
+    }
+    g_unified_analyzer.baseband_enabled = enabled;
+}
+
+/**
+ * Check whether the baseband stage runs
+ */
+bool adc_sampling_is_baseband_enabled(void) {
+    return g_unified_analyzer.baseband_enabled;
+}
+
+/**
+ * Get the baseband magnitude spectrum
+ */
+const float* adc_sampling_get_baseband_spectrum(void) {
+    return g_unified_analyzer.baseband_enabled ? fft_baseband_get_magnitude() : NULL;
+}
+
+/**
+ * Get the number of baseband bins
+ */
+int adc_sampling_get_baseband_bins(void) {
+    return FFT_BASEBAND_BINS;
+}
+
+/**
+ * Convert a baseband bin to frequency in Hz
+ */
+float adc_sampling_baseband_bin_to_frequency(int bin) {
+    return (float)bin * fft_baseband_get_bin_width(adc_sampling_get_sample_rate());
+}
+
+/**
+ * Switch the active window function
+ */
+bool adc_sampling_set_window(fft_window_type_t type) {
+    if (!fft_window_select(type)) {
+        return false;
+    }
+    _adc_update_db_offset();
+    return true;
+}
+
+/**
+ * Switch the FFT size using a cached plan
+ */
+bool adc_sampling_set_fft_size(int size) {
+    if (!fft_plan_is_supported(size)) {
+        return false;
+    }
+    if (ADC_SAMPLING_CHANNELS > 1 && size > FFT_CROSS_MAX_SIZE) {
+        printf("ERROR: FFT size %d exceeds the two-channel limit of %d\n", size, FFT_CROSS_MAX_SIZE);
+        return false;
+    }
+    if (size == g_unified_analyzer.fft_size) {
+        return true;
+    }
+    
+    // Buffers in flight were sized for the old length; restart sampling
+    bool was_active = g_unified_analyzer.sampling_active;
+    if (was_active) {
+        adc_sampling_stop();
+    }
+    
+    if (!fft_plan_select(size)) {
+        return false;
+    }
+    g_unified_analyzer.fft_plan = fft_plan_get_active();
+    g_unified_analyzer.fft_size = size;
+    g_unified_analyzer.hop_size = size / g_unified_analyzer.hop_divisor;
+    g_unified_analyzer.fft_ready = false;
+    g_unified_analyzer.magnitude_ready = false;
+    g_unified_analyzer.ready_buffer = NULL;
+    _adc_update_db_offset();
+    
+    // Sampling restarts with a gap; drop the decimator history across it
+    fft_baseband_reset();
+    
+    if (was_active) {
+        adc_sampling_start();
+    }
+    return true;
+}
+
+/**
+ * Get the active FFT size
+ */
+int adc_sampling_get_fft_size(void) {
+    return g_unified_analyzer.fft_size;
+}
+
+/**
+ * Time every cached FFT size on the analyzer's work buffers
+ */
+bool adc_sampling_benchmark_fft(int frames) {
+    if (g_unified_analyzer.sampling_active) {
+        printf("ERROR: Stop sampling before the FFT size benchmark\n");
+        return false;
+    }
+    
+    fft_plan_benchmark(g_unified_analyzer.fft_input, g_unified_analyzer.fft_output, frames);
+    g_unified_analyzer.fft_ready = false;
+    g_unified_analyzer.magnitude_ready = false;
+    return true;
 }
 
 // ========================================
 // 🔧 DMA Mode Implementation
 // ========================================
 
+// Next-slot address table of the control channel (aligned for its read ring)
+static adc_sample_t* s_capture_addresses[ADC_FRAME_QUEUE_MAX_SLOTS]
+    __attribute__((aligned(ADC_CAPTURE_TABLE_BYTES)));
+
+// Transfer count the control channel writes to re-trigger a ring block
+static uint32_t s_ring_block_count = ADC_RING_DMA_BLOCK;
+
+/**
+ * Slot the capture channel is writing now (frame queue DMA slot source)
+ * The control channel's read address already points at the table entry
+ * after the one it loaded, so it leads the completion IRQ
+ */
+static int _adc_dma_capture_slot(void) {
+    uintptr_t read_addr = (uintptr_t)dma_channel_hw_addr((uint)g_unified_analyzer.dma_control_channel)->read_addr;
+    int next = (int)((read_addr - (uintptr_t)s_capture_addresses) / sizeof(s_capture_addresses[0]));
+    return (next + g_unified_analyzer.capture_slots - 1) % g_unified_analyzer.capture_slots;
+}
+
+/**
+ * Take the ADC FIFO overflow flag (set when DMA fell behind the ADC)
+ * @return ADC_FRAME_FLAG_ADC_OVERFLOW if samples were lost since the last call
+ */
+static uint32_t _adc_take_fifo_overflow(void) {
+    if ((adc_hw->fcs & ADC_FCS_OVER_BITS) == 0) {
+        return 0;
+    }
+    hw_set_bits(&adc_hw->fcs, ADC_FCS_OVER_BITS);  // Write 1 to clear
+    return ADC_FRAME_FLAG_ADC_OVERFLOW;
+}
+
 /**
  * Initialize DMA mode
  */
@@ -317,19 +776,27 @@ bool _adc_dma_init(void) {
     printf("Initializing DMA mode...\n");
     
     // Configure ADC for DMA mode
-    adc_set_round_robin(0);  // Single channel
-    adc_fifo_setup(true, true, 1, false, false);  // Enable FIFO, enable DMA requests
+    adc_set_round_robin(ADC_ROUND_ROBIN_MASK);  // Single channel, or A/B alternating
+    adc_fifo_setup(true, true, 1, false, ADC_CAPTURE_8BIT);  // Enable FIFO, DMA requests, byte shift (8-bit capture)
     
-    // Claim DMA channel
+    // Claim the capture channel and the control channel that re-arms it
     if (ADC_DMA_CHANNEL_AUTO == -1) {
         g_unified_analyzer.dma_channel = dma_claim_unused_channel(true);
     } else {
         g_unified_analyzer.dma_channel = ADC_DMA_CHANNEL_AUTO;
         dma_channel_claim(g_unified_analyzer.dma_channel);
     }
+    g_unified_analyzer.dma_control_channel = dma_claim_unused_channel(true);
     
-    if (g_unified_analyzer.dma_channel < 0) {
-        printf("ERROR: Failed to claim DMA channel\n");
+    if (g_unified_analyzer.dma_channel < 0 || g_unified_analyzer.dma_control_channel < 0) {
+        printf("ERROR: Failed to claim DMA channels\n");
+        return false;
+    }
+    
+    // The DMA address wrap needs storage aligned to the ring size
+    if (g_unified_analyzer.mode == ADC_MODE_DMA_RING &&
+        ((uintptr_t)g_unified_analyzer.ring & (ADC_RING_BYTES - 1)) != 0) {
+        printf("ERROR: Ring mode needs ADC_DMA_RING_BUFFER_MODE=1 (16KB-aligned capture storage)\n");
         return false;
     }
     
@@ -339,14 +806,19 @@ bool _adc_dma_init(void) {
     channel_config_set_read_increment(&g_unified_analyzer.dma_config, false);   // Read from ADC FIFO
     channel_config_set_write_increment(&g_unified_analyzer.dma_config, true);   // Write to buffer
     channel_config_set_dreq(&g_unified_analyzer.dma_config, DREQ_ADC);         // ADC triggers DMA
+    if (g_unified_analyzer.mode == ADC_MODE_DMA_RING) {
+        // Write address wraps inside the aligned ring (no re-arming of the address)
+        channel_config_set_ring(&g_unified_analyzer.dma_config, true, ADC_RING_SIZE_BITS);
+    }
     
-    // Set up DMA interrupt
+    // Set up DMA interrupt (capture channel completions only)
     dma_channel_set_irq0_enabled(g_unified_analyzer.dma_channel, true);
     irq_set_exclusive_handler(DMA_IRQ_0, _adc_dma_interrupt_handler);
     irq_set_enabled(DMA_IRQ_0, true);
     irq_set_priority(DMA_IRQ_0, ADC_DMA_PRIORITY);
     
-    printf("DMA mode initialized - Channel: %d\n", g_unified_analyzer.dma_channel);
+    printf("DMA mode initialized - Capture channel: %d, control channel: %d\n",
+           g_unified_analyzer.dma_channel, g_unified_analyzer.dma_control_channel);
     return true;
     #else
     printf("ERROR: DMA mode not enabled in config_settings.h\n");
@@ -356,24 +828,109 @@ bool _adc_dma_init(void) {
 
 /**
  * Start DMA sampling
+ * The capture channel chains to the control channel, which writes one word
+ * into a triggering alias of the capture channel: the next buffer address
+ * (ping/pong) or the next block count (ring). The capture restarts within a
+ * few bus cycles of completing, long before the ADC FIFO fills, and the CPU
+ * never touches the channel setup while sampling
  */
 void _adc_dma_start(void) {
     #if ADC_DMA_ENABLED
+    if (ADC_SAMPLING_CHANNELS > 1) {
+        // Every frame must start on channel A: restart the round robin there
+        // and drop conversions left over from the last run
+        adc_select_input(ADC_SAMPLING_CHANNEL);
+        adc_fifo_drain();
+    }
+    
+    const uint capture = (uint)g_unified_analyzer.dma_channel;
+    dma_channel_hw_t* capture_hw = dma_channel_hw_addr(capture);
+    dma_channel_config control_config = dma_channel_get_default_config(g_unified_analyzer.dma_control_channel);
+    channel_config_set_transfer_data_size(&control_config, DMA_SIZE_32);
+    channel_config_set_write_increment(&control_config, false);
+    channel_config_set_chain_to(&g_unified_analyzer.dma_config, g_unified_analyzer.dma_control_channel);
+    
+    if (g_unified_analyzer.mode == ADC_MODE_DMA_RING) {
+        // Ring mode: continuous blocks into the ring, frames cut at the hop
+        // (the time of the previous run's last block must not anchor the rate)
+        g_unified_analyzer.ring_write_count = 0;
+        g_unified_analyzer.ring_timestamp_us = 0;
+        g_unified_analyzer.ring_read_start = 0;
+        atomic_store_explicit(&g_unified_analyzer.ring_flags, 0, memory_order_relaxed);
+        
+        // Control: rewrite the block count (TRANS_COUNT_TRIG); the write
+        // address continues (and wraps) in the ring
+        channel_config_set_read_increment(&control_config, false);
+        dma_channel_configure(
+            g_unified_analyzer.dma_control_channel,
+            &control_config,
+            &capture_hw->al1_transfer_count_trig, // Destination (capture re-trigger)
+            &s_ring_block_count,                  // Source (block length)
+            1,                                    // One word per block
+            false                                 // Triggered by the capture chain
+        );
+        dma_channel_configure(
+            capture,
+            &g_unified_analyzer.dma_config,
+            g_unified_analyzer.ring,              // Destination (ring base)
+            &adc_hw->fifo,                        // Source (ADC FIFO)
+            ADC_RING_DMA_BLOCK,                   // Transfer count
+            false                                 // Don't start yet
+        );
+        dma_channel_start(capture);
+        adc_run(true);
+        
+        printf("DMA ring sampling started\n");
+        return;
+    }
+    
+    // Frame queue: as many one-frame slots as fit the ring storage (up to
+    // ADC_CAPTURE_SLOTS); the control channel reads the next slot address
+    // from the table (read ring) into WRITE_ADDR_TRIG; the transfer count reloads
+    const int frame_length = g_unified_analyzer.fft_size * ADC_SAMPLING_CHANNELS;
+    int slots = ADC_CAPTURE_SLOTS;
+    while (slots > 2 && slots * frame_length > ADC_RING_SIZE) {
+        slots /= 2;
+    }
+    int table_bits = 2;
+    while ((1 << table_bits) < slots * (int)sizeof(uint32_t)) {
+        table_bits++;
+    }
+    for (int slot = 0; slot < slots; slot++) {
+        s_capture_addresses[slot] = g_unified_analyzer.ring + slot * frame_length;
+    }
+    g_unified_analyzer.capture_slots = slots;
+    adc_frame_queue_reset(&g_unified_analyzer.capture, slots);
+    
+    channel_config_set_read_increment(&control_config, true);
+    channel_config_set_ring(&control_config, false, table_bits);
+    dma_channel_configure(
+        g_unified_analyzer.dma_control_channel,
+        &control_config,
+        &capture_hw->al2_write_addr_trig,     // Destination (capture re-trigger)
+        &s_capture_addresses[1],              // Source (address after slot 0)
+        1,                                    // One address per frame
+        false                                 // Triggered by the capture chain
+    );
+    
+    // Intact checks follow the hardware, not only the (IRQ-delayed) count
+    adc_frame_queue_set_dma_slot(&g_unified_analyzer.capture, _adc_dma_capture_slot);
+    
     // Configure first DMA transfer
     dma_channel_configure(
-        g_unified_analyzer.dma_channel,
+        capture,
         &g_unified_analyzer.dma_config,
-        g_unified_analyzer.current_buffer,    // Destination
+        s_capture_addresses[0],               // Destination
         &adc_hw->fifo,                        // Source (ADC FIFO)
-        ADC_SAMPLING_FFT_SIZE,                // Transfer count
+        g_unified_analyzer.fft_size * ADC_SAMPLING_CHANNELS, // Transfer count
         false                                 // Don't start yet
     );
     
     // Start DMA and ADC
-    dma_channel_start(g_unified_analyzer.dma_channel);
+    dma_channel_start(capture);
     adc_run(true);
     
-    printf("DMA sampling started\n");
+    printf("DMA sampling started (frame queue: %d slots)\n", slots);
     #endif
 }
 
@@ -383,6 +940,12 @@ void _adc_dma_start(void) {
 void _adc_dma_stop(void) {
     #if ADC_DMA_ENABLED
     adc_run(false);
+    
+    // Unchain before aborting, so a capture completion cannot re-trigger
+    // the control channel (and the control channel the capture) mid-abort
+    channel_config_set_chain_to(&g_unified_analyzer.dma_config, g_unified_analyzer.dma_channel);
+    dma_channel_set_config(g_unified_analyzer.dma_channel, &g_unified_analyzer.dma_config, false);
+    dma_channel_abort(g_unified_analyzer.dma_control_channel);
     dma_channel_abort(g_unified_analyzer.dma_channel);
     printf("DMA sampling stopped\n");
     #endif
@@ -390,40 +953,54 @@ void _adc_dma_stop(void) {
 
 /**
  * DMA interrupt handler
+ * Only publishes the completion: the control channel has already re-armed
+ * the capture, and overruns are detected by the consumer
  */
 void _adc_dma_interrupt_handler(void) {
     #if ADC_DMA_ENABLED
     // Clear interrupt flag
     dma_hw->ints0 = 1u << g_unified_analyzer.dma_channel;
+    uint32_t now_us = time_us_32();
+    uint32_t flags = _adc_take_fifo_overflow();
     
-    // Update sample count
-    g_unified_analyzer.sample_count += ADC_SAMPLING_FFT_SIZE;
-    
-    // Check for buffer overrun
-    if (g_unified_analyzer.data_ready) {
-        g_unified_analyzer.buffer_overruns++;
-        if (ADC_DMA_OVERRUN_DETECTION) {
-            printf("Warning: Buffer overrun detected!\n");
+    if (g_unified_analyzer.mode == ADC_MODE_DMA_RING) {
+        // Publish completed samples (single aligned 32-bit store, after the time)
+        if (flags != 0) {
+            atomic_fetch_or_explicit(&g_unified_analyzer.ring_flags, flags, memory_order_relaxed);
         }
+        g_unified_analyzer.ring_timestamp_us = now_us;
+        g_unified_analyzer.ring_write_count += ADC_RING_DMA_BLOCK;
+        return;
     }
     
-    // Swap buffers
-    _adc_swap_buffers();
+    adc_frame_queue_push(&g_unified_analyzer.capture, now_us, flags);
+    #endif
+}
+
+/**
+ * Pop the oldest intact frame completed by DMA
+ * @return true if a buffer became ready
+ */
+bool _adc_dma_acquire_buffer(void) {
+    adc_frame_info_t frame;
+    if (!adc_frame_queue_pop(&g_unified_analyzer.capture, &frame)) {
+        return false;
+    }
     
-    // Set up next DMA transfer to new current buffer
-    dma_channel_configure(
-        g_unified_analyzer.dma_channel,
-        &g_unified_analyzer.dma_config,
-        g_unified_analyzer.current_buffer,    // New destination buffer
-        &adc_hw->fifo,                        // Source (ADC FIFO)
-        ADC_SAMPLING_FFT_SIZE,                // Transfer count
-        true                                  // Start immediately
-    );
+    if (ADC_DMA_OVERRUN_DETECTION && (frame.flags & ADC_FRAME_FLAG_DROPPED)) {
+        printf("Warning: Buffer overrun detected! (%lu frames dropped)\n", (unsigned long)frame.dropped);
+    }
     
-    // Mark data as ready
+    // Every completion is counted in the sequence, so completed conversions
+    // follow from it even when the consumer dropped frames
+    const uint32_t frame_length = (uint32_t)(g_unified_analyzer.fft_size * ADC_SAMPLING_CHANNELS);
+    _adc_measure_rate(frame.timestamp_us, (frame.sequence + 1) * frame_length);
+    
+    g_unified_analyzer.ready_buffer = s_capture_addresses[frame.slot];
+    g_unified_analyzer.ready_frame = frame;
+    g_unified_analyzer.frame_torn = false;
     g_unified_analyzer.data_ready = true;
-    g_unified_analyzer.last_buffer_completion = get_absolute_time();
-    #endif
+    return true;
 }
 
 // ========================================
@@ -450,22 +1027,28 @@ void _adc_manual_sample_buffer(void) {
     // Record sampling start time
     absolute_time_t sample_start = get_absolute_time();
     
-    // Sample ADC data with precise timing
-    for (int i = 0; i < ADC_SAMPLING_FFT_SIZE; i++) {
-        g_unified_analyzer.current_buffer[i] = adc_read();
+    // Sample ADC data with precise timing (two channels: A then B back to
+    // back, the round robin switches the input after each conversion)
+    const uint64_t period_ns = (uint64_t)(1.0e9f / g_unified_analyzer.sample_rate + 0.5f);
+    adc_sample_t* sample = g_unified_analyzer.current_buffer;
+    for (int i = 0; i < g_unified_analyzer.fft_size; i++) {
+        for (int channel = 0; channel < ADC_SAMPLING_CHANNELS; channel++) {
+            *sample++ = (adc_sample_t)(adc_read() >> ADC_SAMPLE_SHIFT);
+        }
         
-        // Precise timing for target sampling rate
-        sleep_us(SAMPLING_INTERVAL_US);
+        // Absolute deadlines: whole-microsecond waits do not accumulate into
+        // a rate error (rates the loop cannot reach show up as measured rate)
+        busy_wait_until(delayed_by_us(sample_start, (uint64_t)(i + 1) * period_ns / 1000u));
     }
     
     // Update sample count
-    g_unified_analyzer.sample_count += ADC_SAMPLING_FFT_SIZE;
+    g_unified_analyzer.sample_count += g_unified_analyzer.fft_size;
     
     // Calculate actual sampling rate
     absolute_time_t sample_end = get_absolute_time();
     int64_t sample_time_us = absolute_time_diff_us(sample_start, sample_end);
     if (sample_time_us > 0) {
-        float current_rate = (float)ADC_SAMPLING_FFT_SIZE * 1000000.0f / (float)sample_time_us;
+        float current_rate = (float)g_unified_analyzer.fft_size * 1000000.0f / (float)sample_time_us;
         
         // Exponential moving average for stable rate measurement
         if (g_unified_analyzer.actual_sample_rate == 0.0f) {
@@ -478,8 +1061,158 @@ void _adc_manual_sample_buffer(void) {
     
     // Swap buffers and mark data ready
     _adc_swap_buffers();
+    g_unified_analyzer.ready_frame = (adc_frame_info_t){
+        .slot = -1,
+        .sequence = g_unified_analyzer.frame_sequence++,
+        .timestamp_us = time_us_32(),
+    };
+    g_unified_analyzer.data_ready = true;
+}
+
+// ========================================
+// 🔧 Ring Mode Implementation
+// ========================================
+
+/**
+ * Cut the next overlapped frame out of the DMA ring
+ * Counters are absolute sample indices, so all distances are computed with
+ * unsigned subtraction and stay valid across 32-bit wrap. DMA may be writing
+ * the block after ring_write_count, so a frame is only safe while it starts
+ * at least ADC_RING_DMA_BLOCK samples inside the ring window.
+ * @return true if a frame was copied to frame_buffer
+ */
+bool _adc_ring_acquire_frame(void) {
+    // Ring distances count raw conversions (both channels in two-channel mode)
+    const uint32_t fft_size = (uint32_t)(g_unified_analyzer.fft_size * ADC_SAMPLING_CHANNELS);
+    const uint32_t hop_size = (uint32_t)(g_unified_analyzer.hop_size * ADC_SAMPLING_CHANNELS);
+    const uint32_t safe_span = ADC_RING_SIZE - ADC_RING_DMA_BLOCK;
+    
+    // Count and completion time of the same block (the IRQ stores the time first)
+    uint32_t write_count;
+    uint32_t write_time_us;
+    do {
+        write_count = g_unified_analyzer.ring_write_count;
+        write_time_us = g_unified_analyzer.ring_timestamp_us;
+    } while (write_count != g_unified_analyzer.ring_write_count);
+    
+    // The timestamp belongs to a block of this run only once one completed
+    if (write_count > 0) {
+        _adc_measure_rate(write_time_us, write_count);
+    }
+    uint32_t start = g_unified_analyzer.ring_read_start;
+    
+    // Reader fell behind the writer: skip whole hops to stay in the safe window
+    uint32_t backlog = write_count - start;
+    if (backlog > safe_span) {
+        uint32_t skipped = (backlog - safe_span + hop_size - 1) / hop_size;
+        start += skipped * hop_size;
+        g_unified_analyzer.buffer_overruns += skipped;
+        g_unified_analyzer.frame_sequence += skipped;
+        g_unified_analyzer.frame_dropped += skipped;
+    }
+    
+    // Frame not complete yet
+    if (write_count - start < fft_size) {
+        g_unified_analyzer.ring_read_start = start;
+        return false;
+    }
+    
+    // Copy (unwrapping at the ring end) into the linear frame buffer
+    uint32_t index = start & ADC_RING_MASK;
+    if (ADC_SAMPLING_CHANNELS > 1) {
+        _adc_deinterleave_frame(g_unified_analyzer.ring, index, ADC_RING_MASK);
+    } else {
+        uint32_t first = ADC_RING_SIZE - index;
+        if (first > fft_size) first = fft_size;
+        memcpy(g_unified_analyzer.frame_buffer, &g_unified_analyzer.ring[index], 
+               first * sizeof(adc_sample_t));
+        memcpy(&g_unified_analyzer.frame_buffer[first], g_unified_analyzer.ring, 
+               (fft_size - first) * sizeof(adc_sample_t));
+    }
+    
+    // DMA may have advanced during the copy; drop the frame if it was overwritten
+    if (g_unified_analyzer.ring_write_count - start > safe_span) {
+        g_unified_analyzer.ring_read_start = start + hop_size;
+        g_unified_analyzer.buffer_overruns++;
+        g_unified_analyzer.frame_sequence++;
+        g_unified_analyzer.frame_dropped++;
+        return false;
+    }
+    
+    // Sequence counts cut frames; skipped hops since the last frame are
+    // reported on this one like frames dropped from the DMA queue
+    uint32_t dropped = g_unified_analyzer.frame_dropped;
+    uint32_t flags = atomic_exchange_explicit(&g_unified_analyzer.ring_flags, 0, memory_order_relaxed);
+    g_unified_analyzer.ready_frame = (adc_frame_info_t){
+        .slot = -1,
+        .sequence = g_unified_analyzer.frame_sequence++,
+        .timestamp_us = g_unified_analyzer.ring_timestamp_us,
+        .flags = flags | (dropped > 0 ? ADC_FRAME_FLAG_DROPPED : 0),
+        .dropped = dropped,
+    };
+    g_unified_analyzer.frame_dropped = 0;
+    
+    g_unified_analyzer.ring_read_start = start + hop_size;
+    g_unified_analyzer.ready_buffer = g_unified_analyzer.frame_buffer;
     g_unified_analyzer.data_ready = true;
-    g_unified_analyzer.last_buffer_completion = get_absolute_time();
+    return true;
+}
+
+// ========================================
+// 🔧 Two-Channel Implementation
+// ========================================
+
+/**
+ * Split one interleaved A/B frame into frame_buffer (A in [0, N), B in [N, 2N))
+ * @param source Interleaved conversions, A first
+ * @param start Index of the first conversion in source
+ * @param mask Index wrap mask (ADC_RING_MASK for the ring, UINT32_MAX for a linear buffer)
+ */
+void _adc_deinterleave_frame(const adc_sample_t* source, uint32_t start, uint32_t mask) {
+    const int fft_size = g_unified_analyzer.fft_size;
+    adc_sample_t* channel_a = g_unified_analyzer.frame_buffer;
+    adc_sample_t* channel_b = channel_a + fft_size;
+    
+    for (int i = 0; i < fft_size; i++) {
+        channel_a[i] = source[start & mask];
+        channel_b[i] = source[(start + 1) & mask];
+        start += 2;
+    }
+}
+
+/**
+ * Transform both channels of a two-channel frame (the caller adds it to the
+ * cross spectrum once the frame is known to be intact)
+ * Complex builds pack the channels into one FFT (z = a + j b) and separate
+ * the spectra with fft_cross_split(). kiss_fftr already is that packing (an
+ * N/2 complex FFT plus a split), so real-input builds run the cached real
+ * plan twice at the same cost instead of allocating a complex plan; channel
+ * B goes first and is parked in the upper half of the work buffer
+ */
+static void _adc_process_dual_fft(adc_sample_t* channel_a) {
+    const int fft_size = g_unified_analyzer.fft_size;
+    adc_sample_t* channel_b = channel_a + fft_size;
+    kiss_fft_cpx* bins = g_unified_analyzer.fft_output;
+    
+#if FFT_REAL_INPUT_ENABLED
+    _adc_apply_window_function(channel_b, g_unified_analyzer.fft_input);
+    fft_plan_forward(g_unified_analyzer.fft_plan, g_unified_analyzer.fft_input, bins);
+    
+    // B[k] -> bins[N - k]: targets lie above N/2, the sources below it
+    for (int k = 1; k < fft_size / 2; k++) {
+        bins[fft_size - k] = bins[k];
+    }
+    
+    // A in place over bins[0..N/2]; its input spans only the lower half
+    _adc_apply_window_function(channel_a, g_unified_analyzer.fft_input);
+    fft_plan_forward(g_unified_analyzer.fft_plan, g_unified_analyzer.fft_input, bins);
+#else
+    kiss_fft_scalar* packed = &g_unified_analyzer.fft_input[0].r;
+    _adc_window_samples(channel_a, packed, 2);
+    _adc_window_samples(channel_b, packed + 1, 2);
+    fft_plan_forward(g_unified_analyzer.fft_plan, g_unified_analyzer.fft_input, bins);
+    fft_cross_split(bins, fft_size);
+#endif
 }
 
 // ========================================
@@ -500,66 +1233,100 @@ void _adc_swap_buffers(void) {
 }
 
 /**
- * Apply window function and convert ADC data to complex FFT input
+ * Remove DC and apply the active window to one channel
+ * Uses the precomputed coefficient table of the active window, so DC removal
+ * and windowing are a single multiply pass per sample (adc_convert.c)
+ * @param adc_buffer Raw samples (fft_size)
+ * @param out First output scalar
+ * @param stride Scalars between outputs (1 = real input, 2 = real or imaginary parts)
+ */
+static void _adc_window_samples(const adc_sample_t* adc_buffer, kiss_fft_scalar* out, int stride) {
+#ifdef FIXED_POINT
+    const int16_t* window = fft_window_get_coefficients_q15();
+#else
+    const float* window = fft_window_get_coefficients();
+#endif
+    adc_convert_window(adc_buffer, g_unified_analyzer.fft_size, window, out, stride);
+}
+
+/**
+ * Apply window function and convert ADC data to FFT input
+ * (real samples for kiss_fftr, or complex samples with zero imaginary part)
+ */
+void _adc_apply_window_function(adc_sample_t* adc_buffer, adc_fft_input_t* fft_input) {
+#if FFT_REAL_INPUT_ENABLED
+    _adc_window_samples(adc_buffer, fft_input, 1);
+#else
+    _adc_window_samples(adc_buffer, &fft_input[0].r, 2);
+    for (int i = 0; i < g_unified_analyzer.fft_size; i++) {
+        fft_input[i].i = 0;
+    }
+#endif
+}
+
+/**
+ * Recompute the dB stage offset for the current configuration
+ * dBm = 10*log10(|X|^2) + offset, where the offset folds FFT normalization,
+ * volts per LSB, the 0dBm reference and the window amplitude correction
  */
-void _adc_apply_window_function(uint16_t* adc_buffer, kiss_fft_cpx* fft_input) {
-    // Calculate DC offset for removal
-    float dc_offset = 0.0f;
-    for (int i = 0; i < ADC_SAMPLING_FFT_SIZE; i++) {
-        dc_offset += (float)adc_buffer[i];
+static void _adc_update_db_offset(void) {
+#ifdef FIXED_POINT
+    // kiss_fft fixed-point output is already scaled by 1/N; undo the input
+    // shift and the Q15 window peak normalization instead
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT * fft_window_get_q15_scale() /
+                            ((float)(1 << ADC_FIXED_INPUT_SHIFT) * DB_REFERENCE_VOLTAGE_0DBM);
+#else
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT / 
+                            ((float)g_unified_analyzer.fft_size * DB_REFERENCE_VOLTAGE_0DBM);
+#endif
+    amplitude_scale *= fft_window_get_amplitude_correction();
+    
+    fft_db_configure(20.0f * log10f(amplitude_scale));
+}
+
+/**
+ * Program the ADC divider for a rate per channel and record the nominal
+ * rate it really gives (the divider has 1/256 steps)
+ */
+static void _adc_apply_sample_rate(float rate_hz) {
+    float clkdiv = ADC_CLOCK_HZ / (rate_hz * ADC_SAMPLING_CHANNELS) - 1.0f;
+    clkdiv = roundf(clkdiv * 256.0f) / 256.0f;
+    if (clkdiv < ADC_CONVERSION_CYCLES - 1) clkdiv = ADC_CONVERSION_CYCLES - 1;
+    if (clkdiv > ADC_CLKDIV_MAX) clkdiv = ADC_CLKDIV_MAX;
+    
+    adc_set_clkdiv(clkdiv);
+    g_unified_analyzer.adc_clkdiv = clkdiv;
+    g_unified_analyzer.sample_rate = ADC_CLOCK_HZ / ((1.0f + clkdiv) * ADC_SAMPLING_CHANNELS);
+}
+
+/**
+ * Update the measured rate from a DMA completion
+ * Counters are absolute and wrap, so only unsigned differences are used;
+ * each full window yields one rate, averaged into the measurement
+ * @param timestamp_us Completion time (time_us_32())
+ * @param conversions Conversions completed at that time (all channels)
+ */
+static void _adc_measure_rate(uint32_t timestamp_us, uint32_t conversions) {
+    if (!g_unified_analyzer.rate_anchored) {
+        g_unified_analyzer.rate_anchor_us = timestamp_us;
+        g_unified_analyzer.rate_anchor_count = conversions;
+        g_unified_analyzer.rate_anchored = true;
+        return;
     }
-    dc_offset /= ADC_SAMPLING_FFT_SIZE;
     
-    // Apply window function based on config_settings.h configuration
-    for (int i = 0; i < ADC_SAMPLING_FFT_SIZE; i++) {
-        // Remove DC offset and convert to float
-        float sample = (float)adc_buffer[i] - dc_offset;
-        
-        // Apply selected window function
-        float window = 1.0f;  // Default: Rectangle window
-        
-        switch (FFT_WINDOW_TYPE) {
-            case 0:  // Rectangle
-                window = 1.0f;
-                break;
-            case 1:  // Hamming
-                window = 0.54f - 0.46f * cosf(2.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1));
-                break;
-            case 2:  // Hann
-                window = 0.5f * (1.0f - cosf(2.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1)));
-                break;
-            case 3:  // Blackman
-                window = 0.42f - 0.5f * cosf(2.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1)) + 
-                         0.08f * cosf(4.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1));
-                break;
-            case 4:  // Blackman-Harris
-                window = 0.35875f - 0.48829f * cosf(2.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1)) + 
-                         0.14128f * cosf(4.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1)) - 
-                         0.01168f * cosf(6.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1));
-                break;
-            case 5:  // Kaiser-Bessel (beta = 8.5)
-                {
-                    float alpha = (ADC_SAMPLING_FFT_SIZE - 1) / 2.0f;
-                    float x = (i - alpha) / alpha;
-                    float arg = KAISER_BESSEL_BETA * sqrtf(1.0f - x * x);
-                    // Simplified Kaiser window approximation
-                    window = (arg < 50.0f) ? expf(arg - KAISER_BESSEL_BETA) : 0.0f;
-                }
-                break;
-            case 6:  // Flat-Top
-                window = 1.0f - 1.93f * cosf(2.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1)) + 
-                         1.29f * cosf(4.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1)) - 
-                         0.388f * cosf(6.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1)) + 
-                         0.032f * cosf(8.0f * M_PI * i / (ADC_SAMPLING_FFT_SIZE - 1));
-                break;
-            default:
-                window = 1.0f;  // Default to rectangle
-                break;
-        }
-        
-        // Apply window and store in FFT input buffer
-        sample *= window;
-        fft_input[i].r = sample;
-        fft_input[i].i = 0.0f;
+    uint32_t elapsed_us = timestamp_us - g_unified_analyzer.rate_anchor_us;
+    if (elapsed_us < ADC_RATE_MEASURE_WINDOW_US) {
+        return;
+    }
+    uint32_t counted = conversions - g_unified_analyzer.rate_anchor_count;
+    float window_rate = (float)counted * 1000000.0f / ((float)elapsed_us * ADC_SAMPLING_CHANNELS);
+    
+    if (g_unified_analyzer.actual_sample_rate == 0.0f) {
+        g_unified_analyzer.actual_sample_rate = window_rate;
+    } else {
+        g_unified_analyzer.actual_sample_rate += 
+            ADC_RATE_MEASURE_WEIGHT * (window_rate - g_unified_analyzer.actual_sample_rate);
     }
+    g_unified_analyzer.rate_anchor_us = timestamp_us;
+    g_unified_analyzer.rate_anchor_count = conversions;
 }
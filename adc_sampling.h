@@ -5,7 +5,12 @@
 * | Info        :   
 *   - Abstraction layer for ADC sampling methods
 *   - Support for both manual polling and DMA-based sampling
-*   - Double buffering for continuous real-time processing
+*   - Multi-slot buffering for continuous real-time processing (gapless: a
+*     control DMA channel re-arms the capture channel, the IRQ only
+*     pushes completed frames into the SPSC queue of adc_frame_queue.c)
+*   - Ring acquisition with overlapped frames at a configurable hop
+*   - Optional two-channel capture (ADC0/ADC1 round robin) for the cross
+*     spectrum of fft_cross.c
 *   - Configurable via config_settings.h
 *----------------
 ******************************************************************************/
@@ -20,18 +25,75 @@
 #include "hardware/dma.h"
 #include "hardware/irq.h"
 #include "kiss_fft.h"
+#include "kiss_fftr.h"
 #include "config_settings.h"
+#include "fft_window.h"
+#include "fft_db.h"
+#include "fft_plan.h"
+#include "fft_cross.h"
+#include "adc_frame_queue.h"
+#include "adc_convert.h"
 #include "lib/fft/fft_analyzer.h"
 
 // ADC sampling configuration from config_settings.h
-#define ADC_SAMPLING_FFT_SIZE 1024          // Must match FFT processing size
-#define ADC_SAMPLING_RATE SAMPLING_RATE_HZ  // 128kHz from config_settings.h
+#define ADC_SAMPLING_MAX_FFT_SIZE FFT_PLAN_MAX_SIZE      // Buffer capacity (largest cached plan)
+#define ADC_SAMPLING_DEFAULT_FFT_SIZE FFT_DEFAULT_SIZE   // Startup FFT size
+#define ADC_SAMPLING_RATE SAMPLING_RATE_HZ  // Startup rate, 128kHz from config_settings.h
 #define ADC_SAMPLING_CHANNEL 0              // GP26 = ADC0
 
+// Two-channel capture (DUAL_CHANNEL_ENABLED): the ADC alternates between
+// channel A (ADC0) and channel B (ADC1) at twice the rate, so each channel
+// keeps ADC_SAMPLING_RATE. Frames hold 2 x fft_size interleaved samples
+#define ADC_SAMPLING_CHANNELS (DUAL_CHANNEL_ENABLED ? 2 : 1)
+#define ADC_SAMPLING_CHANNEL_B 1            // GP27 = ADC1
+#define ADC_ROUND_ROBIN_MASK (DUAL_CHANNEL_ENABLED ? ((1u << ADC_SAMPLING_CHANNEL) | (1u << ADC_SAMPLING_CHANNEL_B)) : 0)
+#define ADC_CONVERSION_CYCLES 96            // ADC clock cycles per conversion (48MHz -> 2us)
+
+// Runtime sample rate (adc_sampling_set_sample_rate()): one conversion every
+// (1 + clkdiv) ADC clocks, clkdiv with 8 fractional bits and a 16-bit integer
+// part. Both channels share the conversions in two-channel mode
+#define ADC_CLOCK_HZ 48000000.0f            // ADC clock (USB PLL)
+#define ADC_CLKDIV_MAX (65535.0f + 255.0f / 256.0f)
+#define ADC_SAMPLE_RATE_MAX_HZ (ADC_CLOCK_HZ / ADC_CONVERSION_CYCLES / ADC_SAMPLING_CHANNELS)
+#define ADC_SAMPLE_RATE_MIN_HZ (ADC_CLOCK_HZ / (1.0f + ADC_CLKDIV_MAX) / ADC_SAMPLING_CHANNELS)
+
+// Rate measurement: conversions counted between DMA completion timestamps
+// over windows of this length, averaged across windows (ADC clock error)
+#define ADC_RATE_MEASURE_WINDOW_US 500000   // Measurement window (0.5s)
+#define ADC_RATE_MEASURE_WEIGHT 0.25f       // Weight of a new window in the average
+
+// Ring acquisition (ADC_MODE_DMA_RING): DMA writes continuously into a
+// power-of-two sample ring that shares storage with the ping/pong buffers.
+// 8-bit capture keeps the 16KB and holds twice the samples
+#define ADC_RING_SIZE ((ADC_CAPTURE_8BIT ? 4 : 2) * ADC_SAMPLING_MAX_FFT_SIZE) // Samples (8192, 8-bit: 16384)
+#define ADC_RING_BYTES (ADC_RING_SIZE * (int)sizeof(adc_sample_t))           // Bytes, also DMA ring alignment (16KB)
+#define ADC_RING_SIZE_BITS 14                             // log2(ADC_RING_BYTES) for DMA address wrap
+#define ADC_RING_MASK (ADC_RING_SIZE - 1)
+// Only ring mode needs the storage aligned to its size (up to 16KB of
+// padding); the frame queue slots of ping/pong mode need word alignment
+#define ADC_CAPTURE_ALIGNMENT (ADC_DMA_RING_BUFFER_MODE ? ADC_RING_BYTES : 4)
+#define ADC_RING_DMA_BLOCK 128                            // Samples per DMA interrupt (1ms @ 128kHz)
+
+// Frame queue capture (ADC_MODE_DMA): the ring storage is split into
+// slots of one frame; the capture channel chains to a control channel that
+// writes the next slot address from a table into the capture channel's
+// WRITE_ADDR_TRIG alias (power of two: the table is read through a DMA read
+// ring). Large frames get fewer slots (two at the largest FFT size)
+#define ADC_CAPTURE_SLOTS FRAME_QUEUE_SLOTS
+#define ADC_CAPTURE_TABLE_BYTES (ADC_FRAME_QUEUE_MAX_SLOTS * 4)  // Table alignment (covers every slot count)
+
+// FFT input sample type (selected by FFT_REAL_INPUT_ENABLED)
+#if FFT_REAL_INPUT_ENABLED
+typedef kiss_fft_scalar adc_fft_input_t;    // Real samples for kiss_fftr
+#else
+typedef kiss_fft_cpx adc_fft_input_t;       // Complex samples (imag = 0) for kiss_fft
+#endif
+
 // ADC sampling modes
 typedef enum {
     ADC_MODE_MANUAL = 0,    // Manual polling with sleep_us() timing
-    ADC_MODE_DMA = 1        // DMA-based automatic sampling
+    ADC_MODE_DMA = 1,       // DMA-based automatic sampling (ping/pong buffers)
+    ADC_MODE_DMA_RING = 2   // DMA into a sample ring, overlapped frames at a hop
 } adc_sampling_mode_t;
 
 // ADC sampling status
@@ -44,15 +106,25 @@ typedef enum {
 
 // Unified ADC sampling data structure
 typedef struct {
+    // Buffer management (manual double buffering, the frame queue slots in
+    // DMA mode, or the DMA ring in ring mode).
+    // First member, so the ring alignment adds no padding inside the struct
+    union {
+        struct {
+            adc_sample_t buffer_ping[ADC_SAMPLING_MAX_FFT_SIZE]; // Buffer A
+            adc_sample_t buffer_pong[ADC_SAMPLING_MAX_FFT_SIZE]; // Buffer B
+        };
+        adc_sample_t ring[ADC_RING_SIZE];                 // Sample ring (ring mode), frame slots (DMA mode)
+    } __attribute__((aligned(ADC_CAPTURE_ALIGNMENT)));
+    
     // Current configuration
     adc_sampling_mode_t mode;
     adc_sampling_status_t status;
     
-    // Buffer management (double buffering)
-    uint16_t buffer_ping[ADC_SAMPLING_FFT_SIZE];  // Buffer A
-    uint16_t buffer_pong[ADC_SAMPLING_FFT_SIZE];  // Buffer B
-    uint16_t* current_buffer;                     // Currently filling buffer
-    uint16_t* ready_buffer;                       // Buffer ready for processing
+    int fft_size;                                 // Active FFT size (samples per buffer)
+    
+    adc_sample_t* current_buffer;                 // Currently filling buffer
+    adc_sample_t* ready_buffer;                   // Buffer ready for processing
     volatile bool buffer_selector;                // 0=ping active, 1=pong active
     
     // Sampling control
@@ -61,26 +133,71 @@ typedef struct {
     volatile uint32_t sample_count;               // Total samples collected
     volatile uint32_t buffer_overruns;            // Buffer overrun counter
     
-    // DMA specific (only used in DMA mode)
-    int dma_channel;                              // Claimed DMA channel
+    // Ring specific (only used in ring mode)
+    adc_sample_t frame_buffer[ADC_SAMPLING_MAX_FFT_SIZE]; // Linear copy of the current frame
+                                                      // (two-channel: A in [0, N), B in [N, 2N), every mode)
+    volatile uint32_t ring_write_count;           // Absolute samples written by DMA (wraps at 2^32)
+    uint32_t ring_read_start;                     // Absolute index of the next frame start
+    int hop_divisor;                              // Frame hop = fft_size / hop_divisor
+    int hop_size;                                 // Samples between frame starts (per channel)
+    
+    // DMA specific (only used in DMA modes)
+    int dma_channel;                              // Claimed capture DMA channel
+    int dma_control_channel;                      // Re-arms the capture channel (chained)
     dma_channel_config dma_config;                // DMA configuration
     volatile bool dma_error;                      // DMA error flag
+    adc_frame_queue_t capture;                    // Frames pushed by the IRQ (DMA mode)
+    int capture_slots;                            // Frame slots in the DMA cycle
+    volatile uint32_t ring_timestamp_us;          // Completion time of the last ring block
+    atomic_uint_least32_t ring_flags;             // ADC_FRAME_FLAG_* since the last ring frame
     
     // Manual sampling specific (only used in manual mode)
     absolute_time_t last_sample_time;             // Last sample timestamp
     uint32_t manual_sample_index;                 // Current sample index
     
-    // FFT integration
-    kiss_fft_cpx fft_input[ADC_SAMPLING_FFT_SIZE];   // FFT input buffer
-    kiss_fft_cpx fft_output[ADC_SAMPLING_FFT_SIZE];  // FFT output buffer
-    kiss_fft_cfg fft_cfg;                            // kiss_fft configuration
-    float magnitude[ADC_SAMPLING_FFT_SIZE/2];        // Magnitude spectrum
+    // FFT integration: one in-place work buffer per frame. The window pass
+    // fills fft_input, the transform overwrites it with fft_output and the
+    // dB reduction writes magnitude[k] over bins it has already read.
+    // Two-channel frames keep channel A's bins at fft_output[k] and park
+    // channel B's at fft_output[fft_size - k] (fft_cross_split() layout)
+#if FFT_REAL_INPUT_ENABLED
+    union {
+        adc_fft_input_t fft_input[ADC_SAMPLING_MAX_FFT_SIZE];       // Windowed real samples
+        kiss_fft_cpx fft_output[ADC_SAMPLING_MAX_FFT_SIZE/2 + 1];   // Real FFT output (DC..Nyquist)
+        float magnitude[ADC_SAMPLING_MAX_FFT_SIZE/2];               // dBm, window-corrected
+    };
+#else
+    // Complex kiss_fft copies through a stack buffer when run in place, so
+    // only the output and the dB reduction share memory here
+    adc_fft_input_t fft_input[ADC_SAMPLING_MAX_FFT_SIZE];           // FFT input buffer
+    union {
+        kiss_fft_cpx fft_output[ADC_SAMPLING_MAX_FFT_SIZE];         // FFT output buffer
+        float magnitude[ADC_SAMPLING_MAX_FFT_SIZE/2];               // dBm, window-corrected
+    };
+#endif
+    const fft_plan_t* fft_plan;                      // Active cached plan (fft_plan.c)
     bool fft_ready;                                  // FFT results available
+    bool magnitude_ready;                            // Bins reduced to dBm (fft_output consumed)
+    bool frame_torn;                                 // Ready frame overwritten before its last read
+    uint32_t torn_frames;                            // Frames dropped as torn
+    
+    // Multirate: decimated baseband spectrum from the same stream (fft_baseband.c)
+    bool baseband_enabled;                           // Baseband stage runs next to the wideband FFT
+    bool baseband_fed;                               // New samples of the ready frame already decimated
     
     // Performance monitoring
     absolute_time_t sampling_start_time;          // Sampling start timestamp
-    absolute_time_t last_buffer_completion;       // Last buffer completion time
-    float actual_sample_rate;                     // Measured sampling rate
+    adc_frame_info_t ready_frame;                 // Sequence, capture time (time_us_32()) and flags of the ready buffer
+    uint32_t frame_sequence;                      // Frames cut or sampled so far (ring and manual modes)
+    uint32_t frame_dropped;                       // Ring frames skipped since the last frame cut
+    float actual_sample_rate;                     // Measured sampling rate (0 until the first window)
+    
+    // Sample rate control
+    float sample_rate;                            // Nominal rate per channel (from the ADC divider)
+    float adc_clkdiv;                             // Divider programmed into the ADC
+    bool rate_anchored;                           // Measurement window started
+    uint32_t rate_anchor_us;                      // Completion time at the window start
+    uint32_t rate_anchor_count;                   // Conversions completed at the window start
     
 } unified_fft_analyzer_t;
 
@@ -93,7 +210,7 @@ extern unified_fft_analyzer_t g_unified_analyzer;
 
 /**
  * Initialize ADC sampling system
- * @param mode ADC_MODE_MANUAL or ADC_MODE_DMA
+ * @param mode ADC_MODE_MANUAL, ADC_MODE_DMA or ADC_MODE_DMA_RING
  * @return true if successful, false on error
  */
 bool adc_sampling_init(adc_sampling_mode_t mode);
@@ -112,6 +229,8 @@ bool adc_sampling_stop(void);
 
 /**
  * Check if new ADC data is ready for processing
+ * With the baseband stage enabled the new samples are decimated here; a frame
+ * torn meanwhile resets the stage and comes back with adc_sampling_is_frame_torn()
  * @return true if data ready, false otherwise
  */
 bool adc_sampling_is_ready(void);
@@ -120,13 +239,16 @@ bool adc_sampling_is_ready(void);
  * Get pointer to buffer with ready ADC data
  * @return Pointer to ready buffer, NULL if no data ready
  */
-uint16_t* adc_sampling_get_buffer(void);
+adc_sample_t* adc_sampling_get_buffer(void);
 
 /**
  * Signal that processing of current buffer is complete
  * This allows the system to prepare the next buffer
+ * @return true if the frame stayed intact while in use, false if it was
+ *         dropped as torn (DMA mode) or DMA reached its slot after the
+ *         last read (both counted as overruns)
  */
-void adc_sampling_complete_processing(void);
+bool adc_sampling_complete_processing(void);
 
 /**
  * Get current sampling status
@@ -140,22 +262,123 @@ adc_sampling_status_t adc_sampling_get_status(void);
  */
 adc_sampling_mode_t adc_sampling_get_mode(void);
 
+/**
+ * Get sampling mode name as string
+ * @param mode ADC sampling mode
+ * @return String name of mode
+ */
+const char* adc_sampling_get_mode_name(adc_sampling_mode_t mode);
+
+/**
+ * Set the frame hop of ring mode (overlapped STFT)
+ * @param hop_divisor Hop = fft_size / hop_divisor (1=none, 2=50%, 4=75%, 8=87.5% overlap)
+ * @return true if successful, false on invalid divisor
+ */
+bool adc_sampling_set_hop_divisor(int hop_divisor);
+
+/**
+ * Get the frame hop in samples
+ * @return Samples between frame starts (fft_size outside ring mode)
+ */
+int adc_sampling_get_hop_size(void);
+
+/**
+ * Get the capture time of the ready buffer
+ * @return Completion time of its last sample in us (time_us_32() clock)
+ */
+uint32_t adc_sampling_get_ready_timestamp(void);
+
+/**
+ * Get the queue information of the ready buffer
+ * DMA mode reports the frame queue descriptor; ring mode counts cut frames
+ * (skipped hops set ADC_FRAME_FLAG_DROPPED) and manual mode sampled frames
+ * @param frame Output: sequence, capture time, flags and frames dropped before it
+ * @return true if data is ready
+ */
+bool adc_sampling_get_frame_info(adc_frame_info_t* frame);
+
+/**
+ * Get the depth and backlog of the DMA frame queue
+ * @param backlog Output: completed frames not taken yet, or NULL
+ * @return Frame slots in the DMA cycle, 0 outside DMA mode
+ */
+int adc_sampling_get_queue_slots(uint32_t* backlog);
+
+/**
+ * Get the number of captured channels
+ * @return ADC_SAMPLING_CHANNELS
+ */
+int adc_sampling_get_channel_count(void);
+
+/**
+ * Get one channel of the ready frame (fft_size samples)
+ * Two-channel frames are deinterleaved once when they become ready
+ * @param channel 0 = A (ADC0, also adc_sampling_get_buffer()), 1 = B (ADC1)
+ * @return Pointer to the channel samples, NULL if no data ready or no such channel
+ */
+const adc_sample_t* adc_sampling_get_channel_buffer(int channel);
+
+/**
+ * Get the delay of channel B behind channel A
+ * Free-running round robin converts B half a sample period after A; manual
+ * mode reads B right after A (one conversion time)
+ * @return Delay in samples (0 with one channel)
+ */
+float adc_sampling_get_channel_skew(void);
+
+/**
+ * Get the samples of the ready buffer that no earlier frame contained
+ * Stream consumers (zoom FFT, narrowband detectors) see every sample once
+ * even when ring mode overlaps frames
+ * @param count Output: number of new samples (hop size, or fft_size outside ring mode)
+ * @return Pointer to the new samples, NULL if no data ready
+ */
+const adc_sample_t* adc_sampling_get_new_samples(int* count);
+
 // ========================================
 // 🔧 Performance Monitoring API
 // ========================================
 
 /**
  * Get actual measured sampling rate
- * @return Sampling rate in Hz
+ * DMA modes count conversions between DMA completion timestamps, manual mode
+ * times each buffer
+ * @return Sampling rate in Hz, 0 until the first measurement
  */
 float adc_sampling_get_actual_rate(void);
 
 /**
  * Get buffer overrun count
- * @return Number of buffer overruns since start
+ * @return Frames lost since start (DMA mode: dropped by consumer lag plus
+ *         overwritten while in use; ring mode: skipped hops)
  */
 uint32_t adc_sampling_get_overrun_count(void);
 
+/**
+ * Get the number of frames dropped as torn
+ * DMA mode only: frames whose slot DMA reached again before a stage's last
+ * read of it finished (adc_sampling_check_frame()); no average, detector,
+ * stream stage or measurement publishes them
+ * @return Torn frames since start (also part of the overrun count)
+ */
+uint32_t adc_sampling_get_torn_count(void);
+
+/**
+ * Check whether the ready frame was dropped as torn
+ * @return true if adc_sampling_check_frame() (or adc_sampling_process_fft())
+ *         failed because DMA overwrote the frame
+ */
+bool adc_sampling_is_frame_torn(void);
+
+/**
+ * Check the ready frame after a stage read the capture slot for the last time
+ * Stream stages call this once they have consumed adc_sampling_get_new_samples();
+ * a frame DMA reached meanwhile is marked torn and counted once, and the
+ * caller resets whatever state the frame fed
+ * @return true if the frame is intact, false if torn or no data ready
+ */
+bool adc_sampling_check_frame(void);
+
 /**
  * Get total sample count
  * @return Total samples collected since start
@@ -173,7 +396,13 @@ void adc_sampling_reset_counters(void);
 
 /**
  * Process current ADC buffer through FFT with windowing
- * @return true if FFT completed successfully, false on error
+ * Two-channel frames transform both channels (one packed complex FFT, or two
+ * real FFTs in real-input builds) and add them to the cross spectrum; the
+ * magnitude and Welch paths see channel A. In DMA mode the frame is
+ * checked after the window pass (its last read of the capture slot): a torn
+ * frame is dropped there, before the FFT and the cross spectrum
+ * @return true if FFT completed successfully, false on error or a torn frame
+ *         (adc_sampling_is_frame_torn())
  */
 bool adc_sampling_process_fft(void);
 
@@ -185,17 +414,115 @@ bool adc_sampling_is_fft_ready(void);
 
 /**
  * Get FFT magnitude spectrum
- * @return Pointer to magnitude array (FFT_SIZE/2 elements)
+ * The first call per frame reduces the bins to dBm in place, after which
+ * adc_sampling_get_fft_output() returns NULL for that frame
+ * @return Pointer to magnitude array in dBm, window-corrected (fft_size/2 elements)
  */
 float* adc_sampling_get_magnitude_spectrum(void);
 
 /**
- * Convert FFT bin to frequency in Hz
- * @param bin FFT bin index (0 to FFT_SIZE/2-1)
+ * Get raw FFT output of the last processed frame
+ * @return Pointer to complex bins (fft_size/2 + 1 elements), NULL if no results
+ *         or the frame was already reduced to dBm
+ */
+const kiss_fft_cpx* adc_sampling_get_fft_output(void);
+
+/**
+ * Convert FFT bin to frequency in Hz (at adc_sampling_get_sample_rate())
+ * @param bin FFT bin index (0 to fft_size/2-1)
  * @return Frequency in Hz
  */
 float adc_sampling_bin_to_frequency(int bin);
 
+/**
+ * Change the sample rate at runtime (ADC clock divider)
+ * The divider is rounded to its 1/256 steps; sampling is restarted if active
+ * and the rate measurement starts over
+ * @param rate_hz Rate per channel (ADC_SAMPLE_RATE_MIN_HZ to ADC_SAMPLE_RATE_MAX_HZ)
+ * @return true if set, false if out of range
+ */
+bool adc_sampling_set_sample_rate(float rate_hz);
+
+/**
+ * Get the calibrated sample rate for frequency mapping
+ * @return Measured rate once available, the nominal divider rate before
+ */
+float adc_sampling_get_sample_rate(void);
+
+/**
+ * Get the nominal sample rate of the programmed divider
+ * Stages with precomputed coefficients (zoom, Goertzel, octave) use this one
+ * @return Rate per channel in Hz
+ */
+float adc_sampling_get_nominal_rate(void);
+
+/**
+ * Enable the decimated baseband spectrum (0 to fs/16 with FFT_BASEBAND_DECIMATION
+ * times finer bins). The new samples of every acquired frame are decimated once
+ * when it becomes ready, in every analysis mode
+ * @param enabled true to run the baseband stage
+ */
+void adc_sampling_set_baseband_enabled(bool enabled);
+
+/**
+ * Check whether the baseband stage runs
+ * @return true if enabled
+ */
+bool adc_sampling_is_baseband_enabled(void);
+
+/**
+ * Get the baseband magnitude spectrum (counterpart of adc_sampling_get_magnitude_spectrum())
+ * @return Pointer to adc_sampling_get_baseband_bins() values in dBm, NULL if
+ *         disabled or no baseband FFT has completed yet
+ */
+const float* adc_sampling_get_baseband_spectrum(void);
+
+/**
+ * Get the number of baseband bins
+ * @return FFT_BASEBAND_BINS
+ */
+int adc_sampling_get_baseband_bins(void);
+
+/**
+ * Convert a baseband bin to frequency in Hz
+ * @param bin Baseband bin index (0 to adc_sampling_get_baseband_bins()-1)
+ * @return Frequency in Hz
+ */
+float adc_sampling_baseband_bin_to_frequency(int bin);
+
+/**
+ * Switch the active window function
+ * Also updates the dB stage offset for the new window's amplitude correction.
+ * Rebuilds the window tables in place: call between frames on the core that
+ * processes them (fft_realtime_unified_set_window() does)
+ * @param type Window type
+ * @return true if switched, false if type is invalid
+ */
+bool adc_sampling_set_window(fft_window_type_t type);
+
+/**
+ * Switch the FFT size using a cached plan (no allocation)
+ * Sampling is restarted if active, so the next buffer has the new length
+ * @param size FFT size (one of FFT_PLAN_SIZE_LIST, up to FFT_CROSS_MAX_SIZE
+ *        with two channels)
+ * @return true if switched, false if size is not registered
+ */
+bool adc_sampling_set_fft_size(int size);
+
+/**
+ * Get the active FFT size
+ * @return FFT size in samples
+ */
+int adc_sampling_get_fft_size(void);
+
+/**
+ * Time the forward FFT of every cached size on the analyzer's buffers
+ * and print the throughput table (fft_plan_benchmark())
+ * @param frames Transforms per size
+ * @return true if run, false while sampling is active
+ */
+bool adc_sampling_benchmark_fft(int frames);
+
 // ========================================
 // 🔧 Internal Functions (Implementation Use Only)
 // ========================================
@@ -205,13 +532,20 @@ bool _adc_dma_init(void);
 void _adc_dma_start(void);
 void _adc_dma_stop(void);
 void _adc_dma_interrupt_handler(void);
+bool _adc_dma_acquire_buffer(void);
 
 // Manual mode internal functions
 bool _adc_manual_init(void);
 void _adc_manual_sample_buffer(void);
 
+// Ring mode internal functions
+bool _adc_ring_acquire_frame(void);
+
+// Two-channel internal functions
+void _adc_deinterleave_frame(const adc_sample_t* source, uint32_t start, uint32_t mask);
+
 // Common internal functions
 void _adc_swap_buffers(void);
-void _adc_apply_window_function(uint16_t* adc_buffer, kiss_fft_cpx* fft_input);
+void _adc_apply_window_function(adc_sample_t* adc_buffer, adc_fft_input_t* fft_input);
 
 #endif // __ADC_SAMPLING_H
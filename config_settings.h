@@ -18,6 +18,8 @@
 #define TARGET_FRAME_TIME_US (1000000 / TARGET_FPS) // フレーム時間（マイクロ秒）
 
 // ** ADCサンプリング設定 **
+// ※ 起動時の値。実行中は fft_realtime_unified_set_sample_rate() で変更可能（約730Hz〜500kHz、2チャンネル時は半分）
+// ※ 周波数軸・ビン周波数・RBWはDMA完了時刻から実測したレートを使用（約0.5秒毎に更新）
 #define SAMPLING_RATE_HZ 128000                      // サンプリング周波数（128kHz）
 #define SAMPLING_INTERVAL_US (1000000.0 / SAMPLING_RATE_HZ) // サンプリング間隔（μs）
 
@@ -41,16 +43,32 @@
 #define IMPEDANCE_CORRECTION_FACTOR ((ADC_INPUT_IMPEDANCE + SIGNAL_SOURCE_IMPEDANCE) / ADC_INPUT_IMPEDANCE)
 
 // ** 周波数スケール設定 **
+// 対数スケールでは fft_octave.c のオクターブ分割（定Q）解析で各表示列を求める
+// ハーフバンドFIRで1/2間引きを縦続し、各段の上位1オクターブ（段レートの0.2〜0.4倍）を256点FFTで分解
+// （リニアFFTのビンを対数軸へ写すだけでは低域の列にビンが無く、1kHz付近は1列おきにしか埋まらない）
+// ※ オクターブ解析のバッファ（約7KB）は対数スケール時のみアリーナから確保。スペクトラムモードのみ（Welch/SDFTはビン写像）
 #define USE_LOG_FREQ_SCALE 0                        // 1=対数スケール, 0=リニアスケール
-
-// ** ピークホールド設定 **
-#define PEAK_HOLD_DURATION_MS 1                     // ピークホールド時間（ミリ秒）
+#define LOG_FREQ_OCTAVE_STAGES 6                    // オクターブ段数（2〜10、最下段の下端 0.2×fs/2^(段数-1) ≦ FREQUENCY_RANGE_MIN）
+#define LOG_FREQ_BENCHMARK_ENABLED 0                // 1=起動時にビン写像とオクターブ解析の処理時間を比較表示
+
+// ** トレース処理設定（平均化・ホールド） **
+// 表示スペクトラムとホールド線は fft_trace.c で線形電力領域で処理し、表示は完成したトレースを描画するだけ
+// （dB値の平均はノイズフロアを最大2.5dB低く偏らせるため使わない）
+// モード: 0=クリア/ライト, 1=RMS平均（Nフレーム毎にリスタート）, 2=指数平均（重み1/N）,
+//         3=最大ホールド, 4=最小ホールド, 5=減衰付きホールド（保持時間後に減衰）
+#define TRACE_COUNT 2                               // トレース数（0=スペクトラム, 1=ホールド線）
+#define TRACE_SPECTRUM_MODE 2                       // スペクトラムのトレースモード（Welchモードでは常にクリア/ライト）
+#define TRACE_HOLD_MODE 5                           // ホールド線のトレースモード
+#define TRACE_AVERAGE_COUNT 4                       // RMS平均・指数平均のフレーム数N
+#define PEAK_HOLD_DURATION_MS 1                     // 減衰付きホールドの保持時間（ミリ秒、表示フレーム換算で最大255。1フレーム未満は保持なしで即減衰）
+#define TRACE_HOLD_DECAY_DB_PER_SEC 30.0f           // 保持時間経過後の減衰速度（dB/秒）
 
 // ** FFT窓関数設定 **
 // 窓関数タイプ選択: 0=レクタングル, 1=ハミング, 2=ハン, 3=ブラックマン, 4=ブラックマン・ハリス, 5=カイザー・ベッセル, 6=フラットトップ
-#define FFT_WINDOW_TYPE 0                           // 使用する窓関数
+#define FFT_WINDOW_TYPE 0                           // 起動時の窓関数（実行時に fft_realtime_unified_set_window() で切替可能）
 
 // 各窓関数のコヒーレントゲイン補正係数（理論値）
+// ※ 解析時の補正は fft_window.c が窓係数テーブルから実測したゲイン/ENBWを使用（以下は参考値）
 #define WINDOW_COHERENT_GAIN_RECTANGLE 1.0f         // レクタングル窓（矩形窓）
 #define WINDOW_COHERENT_GAIN_HAMMING 0.54f          // ハミング窓
 #define WINDOW_COHERENT_GAIN_HANN 0.5f              // ハン窓（ハニング）
@@ -68,6 +86,75 @@
 #define WINDOW_AMPLITUDE_CORRECTION_KAISER_BESSEL (1.0f / 0.4f)      // 2.5
 #define WINDOW_AMPLITUDE_CORRECTION_FLATTOP (1.0f / 0.2156f)         // ≈4.6385
 
+// ** FFT変換モード設定 **
+// 1=実数入力FFT（kiss_fftr: N/2点複素FFT＋分割処理、演算量・メモリ約半分）, 0=従来の複素FFT（虚部0）
+#define FFT_REAL_INPUT_ENABLED 1
+
+// ** FFTサイズ設定 **
+// 256/512/1024/1280/1600/2048/4096点のプランと窓テーブルを起動時に事前確保（fft_plan.c）
+// 1280点=100Hz/ビン、1600点=80Hz/ビン（128kHz時）: 100Hz刻みの校正トーンがビン中心に乗りスカロップ損失なし（1024点の125Hz刻みでは1.1kHz等がビン間に落ちる）
+// 実行時に fft_realtime_unified_set_fft_size() で切替可能（分解能帯域幅 ⇔ 更新レート）
+#define FFT_DEFAULT_SIZE 1024                       // 起動時のFFTサイズ
+#define FFT_SIZE_BENCHMARK_ENABLED 0                // 1=起動時に全FFTサイズの処理時間（2のべき乗 vs 混合基数）を計測して表示
+
+// ** 解析モード設定 **
+// 0=スペクトラム（dBm、単一ピリオドグラム）, 1=Welch平均PSD（dBm/Hz、線形パワー領域でK区間平均）
+// 2=スライディングDFT（dBm、指定ビン範囲のみ1サンプル毎に更新、窓長=FFTサイズ）
+// 実行時に fft_realtime_unified_set_analysis_mode() で切替可能
+#define FFT_ANALYSIS_MODE 0                         // 起動時の解析モード
+#define WELCH_SEGMENT_COUNT 8                       // Welch平均の区間数K（分散は約1/K）
+#define SDFT_FIRST_BIN 8                            // スライディングDFTの先頭ビン（1024点で1kHz）
+#define SDFT_BIN_COUNT 16                           // スライディングDFTのビン数（最大64、1ビンあたり毎サンプル約8演算）
+#define SDFT_HANN_WINDOW 1                          // 1=ハン窓（周波数領域カーネル）, 0=矩形窓
+
+// ** ズームFFT設定 **
+// NCOミキサ → CIC＋補償FIRで間引き → 1024点複素FFT（中心周波数±スパン/2 を 出力レート/1024 Hz/ビンで解析）
+// 実行時に fft_realtime_unified_set_zoom() で切替可能。結果はステータス出力に表示
+// 間引きはスパンがFIRの平坦域（出力レートの±0.44）に収まる最大値。実際のスパンはそれ以上（既定で±1.76kHz）、外側のビンは下限値
+#define FFT_ZOOM_ENABLED 0                          // 1=ズームFFT有効, 0=無効
+#define FFT_ZOOM_CENTER_HZ 10000.0f                 // 中心周波数（Hz）
+#define FFT_ZOOM_SPAN_HZ 2000.0f                    // スパン（Hz）- 2000で±1kHz、約3.9Hz/ビン
+
+// ** マルチレート（ベースバンド）解析設定 **
+// 同じADCストリームをCIC(4倍)＋補償FIR(2倍)で1/8に間引き、0〜8kHzを1024点で解析（15.6Hz/ビン、広帯域の8倍細かい）
+// 間引きは取得フレーム毎の新規サンプルに対して逐次実行。結果は adc_sampling_get_baseband_spectrum() で取得しステータス出力に表示
+#define FFT_BASEBAND_ENABLED 0                      // 1=ベースバンドスペクトラムを広帯域と並行して計算, 0=無効
+
+// ** Goertzelトーン追跡設定 **
+// FREQ_MARKERS_HZ_ARRAY の各周波数をGoertzel法でサンプル毎に追跡し、ブロック毎にdBmを更新
+// 数トーンならFFTより大幅に軽量（損益分岐は tools/goertzel_bench.c で計測）
+// 実行時に fft_realtime_unified_set_tracker_mode() で切替可能。結果はステータス出力に表示
+#define GOERTZEL_TRACKER_MODE 0                     // 0=無効, 1=FFTと並行, 2=FFTの代わりに実行
+#define GOERTZEL_BLOCK_SIZE 256                     // ブロック長（256/512/1024/2048/4096、256で500回/秒更新）
+
+// ** ピーク検出設定 **
+// スペクトラムモードで表示フレーム毎に閾値以上の極大を1パスで検出し、レベル順の上位N個を保持
+// 3点補間でビン間の周波数を推定し、現在の窓関数のスカロップ損失でレベルを補正（結果はステータス出力に表示）
+// ガウス補間は矩形窓・フラットトップ以外で誤差0.02ビン以下、放物線補間は約0.05ビン
+#define PEAK_LIST_COUNT 8                           // ピークリスト長（1〜16）
+#define PEAK_THRESHOLD_DBM -60.0f                   // 検出閾値（dBm）
+#define PEAK_INTERPOLATION 2                        // 0=ビン中心, 1=放物線補間, 2=ガウス補間（dB上の放物線）
+
+// ** 歪み・ノイズ測定設定 **
+// スペクトラムモードでフレーム毎に THD, THD+N, SNR, SINAD, SFDR, ENOB を計算（adc_sampling_process_fft() のdBm配列を再利用）
+// 基本波・高調波は窓関数毎の漏れ幅（ビン数）で電力を合算、fs/2を超える高調波は折り返し位置で合算
+// SNR 60dB超の測定はブラックマン・ハリス窓またはフラットトップ窓を推奨（矩形窓は漏れが大きく不可）
+// Q15パイプラインはノイズフロアが約60dBで頭打ち。高分解能測定は浮動小数点またはQ31で行う
+#define DISTORTION_ENABLED 0                        // 1=歪み測定を実行しステータス出力に表示, 0=無効
+#define DISTORTION_FUNDAMENTAL_HZ 0.0f              // 基本波周波数（Hz、0=DC以外の最大ビンを自動検出）
+#define DISTORTION_MAX_HARMONIC 10                  // 合算する最高次高調波（2〜16）
+
+// ** 固定小数点パイプライン設定 **
+// ビルド時に CMake オプション -DPICOFFT_FIXED_POINT=16 (Q15) / 32 (Q31) で選択（0=浮動小数点、既定）
+// 整数DC除去 → Q15窓乗算 → スケーリング付き固定小数点FFT → 整数パワー/対数変換
+// ※ 統合システム（adc_sampling.c）のみ対応。旧システム（lib/lcd_test.c）は浮動小数点前提
+
+// ** 静的メモリアリーナ設定 **
+// FFTプラン（kiss_fftのlenmem方式）と表示バッファを起動時に1つの静的領域から確保（malloc不使用、fft_arena.c）
+// 予算超過は起動時にエラー表示（必要KB数を表示）して初期化失敗。使用量は起動ログに表示
+// ※ 0=自動（FFTプラン＋ズームFFTプランの見積り）。double_buffer / partial_update の画面バッファを使う場合は明示指定
+#define FFT_ARENA_SIZE_KB 0                         // アリーナサイズ（KB、0=自動）
+
 // カイザー・ベッセル窓パラメータ
 #define KAISER_BESSEL_BETA 8.5f                     // カイザー・ベッセル窓のβパラメータ（高精度）
 
@@ -78,22 +165,51 @@
 #define ADC_DMA_CHANNEL_AUTO -1                     // -1=自動選択, 0-11=手動指定
 
 // ** DMAサンプリング高度設定 **
-#define ADC_DMA_TRANSFER_SIZE DMA_SIZE_16           // DMA転送サイズ (16bit ADC)
-#define ADC_DMA_RING_BUFFER_MODE 1                  // 1=リングバッファ, 0=ワンショット
+// 取得用DMAチャンネルを制御用DMAチャンネルにチェーンし、制御チャンネルが次のバッファアドレス（ピンポン）またはブロック長（リング）を
+// 取得チャンネルのトリガ付きエイリアスへ書き込んで即再起動（割り込み内での再設定なし、サンプル欠落なし）
+// 割り込みは完了の公開（タイムスタンプ＋完了数）のみ。バッファの受け渡しとオーバーラン判定はメインループ側（adc_frame_queue.c）
+// ピンポンモードのフレームキュー: 取得領域（8192サンプル）をフレーム単位のスロットに分割し、処理側はスロット数-1フレームまで遅れても欠落なし
+// ※ 2のべき乗（2〜8）。大きなフレームでは自動で減少（FFT 1024点以下=8, 2048点=4, 4096点=2。2チャンネル時はフレームが2倍、8bit取得時は領域が2倍）
+#define ADC_DMA_TRANSFER_SIZE (ADC_CAPTURE_8BIT ? DMA_SIZE_8 : DMA_SIZE_16) // DMA転送サイズ (8bit取得時は1バイト)
+// リングモードは取得領域を16KB境界に配置するため、リンカ配置次第で最大16KBのRAMがアラインメント余白になる（ピンポンでは不要）
+#define ADC_DMA_RING_BUFFER_MODE 0                  // 1=リングバッファ（オーバーラップSTFT）, 0=ピンポンバッファ（フレームキュー、既定）
+#define ADC_STFT_HOP_DIVISOR 2                      // リングモードのフレーム間隔 = FFTサイズ/分母（2=50%, 4=75%, 8=87.5%重複）
 #define ADC_DMA_ERROR_RECOVERY 1                    // 1=エラー自動回復, 0=手動回復
-#define ADC_DMA_OVERRUN_DETECTION 1                 // 1=オーバーラン検出有効, 0=無効
+#define FRAME_QUEUE_SLOTS 8                         // フレームキューのスロット数（2/4/8）
+#define ADC_DMA_OVERRUN_DETECTION 1                 // 1=オーバーラン検出時に警告表示（メインループから）, 0=計数のみ
+
+// ** 8bit取得モード **
+// ADC FIFOのバイトシフト（上位8bitのみ）とDMA_SIZE_8転送でサンプルを1バイトに格納し、DMA・フレームコピーのメモリ帯域を半減
+// 同じ16KBの取得領域に2倍のサンプル（16384）が入り、フレームキューのスロット数とリングの遅れ許容量が2倍。フレームバッファは半分（4KB）
+// 窓掛けは8bit専用カーネル（4サンプル/ワード読み出し＋256段のレベル表、adc_convert.c）。dB校正は12bit換算のまま
+// ※ 量子化ノイズが約24dB上昇するため広帯域のサーベイ向け（ノイズフロア・歪み測定には12bit取得を使用）
+#define ADC_CAPTURE_8BIT 0                          // 1=8bit取得（バイトシフト）, 0=12bit取得（16bit転送）
+
+// ** 2チャンネル（伝達関数）測定設定 **
+// ADC0(GP26)=チャンネルA（基準・入力）とADC1(GP27)=チャンネルB（応答・出力）をラウンドロビンで交互に変換（各チャンネル SAMPLING_RATE_HZ、ADC全体で2倍）
+// 取得フレームをA/Bに分離し、両チャンネルのFFTから平均化クロススペクトル、H1伝達関数（B/Aのゲイン・位相）、コヒーレンスを計算（fft_cross.c）
+// 複素FFTビルドは1回の複素FFTに2実信号を詰めて分離、実数入力ビルドはキャッシュ済み実数FFTを2回（kiss_fftr自体が同じ詰め込み方式）
+// BはAより半サンプル遅れて変換されるため位相から補正済み。表示・Welch・ピーク等はチャンネルAを使用。結果はマーカー周波数でステータス出力に表示
+// ※ FFTサイズは1024点まで（平均化バッファ8KBをこのモード時のみアリーナから確保）
+#define DUAL_CHANNEL_ENABLED 0                      // 1=2チャンネル取得とクロススペクトル解析, 0=1チャンネル（GP26のみ）
+#define CROSS_SPECTRUM_AVERAGES 16                  // クロススペクトル指数平均のフレーム数N（コヒーレンスの推定にはN≧8程度を推奨）
+
+// ** デュアルコア・パイプライン設定 **
+// コア1がADCフレームの処理（FFT・dB変換・Welch・ズーム・オクターブ等の全解析段）を行い、コア0は描画（表示マッピングとSPI転送）だけを行う
+// スペクトルは2つのスロットで受け渡し、スロット番号だけをコア間FIFOで送る（fft_pipeline.c、ロック不要）。描画中もコア1はフレームを同じスロットへ合成し続けるため取りこぼしなし
+// ※ 実数入力FFT（FFT_REAL_INPUT_ENABLED=1）または固定小数点ビルドが必要（複素floatビルドのインプレースFFTはコア1のスタック4KBを超える）
+// ※ 2つ目のスロット（約9KB、2チャンネル時はFFTサイズ上限に合わせて約3KB）をアリーナから確保
+#define DUAL_CORE_PIPELINE_ENABLED 1                // 1=解析をコア1・描画をコア0で並列実行, 0=両方コア0で逐次実行
 
 // ** 表示設定 **
+// ※ SAMPLING_RATE_HZ での表示範囲。サンプリング周波数の変更時はレート比で拡縮し、目盛りラベルも自動で再計算
 #define FREQUENCY_RANGE_MIN 1000                    // 最低周波数（1kHz）
 #define FREQUENCY_RANGE_MAX 50000                   // 最高周波数（50kHz）
 #define AMPLITUDE_RANGE_MIN_DB -100                 // 最小振幅（dB）
 #define AMPLITUDE_RANGE_MAX_DB 20                   // 最大振幅（dB）
 
-// ** 表示座標補正設定 **
-#define FREQUENCY_DISPLAY_OFFSET_HZ -2500           // 周波数表示オフセット（Hzで指定）- 負値で左にシフト ADC_DMA_ENABLEDを手動にするときだけ、オフセット入れる
-#define ENABLE_FREQUENCY_OFFSET_CORRECTION 0        // 1=オフセット補正有効, 0=無効
-
 // ** 周波数マーカー設定 **
+// Goertzelトラッカーと伝達関数（B/A）表示の周波数（周波数軸の目盛りは表示範囲から自動生成）
 // 1kHz, 5kHz, 10kHz, 15kHz, 20kHz, 25kHz, 30kHz, 35kHz, 40kHz, 45kHz, 50kHz (5kHz刻み)
 #define FREQ_MARKERS_COUNT 11                       // マーカー数
 #define FREQ_MARKERS_HZ_ARRAY {1000, 5000, 10000, 15000, 20000, 25000, 30000, 35000, 40000, 45000, 50000}
@@ -0,0 +1,104 @@
+/*****************************************************************************
+* | File      	:   fft_arena.c
+* | Author      :   PicoFFT Project
+* | Function    :   Static startup arena for long-lived buffers
+* | Info        :
+*   - FFT_ARENA_SIZE_KB 0 sizes the arena for the unified pipeline (plan
+*     registry + zoom FFT plan + octave cascade on the log axis + two-channel
+*     cross spectrum); LCD frame
+*     buffers need an explicit budget
+*   - Budget errors name the owner and the size the arena would need
+*----------------
+******************************************************************************/
+
+#include "fft_arena.h"
+#include "fft_plan.h"
+#include "fft_zoom.h"
+#include "fft_octave.h"
+#include "fft_cross.h"
+#include "fft_realtime_unified.h"
+#include <stdio.h>
+
+#if FFT_ARENA_SIZE_KB > 0
+#define FFT_ARENA_BYTES ((size_t)FFT_ARENA_SIZE_KB * 1024)
+#else
+#define FFT_ARENA_BYTES (FFT_PLAN_POOL_BYTES + FFT_ZOOM_CFG_BYTES + FFT_OCTAVE_ARENA_BYTES + \
+                         FFT_CROSS_ARENA_BYTES + FFT_SPECTRUM_ARENA_BYTES + 5 * FFT_ARENA_ALIGN)
+#endif
+
+// Static arena region
+static uint8_t s_arena[FFT_ARENA_BYTES] __attribute__((aligned(FFT_ARENA_ALIGN)));
+
+// Global arena state
+static fft_arena_state_t g_arena = {0};
+
+// ========================================
+// 🔧 Arena API Implementation
+// ========================================
+
+/**
+ * Carve a block out of the arena
+ */
+void* fft_arena_alloc(size_t bytes, const char* owner) {
+    if (g_arena.locked) {
+        printf("ERROR: FFT arena is locked, %s allocated %u bytes after startup\n",
+               owner, (unsigned)bytes);
+        return NULL;
+    }
+    
+    // Total demand as if every request had fit (sizes the budget in the error message)
+    g_arena.requested = ((g_arena.requested + FFT_ARENA_ALIGN - 1) & ~(size_t)(FFT_ARENA_ALIGN - 1)) + bytes;
+    
+    size_t offset = (g_arena.used + FFT_ARENA_ALIGN - 1) & ~(size_t)(FFT_ARENA_ALIGN - 1);
+    if (bytes > sizeof(s_arena) - offset) {
+        printf("ERROR: FFT arena budget exceeded by %s (need %u, free %u of %u bytes; "
+               "FFT_ARENA_SIZE_KB must be at least %u)\n",
+               owner, (unsigned)bytes, (unsigned)(sizeof(s_arena) - offset),
+               (unsigned)sizeof(s_arena), (unsigned)((g_arena.requested + 1023) / 1024));
+        return NULL;
+    }
+    
+    if (g_arena.block_count < FFT_ARENA_MAX_BLOCKS) {
+        g_arena.blocks[g_arena.block_count].owner = owner;
+        g_arena.blocks[g_arena.block_count].bytes = bytes;
+        g_arena.block_count++;
+    }
+    g_arena.used = offset + bytes;
+    return &s_arena[offset];
+}
+
+/**
+ * End the startup phase
+ */
+void fft_arena_lock(void) {
+    g_arena.locked = true;
+}
+
+/**
+ * Get bytes in use
+ */
+size_t fft_arena_get_used(void) {
+    return g_arena.used;
+}
+
+/**
+ * Get the arena budget
+ */
+size_t fft_arena_get_capacity(void) {
+    return sizeof(s_arena);
+}
+
+/**
+ * Print per-owner usage
+ */
+void fft_arena_print_usage(void) {
+    printf("FFT arena: peak %u / %u bytes (%u free)%s\n",
+           (unsigned)g_arena.used, (unsigned)sizeof(s_arena),
+           (unsigned)(sizeof(s_arena) - g_arena.used), g_arena.locked ? ", locked" : "");
+    for (int i = 0; i < g_arena.block_count; i++) {
+        printf("  %-20s %8u bytes\n", g_arena.blocks[i].owner, (unsigned)g_arena.blocks[i].bytes);
+    }
+    if (g_arena.requested > g_arena.used) {
+        printf("  Over budget: startup asked for %u bytes\n", (unsigned)g_arena.requested);
+    }
+}
@@ -0,0 +1,77 @@
+/*****************************************************************************
+* | File      	:   fft_arena.h
+* | Author      :   PicoFFT Project
+* | Function    :   Static startup arena for long-lived buffers
+* | Info        :
+*   - One statically sized region (FFT_ARENA_SIZE_KB) replaces malloc for
+*     FFT plans (kiss_fft lenmem mode) and display buffers
+*   - Bump allocation at init only: nothing is freed, so startup time is
+*     deterministic and the heap never fragments on long runs
+*   - An allocation over budget fails immediately with the owner and the
+*     missing byte count; usage is reported per owner
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_ARENA_H
+#define __FFT_ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config_settings.h"
+
+// Arena configuration
+#define FFT_ARENA_ALIGN 8                   // Allocation alignment (kiss_fft states, DMA buffers)
+#define FFT_ARENA_MAX_BLOCKS 16             // Allocations tracked for the usage report
+
+// One arena allocation
+typedef struct {
+    const char* owner;          // Module that requested the block
+    size_t bytes;               // Bytes requested (before alignment)
+} fft_arena_block_t;
+
+// Arena state
+typedef struct {
+    size_t used;                            // Bytes carved so far (also the peak: nothing is freed)
+    size_t requested;                       // Total asked for, including failed requests
+    fft_arena_block_t blocks[FFT_ARENA_MAX_BLOCKS];
+    int block_count;
+    bool locked;                            // Startup finished, further allocations are errors
+} fft_arena_state_t;
+
+// ========================================
+// 🔧 Arena API
+// ========================================
+
+/**
+ * Carve a block out of the arena
+ * Fails fast (with a budget error on the console) instead of falling back to malloc
+ * @param bytes Block size
+ * @param owner Module name for the usage report and error messages
+ * @return FFT_ARENA_ALIGN-aligned block, NULL if over budget or the arena is locked
+ */
+void* fft_arena_alloc(size_t bytes, const char* owner);
+
+/**
+ * End the startup phase: later allocations fail
+ */
+void fft_arena_lock(void);
+
+/**
+ * Get bytes in use (equals the peak usage)
+ * @return Used bytes
+ */
+size_t fft_arena_get_used(void);
+
+/**
+ * Get the arena budget
+ * @return Arena size in bytes
+ */
+size_t fft_arena_get_capacity(void);
+
+/**
+ * Print per-owner usage, the peak and the remaining budget
+ */
+void fft_arena_print_usage(void);
+
+#endif // __FFT_ARENA_H
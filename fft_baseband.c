@@ -0,0 +1,189 @@
+/*****************************************************************************
+* | File      	:   fft_baseband.c
+* | Author      :   PicoFFT Project
+* | Function    :   Decimated baseband spectrum (multirate analysis)
+* | Info        :
+*   - 4x CIC + 2x FIR: 128kHz -> 16kHz, flat to 0.22 * 32kHz = 7kHz, the
+*     top of the 0-8kHz span lies in the FIR transition band
+*   - Decimation costs per input sample, the FFT only every FFT_BASEBAND_HOP
+*     baseband samples (fs / 8 / 512 = 31 spectra/s at 128kHz)
+*----------------
+******************************************************************************/
+
+#include "fft_baseband.h"
+#include "fft_window.h"
+#include "adc_sampling.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+
+// Global baseband state
+static fft_baseband_state_t g_baseband = {0};
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Recompute the dB offset for the active window
+ * Same scaling as the wideband path: the decimator has unity passband gain,
+ * so a baseband tone keeps its ADC amplitude
+ */
+static void _fft_baseband_update_db_offset(void) {
+    const fft_window_info_t* info = fft_window_get_info_for_size(FFT_BASEBAND_FFT_SIZE);
+    float correction = (info != NULL && info->coherent_gain > 0.0f) ? 1.0f / info->coherent_gain : 1.0f;
+    
+#ifdef FIXED_POINT
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT /
+                            ((float)(1 << ADC_FIXED_INPUT_SHIFT) * DB_REFERENCE_VOLTAGE_0DBM);
+#else
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT /
+                            ((float)FFT_BASEBAND_FFT_SIZE * DB_REFERENCE_VOLTAGE_0DBM);
+#endif
+    amplitude_scale *= correction;
+    
+    fft_db_stage_configure(&g_baseband.db_stage, 20.0f * log10f(amplitude_scale));
+    g_baseband.window_type = fft_window_get_type();
+}
+
+/**
+ * Window the baseband history and compute one dBm spectrum
+ */
+static void _fft_baseband_compute_spectrum(void) {
+    const float* window = fft_window_get_coefficients_for_size(FFT_BASEBAND_FFT_SIZE);
+    
+    if (g_baseband.window_type != fft_window_get_type()) {
+        _fft_baseband_update_db_offset();
+    }
+    
+    // Oldest sample first (history is full, so it starts at the write position)
+    int pos = g_baseband.baseband_pos;
+    for (int i = 0; i < FFT_BASEBAND_FFT_SIZE; i++) {
+#ifdef FIXED_POINT
+        const float max_scalar = (float)((1u << (FIXED_POINT - 1)) - 1);
+        float value = g_baseband.baseband[pos] * window[i] * (float)(1 << ADC_FIXED_INPUT_SHIFT);
+        if (value > max_scalar) value = max_scalar;
+        if (value < -max_scalar) value = -max_scalar;
+        kiss_fft_scalar x = (kiss_fft_scalar)lrintf(value);
+#else
+        kiss_fft_scalar x = g_baseband.baseband[pos] * window[i];
+#endif
+#if FFT_REAL_INPUT_ENABLED
+        g_baseband.fft_input[i] = x;
+#else
+        g_baseband.fft_input[i].r = x;
+        g_baseband.fft_input[i].i = 0;
+#endif
+        if (++pos == FFT_BASEBAND_FFT_SIZE) {
+            pos = 0;
+        }
+    }
+    
+    fft_plan_forward(g_baseband.plan, g_baseband.fft_input, g_baseband.fft_output);
+    fft_db_stage_convert_spectrum(&g_baseband.db_stage, g_baseband.fft_output,
+                                  g_baseband.magnitude, FFT_BASEBAND_BINS);
+    
+    g_baseband.spectrum_ready = true;
+    g_baseband.spectrum_count++;
+}
+
+// ========================================
+// 🔧 Baseband API Implementation
+// ========================================
+
+/**
+ * Initialize the baseband stage
+ */
+bool fft_baseband_init(void) {
+    memset(&g_baseband, 0, sizeof(g_baseband));
+    
+    g_baseband.plan = fft_plan_find(FFT_BASEBAND_FFT_SIZE);
+    if (g_baseband.plan == NULL ||
+        fft_window_get_coefficients_for_size(FFT_BASEBAND_FFT_SIZE) == NULL) {
+        printf("ERROR: No cached plan/window for baseband FFT size %d\n", FFT_BASEBAND_FFT_SIZE);
+        return false;
+    }
+    if (!fft_decimator_init(&g_baseband.decim, FFT_BASEBAND_CIC_RATIO, FFT_BASEBAND_FIR_RATIO,
+                            FFT_BASEBAND_FIR_TAPS)) {
+        return false;
+    }
+    
+    _fft_baseband_update_db_offset();
+    g_baseband.initialized = true;
+    return true;
+}
+
+/**
+ * Discard filter state and baseband history
+ */
+void fft_baseband_reset(void) {
+    fft_decimator_reset(&g_baseband.decim);
+    g_baseband.baseband_pos = 0;
+    g_baseband.baseband_filled = 0;
+    g_baseband.new_since_fft = 0;
+    g_baseband.spectrum_ready = false;
+}
+
+/**
+ * Feed raw ADC samples through the decimator
+ */
+bool fft_baseband_process(const adc_sample_t* samples, int count) {
+    int32_t centered[FFT_BASEBAND_CHUNK];
+    float decimated[FFT_BASEBAND_CHUNK / FFT_BASEBAND_DECIMATION + 1];
+    bool produced = false;
+    
+    if (!g_baseband.initialized || samples == NULL) {
+        return false;
+    }
+    
+    for (int start = 0; start < count; start += FFT_BASEBAND_CHUNK) {
+        int chunk = count - start;
+        if (chunk > FFT_BASEBAND_CHUNK) chunk = FFT_BASEBAND_CHUNK;
+    
+        for (int i = 0; i < chunk; i++) {
+            centered[i] = ADC_SAMPLE_CENTER(samples[start + i]);
+        }
+        int outputs = fft_decimator_process(&g_baseband.decim, centered, chunk, decimated);
+    
+        for (int i = 0; i < outputs; i++) {
+            g_baseband.baseband[g_baseband.baseband_pos] = decimated[i];
+            if (++g_baseband.baseband_pos == FFT_BASEBAND_FFT_SIZE) {
+                g_baseband.baseband_pos = 0;
+            }
+            if (g_baseband.baseband_filled < FFT_BASEBAND_FFT_SIZE) {
+                g_baseband.baseband_filled++;
+            }
+    
+            if (g_baseband.baseband_filled == FFT_BASEBAND_FFT_SIZE &&
+                ++g_baseband.new_since_fft >= FFT_BASEBAND_HOP) {
+                g_baseband.new_since_fft = 0;
+                _fft_baseband_compute_spectrum();
+                produced = true;
+            }
+        }
+    }
+    
+    return produced;
+}
+
+/**
+ * Get the last baseband spectrum
+ */
+const float* fft_baseband_get_magnitude(void) {
+    return g_baseband.spectrum_ready ? g_baseband.magnitude : NULL;
+}
+
+/**
+ * Get the baseband bin spacing
+ */
+float fft_baseband_get_bin_width(float sample_rate) {
+    return sample_rate / (float)(FFT_BASEBAND_DECIMATION * FFT_BASEBAND_FFT_SIZE);
+}
+
+/**
+ * Get the number of baseband spectra computed
+ */
+uint32_t fft_baseband_get_spectrum_count(void) {
+    return g_baseband.spectrum_count;
+}
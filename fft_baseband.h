@@ -0,0 +1,111 @@
+/*****************************************************************************
+* | File      	:   fft_baseband.h
+* | Author      :   PicoFFT Project
+* | Function    :   Decimated baseband spectrum (multirate analysis)
+* | Info        :
+*   - CIC + compensating FIR (fft_decimator.c) reduce the ADC stream by
+*     FFT_BASEBAND_DECIMATION, incrementally per acquired buffer
+*   - Real FFT of the baseband with the cached plan of the same size, so the
+*     0 - fs/16 span is resolved 8x finer than the wideband spectrum
+*   - Fed by adc_sampling.c next to the wideband frame; read through
+*     adc_sampling_get_baseband_spectrum()
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_BASEBAND_H
+#define __FFT_BASEBAND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "kiss_fft.h"
+#include "fft_db.h"
+#include "fft_decimator.h"
+#include "fft_plan.h"
+#include "adc_convert.h"
+
+// Baseband configuration
+#define FFT_BASEBAND_FFT_SIZE 1024          // Baseband FFT size (must be a registered plan size)
+#define FFT_BASEBAND_CIC_RATIO 4
+#define FFT_BASEBAND_FIR_RATIO 2
+#define FFT_BASEBAND_DECIMATION (FFT_BASEBAND_CIC_RATIO * FFT_BASEBAND_FIR_RATIO)
+#define FFT_BASEBAND_FIR_TAPS 95
+#define FFT_BASEBAND_HOP (FFT_BASEBAND_FFT_SIZE / 2) // New baseband samples per spectrum (50% overlap)
+#define FFT_BASEBAND_CHUNK 64               // Input samples converted per block
+#define FFT_BASEBAND_BINS (FFT_BASEBAND_FFT_SIZE / 2)
+
+#if FFT_REAL_INPUT_ENABLED
+#define FFT_BASEBAND_OUTPUT_BINS (FFT_BASEBAND_FFT_SIZE / 2 + 1)
+#else
+#define FFT_BASEBAND_OUTPUT_BINS FFT_BASEBAND_FFT_SIZE
+#endif
+
+// Baseband state
+typedef struct {
+    fft_decimator_t decim;                  // fs -> fs / FFT_BASEBAND_DECIMATION
+    const fft_plan_t* plan;                 // Cached plan of FFT_BASEBAND_FFT_SIZE
+    fft_window_type_t window_type;          // Window the dB offset was computed for
+    
+    // Baseband history (circular, oldest sample at baseband_pos once full)
+    float baseband[FFT_BASEBAND_FFT_SIZE];
+    int baseband_pos;
+    int baseband_filled;
+    int new_since_fft;
+    
+    // In-place FFT work buffer (windowed input, then bins)
+    union {
+        fft_kernel_input_t fft_input[FFT_BASEBAND_FFT_SIZE];
+        kiss_fft_cpx fft_output[FFT_BASEBAND_OUTPUT_BINS];
+    };
+    fft_db_stage_t db_stage;                // Own offset (baseband FFT size and window)
+    float magnitude[FFT_BASEBAND_BINS];     // dBm, DC to output rate / 2
+    uint32_t spectrum_count;
+    bool spectrum_ready;
+    bool initialized;
+} fft_baseband_state_t;
+
+// ========================================
+// 🔧 Baseband API
+// ========================================
+
+/**
+ * Initialize the baseband stage (decimator design, plan lookup)
+ * Requires fft_plan_init() with FFT_BASEBAND_FFT_SIZE among the plan sizes
+ * @return true if successful, false on error
+ */
+bool fft_baseband_init(void);
+
+/**
+ * Discard filter state and baseband history
+ */
+void fft_baseband_reset(void);
+
+/**
+ * Feed raw ADC samples through the decimator
+ * A spectrum is computed every FFT_BASEBAND_HOP baseband samples
+ * @param samples Raw ADC samples (adc_sample_t), contiguous in time
+ * @param count Number of samples
+ * @return true if at least one new baseband spectrum was produced
+ */
+bool fft_baseband_process(const adc_sample_t* samples, int count);
+
+/**
+ * Get the last baseband spectrum
+ * @return Pointer to FFT_BASEBAND_BINS bins in dBm, NULL if none yet
+ */
+const float* fft_baseband_get_magnitude(void);
+
+/**
+ * Get the baseband bin spacing
+ * @param sample_rate ADC sample rate (measured, see adc_sampling_get_sample_rate)
+ * @return sample_rate / FFT_BASEBAND_DECIMATION / FFT_BASEBAND_FFT_SIZE in Hz
+ */
+float fft_baseband_get_bin_width(float sample_rate);
+
+/**
+ * Get the number of baseband spectra computed
+ * @return Spectrum count since reset
+ */
+uint32_t fft_baseband_get_spectrum_count(void);
+
+#endif // __FFT_BASEBAND_H
@@ -0,0 +1,200 @@
+/*****************************************************************************
+* | File      	:   fft_cross.c
+* | Author      :   PicoFFT Project
+* | Function    :   Averaged cross spectrum, H1 transfer function and coherence
+* | Info        :
+*   - Per frame: 3 multiply-adds per spectrum product and bin, no division or
+*     log; gain, phase and coherence are formed only when read
+*   - Averages use the running mean of fft_trace.c (weight 1/k up to N
+*     frames, then 1/N), so results are valid from the second frame on
+*----------------
+******************************************************************************/
+
+#include "fft_cross.h"
+#include "fft_arena.h"
+#include "fft_db.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#define FFT_CROSS_RAD_TO_DEG 57.29577951f
+
+#ifdef FIXED_POINT
+typedef int64_t fft_cross_sum_t;            // Q15/Q31 pair sums before the halving shift
+#define FFT_CROSS_HALF(sum) ((kiss_fft_scalar)((sum) >> 1))
+#else
+typedef float fft_cross_sum_t;
+#define FFT_CROSS_HALF(sum) ((sum) * 0.5f)
+#endif
+
+// Averaged spectra, carved from the arena on first init
+static fft_cross_buffers_t* s_cross_buffers = NULL;
+
+// Global cross spectrum state
+static fft_cross_state_t g_cross = {0};
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Form gain, phase and coherence of one averaged bin
+ */
+static void _fft_cross_eval_bin(int bin, float* gain_db, float* phase_deg, float* coherence) {
+    const fft_cross_buffers_t* acc = g_cross.buffers;
+    float gxx = acc->gxx[bin];
+    float cross_power = acc->gxy_re[bin] * acc->gxy_re[bin] + acc->gxy_im[bin] * acc->gxy_im[bin];
+    
+    if (gain_db != NULL) {
+        // |H1| = |Gxy| / Gxx
+        *gain_db = (gxx > 0.0f && cross_power > 0.0f) ? 10.0f * log10f(cross_power) - 20.0f * log10f(gxx)
+                                                      : FFT_DB_FLOOR;
+    }
+    if (phase_deg != NULL) {
+        // Channel B sampled skew samples late: its phase leads by 2 pi f skew / fs
+        float phase = FFT_CROSS_RAD_TO_DEG * atan2f(acc->gxy_im[bin], acc->gxy_re[bin]) -
+                      360.0f * g_cross.channel_skew * (float)bin / (float)g_cross.fft_size;
+        if (phase <= -180.0f) phase += 360.0f;
+        *phase_deg = phase;
+    }
+    if (coherence != NULL) {
+        float auto_product = gxx * acc->gyy[bin];
+        *coherence = (auto_product > 0.0f) ? cross_power / auto_product : 0.0f;
+    }
+}
+
+// ========================================
+// 🔧 Cross Spectrum API Implementation
+// ========================================
+
+/**
+ * Initialize the cross spectrum averages
+ */
+bool fft_cross_init(int average_count, float channel_skew) {
+    if (average_count < 1 || channel_skew < 0.0f || channel_skew >= 1.0f) {
+        printf("ERROR: Invalid cross spectrum settings (N=%d, skew %.3f samples)\n",
+               average_count, channel_skew);
+        return false;
+    }
+    
+    if (s_cross_buffers == NULL) {
+        s_cross_buffers = fft_arena_alloc(sizeof(fft_cross_buffers_t), "fft_cross");
+        if (s_cross_buffers == NULL) {
+            return false;
+        }
+    }
+    
+    memset(&g_cross, 0, sizeof(g_cross));
+    g_cross.buffers = s_cross_buffers;
+    g_cross.average_count = average_count;
+    g_cross.channel_skew = channel_skew;
+    return true;
+}
+
+/**
+ * Restart the averages
+ */
+void fft_cross_reset(void) {
+    g_cross.frame_count = 0;
+}
+
+/**
+ * Separate the packed complex FFT of two real channels in place
+ */
+void fft_cross_split(kiss_fft_cpx* bins, int fft_size) {
+    const int half = fft_size / 2;
+    
+    // DC and Nyquist: X real part is Re Z, Y (Im Z) is not kept
+    bins[0].i = 0;
+    bins[half].i = 0;
+    
+    for (int k = 1; k < half; k++) {
+        kiss_fft_cpx a = bins[k];
+        kiss_fft_cpx b = bins[fft_size - k];
+    
+        bins[k].r = FFT_CROSS_HALF((fft_cross_sum_t)a.r + b.r);
+        bins[k].i = FFT_CROSS_HALF((fft_cross_sum_t)a.i - b.i);
+        bins[fft_size - k].r = FFT_CROSS_HALF((fft_cross_sum_t)a.i + b.i);
+        bins[fft_size - k].i = FFT_CROSS_HALF((fft_cross_sum_t)b.r - a.r);
+    }
+}
+
+/**
+ * Add one packed two-channel frame to the averages
+ */
+bool fft_cross_accumulate(const kiss_fft_cpx* bins, int fft_size) {
+    if (g_cross.buffers == NULL || bins == NULL || fft_size < 4 || fft_size > FFT_CROSS_MAX_SIZE) {
+        return false;
+    }
+    if (fft_size != g_cross.fft_size) {
+        g_cross.fft_size = fft_size;
+        fft_cross_reset();
+    }
+    
+    // Running mean, then exponential with weight 1/N
+    uint32_t k_frames = g_cross.frame_count + 1;
+    if (k_frames > (uint32_t)g_cross.average_count) {
+        k_frames = (uint32_t)g_cross.average_count;
+    }
+    const float weight = 1.0f / (float)k_frames;
+    
+    fft_cross_buffers_t* acc = g_cross.buffers;
+    for (int k = 1; k < fft_size / 2; k++) {
+        float xr = (float)bins[k].r;
+        float xi = (float)bins[k].i;
+        float yr = (float)bins[fft_size - k].r;
+        float yi = (float)bins[fft_size - k].i;
+    
+        // conj(X) Y
+        float cross_re = xr * yr + xi * yi;
+        float cross_im = xr * yi - xi * yr;
+    
+        acc->gxx[k] += (xr * xr + xi * xi - acc->gxx[k]) * weight;
+        acc->gyy[k] += (yr * yr + yi * yi - acc->gyy[k]) * weight;
+        acc->gxy_re[k] += (cross_re - acc->gxy_re[k]) * weight;
+        acc->gxy_im[k] += (cross_im - acc->gxy_im[k]) * weight;
+    }
+    
+    g_cross.frame_count++;
+    return true;
+}
+
+/**
+ * Get the transfer function and coherence at one bin
+ */
+bool fft_cross_get_point(int bin, float sample_rate, fft_cross_point_t* point) {
+    if (point == NULL || g_cross.frame_count == 0 || bin < 1 || bin >= g_cross.fft_size / 2) {
+        return false;
+    }
+    
+    point->frequency_hz = (float)bin * sample_rate / (float)g_cross.fft_size;
+    _fft_cross_eval_bin(bin, &point->gain_db, &point->phase_deg, &point->coherence);
+    return true;
+}
+
+/**
+ * Get the transfer function and coherence of every bin
+ */
+bool fft_cross_get_transfer(float* gain_db, float* phase_deg, float* coherence, int bins) {
+    if (g_cross.frame_count == 0 || bins < 1 || bins > g_cross.fft_size / 2) {
+        return false;
+    }
+    
+    if (gain_db != NULL) gain_db[0] = FFT_DB_FLOOR;
+    if (phase_deg != NULL) phase_deg[0] = 0.0f;
+    if (coherence != NULL) coherence[0] = 0.0f;
+    for (int bin = 1; bin < bins; bin++) {
+        _fft_cross_eval_bin(bin,
+                            gain_db != NULL ? &gain_db[bin] : NULL,
+                            phase_deg != NULL ? &phase_deg[bin] : NULL,
+                            coherence != NULL ? &coherence[bin] : NULL);
+    }
+    return true;
+}
+
+/**
+ * Get the number of averaged frames
+ */
+uint32_t fft_cross_get_frame_count(void) {
+    return g_cross.frame_count;
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************
+* | File      	:   fft_cross.h
+* | Author      :   PicoFFT Project
+* | Function    :   Averaged cross spectrum, H1 transfer function and coherence
+* | Info        :
+*   - Two-channel capture (DUAL_CHANNEL_ENABLED): channel A (ADC0, GP26) is
+*     the reference/stimulus, channel B (ADC1, GP27) the response
+*   - Gxx, Gyy and the complex Gxy = conj(X) Y are averaged per bin in the
+*     linear domain; H1 = Gxy / Gxx, coherence = |Gxy|^2 / (Gxx Gyy)
+*   - Both spectra of one frame come in one packed buffer (see
+*     fft_cross_split()), so no second spectrum array is needed
+*   - Round-robin sampling puts channel B a fraction of a sample after
+*     channel A; that delay is removed from the phase
+*   - Buffers come from the arena only when DUAL_CHANNEL_ENABLED is set
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_CROSS_H
+#define __FFT_CROSS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "kiss_fft.h"
+
+// Cross spectrum configuration
+#define FFT_CROSS_MAX_SIZE 1024             // Largest FFT size in two-channel mode (arena budget)
+#define FFT_CROSS_MAX_BINS (FFT_CROSS_MAX_SIZE / 2)
+
+// Averaged spectra (one arena block, struct of arrays)
+typedef struct {
+    float gxx[FFT_CROSS_MAX_BINS];          // Channel A auto spectrum |X|^2
+    float gyy[FFT_CROSS_MAX_BINS];          // Channel B auto spectrum |Y|^2
+    float gxy_re[FFT_CROSS_MAX_BINS];       // Cross spectrum conj(X) Y
+    float gxy_im[FFT_CROSS_MAX_BINS];
+} fft_cross_buffers_t;
+
+#if DUAL_CHANNEL_ENABLED
+#define FFT_CROSS_ARENA_BYTES (sizeof(fft_cross_buffers_t))     // Sizes the arena
+#else
+#define FFT_CROSS_ARENA_BYTES 0
+#endif
+
+// Transfer function at one bin
+typedef struct {
+    float frequency_hz;
+    float gain_db;                          // 20 log10 |H1| (channel B / channel A)
+    float phase_deg;                        // arg H1 in -180..180, sampling skew removed
+    float coherence;                        // 0..1 (1 = B fully explained by A)
+} fft_cross_point_t;
+
+// Cross spectrum state
+typedef struct {
+    fft_cross_buffers_t* buffers;           // Arena block
+    int average_count;                      // Exponential average weight 1/N after N frames
+    float channel_skew;                     // Channel B delay in samples
+    int fft_size;                           // Size of the averaged frames (restart on change)
+    uint32_t frame_count;                   // Frames since the last restart
+} fft_cross_state_t;
+
+// ========================================
+// 🔧 Cross Spectrum API
+// ========================================
+
+/**
+ * Initialize the cross spectrum averages
+ * @param average_count Frames of the exponential average (>= 1)
+ * @param channel_skew Delay of channel B behind channel A in samples (0.5 for
+ *        free-running round robin over two channels)
+ * @return true if successful, false on invalid parameters or arena budget
+ */
+bool fft_cross_init(int average_count, float channel_skew);
+
+/**
+ * Restart the averages
+ */
+void fft_cross_reset(void);
+
+/**
+ * Separate the complex FFT of z = x + j y (x, y real) in place into the
+ * packed two-channel layout: X[k] = (Z[k] + conj(Z[N-k])) / 2 stays at
+ * bins[k] (k = 0..N/2), Y[k] = (Z[k] - conj(Z[N-k])) / 2j moves to
+ * bins[N-k] (k = 1..N/2-1). Each pair (k, N-k) is read and written once.
+ * Real-input builds fill the same layout from two real FFTs instead.
+ * @param bins Complex FFT output (fft_size elements)
+ * @param fft_size FFT size N
+ */
+void fft_cross_split(kiss_fft_cpx* bins, int fft_size);
+
+/**
+ * Add one frame in the packed two-channel layout to the averages
+ * A change of FFT size restarts the averages
+ * @param bins Packed spectra (X[k] at bins[k], Y[k] at bins[fft_size - k])
+ * @param fft_size FFT size (up to FFT_CROSS_MAX_SIZE)
+ * @return true if the frame was added
+ */
+bool fft_cross_accumulate(const kiss_fft_cpx* bins, int fft_size);
+
+/**
+ * Get the transfer function and coherence at one bin
+ * @param bin Bin index (1 to fft_size/2 - 1)
+ * @param sample_rate Sampling rate per channel in Hz
+ * @param point Output
+ * @return true if at least one frame is averaged and the bin is valid
+ */
+bool fft_cross_get_point(int bin, float sample_rate, fft_cross_point_t* point);
+
+/**
+ * Get the transfer function and coherence of every bin
+ * Bin 0 (DC, removed before the FFT) reads as gain FFT_DB_FLOOR, coherence 0
+ * @param gain_db Output: |H1| in dB, or NULL
+ * @param phase_deg Output: arg H1 in degrees, or NULL
+ * @param coherence Output: 0..1, or NULL
+ * @param bins Number of bins (fft_size/2 of the averaged frames)
+ * @return true if at least one frame is averaged
+ */
+bool fft_cross_get_transfer(float* gain_db, float* phase_deg, float* coherence, int bins);
+
+/**
+ * Get the number of averaged frames
+ * @return Frames since the last restart
+ */
+uint32_t fft_cross_get_frame_count(void);
+
+#endif // __FFT_CROSS_H
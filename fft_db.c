@@ -0,0 +1,202 @@
+/*****************************************************************************
+* | File      	:   fft_db.c
+* | Author      :   PicoFFT Project
+* | Function    :   Power-to-dB conversion stage for FFT spectra
+* | Info        :   
+*   - log2 from the float exponent plus a 32-segment mantissa table
+*   - Integer variant (leading-one + table) for the fixed-point pipeline
+*----------------
+******************************************************************************/
+
+#include "fft_db.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+// Global dB stage configuration
+static fft_db_stage_t g_db_stage = {
+    .offset_db = 0.0f,
+    .power_floor = 0.0f,
+};
+
+// log2(1 + i/32), i = 0..32
+static const float s_log2_table[33] = {
+    0.00000000f, 0.04439412f, 0.08746284f, 0.12928302f,
+    0.16992500f, 0.20945337f, 0.24792751f, 0.28540222f,
+    0.32192809f, 0.35755200f, 0.39231742f, 0.42626475f,
+    0.45943162f, 0.49185310f, 0.52356196f, 0.55458885f,
+    0.58496250f, 0.61470984f, 0.64385619f, 0.67242534f,
+    0.70043972f, 0.72792045f, 0.75488750f, 0.78135971f,
+    0.80735492f, 0.83289001f, 0.85798100f, 0.88264305f,
+    0.90689060f, 0.93073734f, 0.95419631f, 0.97727992f,
+    1.00000000f,
+};
+
+// log2(1 + i/32) in Q16, i = 0..32
+static const int32_t s_log2_q16_table[33] = {
+        0,  2909,  5732,  8473, 11136, 13727, 16248, 18704,
+    21098, 23433, 25711, 27936, 30109, 32234, 34312, 36346,
+    38336, 40286, 42196, 44068, 45904, 47705, 49472, 51207,
+    52911, 54584, 56229, 57845, 59434, 60997, 62534, 64047,
+    65536,
+};
+
+#define FFT_DB_PER_LOG2_Q16 197283          // 10*log10(2) in Q16
+
+// ========================================
+// 🔧 log2 Approximations
+// ========================================
+
+/**
+ * Fast log2: exponent bits give the integer part, the top 5 mantissa bits
+ * select a table segment and the remaining 18 bits interpolate linearly
+ */
+static inline float _fft_db_log2(float x) {
+    union { float f; uint32_t u; } bits = { .f = x };
+    int exponent = (int)((bits.u >> 23) & 0xFF) - 127;
+    uint32_t mantissa = bits.u & 0x7FFFFF;
+    uint32_t index = mantissa >> 18;
+    float t = (float)(mantissa & 0x3FFFF) * (1.0f / 262144.0f);
+    float y0 = s_log2_table[index];
+    
+    return (float)exponent + y0 + (s_log2_table[index + 1] - y0) * t;
+}
+
+float fft_db_fast_log2(float x) {
+    return _fft_db_log2(x);
+}
+
+/**
+ * Integer log2 in Q16: leading-one position plus the same 32-segment table
+ */
+int32_t fft_db_log2_q16(uint64_t value) {
+    if (value == 0) return INT32_MIN;
+    
+    int msb = 63 - __builtin_clzll(value);
+    
+    // 16 fraction bits below the leading one
+    uint32_t fraction = (msb >= 16) ? (uint32_t)(value >> (msb - 16)) 
+                                    : (uint32_t)(value << (16 - msb));
+    fraction &= 0xFFFF;
+    
+    int index = fraction >> 11;             // Table segment (5 bits)
+    int32_t t = fraction & 0x7FF;           // Position inside segment (11 bits)
+    int32_t y0 = s_log2_q16_table[index];
+    int32_t y1 = s_log2_q16_table[index + 1];
+    
+    return (msb << 16) + y0 + (((y1 - y0) * t) >> 11);
+}
+
+// ========================================
+// 🔧 dB Conversion API Implementation
+// ========================================
+
+/**
+ * Configure a separate dB stage instance
+ */
+void fft_db_stage_configure(fft_db_stage_t* stage, float offset_db) {
+    stage->offset_db = offset_db;
+    
+    // Linear power that maps exactly to the floor; anything below is clamped
+    // without evaluating the log (also catches |X|^2 == 0)
+    stage->power_floor = powf(10.0f, (FFT_DB_FLOOR - offset_db) / 10.0f);
+    
+#ifdef FIXED_POINT
+    stage->offset_q16 = (int32_t)(offset_db * 65536.0f);
+#endif
+}
+
+/**
+ * Configure the dB stage
+ */
+void fft_db_configure(float offset_db) {
+    fft_db_stage_configure(&g_db_stage, offset_db);
+}
+
+/**
+ * Get the configured additive offset
+ */
+float fft_db_get_offset(void) {
+    return g_db_stage.offset_db;
+}
+
+/**
+ * Convert an array of linear power values to dB
+ */
+void fft_db_convert_power(const float* power, float* db_out, int bins, float offset_adjust_db) {
+    const float offset_db = g_db_stage.offset_db + offset_adjust_db;
+    
+    for (int i = 0; i < bins; i++) {
+        float db = FFT_DB_FLOOR;
+        if (power[i] > 0.0f) {
+            db = _fft_db_log2(power[i]) * FFT_DB_PER_LOG2 + offset_db;
+            if (db < FFT_DB_FLOOR) db = FFT_DB_FLOOR;
+        }
+        db_out[i] = db;
+    }
+}
+
+/**
+ * Convert a single linear power value to dB
+ */
+float fft_db_from_power(float power) {
+    if (!(power > g_db_stage.power_floor)) {
+        return FFT_DB_FLOOR;
+    }
+    return _fft_db_log2(power) * FFT_DB_PER_LOG2 + g_db_stage.offset_db;
+}
+
+/**
+ * Convert a spectrum to dB with a separate stage instance
+ */
+void fft_db_stage_convert_spectrum(const fft_db_stage_t* stage, const kiss_fft_cpx* spectrum, 
+                                   float* db_out, int bins) {
+#ifdef FIXED_POINT
+    const int32_t offset_q16 = stage->offset_q16;
+    const int32_t floor_q16 = (int32_t)(FFT_DB_FLOOR * 65536.0f);
+    
+    for (int i = 0; i < bins; i++) {
+        int64_t real = spectrum[i].r;
+        int64_t imag = spectrum[i].i;
+        uint64_t power = (uint64_t)(real * real) + (uint64_t)(imag * imag);
+        
+        int32_t db_q16 = floor_q16;
+        if (power > 0) {
+            db_q16 = (int32_t)(((int64_t)fft_db_log2_q16(power) * FFT_DB_PER_LOG2_Q16) >> 16) + 
+                     offset_q16;
+            if (db_q16 < floor_q16) db_q16 = floor_q16;
+        }
+        db_out[i] = (float)db_q16 * (1.0f / 65536.0f);
+    }
+#else
+    const float offset_db = stage->offset_db;
+    const float power_floor = stage->power_floor;
+    
+    for (int i = 0; i < bins; i++) {
+        float real = spectrum[i].r;
+        float imag = spectrum[i].i;
+        float power = real * real + imag * imag;
+        
+        db_out[i] = (power > power_floor) ? 
+                    _fft_db_log2(power) * FFT_DB_PER_LOG2 + offset_db : FFT_DB_FLOOR;
+    }
+#endif
+}
+
+/**
+ * Convert a spectrum to dB in one pass
+ */
+void fft_db_convert_spectrum(const kiss_fft_cpx* spectrum, float* db_out, int bins) {
+    fft_db_stage_convert_spectrum(&g_db_stage, spectrum, db_out, bins);
+}
+
+/**
+ * Convert linear power values to dB with a separate stage instance
+ */
+void fft_db_stage_convert_power(const fft_db_stage_t* stage, const float* power, 
+                                float* db_out, int count) {
+    for (int i = 0; i < count; i++) {
+        db_out[i] = (power[i] > stage->power_floor) ?
+                    _fft_db_log2(power[i]) * FFT_DB_PER_LOG2 + stage->offset_db : FFT_DB_FLOOR;
+    }
+}
@@ -0,0 +1,128 @@
+/*****************************************************************************
+* | File      	:   fft_db.h
+* | Author      :   PicoFFT Project
+* | Function    :   Power-to-dB conversion stage for FFT spectra
+* | Info        :   
+*   - Works on |X|^2 directly (no sqrtf, no divide per bin)
+*   - Table-based log2 approximation instead of log10f
+*   - All constant terms folded into one additive offset per configuration
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_DB_H
+#define __FFT_DB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "kiss_fft.h"
+
+// dB stage configuration
+#define FFT_DB_FLOOR -200.0f                // Output for bins below the floor (dBm)
+#define FFT_DB_PER_LOG2 3.01029996f         // 10*log10(2): power dB per log2 unit
+
+// Accuracy of the log2 approximation (32-segment table, linear interpolation):
+//   |error| <= 1.8e-4 log2 units = 5.3e-4 dB for every input above the floor.
+// The Q16 integer path adds the rounding of its table, interpolation, dB
+// constant and offset: |error| <= 6.7e-4 dB.
+// Measured over -200..+20 dBm against 10*log10() in double
+// (tools/fft_db_bench.c): max 5.3e-4 dB (float), 6.6e-4 dB (Q16).
+
+// dB stage state (the main analyzer uses the default stage; other spectrum
+// producers with their own scaling keep their own instance)
+typedef struct {
+    float offset_db;            // Single additive term: dB = 10*log10(|X|^2) + offset_db
+    float power_floor;          // |X|^2 at or below this maps to FFT_DB_FLOOR
+#ifdef FIXED_POINT
+    int32_t offset_q16;         // offset_db in Q16 for the integer path
+#endif
+} fft_db_stage_t;
+
+// ========================================
+// 🔧 dB Conversion API
+// ========================================
+
+/**
+ * Configure the dB stage
+ * Call once whenever FFT size, window or calibration changes
+ * @param offset_db Constant added to 10*log10(|X|^2) (normalization, 
+ *                  volts per LSB, 0dBm reference and window correction)
+ */
+void fft_db_configure(float offset_db);
+
+/**
+ * Configure a separate dB stage instance
+ * @param stage Stage to configure
+ * @param offset_db Constant added to 10*log10(|X|^2)
+ */
+void fft_db_stage_configure(fft_db_stage_t* stage, float offset_db);
+
+/**
+ * Convert a spectrum to dB with a separate stage instance
+ * @param stage Configured stage
+ * @param spectrum FFT output bins
+ * @param db_out Output array (bins elements)
+ * @param bins Number of bins to convert
+ */
+void fft_db_stage_convert_spectrum(const fft_db_stage_t* stage, const kiss_fft_cpx* spectrum, 
+                                   float* db_out, int bins);
+
+/**
+ * Convert linear power values to dB with a separate stage instance
+ * For producers that form |X|^2 themselves (Goertzel bank)
+ * @param stage Configured stage
+ * @param power Linear power values in the stage's units
+ * @param db_out Output array (count elements)
+ * @param count Number of values
+ */
+void fft_db_stage_convert_power(const fft_db_stage_t* stage, const float* power, 
+                                float* db_out, int count);
+
+/**
+ * Get the configured additive offset
+ * @return Offset in dB
+ */
+float fft_db_get_offset(void);
+
+/**
+ * Convert a spectrum to dB in one pass
+ * db_out may overlay spectrum: element k is written after bin k is read and
+ * never reaches past it, so the conversion can run in place
+ * @param spectrum FFT output bins
+ * @param db_out Output array (dBm, bins elements)
+ * @param bins Number of bins to convert
+ */
+void fft_db_convert_spectrum(const kiss_fft_cpx* spectrum, float* db_out, int bins);
+
+/**
+ * Convert an array of linear power values to dB
+ * Used by stages that average in the power domain before the log
+ * @param power |X|^2 values in FFT units
+ * @param db_out Output array (bins elements)
+ * @param bins Number of values to convert
+ * @param offset_adjust_db Extra term added to the configured offset
+ *                         (e.g. -10*log10(noise bandwidth) for densities)
+ */
+void fft_db_convert_power(const float* power, float* db_out, int bins, float offset_adjust_db);
+
+/**
+ * Convert a single linear power value to dB
+ * @param power |X|^2 in FFT units
+ * @return dBm value (FFT_DB_FLOOR if at or below the floor)
+ */
+float fft_db_from_power(float power);
+
+/**
+ * Fast log2 approximation for positive normal floats
+ * @param x Input value (> 0)
+ * @return log2(x), |error| <= 1.8e-4
+ */
+float fft_db_fast_log2(float x);
+
+/**
+ * Integer log2 in Q16 format
+ * @param value Input value (> 0)
+ * @return log2(value) * 65536, |error| <= 1.8e-4 * 65536 + 1
+ */
+int32_t fft_db_log2_q16(uint64_t value);
+
+#endif // __FFT_DB_H
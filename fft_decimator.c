@@ -0,0 +1,169 @@
+/*****************************************************************************
+* | File      	:   fft_decimator.c
+* | Author      :   PicoFFT Project
+* | Function    :   Decimating low-pass filter chain (CIC + compensating FIR)
+* | Info        :   
+*   - CIC runs at the input rate with 64-bit wrapping adds (no multiplies)
+*   - FIR runs at the CIC output rate and only computes kept outputs
+*   - FIR coefficients are designed once at configuration time
+*----------------
+******************************************************************************/
+
+#include "fft_decimator.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FFT_DECIM_DESIGN_STEPS 256          // Integration steps of the FIR design
+
+// ========================================
+// 🔧 FIR Design (cold path only)
+// ========================================
+
+/**
+ * Inverse of the normalized CIC magnitude response
+ * f is in cycles per CIC output sample
+ */
+static double _fft_decimator_cic_compensation(double f, int cic_ratio) {
+    if (cic_ratio <= 1 || f <= 0.0) return 1.0;
+    
+    double response = sin(M_PI * f) / (cic_ratio * sin(M_PI * f / cic_ratio));
+    return 1.0 / pow(fabs(response), FFT_DECIM_CIC_ORDER);
+}
+
+/**
+ * Windowed design of the compensating low-pass FIR
+ * The ideal response (CIC inverse up to the cutoff, zero above) is integrated
+ * numerically, shaped with a Blackman window and normalized to unity DC gain
+ */
+static void _fft_decimator_design_fir(fft_decimator_t* decim) {
+    const double cutoff = 0.5 * (FFT_DECIM_FIR_PASS_EDGE + FFT_DECIM_FIR_STOP_EDGE);
+    const double step = cutoff / FFT_DECIM_DESIGN_STEPS;
+    const double center = 0.5 * (decim->taps - 1);
+    double sum = 0.0;
+    
+    for (int n = 0; n < decim->taps; n++) {
+        double t = n - center;
+        double ideal = 0.0;
+        for (int k = 0; k < FFT_DECIM_DESIGN_STEPS; k++) {
+            double f = (k + 0.5) * step;
+            ideal += _fft_decimator_cic_compensation(f, decim->cic_ratio) * cos(2.0 * M_PI * f * t);
+        }
+        ideal *= 2.0 * step;
+    
+        double phase = 2.0 * M_PI * n / (decim->taps - 1);
+        double window = 0.42 - 0.5 * cos(phase) + 0.08 * cos(2.0 * phase);
+    
+        decim->fir_coeffs[n] = (float)(ideal * window);
+        sum += ideal * window;
+    }
+    
+    for (int n = 0; n < decim->taps; n++) {
+        decim->fir_coeffs[n] = (float)(decim->fir_coeffs[n] / sum);
+    }
+}
+
+// ========================================
+// 🔧 Decimator API Implementation
+// ========================================
+
+/**
+ * Configure a decimator and design its FIR
+ */
+bool fft_decimator_init(fft_decimator_t* decim, int cic_ratio, int fir_ratio, int taps) {
+    if (decim == NULL || cic_ratio < 1 || cic_ratio > FFT_DECIM_MAX_CIC_RATIO ||
+        fir_ratio < 1 || fir_ratio > FFT_DECIM_MAX_FIR_RATIO ||
+        taps < 3 || taps > FFT_DECIM_MAX_TAPS || (taps & 1) == 0) {
+        printf("ERROR: Invalid decimator configuration (CIC %d, FIR %d, %d taps)\n",
+               cic_ratio, fir_ratio, taps);
+        return false;
+    }
+    
+    memset(decim, 0, sizeof(*decim));
+    decim->cic_ratio = cic_ratio;
+    decim->fir_ratio = fir_ratio;
+    decim->taps = taps;
+    decim->cic_gain_inv = (float)(1.0 / pow((double)cic_ratio, FFT_DECIM_CIC_ORDER));
+    
+    _fft_decimator_design_fir(decim);
+    return true;
+}
+
+/**
+ * Clear the filter state
+ */
+void fft_decimator_reset(fft_decimator_t* decim) {
+    memset(decim->integrators, 0, sizeof(decim->integrators));
+    memset(decim->combs, 0, sizeof(decim->combs));
+    memset(decim->fir_history, 0, sizeof(decim->fir_history));
+    decim->cic_phase = 0;
+    decim->fir_pos = 0;
+    decim->fir_phase = 0;
+}
+
+/**
+ * Filter and decimate a block of samples
+ */
+int fft_decimator_process(fft_decimator_t* decim, const int32_t* input, int count, float* output) {
+    const int taps = decim->taps;
+    int produced = 0;
+    
+    for (int i = 0; i < count; i++) {
+        float fir_input;
+    
+        if (decim->cic_ratio > 1) {
+            // Integrators at the input rate
+            uint64_t acc = (uint64_t)(int64_t)input[i];
+            for (int s = 0; s < FFT_DECIM_CIC_ORDER; s++) {
+                decim->integrators[s] += acc;
+                acc = decim->integrators[s];
+            }
+            if (++decim->cic_phase < decim->cic_ratio) {
+                continue;
+            }
+            decim->cic_phase = 0;
+    
+            // Combs at the decimated rate
+            for (int s = 0; s < FFT_DECIM_CIC_ORDER; s++) {
+                uint64_t previous = decim->combs[s];
+                decim->combs[s] = acc;
+                acc -= previous;
+            }
+            fir_input = (float)(int64_t)acc * decim->cic_gain_inv;
+        } else {
+            fir_input = (float)input[i];
+        }
+    
+        // Push into the doubled history; [fir_pos, fir_pos + taps) is always contiguous
+        decim->fir_history[decim->fir_pos] = fir_input;
+        decim->fir_history[decim->fir_pos + taps] = fir_input;
+        if (++decim->fir_pos == taps) {
+            decim->fir_pos = 0;
+        }
+        if (++decim->fir_phase < decim->fir_ratio) {
+            continue;
+        }
+        decim->fir_phase = 0;
+    
+        // Symmetric coefficients, so history order does not matter
+        const float* history = &decim->fir_history[decim->fir_pos];
+        float sum = 0.0f;
+        for (int k = 0; k < taps; k++) {
+            sum += decim->fir_coeffs[k] * history[k];
+        }
+        output[produced++] = sum;
+    }
+    
+    return produced;
+}
+
+/**
+ * Get the total decimation ratio
+ */
+int fft_decimator_get_ratio(const fft_decimator_t* decim) {
+    return decim->cic_ratio * decim->fir_ratio;
+}
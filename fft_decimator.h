@@ -0,0 +1,85 @@
+/*****************************************************************************
+* | File      	:   fft_decimator.h
+* | Author      :   PicoFFT Project
+* | Function    :   Decimating low-pass filter chain (CIC + compensating FIR)
+* | Info        :   
+*   - 4th-order CIC does the bulk of the rate reduction with integer adds only
+*   - Windowed FIR flattens the CIC droop and sets the final cutoff
+*   - One instance per real stream (I and Q of a mixer use two instances)
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_DECIMATOR_H
+#define __FFT_DECIMATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Decimator configuration
+#define FFT_DECIM_CIC_ORDER 4               // CIC integrator/comb stages
+#define FFT_DECIM_MAX_CIC_RATIO 256         // 27-bit input + 4*log2(256) bits fits int64
+#define FFT_DECIM_MAX_FIR_RATIO 4
+#define FFT_DECIM_MAX_TAPS 95               // Odd length, linear phase
+#define FFT_DECIM_FIR_PASS_EDGE 0.22f       // Flat passband, fraction of the FIR input rate
+#define FFT_DECIM_FIR_STOP_EDGE 0.28f       // Stopband start (folds onto the pass edge at fir_ratio 2)
+
+// Decimator state
+typedef struct {
+    int cic_ratio;                                  // CIC decimation (1 = bypass)
+    int fir_ratio;                                  // FIR decimation
+    int taps;                                       // FIR length
+    
+    // CIC (wrapping two's complement arithmetic, exact for any bit growth <= 64)
+    uint64_t integrators[FFT_DECIM_CIC_ORDER];
+    uint64_t combs[FFT_DECIM_CIC_ORDER];            // Previous integrator outputs per comb
+    int cic_phase;                                  // Inputs since the last CIC output
+    float cic_gain_inv;                             // 1 / cic_ratio^order
+    
+    // FIR (history stored twice so the dot product never wraps)
+    float fir_coeffs[FFT_DECIM_MAX_TAPS];
+    float fir_history[2 * FFT_DECIM_MAX_TAPS];
+    int fir_pos;                                    // Next history write position
+    int fir_phase;                                  // FIR inputs since the last output
+} fft_decimator_t;
+
+// ========================================
+// 🔧 Decimator API
+// ========================================
+
+/**
+ * Configure a decimator and design its FIR
+ * The FIR passband inverts the CIC droop up to FFT_DECIM_FIR_PASS_EDGE
+ * @param decim Decimator to configure
+ * @param cic_ratio CIC decimation (1 to FFT_DECIM_MAX_CIC_RATIO, 1 = bypass)
+ * @param fir_ratio FIR decimation (1 to FFT_DECIM_MAX_FIR_RATIO)
+ * @param taps FIR length (odd, 3 to FFT_DECIM_MAX_TAPS)
+ * @return true if successful, false on invalid parameters
+ */
+bool fft_decimator_init(fft_decimator_t* decim, int cic_ratio, int fir_ratio, int taps);
+
+/**
+ * Clear the filter state (keeps the configuration)
+ * @param decim Decimator to reset
+ */
+void fft_decimator_reset(fft_decimator_t* decim);
+
+/**
+ * Filter and decimate a block of samples
+ * Input magnitude must stay below 2^27 so the CIC register cannot overflow
+ * @param decim Configured decimator
+ * @param input Input samples
+ * @param count Number of input samples
+ * @param output Output samples at the decimated rate, unity DC gain
+ *               (capacity count / (cic_ratio * fir_ratio) + 1)
+ * @return Number of output samples written
+ */
+int fft_decimator_process(fft_decimator_t* decim, const int32_t* input, int count, float* output);
+
+/**
+ * Get the total decimation ratio
+ * @param decim Configured decimator
+ * @return cic_ratio * fir_ratio
+ */
+int fft_decimator_get_ratio(const fft_decimator_t* decim);
+
+#endif // __FFT_DECIMATOR_H
@@ -0,0 +1,243 @@
+/*****************************************************************************
+* | File      	:   fft_distortion.c
+* | Author      :   PicoFFT Project
+* | Function    :   THD, THD+N, SNR, SINAD, SFDR and ENOB from one spectrum
+* | Info        :
+*   - The dBm array is window-corrected at the bin center; power summed over
+*     a tone's leakage bins is divided by the window ENBW, so levels do not
+*     depend on where the tone falls between bins
+*   - Noise under the excluded tone bins is filled in at the mean noise
+*     level of the remaining bins (DC excluded)
+*----------------
+******************************************************************************/
+
+#include "fft_distortion.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+// Bin classes (harmonic bins hold their order 2..FFT_DISTORTION_MAX_HARMONIC)
+#define FFT_DISTORTION_CLASS_NOISE 0
+#define FFT_DISTORTION_CLASS_FUNDAMENTAL 1
+#define FFT_DISTORTION_CLASS_DC 255
+
+#define FFT_DISTORTION_NOT_COUNTED -999.0f
+#define FFT_DISTORTION_MIN_POWER 1e-30f
+
+// Leakage half-width per window type: at least the main lobe half-width
+// plus one bin for off-bin tones (Kaiser-Bessel at beta 8.5: +/-2.9 bins)
+static const int8_t s_leakage_bins[FFT_WINDOW_TYPE_COUNT] = {
+    3,  // Rectangle (sidelobes decay slowly, off-bin tones leak further)
+    4,  // Hamming
+    5,  // Hann (sidelobes fall 18 dB/octave, a wider sum keeps them out of the noise)
+    5,  // Blackman
+    5,  // Blackman-Harris
+    5,  // Kaiser-Bessel
+    6   // Flat-Top
+};
+
+// Global distortion engine state
+static fft_distortion_state_t g_distortion = {0};
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Strongest bin in [first, last] (clamped to the spectrum)
+ */
+static int _fft_distortion_find_max(const float* spectrum_dbm, int bins, int first, int last) {
+    if (first < 0) first = 0;
+    if (last > bins - 1) last = bins - 1;
+    
+    int peak = first;
+    for (int k = first + 1; k <= last; k++) {
+        if (spectrum_dbm[k] > spectrum_dbm[peak]) peak = k;
+    }
+    return peak;
+}
+
+/**
+ * Claim the unowned leakage bins around a tone
+ * Overlapping ranges stay with the earlier claim (fundamental, then lower orders)
+ * @return false (nothing claimed) if the peak bin itself is already owned
+ */
+static bool _fft_distortion_claim(int bins, int center, int half_width, uint8_t tone_class) {
+    int first = center - half_width;
+    int last = center + half_width;
+    if (first < 0) first = 0;
+    if (last > bins - 1) last = bins - 1;
+    
+    if (g_distortion.bin_class[center] != FFT_DISTORTION_CLASS_NOISE) {
+        return false;
+    }
+    for (int k = first; k <= last; k++) {
+        if (g_distortion.bin_class[k] == FFT_DISTORTION_CLASS_NOISE) {
+            g_distortion.bin_class[k] = tone_class;
+        }
+    }
+    return true;
+}
+
+/**
+ * Ratio in dB with a floor for empty sums
+ */
+static float _fft_distortion_ratio_db(float numerator, float denominator) {
+    if (numerator < FFT_DISTORTION_MIN_POWER) numerator = FFT_DISTORTION_MIN_POWER;
+    if (denominator < FFT_DISTORTION_MIN_POWER) denominator = FFT_DISTORTION_MIN_POWER;
+    return 10.0f * log10f(numerator / denominator);
+}
+
+// ========================================
+// 🔧 Distortion Engine API Implementation
+// ========================================
+
+/**
+ * Configure the distortion engine
+ */
+bool fft_distortion_init(int max_harmonic, float fundamental_hz) {
+    if (max_harmonic < 2 || max_harmonic > FFT_DISTORTION_MAX_HARMONIC || fundamental_hz < 0.0f) {
+        printf("ERROR: Invalid distortion settings (harmonic %d, fundamental %.1f Hz)\n",
+               max_harmonic, fundamental_hz);
+        return false;
+    }
+    
+    memset(&g_distortion, 0, sizeof(g_distortion));
+    g_distortion.max_harmonic = max_harmonic;
+    g_distortion.fundamental_hz = fundamental_hz;
+    return true;
+}
+
+/**
+ * Measure one spectrum
+ */
+bool fft_distortion_analyze(const float* spectrum_dbm, int bins, float bin_width_hz) {
+    int lobe = fft_distortion_get_leakage_bins(fft_window_get_type());
+    if (spectrum_dbm == NULL || bins > FFT_DISTORTION_MAX_BINS || bins < 8 * lobe ||
+        g_distortion.max_harmonic == 0) {
+        return false;
+    }
+    fft_distortion_result_t* result = &g_distortion.result;
+    
+    // Pass 1 (dB only): fundamental peak, interpolated frequency, tone bins
+    int fundamental;
+    if (g_distortion.fundamental_hz > 0.0f) {
+        int expected = (int)(g_distortion.fundamental_hz / bin_width_hz + 0.5f);
+        fundamental = _fft_distortion_find_max(spectrum_dbm, bins, expected - lobe, expected + lobe);
+    } else {
+        fundamental = _fft_distortion_find_max(spectrum_dbm, bins, lobe + 1, bins - 1);
+    }
+    if (fundamental <= lobe || fundamental >= bins - 1) {
+        return false;  // Fundamental inside the DC region or at the band edge
+    }
+    
+    // Gaussian interpolation (parabola through the dB values)
+    float left = spectrum_dbm[fundamental - 1];
+    float center = spectrum_dbm[fundamental];
+    float right = spectrum_dbm[fundamental + 1];
+    float denominator = left - 2.0f * center + right;
+    float delta = (denominator < 0.0f) ? 0.5f * (left - right) / denominator : 0.0f;
+    if (delta > 0.5f) delta = 0.5f;
+    if (delta < -0.5f) delta = -0.5f;
+    result->fundamental_hz = ((float)fundamental + delta) * bin_width_hz;
+    
+    // A low fundamental keeps its full leakage range, DC gets what is left
+    memset(g_distortion.bin_class, FFT_DISTORTION_CLASS_NOISE, (size_t)bins);
+    _fft_distortion_claim(bins, fundamental, lobe, FFT_DISTORTION_CLASS_FUNDAMENTAL);
+    for (int k = 0; k <= lobe && g_distortion.bin_class[k] == FFT_DISTORTION_CLASS_NOISE; k++) {
+        g_distortion.bin_class[k] = FFT_DISTORTION_CLASS_DC;
+    }
+    
+    float sample_rate = 2.0f * (float)bins * bin_width_hz;
+    for (int order = 2; order <= FFT_DISTORTION_MAX_HARMONIC; order++) {
+        result->harmonic_dbc[order] = FFT_DISTORTION_NOT_COUNTED;
+    }
+    for (int order = 2; order <= g_distortion.max_harmonic; order++) {
+        // Fold into 0..fs/2 (ADC harmonics above Nyquist alias back)
+        float frequency = fmodf((float)order * result->fundamental_hz, sample_rate);
+        if (frequency > 0.5f * sample_rate) frequency = sample_rate - frequency;
+        int expected = (int)(frequency / bin_width_hz + 0.5f);
+        int peak = _fft_distortion_find_max(spectrum_dbm, bins, expected - 1, expected + 1);
+        if (_fft_distortion_claim(bins, peak, lobe, (uint8_t)order)) {
+            result->harmonic_dbc[order] = 0.0f;  // Counted, filled in below
+        }
+    }
+    
+    // Pass 2: linear power per class (one exp per bin)
+    float fundamental_power = 0.0f;
+    float harmonic_power[FFT_DISTORTION_MAX_HARMONIC + 1] = {0};
+    float noise_power = 0.0f;
+    float max_noise_bin = 0.0f;
+    int noise_bins = 0;
+    int dc_bins = 0;
+    for (int k = 0; k < bins; k++) {
+        uint8_t owner = g_distortion.bin_class[k];
+        if (owner == FFT_DISTORTION_CLASS_DC) {
+            dc_bins++;
+            continue;
+        }
+        float power = exp2f(spectrum_dbm[k] * 0.33219281f);  // 10^(dBm / 10)
+        if (owner == FFT_DISTORTION_CLASS_NOISE) {
+            noise_power += power;
+            noise_bins++;
+            if (power > max_noise_bin) max_noise_bin = power;
+        } else if (owner == FFT_DISTORTION_CLASS_FUNDAMENTAL) {
+            fundamental_power += power;
+        } else {
+            harmonic_power[owner] += power;
+        }
+    }
+    if (noise_bins > 0) {
+        noise_power *= (float)(bins - dc_bins) / (float)noise_bins;
+    }
+    
+    // Spur: strongest harmonic (summed) or noise bin (peak bin x ENBW = lobe sum)
+    float enbw = fft_window_get_enbw();
+    float total_harmonics = 0.0f;
+    float spur_power = max_noise_bin * enbw;
+    for (int order = 2; order <= g_distortion.max_harmonic; order++) {
+        if (result->harmonic_dbc[order] == FFT_DISTORTION_NOT_COUNTED) {
+            continue;
+        }
+        total_harmonics += harmonic_power[order];
+        result->harmonic_dbc[order] = _fft_distortion_ratio_db(harmonic_power[order], fundamental_power);
+        if (harmonic_power[order] > spur_power) spur_power = harmonic_power[order];
+    }
+    
+    result->fundamental_dbm = _fft_distortion_ratio_db(fundamental_power, enbw);
+    result->thd_db = _fft_distortion_ratio_db(total_harmonics, fundamental_power);
+    result->thd_percent = 100.0f * sqrtf(total_harmonics / (fundamental_power + FFT_DISTORTION_MIN_POWER));
+    result->thdn_db = _fft_distortion_ratio_db(total_harmonics + noise_power, fundamental_power);
+    result->snr_db = _fft_distortion_ratio_db(fundamental_power, noise_power);
+    result->sinad_db = -result->thdn_db;
+    result->sfdr_db = _fft_distortion_ratio_db(fundamental_power, spur_power);
+    result->enob_bits = (result->sinad_db - 1.76f) / 6.02f;
+    
+    g_distortion.measurement_count++;
+    g_distortion.result_ready = true;
+    return true;
+}
+
+/**
+ * Get the last measurement
+ */
+const fft_distortion_result_t* fft_distortion_get_result(void) {
+    return g_distortion.result_ready ? &g_distortion.result : NULL;
+}
+
+/**
+ * Get the number of spectra measured
+ */
+uint32_t fft_distortion_get_measurement_count(void) {
+    return g_distortion.measurement_count;
+}
+
+/**
+ * Get the leakage half-width used for a window
+ */
+int fft_distortion_get_leakage_bins(fft_window_type_t type) {
+    if (type < 0 || type >= FFT_WINDOW_TYPE_COUNT) {
+        return s_leakage_bins[FFT_WINDOW_FLATTOP];
+    }
+    return s_leakage_bins[type];
+}
@@ -0,0 +1,91 @@
+/*****************************************************************************
+* | File      	:   fft_distortion.h
+* | Author      :   PicoFFT Project
+* | Function    :   THD, THD+N, SNR, SINAD, SFDR and ENOB from one spectrum
+* | Info        :
+*   - Works on the dBm magnitude array of adc_sampling_process_fft(): no
+*     extra FFT, one pass to locate the tones and one to sum the powers
+*   - Fundamental auto-detected (strongest bin above DC) or configured
+*   - Fundamental, harmonics and DC are summed over a window-dependent
+*     leakage width; harmonics above fs/2 are folded back (aliased)
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_DISTORTION_H
+#define __FFT_DISTORTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "fft_window.h"
+
+// Distortion engine configuration
+#define FFT_DISTORTION_MAX_HARMONIC 16      // Highest harmonic order summed
+#define FFT_DISTORTION_MAX_BINS (FFT_WINDOW_MAX_SIZE / 2)
+
+// Measurement of one spectrum (ratios in dB, relative to the fundamental)
+typedef struct {
+    float fundamental_hz;                   // Interpolated fundamental frequency
+    float fundamental_dbm;                  // Fundamental power (leakage bins summed)
+    float thd_db;                           // Harmonics / fundamental
+    float thd_percent;
+    float thdn_db;                          // (Harmonics + noise) / fundamental
+    float snr_db;                           // Fundamental / noise (harmonics excluded)
+    float sinad_db;                         // Fundamental / (noise + harmonics)
+    float sfdr_db;                          // Fundamental / strongest spur (dBc, positive)
+    float enob_bits;                        // (SINAD - 1.76) / 6.02
+    float harmonic_dbc[FFT_DISTORTION_MAX_HARMONIC + 1]; // Per order (index 2..max), -999 if not counted
+} fft_distortion_result_t;
+
+// Distortion engine state
+typedef struct {
+    int max_harmonic;                       // Harmonics 2..max_harmonic are summed
+    float fundamental_hz;                   // Configured fundamental, 0 = auto-detect
+    uint8_t bin_class[FFT_DISTORTION_MAX_BINS]; // DC / fundamental / harmonic / noise per bin
+    fft_distortion_result_t result;
+    uint32_t measurement_count;
+    bool result_ready;
+} fft_distortion_state_t;
+
+// ========================================
+// 🔧 Distortion Engine API
+// ========================================
+
+/**
+ * Configure the distortion engine
+ * @param max_harmonic Highest harmonic order (2 to FFT_DISTORTION_MAX_HARMONIC)
+ * @param fundamental_hz Expected fundamental, 0 to use the strongest bin
+ * @return true if successful, false on invalid parameters
+ */
+bool fft_distortion_init(int max_harmonic, float fundamental_hz);
+
+/**
+ * Measure one spectrum
+ * The spectrum must be windowed with the active window at FFT size 2 * bins
+ * @param spectrum_dbm Magnitude spectrum in dBm (adc_sampling_get_magnitude_spectrum())
+ * @param bins Number of bins (FFT size / 2)
+ * @param bin_width_hz Bin spacing in Hz
+ * @return true if a fundamental was found and the result updated
+ */
+bool fft_distortion_analyze(const float* spectrum_dbm, int bins, float bin_width_hz);
+
+/**
+ * Get the last measurement
+ * @return Result, NULL if nothing was measured yet
+ */
+const fft_distortion_result_t* fft_distortion_get_result(void);
+
+/**
+ * Get the number of spectra measured
+ * @return Measurement count
+ */
+uint32_t fft_distortion_get_measurement_count(void);
+
+/**
+ * Get the leakage half-width used for a window
+ * @param type Window type
+ * @return Bins summed on each side of a tone's peak bin
+ */
+int fft_distortion_get_leakage_bins(fft_window_type_t type);
+
+#endif // __FFT_DISTORTION_H
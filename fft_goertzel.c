@@ -0,0 +1,253 @@
+/*****************************************************************************
+* | File      	:   fft_goertzel.c
+* | Author      :   PicoFFT Project
+* | Function    :   Goertzel tracker bank for a few fixed frequencies
+* | Info        :
+*   - Cost is one multiply and two adds per tone per sample, so a handful of
+*     tones is far cheaper than a full FFT (see tools/goertzel_bench.c)
+*   - Runs in float in every build (the recursion needs the headroom)
+*   - Levels use the main spectrum's dBm convention
+*----------------
+******************************************************************************/
+
+#include "fft_goertzel.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FFT_GOERTZEL_RUN 64                 // Samples windowed per pass over the tones
+#define FFT_GOERTZEL_LANES 4                // Tones advanced together per pass
+
+// Global Goertzel bank
+static fft_goertzel_bank_t g_goertzel = {0};
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Recompute the dB offset for the active window
+ * |X| of a tone with amplitude A is A * block_size * CG / 2, so this is the
+ * main path's float offset with N = block_size
+ */
+static void _fft_goertzel_update_db_offset(void) {
+    const fft_window_info_t* info = fft_window_get_info_for_size(g_goertzel.block_size);
+    float correction = (info != NULL && info->coherent_gain > 0.0f) ? 1.0f / info->coherent_gain : 1.0f;
+    float amplitude_scale = ADC_SAMPLE_VOLTAGE_PER_LSB * correction /
+                            ((float)g_goertzel.block_size * DB_REFERENCE_VOLTAGE_0DBM);
+    
+    fft_db_stage_configure(&g_goertzel.db_stage, 20.0f * log10f(amplitude_scale));
+    g_goertzel.window_type = fft_window_get_type();
+}
+
+/**
+ * Close the current block: publish |X|^2 and dBm, restart the recursions
+ */
+static void _fft_goertzel_finish_block(void) {
+    for (int t = 0; t < g_goertzel.tone_count; t++) {
+        fft_goertzel_tone_t* tone = &g_goertzel.tones[t];
+        g_goertzel.power[t] = tone->s1 * tone->s1 + tone->s2 * tone->s2 -
+                              tone->coeff * tone->s1 * tone->s2;
+        tone->s1 = 0.0f;
+        tone->s2 = 0.0f;
+    }
+    
+    if (g_goertzel.window_type != fft_window_get_type()) {
+        _fft_goertzel_update_db_offset();
+    }
+    fft_db_stage_convert_power(&g_goertzel.db_stage, g_goertzel.power,
+                               g_goertzel.dbm, g_goertzel.tone_count);
+    
+    g_goertzel.dc_offset = (float)g_goertzel.dc_sum / g_goertzel.block_size;
+    g_goertzel.dc_sum = 0;
+    g_goertzel.block_pos = 0;
+    g_goertzel.block_count++;
+    g_goertzel.results_ready = true;
+}
+
+// ========================================
+// 🔧 Goertzel Bank API Implementation
+// ========================================
+
+/**
+ * Initialize the bank
+ */
+bool fft_goertzel_init(const float* frequencies_hz, int count, int block_size, float sample_rate) {
+    memset(&g_goertzel, 0, sizeof(g_goertzel));
+    
+    const float* window = fft_window_get_coefficients_for_size(block_size);
+    if (window == NULL || sample_rate <= 0.0f) {
+        printf("ERROR: No window table for Goertzel block size %d\n", block_size);
+        return false;
+    }
+    
+    g_goertzel.window = window;
+    g_goertzel.block_size = block_size;
+    g_goertzel.sample_rate = sample_rate;
+    g_goertzel.dc_offset = (float)ADC_SAMPLE_MIDSCALE;
+    _fft_goertzel_update_db_offset();
+    
+    return fft_goertzel_set_frequencies(frequencies_hz, count);
+}
+
+/**
+ * Replace the tracked frequencies
+ */
+bool fft_goertzel_set_frequencies(const float* frequencies_hz, int count) {
+    if (frequencies_hz == NULL || count < 1 || count > FFT_GOERTZEL_MAX_TONES ||
+        g_goertzel.block_size == 0) {
+        printf("ERROR: Invalid Goertzel tone count %d (max %d)\n", count, FFT_GOERTZEL_MAX_TONES);
+        return false;
+    }
+    for (int t = 0; t < count; t++) {
+        if (frequencies_hz[t] < 0.0f || frequencies_hz[t] > g_goertzel.sample_rate / 2.0f) {
+            printf("ERROR: Goertzel frequency %.1f Hz out of range\n", frequencies_hz[t]);
+            return false;
+        }
+    }
+    
+    for (int t = 0; t < count; t++) {
+        double w = 2.0 * M_PI * frequencies_hz[t] / g_goertzel.sample_rate;
+        g_goertzel.tones[t].frequency_hz = frequencies_hz[t];
+        g_goertzel.tones[t].coeff = (float)(2.0 * cos(w));
+    }
+    g_goertzel.tone_count = count;
+    fft_goertzel_reset();
+    return true;
+}
+
+/**
+ * Discard the partial block and the last results
+ */
+void fft_goertzel_reset(void) {
+    for (int t = 0; t < g_goertzel.tone_count; t++) {
+        g_goertzel.tones[t].s1 = 0.0f;
+        g_goertzel.tones[t].s2 = 0.0f;
+    }
+    g_goertzel.block_pos = 0;
+    g_goertzel.dc_sum = 0;
+    g_goertzel.results_ready = false;
+}
+
+/**
+ * Run every tone's recursion over a block of raw ADC samples
+ * Works in runs of up to FFT_GOERTZEL_RUN samples: the windowed run is formed
+ * once, then each tone iterates over it with its state in registers
+ */
+int fft_goertzel_process(const adc_sample_t* samples, int count) {
+    const int tone_count = g_goertzel.tone_count;
+    float windowed[FFT_GOERTZEL_RUN];
+    int blocks = 0;
+    
+    if (samples == NULL || tone_count == 0) {
+        return 0;
+    }
+    
+    int i = 0;
+    while (i < count) {
+        int run = g_goertzel.block_size - g_goertzel.block_pos;
+        if (run > count - i) run = count - i;
+        if (run > FFT_GOERTZEL_RUN) run = FFT_GOERTZEL_RUN;
+    
+        const float* window = &g_goertzel.window[g_goertzel.block_pos];
+        const float dc_offset = g_goertzel.dc_offset;
+        uint32_t dc_sum = 0;
+        for (int n = 0; n < run; n++) {
+            dc_sum += samples[i + n];
+            windowed[n] = ((float)samples[i + n] - dc_offset) * window[n];
+        }
+        g_goertzel.dc_sum += dc_sum;
+    
+        // s[n] = x[n] + 2cos(w) * s[n-1] - s[n-2]; full groups of
+        // FFT_GOERTZEL_LANES tones keep independent recursions in flight
+        // (a single chain is latency bound), leftovers run one at a time
+        int t = 0;
+        for (; t + FFT_GOERTZEL_LANES <= tone_count; t += FFT_GOERTZEL_LANES) {
+            fft_goertzel_tone_t* tones = &g_goertzel.tones[t];
+            float coeff[FFT_GOERTZEL_LANES];
+            float s1[FFT_GOERTZEL_LANES];
+            float s2[FFT_GOERTZEL_LANES];
+            for (int k = 0; k < FFT_GOERTZEL_LANES; k++) {
+                coeff[k] = tones[k].coeff;
+                s1[k] = tones[k].s1;
+                s2[k] = tones[k].s2;
+            }
+            for (int n = 0; n < run; n++) {
+                const float x = windowed[n];
+                for (int k = 0; k < FFT_GOERTZEL_LANES; k++) {
+                    float s0 = x + coeff[k] * s1[k] - s2[k];
+                    s2[k] = s1[k];
+                    s1[k] = s0;
+                }
+            }
+            for (int k = 0; k < FFT_GOERTZEL_LANES; k++) {
+                tones[k].s1 = s1[k];
+                tones[k].s2 = s2[k];
+            }
+        }
+        for (; t < tone_count; t++) {
+            fft_goertzel_tone_t* tone = &g_goertzel.tones[t];
+            const float coeff = tone->coeff;
+            float s1 = tone->s1;
+            float s2 = tone->s2;
+            for (int n = 0; n < run; n++) {
+                float s0 = windowed[n] + coeff * s1 - s2;
+                s2 = s1;
+                s1 = s0;
+            }
+            tone->s1 = s1;
+            tone->s2 = s2;
+        }
+    
+        i += run;
+        g_goertzel.block_pos += run;
+        if (g_goertzel.block_pos == g_goertzel.block_size) {
+            _fft_goertzel_finish_block();
+            blocks++;
+        }
+    }
+    
+    return blocks;
+}
+
+/**
+ * Get the tone levels of the last completed block
+ */
+const float* fft_goertzel_get_dbm(void) {
+    return g_goertzel.results_ready ? g_goertzel.dbm : NULL;
+}
+
+/**
+ * Get the number of tracked tones
+ */
+int fft_goertzel_get_tone_count(void) {
+    return g_goertzel.tone_count;
+}
+
+/**
+ * Get a tracked frequency
+ */
+float fft_goertzel_get_frequency(int index) {
+    if (index < 0 || index >= g_goertzel.tone_count) {
+        return 0.0f;
+    }
+    return g_goertzel.tones[index].frequency_hz;
+}
+
+/**
+ * Get the result rate
+ */
+float fft_goertzel_get_update_rate(void) {
+    return (g_goertzel.block_size > 0) ? g_goertzel.sample_rate / g_goertzel.block_size : 0.0f;
+}
+
+/**
+ * Get the number of completed blocks
+ */
+uint32_t fft_goertzel_get_block_count(void) {
+    return g_goertzel.block_count;
+}
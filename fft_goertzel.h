@@ -0,0 +1,119 @@
+/*****************************************************************************
+* | File      	:   fft_goertzel.h
+* | Author      :   PicoFFT Project
+* | Function    :   Goertzel tracker bank for a few fixed frequencies
+* | Info        :
+*   - Second-order Goertzel recursion per tone, updated sample by sample
+*   - Windowed blocks from the shared window tables, any (non-bin) frequency
+*   - Reports dBm per block: fs / block size updates per second
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_GOERTZEL_H
+#define __FFT_GOERTZEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "fft_db.h"
+#include "fft_window.h"
+#include "adc_convert.h"
+
+// Goertzel bank configuration
+#define FFT_GOERTZEL_MAX_TONES 32
+
+// One tracked tone
+typedef struct {
+    float frequency_hz;                     // Tracked frequency
+    float coeff;                            // 2*cos(w)
+    float s1;                               // s[n-1]
+    float s2;                               // s[n-2]
+} fft_goertzel_tone_t;
+
+// Goertzel bank state
+typedef struct {
+    fft_goertzel_tone_t tones[FFT_GOERTZEL_MAX_TONES];
+    int tone_count;
+    int block_size;                         // Samples per result (has a window table)
+    int block_pos;                          // Samples in the current block
+    float sample_rate;
+    float dc_offset;                        // Mean of the previous block (removed from the next)
+    uint32_t dc_sum;                        // Raw sample sum of the current block
+    const float* window;                    // Window table for block_size
+    fft_window_type_t window_type;          // Window the dB offset was computed for
+    fft_db_stage_t db_stage;                // Own offset (block size differs from the FFT)
+    float power[FFT_GOERTZEL_MAX_TONES];    // |X|^2 of the last block
+    float dbm[FFT_GOERTZEL_MAX_TONES];      // Last block in dBm (window-corrected)
+    uint32_t block_count;                   // Completed blocks
+    bool results_ready;
+} fft_goertzel_bank_t;
+
+// ========================================
+// 🔧 Goertzel Bank API
+// ========================================
+
+/**
+ * Initialize the bank
+ * Requires fft_window_init() with block_size among the table sizes
+ * @param frequencies_hz Tracked frequencies (0 to fs/2)
+ * @param count Number of tones (1 to FFT_GOERTZEL_MAX_TONES)
+ * @param block_size Samples per result (e.g. 256 = 500 updates/s at 128kHz)
+ * @param sample_rate Sampling rate in Hz
+ * @return true if successful, false on invalid parameters
+ */
+bool fft_goertzel_init(const float* frequencies_hz, int count, int block_size, float sample_rate);
+
+/**
+ * Replace the tracked frequencies (restarts the current block)
+ * @param frequencies_hz Tracked frequencies (0 to fs/2)
+ * @param count Number of tones (1 to FFT_GOERTZEL_MAX_TONES)
+ * @return true if successful, false on invalid parameters
+ */
+bool fft_goertzel_set_frequencies(const float* frequencies_hz, int count);
+
+/**
+ * Discard the partial block and the last results
+ * (fft_goertzel_get_dbm() returns NULL until the next block completes)
+ */
+void fft_goertzel_reset(void);
+
+/**
+ * Run every tone's recursion over a block of raw ADC samples
+ * @param samples Raw ADC samples (adc_sample_t), contiguous in time
+ * @param count Number of samples
+ * @return Number of blocks completed (results refreshed if > 0)
+ */
+int fft_goertzel_process(const adc_sample_t* samples, int count);
+
+/**
+ * Get the tone levels of the last completed block
+ * @return Pointer to tone_count levels in dBm, NULL if no block completed yet
+ */
+const float* fft_goertzel_get_dbm(void);
+
+/**
+ * Get the number of tracked tones
+ * @return Tone count
+ */
+int fft_goertzel_get_tone_count(void);
+
+/**
+ * Get a tracked frequency
+ * @param index Tone index (0 to tone_count-1)
+ * @return Frequency in Hz, 0 on invalid index
+ */
+float fft_goertzel_get_frequency(int index);
+
+/**
+ * Get the result rate
+ * @return Blocks per second
+ */
+float fft_goertzel_get_update_rate(void);
+
+/**
+ * Get the number of completed blocks
+ * @return Block count since initialization
+ */
+uint32_t fft_goertzel_get_block_count(void);
+
+#endif // __FFT_GOERTZEL_H
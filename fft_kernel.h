@@ -0,0 +1,55 @@
+/*****************************************************************************
+* | File      	:   fft_kernel.h
+* | Author      :   PicoFFT Project
+* | Function    :   Build-time specialized FFT kernels (generated backend)
+* | Info        :
+*   - Kernels come from tools/gen_fft_kernel.py (fft_kernel_generated.c in
+*     the build tree), selected with -DPICOFFT_FFT_BACKEND=generated
+*   - Same input/output layout as kiss_fftr (or kiss_fft without
+*     FFT_REAL_INPUT_ENABLED), so they drop into the plan registry
+*   - Float builds only; sizes without a kernel keep their kiss_fft plan
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_KERNEL_H
+#define __FFT_KERNEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config_settings.h"
+#include "kiss_fft.h"
+
+#ifdef FFT_BACKEND_GENERATED
+#include "fft_kernel_generated.h"
+#endif
+
+// Kernel input: real samples, or complex samples with zero imaginary part
+#if FFT_REAL_INPUT_ENABLED
+typedef kiss_fft_scalar fft_kernel_input_t;
+#else
+typedef kiss_fft_cpx fft_kernel_input_t;
+#endif
+
+// Forward transform of one fixed size (bins 0..N/2 for real input); input
+// and output may be the same buffer (sized for the output)
+typedef void (*fft_kernel_fn)(const fft_kernel_input_t* input, kiss_fft_cpx* output);
+
+// Generated kernel descriptor
+typedef struct {
+    int size;                   // FFT size (points)
+    fft_kernel_fn forward;      // Specialized forward transform
+    uint32_t rodata_bytes;      // Const twiddle and index tables (flash)
+} fft_kernel_t;
+
+// ========================================
+// 🔧 Generated Kernel API
+// ========================================
+
+/**
+ * Find the generated kernel for a size
+ * @param size FFT size
+ * @return Kernel descriptor, NULL if the size was not generated
+ */
+const fft_kernel_t* fft_kernel_find(int size);
+
+#endif // __FFT_KERNEL_H
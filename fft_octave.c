@@ -0,0 +1,455 @@
+/*****************************************************************************
+* | File      	:   fft_octave.c
+* | Author      :   PicoFFT Project
+* | Function    :   Constant-Q (octave cascade) spectrum for the log frequency axis
+* | Info        :
+*   - 55-tap Blackman half-band per octave: flat to 0.2, stopband from 0.3 x
+*     input rate; every other tap is zero, so 14 multiplies per output
+*   - The cascade costs < 1 half-band output per input sample in total;
+*     the stage FFTs run only when the display asks for columns
+*   - Levels use the wideband dBm scaling: the half-bands have unity
+*     passband gain, so a tone keeps its ADC amplitude in every stage
+*----------------
+******************************************************************************/
+
+#include "fft_octave.h"
+#include "fft_window.h"
+#include "fft_arena.h"
+#include "adc_sampling.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FFT_OCTAVE_HALFBAND_CENTER ((FFT_OCTAVE_HALFBAND_TAPS - 1) / 2)
+
+// Stage buffers (carved from the arena on first init)
+static fft_octave_buffers_t* s_octave_buffers = NULL;
+
+// Global octave cascade state
+static fft_octave_state_t g_octave = {0};
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Windowed half-band design (cold path only)
+ * Ideal low-pass at a quarter of the input rate, Blackman window; the odd
+ * taps are scaled so the DC gain is exactly 1 with the 0.5 center tap
+ */
+static void _fft_octave_design_halfband(void) {
+    double sum = 0.0;
+    
+    for (int j = 0; j < FFT_OCTAVE_HALFBAND_PAIRS; j++) {
+        int offset = 2 * j + 1;
+        double ideal = sin(M_PI * offset / 2.0) / (M_PI * offset);
+        double phase = 2.0 * M_PI * (FFT_OCTAVE_HALFBAND_CENTER + offset) / (FFT_OCTAVE_HALFBAND_TAPS - 1);
+        double window = 0.42 - 0.5 * cos(phase) + 0.08 * cos(2.0 * phase);
+        g_octave.halfband_coeffs[j] = (float)(ideal * window);
+        sum += 2.0 * ideal * window;
+    }
+    
+    for (int j = 0; j < FFT_OCTAVE_HALFBAND_PAIRS; j++) {
+        g_octave.halfband_coeffs[j] = (float)(g_octave.halfband_coeffs[j] * 0.5 / sum);
+    }
+}
+
+/**
+ * Recompute the dB offset for the active window
+ * Same scaling as fft_baseband.c, less the history scale
+ */
+static void _fft_octave_update_db_offset(void) {
+    const fft_window_info_t* info = fft_window_get_info_for_size(FFT_OCTAVE_FFT_SIZE);
+    float correction = (info != NULL && info->coherent_gain > 0.0f) ? 1.0f / info->coherent_gain : 1.0f;
+    
+#ifdef FIXED_POINT
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT /
+                            ((float)(1 << ADC_FIXED_INPUT_SHIFT) * DB_REFERENCE_VOLTAGE_0DBM);
+    g_octave.input_scale = (float)(1 << ADC_FIXED_INPUT_SHIFT) / FFT_OCTAVE_HISTORY_SCALE;
+#else
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT /
+                            ((float)FFT_OCTAVE_FFT_SIZE * DB_REFERENCE_VOLTAGE_0DBM);
+    g_octave.input_scale = 1.0f / FFT_OCTAVE_HISTORY_SCALE;
+#endif
+    amplitude_scale *= correction;
+    
+    fft_db_stage_configure(&g_octave.db_stage, 20.0f * log10f(amplitude_scale));
+    g_octave.window_type = fft_window_get_type();
+}
+
+/**
+ * Append samples to one stage history (int16 in 1/FFT_OCTAVE_HISTORY_SCALE LSB)
+ */
+static void _fft_octave_store(int stage, const float* samples, int count) {
+    int16_t* history = s_octave_buffers->history[stage];
+    int pos = g_octave.history_pos[stage];
+    
+    for (int i = 0; i < count; i++) {
+        float value = samples[i] * FFT_OCTAVE_HISTORY_SCALE;
+        if (value > 32767.0f) value = 32767.0f;
+        if (value < -32767.0f) value = -32767.0f;
+        history[pos] = (int16_t)lrintf(value);
+        if (++pos == FFT_OCTAVE_FFT_SIZE) {
+            pos = 0;
+        }
+    }
+    g_octave.history_pos[stage] = pos;
+    
+    g_octave.history_filled[stage] += count;
+    if (g_octave.history_filled[stage] > FFT_OCTAVE_FFT_SIZE) {
+        g_octave.history_filled[stage] = FFT_OCTAVE_FFT_SIZE;
+    }
+}
+
+/**
+ * Half-band 2:1 decimation from stage - 1 to stage
+ * @return Number of outputs written
+ */
+static int _fft_octave_halfband(int stage, const float* input, int count, float* output) {
+    const int filter = stage - 1;
+    float* history = s_octave_buffers->halfband[filter];
+    const float* coeffs = g_octave.halfband_coeffs;
+    int pos = g_octave.halfband_pos[filter];
+    int phase = g_octave.halfband_phase[filter];
+    int outputs = 0;
+    
+    for (int i = 0; i < count; i++) {
+        history[pos] = input[i];
+        history[pos + FFT_OCTAVE_HALFBAND_TAPS] = input[i];
+        if (++pos == FFT_OCTAVE_HALFBAND_TAPS) {
+            pos = 0;
+        }
+        if (++phase < 2) {
+            continue;
+        }
+        phase = 0;
+    
+        // Oldest sample first; the zero even-offset taps are skipped
+        const float* x = &history[pos + FFT_OCTAVE_HALFBAND_CENTER];
+        float acc = 0.5f * x[0];
+        for (int j = 0; j < FFT_OCTAVE_HALFBAND_PAIRS; j++) {
+            acc += coeffs[j] * (x[-(2 * j + 1)] + x[2 * j + 1]);
+        }
+        output[outputs++] = acc;
+    }
+    
+    g_octave.halfband_pos[filter] = pos;
+    g_octave.halfband_phase[filter] = phase;
+    return outputs;
+}
+
+/**
+ * Window one stage history and compute its dBm spectrum in the work buffer
+ */
+static const float* _fft_octave_stage_spectrum(int stage, const float* window) {
+    const int16_t* history = s_octave_buffers->history[stage];
+    
+    // Oldest sample first (history is full, so it starts at the write position)
+    int pos = g_octave.history_pos[stage];
+    for (int i = 0; i < FFT_OCTAVE_FFT_SIZE; i++) {
+        float value = (float)history[pos] * window[i] * g_octave.input_scale;
+#ifdef FIXED_POINT
+        const float max_scalar = (float)((1u << (FIXED_POINT - 1)) - 1);
+        if (value > max_scalar) value = max_scalar;
+        if (value < -max_scalar) value = -max_scalar;
+        kiss_fft_scalar x = (kiss_fft_scalar)lrintf(value);
+#else
+        kiss_fft_scalar x = value;
+#endif
+#if FFT_REAL_INPUT_ENABLED
+        s_octave_buffers->fft_input[i] = x;
+#else
+        s_octave_buffers->fft_input[i].r = x;
+        s_octave_buffers->fft_input[i].i = 0;
+#endif
+        if (++pos == FFT_OCTAVE_FFT_SIZE) {
+            pos = 0;
+        }
+    }
+    
+    // dBm in place over the bins (float k is written after bin k was read)
+    float* magnitude = (float*)s_octave_buffers->fft_output;
+    fft_plan_forward(g_octave.plan, s_octave_buffers->fft_input, s_octave_buffers->fft_output);
+    fft_db_stage_convert_spectrum(&g_octave.db_stage, s_octave_buffers->fft_output, magnitude,
+                                  FFT_OCTAVE_BINS);
+    return magnitude;
+}
+
+/**
+ * Log axis position as fft_streaming_display_freq_to_position() computes it
+ * (benchmark reference for the per-bin remap)
+ */
+static float _fft_octave_remap_position(float freq_hz, float f_min, float f_max) {
+    float log_freq = log10f(freq_hz);
+    float log_min = log10f(f_min);
+    float log_max = log10f(f_max);
+    return (log_freq - log_min) / (log_max - log_min);
+}
+
+// ========================================
+// 🔧 Octave Cascade API Implementation
+// ========================================
+
+/**
+ * Initialize the cascade and map the display columns onto it
+ */
+bool fft_octave_init(float sample_rate, float f_min, float f_max, int columns) {
+    if (sample_rate <= 0.0f || f_min <= 0.0f || f_max <= f_min ||
+        columns < 1 || columns > FFT_OCTAVE_MAX_COLUMNS ||
+        FFT_OCTAVE_STAGES < 2 || FFT_OCTAVE_STAGES > FFT_OCTAVE_MAX_STAGES) {
+        printf("ERROR: Invalid octave cascade settings (%d stages, %.0f-%.0f Hz, %d columns)\n",
+               FFT_OCTAVE_STAGES, f_min, f_max, columns);
+        return false;
+    }
+    
+    memset(&g_octave, 0, sizeof(g_octave));
+    
+    g_octave.plan = fft_plan_find(FFT_OCTAVE_FFT_SIZE);
+    if (g_octave.plan == NULL || fft_window_get_coefficients_for_size(FFT_OCTAVE_FFT_SIZE) == NULL) {
+        printf("ERROR: No cached plan/window for octave FFT size %d\n", FFT_OCTAVE_FFT_SIZE);
+        return false;
+    }
+    
+    // The lowest stage must reach the left display edge
+    float lowest_hz = FFT_OCTAVE_BAND_LOW * sample_rate / (float)(1 << (FFT_OCTAVE_STAGES - 1));
+    if (lowest_hz > f_min) {
+        printf("ERROR: %d octave stages reach down to %.0f Hz, the display starts at %.0f Hz\n",
+               FFT_OCTAVE_STAGES, lowest_hz, f_min);
+        return false;
+    }
+    
+    if (s_octave_buffers == NULL) {
+        s_octave_buffers = fft_arena_alloc(sizeof(fft_octave_buffers_t), "fft_octave");
+        if (s_octave_buffers == NULL) {
+            return false;
+        }
+    }
+    g_octave.buffers = s_octave_buffers;
+    g_octave.sample_rate = sample_rate;
+    g_octave.f_min = f_min;
+    g_octave.f_max = f_max;
+    g_octave.column_count = columns;
+    
+    // Column map: the highest-rate stage whose alias-free octave holds the
+    // column's upper edge, then the bins whose centers fall into the column
+    float ratio = f_max / f_min;
+    for (int c = 0; c < columns; c++) {
+        float f_lo = f_min * powf(ratio, (float)c / (float)columns);
+        float f_hi = f_min * powf(ratio, (float)(c + 1) / (float)columns);
+    
+        int stage = (int)floorf(log2f(FFT_OCTAVE_BAND_HIGH * sample_rate / f_hi));
+        if (stage < 0) stage = 0;
+        if (stage > FFT_OCTAVE_STAGES - 1) stage = FFT_OCTAVE_STAGES - 1;
+        float bin_width = fft_octave_get_bin_width(stage);
+    
+        int first = (int)ceilf(f_lo / bin_width);
+        int last = (int)ceilf(f_hi / bin_width) - 1;
+        if (last < first) {
+            first = last = (int)(sqrtf(f_lo * f_hi) / bin_width + 0.5f);  // Column narrower than a bin
+        } else {
+            g_octave.resolved_columns++;
+        }
+        if (first < 1) first = 1;
+        if (last > FFT_OCTAVE_BINS - 1) last = FFT_OCTAVE_BINS - 1;
+        if (first > last) first = last;
+        s_octave_buffers->columns[c].first = (uint8_t)first;
+        s_octave_buffers->columns[c].last = (uint8_t)last;
+    
+        // Columns rise in frequency, stages fall: each stage owns one run
+        if (g_octave.column_end[stage] == 0) {
+            g_octave.column_begin[stage] = c;
+        }
+        g_octave.column_end[stage] = c + 1;
+    }
+    
+    _fft_octave_design_halfband();
+    _fft_octave_update_db_offset();
+    g_octave.initialized = true;
+    fft_octave_reset();
+    return true;
+}
+
+/**
+ * Discard filter state and stage histories
+ */
+void fft_octave_reset(void) {
+    if (!g_octave.initialized) {
+        return;
+    }
+    memset(s_octave_buffers->history, 0, sizeof(s_octave_buffers->history));
+    memset(s_octave_buffers->halfband, 0, sizeof(s_octave_buffers->halfband));
+    memset(g_octave.history_pos, 0, sizeof(g_octave.history_pos));
+    memset(g_octave.history_filled, 0, sizeof(g_octave.history_filled));
+    memset(g_octave.halfband_pos, 0, sizeof(g_octave.halfband_pos));
+    memset(g_octave.halfband_phase, 0, sizeof(g_octave.halfband_phase));
+}
+
+/**
+ * Feed raw ADC samples through the decimator chain
+ */
+void fft_octave_process(const adc_sample_t* samples, int count) {
+    float block_a[FFT_OCTAVE_CHUNK];
+    float block_b[FFT_OCTAVE_CHUNK / 2 + 1];
+    
+    if (!g_octave.initialized || samples == NULL) {
+        return;
+    }
+    
+    for (int start = 0; start < count; start += FFT_OCTAVE_CHUNK) {
+        int chunk = count - start;
+        if (chunk > FFT_OCTAVE_CHUNK) chunk = FFT_OCTAVE_CHUNK;
+    
+        for (int i = 0; i < chunk; i++) {
+            block_a[i] = (float)ADC_SAMPLE_CENTER(samples[start + i]);
+        }
+    
+        // Each stage stores its block and halves it for the next (ping-pong)
+        float* input = block_a;
+        float* output = block_b;
+        for (int stage = 0; stage < FFT_OCTAVE_STAGES && chunk > 0; stage++) {
+            _fft_octave_store(stage, input, chunk);
+            if (stage + 1 < FFT_OCTAVE_STAGES) {
+                chunk = _fft_octave_halfband(stage + 1, input, chunk, output);
+                float* swap = input;
+                input = output;
+                output = swap;
+            }
+        }
+    }
+}
+
+/**
+ * Compute one constant-Q column spectrum
+ */
+bool fft_octave_get_columns(float* column_dbm) {
+    if (!g_octave.initialized || column_dbm == NULL) {
+        return false;
+    }
+    for (int stage = 0; stage < FFT_OCTAVE_STAGES; stage++) {
+        if (g_octave.column_end[stage] > 0 && g_octave.history_filled[stage] < FFT_OCTAVE_FFT_SIZE) {
+            return false;  // Lowest stages fill 2x slower per octave
+        }
+    }
+    
+    if (g_octave.window_type != fft_window_get_type()) {
+        _fft_octave_update_db_offset();
+    }
+    const float* window = fft_window_get_coefficients_for_size(FFT_OCTAVE_FFT_SIZE);
+    
+    for (int stage = 0; stage < FFT_OCTAVE_STAGES; stage++) {
+        if (g_octave.column_end[stage] == 0) {
+            continue;  // No column in this octave
+        }
+        const float* magnitude = _fft_octave_stage_spectrum(stage, window);
+    
+        for (int c = g_octave.column_begin[stage]; c < g_octave.column_end[stage]; c++) {
+            const fft_octave_column_t* column = &s_octave_buffers->columns[c];
+            float level = magnitude[column->first];
+            for (int bin = column->first + 1; bin <= column->last; bin++) {
+                if (magnitude[bin] > level) level = magnitude[bin];
+            }
+            column_dbm[c] = level;
+        }
+    }
+    
+    g_octave.update_count++;
+    return true;
+}
+
+/**
+ * Get the bin spacing of one stage
+ */
+float fft_octave_get_bin_width(int stage) {
+    if (stage < 0 || stage >= FFT_OCTAVE_STAGES) {
+        return 0.0f;
+    }
+    return g_octave.sample_rate / (float)((1 << stage) * FFT_OCTAVE_FFT_SIZE);
+}
+
+/**
+ * Get the number of column spectra computed
+ */
+uint32_t fft_octave_get_update_count(void) {
+    return g_octave.update_count;
+}
+
+/**
+ * Time the per-bin log remap against the cascade
+ */
+bool fft_octave_benchmark(float* column_dbm, int fft_size, int updates) {
+    if (!g_octave.initialized || column_dbm == NULL || fft_size < 2 || updates < 1) {
+        printf("ERROR: Octave benchmark needs an initialized cascade\n");
+        return false;
+    }
+    const int columns = g_octave.column_count;
+    const float f_min = g_octave.f_min;
+    const float f_max = g_octave.f_max;
+    const int samples_per_update = (int)(g_octave.sample_rate / (float)TARGET_FPS);
+    
+    // Per-bin remap of the linear spectrum (levels are synthetic: the cost is
+    // the frequency, log position and column max per bin)
+    int remap_filled = 0;
+    int64_t remap_us = 0;
+    for (int u = 0; u < updates; u++) {
+        for (int c = 0; c < columns; c++) {
+            column_dbm[c] = FFT_DB_FLOOR;
+        }
+        absolute_time_t start = get_absolute_time();
+        for (int bin = 1; bin < fft_size / 2; bin++) {
+            float bin_freq = (float)bin * g_octave.sample_rate / (float)fft_size;
+            if (bin_freq < f_min || bin_freq > f_max) continue;
+            int col = (int)(_fft_octave_remap_position(bin_freq, f_min, f_max) * (float)columns);
+            if (col < 0) col = 0;
+            if (col >= columns) col = columns - 1;
+            float level = (float)(bin & 63) - 100.0f;
+            if (level > column_dbm[col]) column_dbm[col] = level;
+        }
+        remap_us += absolute_time_diff_us(start, get_absolute_time());
+    }
+    for (int c = 0; c < columns; c++) {
+        if (column_dbm[c] > FFT_DB_FLOOR) remap_filled++;
+    }
+    
+    // Cascade: one update's worth of noise input, then the column spectrum
+    adc_sample_t noise[FFT_OCTAVE_CHUNK];
+    uint32_t lcg = 12345u;
+    for (int i = 0; i < FFT_OCTAVE_CHUNK; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        noise[i] = (adc_sample_t)(ADC_SAMPLE_MIDSCALE + (((int32_t)(lcg >> 22) - 512) >> ADC_SAMPLE_SHIFT));
+    }
+    fft_octave_reset();
+    for (int i = 0; i < (FFT_OCTAVE_FFT_SIZE << (FFT_OCTAVE_STAGES - 1)); i += FFT_OCTAVE_CHUNK) {
+        fft_octave_process(noise, FFT_OCTAVE_CHUNK);  // Fill every stage first
+    }
+    int64_t decimate_us = 0;
+    int64_t columns_us = 0;
+    for (int u = 0; u < updates; u++) {
+        absolute_time_t start = get_absolute_time();
+        for (int i = 0; i < samples_per_update; i += FFT_OCTAVE_CHUNK) {
+            fft_octave_process(noise, FFT_OCTAVE_CHUNK);
+        }
+        absolute_time_t middle = get_absolute_time();
+        fft_octave_get_columns(column_dbm);
+        decimate_us += absolute_time_diff_us(start, middle);
+        columns_us += absolute_time_diff_us(middle, get_absolute_time());
+    }
+    fft_octave_reset();
+    g_octave.update_count = 0;
+    
+    float update_us = 1000000.0f / (float)TARGET_FPS;
+    printf("=== Log Frequency Axis Cost (%d updates, %d columns %.0f-%.0f Hz) ===\n",
+           updates, columns, f_min, f_max);
+    printf("  Per-bin remap (%d-pt FFT):   %8.1f us/update, %3d/%d columns hold a bin\n",
+           fft_size, (float)remap_us / (float)updates, remap_filled, columns);
+    printf("  Octave cascade (%d x %d-pt): %8.1f us/update decimation (%.1f%% load)\n",
+           FFT_OCTAVE_STAGES, FFT_OCTAVE_FFT_SIZE, (float)decimate_us / (float)updates,
+           100.0f * (float)decimate_us / ((float)updates * update_us));
+    printf("                               %8.1f us/update FFTs + columns, %3d/%d columns hold a bin\n",
+           (float)columns_us / (float)updates, g_octave.resolved_columns, columns);
+    return true;
+}
@@ -0,0 +1,158 @@
+/*****************************************************************************
+* | File      	:   fft_octave.h
+* | Author      :   PicoFFT Project
+* | Function    :   Constant-Q (octave cascade) spectrum for the log frequency axis
+* | Info        :
+*   - A chain of half-band 2:1 decimators splits the ADC stream into octave
+*     stages fs, fs/2, fs/4, ...; every stage keeps the last 256 samples
+*   - One 256-point FFT per stage and display update resolves the top
+*     octave of that stage ([0.2, 0.4] x stage rate) into ~51 bins, so the
+*     bins per display column stay constant across the log axis
+*   - Column map (stage and bin range per column) built once at init: no
+*     log10f per bin at run time
+*   - Buffers come from the arena only when USE_LOG_FREQ_SCALE is set
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_OCTAVE_H
+#define __FFT_OCTAVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "kiss_fft.h"
+#include "fft_db.h"
+#include "fft_plan.h"
+#include "adc_convert.h"
+
+// Octave cascade configuration
+#define FFT_OCTAVE_STAGES LOG_FREQ_OCTAVE_STAGES
+#define FFT_OCTAVE_MAX_STAGES 10            // fs / 512 lowest stage rate
+#define FFT_OCTAVE_FFT_SIZE 256             // Per-stage FFT size (must be a registered plan size)
+#define FFT_OCTAVE_BINS (FFT_OCTAVE_FFT_SIZE / 2)
+#define FFT_OCTAVE_BAND_LOW 0.2f            // Octave analyzed per stage, fraction of the stage rate
+#define FFT_OCTAVE_BAND_HIGH 0.4f           // (alias-free: the half-band stops from 0.3 x input rate)
+#define FFT_OCTAVE_HALFBAND_TAPS 55         // 4k+3 taps: center + 14 symmetric odd-offset pairs
+#define FFT_OCTAVE_HALFBAND_PAIRS ((FFT_OCTAVE_HALFBAND_TAPS + 1) / 4)
+#define FFT_OCTAVE_HISTORY_SCALE 8.0f       // Stage history as int16 in 1/8 ADC LSB
+#define FFT_OCTAVE_CHUNK 64                 // Input samples converted per block
+#define FFT_OCTAVE_MAX_COLUMNS 320          // Display columns (LCD width)
+
+#if FFT_REAL_INPUT_ENABLED
+#define FFT_OCTAVE_OUTPUT_BINS (FFT_OCTAVE_FFT_SIZE / 2 + 1)
+#else
+#define FFT_OCTAVE_OUTPUT_BINS FFT_OCTAVE_FFT_SIZE
+#endif
+
+// Bin range of one display column in its stage spectrum
+typedef struct {
+    uint8_t first;
+    uint8_t last;
+} fft_octave_column_t;
+
+// Large buffers (one arena block)
+typedef struct {
+    int16_t history[FFT_OCTAVE_STAGES][FFT_OCTAVE_FFT_SIZE]; // Circular, stage rate
+    float halfband[FFT_OCTAVE_STAGES - 1][2 * FFT_OCTAVE_HALFBAND_TAPS]; // Input of the filter producing stage s + 1 (stored twice)
+    
+    // In-place FFT work buffer (windowed input, then bins, then dBm)
+    union {
+        fft_kernel_input_t fft_input[FFT_OCTAVE_FFT_SIZE];
+        kiss_fft_cpx fft_output[FFT_OCTAVE_OUTPUT_BINS];
+    };
+    fft_octave_column_t columns[FFT_OCTAVE_MAX_COLUMNS];
+} fft_octave_buffers_t;
+
+#if USE_LOG_FREQ_SCALE
+#define FFT_OCTAVE_ARENA_BYTES (sizeof(fft_octave_buffers_t))   // Sizes the arena
+#else
+#define FFT_OCTAVE_ARENA_BYTES 0
+#endif
+
+// Octave cascade state
+typedef struct {
+    fft_octave_buffers_t* buffers;          // Arena block
+    const fft_plan_t* plan;                 // Cached plan of FFT_OCTAVE_FFT_SIZE
+    float halfband_coeffs[FFT_OCTAVE_HALFBAND_PAIRS]; // Odd-offset taps (center tap is 0.5)
+    float sample_rate;                      // Stage 0 rate
+    float f_min, f_max;                     // Display edges
+    int column_count;
+    int resolved_columns;                   // Columns holding at least one bin center
+    int column_begin[FFT_OCTAVE_STAGES];    // Columns [begin, end) drawn from each stage
+    int column_end[FFT_OCTAVE_STAGES];
+    
+    // Per-stage stream position
+    int history_pos[FFT_OCTAVE_STAGES];     // Next write (oldest sample once full)
+    int history_filled[FFT_OCTAVE_STAGES];
+    int halfband_pos[FFT_OCTAVE_STAGES];    // Per filter (stage s + 1 from stage s)
+    int halfband_phase[FFT_OCTAVE_STAGES];  // Filter inputs since the last output
+    
+    fft_window_type_t window_type;          // Window the dB offset was computed for
+    fft_db_stage_t db_stage;
+    float input_scale;                      // History value -> FFT input
+    uint32_t update_count;
+    bool initialized;
+} fft_octave_state_t;
+
+// ========================================
+// 🔧 Octave Cascade API
+// ========================================
+
+/**
+ * Initialize the cascade and map the log-spaced display columns onto it
+ * Column c spans f_min * (f_max / f_min)^(c / columns) to the next column's start
+ * Requires fft_plan_init() with FFT_OCTAVE_FFT_SIZE among the plan sizes
+ * @param sample_rate ADC sample rate in Hz
+ * @param f_min Left edge of the display in Hz (reached by the lowest stage)
+ * @param f_max Right edge of the display in Hz
+ * @param columns Display columns (1 to FFT_OCTAVE_MAX_COLUMNS)
+ * @return true if successful, false on invalid parameters or arena budget
+ */
+bool fft_octave_init(float sample_rate, float f_min, float f_max, int columns);
+
+/**
+ * Discard filter state and stage histories
+ */
+void fft_octave_reset(void);
+
+/**
+ * Feed raw ADC samples through the decimator chain
+ * @param samples Raw ADC samples (adc_sample_t), contiguous in time
+ * @param count Number of samples
+ */
+void fft_octave_process(const adc_sample_t* samples, int count);
+
+/**
+ * Compute one constant-Q column spectrum (one FFT per stage)
+ * Each column takes the strongest bin of its range (nearest bin if the
+ * column is narrower than a bin)
+ * @param column_dbm Output: one level per column in dBm
+ * @return true if every stage history is full and the columns were written
+ */
+bool fft_octave_get_columns(float* column_dbm);
+
+/**
+ * Get the bin spacing of one stage
+ * @param stage Stage index (0 = full rate)
+ * @return Stage rate / FFT_OCTAVE_FFT_SIZE in Hz, 0 for an invalid stage
+ */
+float fft_octave_get_bin_width(int stage);
+
+/**
+ * Get the number of column spectra computed
+ * @return Update count since init
+ */
+uint32_t fft_octave_get_update_count(void);
+
+/**
+ * Time the per-bin log remap of the linear spectrum against the cascade
+ * (decimation of one update's input, FFTs and column map) and print both
+ * with the number of columns each one fills; the cascade is reset afterwards
+ * @param column_dbm Work buffer (one float per column)
+ * @param fft_size Linear FFT size of the per-bin remap
+ * @param updates Display updates timed
+ * @return true if the benchmark ran
+ */
+bool fft_octave_benchmark(float* column_dbm, int fft_size, int updates);
+
+#endif // __FFT_OCTAVE_H
@@ -0,0 +1,208 @@
+/*****************************************************************************
+* | File      	:   fft_peaks.c
+* | Author      :   PicoFFT Project
+* | Function    :   Sub-bin peak search over a dBm spectrum
+* | Info        :
+*   - The dBm spectrum is window-corrected at the bin center, so only the
+*     scalloping loss at the refined offset is added back
+*   - The scalloping table is the window's DTFT sampled once per window or
+*     size change, not per frame
+*----------------
+******************************************************************************/
+
+#include "fft_peaks.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FFT_PEAKS_PHASOR_RUN 64             // Samples per exact phasor restart (power of two)
+
+// Global peak search state
+static fft_peaks_state_t g_peaks = {0};
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Sample the active window's DTFT between the bin center and half a bin
+ * |W(d)| / |W(0)| in dB, for d = 0 to 0.5 bin
+ * (runs on the render core after a window switch was acknowledged, so the
+ * table is complete; the switch itself never overlaps a render)
+ */
+static void _fft_peaks_build_scallop_table(int size) {
+    const float* window = fft_window_get_coefficients_for_size(size);
+    
+    g_peaks.window_type = fft_window_get_type();
+    g_peaks.window_size = size;
+    if (window == NULL) {
+        memset(g_peaks.scallop_db, 0, sizeof(g_peaks.scallop_db));
+        return;
+    }
+    
+    float center = 0.0f;
+    for (int n = 0; n < size; n++) {
+        center += window[n];
+    }
+    
+    g_peaks.scallop_db[0] = 0.0f;
+    for (int step = 1; step <= FFT_PEAKS_SCALLOP_STEPS; step++) {
+        // Phasor rotation instead of cosf/sinf per sample, resynchronized
+        // every FFT_PEAKS_PHASOR_RUN samples so float rounding cannot drift
+        float omega = (float)M_PI * (float)step / (float)(FFT_PEAKS_SCALLOP_STEPS * size);
+        float rot_re = cosf(omega);
+        float rot_im = -sinf(omega);
+        float ph_re = 1.0f, ph_im = 0.0f;
+        float sum_re = 0.0f, sum_im = 0.0f;
+        for (int n = 0; n < size; n++) {
+            if ((n & (FFT_PEAKS_PHASOR_RUN - 1)) == 0) {
+                ph_re = cosf(omega * (float)n);
+                ph_im = -sinf(omega * (float)n);
+            }
+            sum_re += window[n] * ph_re;
+            sum_im += window[n] * ph_im;
+            float next_re = ph_re * rot_re - ph_im * rot_im;
+            ph_im = ph_re * rot_im + ph_im * rot_re;
+            ph_re = next_re;
+        }
+        float gain = sqrtf(sum_re * sum_re + sum_im * sum_im) / center;
+        g_peaks.scallop_db[step] = 20.0f * log10f(gain > 1e-6f ? gain : 1e-6f);
+    }
+}
+
+/**
+ * Scalloping loss at a fractional bin offset (linear in the table)
+ */
+static float _fft_peaks_scallop_db(float delta) {
+    float pos = fabsf(delta) * (2.0f * FFT_PEAKS_SCALLOP_STEPS);
+    if (pos >= FFT_PEAKS_SCALLOP_STEPS) {
+        return g_peaks.scallop_db[FFT_PEAKS_SCALLOP_STEPS];
+    }
+    int index = (int)pos;
+    float frac = pos - (float)index;
+    return g_peaks.scallop_db[index] + frac * (g_peaks.scallop_db[index + 1] - g_peaks.scallop_db[index]);
+}
+
+/**
+ * Refine a local maximum: fractional offset from bin k and corrected level
+ */
+static void _fft_peaks_refine(const float* spectrum_dbm, int k, float* delta, float* dbm) {
+    float left = spectrum_dbm[k - 1];
+    float center = spectrum_dbm[k];
+    float right = spectrum_dbm[k + 1];
+    
+    if (g_peaks.method == FFT_PEAKS_INTERP_PARABOLIC) {
+        // dB -> linear magnitude relative to the center bin (bounded exponents)
+        left = powf(10.0f, (left - center) * 0.05f);
+        right = powf(10.0f, (right - center) * 0.05f);
+        center = 1.0f;
+    }
+    
+    float denominator = left - 2.0f * center + right;
+    float d = (denominator < 0.0f) ? 0.5f * (left - right) / denominator : 0.0f;
+    if (d > 0.5f) d = 0.5f;
+    if (d < -0.5f) d = -0.5f;
+    
+    *delta = d;
+    *dbm = spectrum_dbm[k] - _fft_peaks_scallop_db(d);
+}
+
+// ========================================
+// 🔧 Peak Search API Implementation
+// ========================================
+
+/**
+ * Configure the peak search
+ */
+bool fft_peaks_init(int max_peaks, float threshold_dbm, fft_peaks_interp_t method) {
+    if (max_peaks < 1 || max_peaks > FFT_PEAKS_MAX_PEAKS ||
+        method < 0 || method >= FFT_PEAKS_INTERP_COUNT) {
+        printf("ERROR: Invalid peak search settings (%d peaks, method %d)\n", max_peaks, method);
+        return false;
+    }
+    
+    memset(&g_peaks, 0, sizeof(g_peaks));
+    g_peaks.max_peaks = max_peaks;
+    g_peaks.threshold_dbm = threshold_dbm;
+    g_peaks.method = method;
+    return true;
+}
+
+/**
+ * Find the strongest peaks of one spectrum
+ */
+int fft_peaks_find(const float* spectrum_dbm, int bins, float bin_width_hz) {
+    g_peaks.peak_count = 0;
+    if (spectrum_dbm == NULL || bins < 3 || g_peaks.max_peaks == 0) {
+        return 0;
+    }
+    
+    if (g_peaks.method != FFT_PEAKS_INTERP_NONE &&
+        (g_peaks.window_size != 2 * bins || g_peaks.window_type != fft_window_get_type())) {
+        _fft_peaks_build_scallop_table(2 * bins);
+    }
+    
+    // One pass: every local maximum above the threshold is refined and
+    // insertion-sorted into the list; the weakest entry drops off the end
+    for (int k = 1; k < bins - 1; k++) {
+        float level = spectrum_dbm[k];
+        if (level < g_peaks.threshold_dbm || level <= spectrum_dbm[k - 1] || level < spectrum_dbm[k + 1]) {
+            continue;
+        }
+    
+        float delta = 0.0f;
+        float dbm = level;
+        if (g_peaks.method != FFT_PEAKS_INTERP_NONE) {
+            _fft_peaks_refine(spectrum_dbm, k, &delta, &dbm);
+        }
+    
+        int slot = g_peaks.peak_count;
+        if (slot == g_peaks.max_peaks) {
+            if (dbm <= g_peaks.peaks[slot - 1].dbm) {
+                continue;
+            }
+            slot--;
+        } else {
+            g_peaks.peak_count++;
+        }
+        while (slot > 0 && g_peaks.peaks[slot - 1].dbm < dbm) {
+            g_peaks.peaks[slot] = g_peaks.peaks[slot - 1];
+            slot--;
+        }
+        g_peaks.peaks[slot].bin = (float)k + delta;
+        g_peaks.peaks[slot].frequency_hz = ((float)k + delta) * bin_width_hz;
+        g_peaks.peaks[slot].dbm = dbm;
+    }
+    
+    return g_peaks.peak_count;
+}
+
+/**
+ * Get the peak list of the last search
+ */
+const fft_peak_t* fft_peaks_get(void) {
+    return g_peaks.peaks;
+}
+
+/**
+ * Get the number of peaks of the last search
+ */
+int fft_peaks_get_count(void) {
+    return g_peaks.peak_count;
+}
+
+/**
+ * Get interpolation method name as string
+ */
+const char* fft_peaks_get_method_name(fft_peaks_interp_t method) {
+    switch (method) {
+        case FFT_PEAKS_INTERP_NONE:      return "Bin center";
+        case FFT_PEAKS_INTERP_PARABOLIC: return "Parabolic";
+        case FFT_PEAKS_INTERP_GAUSSIAN:  return "Gaussian";
+        default:                         return "Unknown";
+    }
+}
@@ -0,0 +1,99 @@
+/*****************************************************************************
+* | File      	:   fft_peaks.h
+* | Author      :   PicoFFT Project
+* | Function    :   Sub-bin peak search over a dBm spectrum
+* | Info        :
+*   - One pass over the bins finds local maxima above a threshold and keeps
+*     the strongest FFT_PEAKS_MAX_PEAKS in a sorted list
+*   - Frequency refined by three-point interpolation (parabolic on the
+*     magnitude, or Gaussian = parabolic on dB)
+*   - Amplitude corrected by the scalloping loss of the active window at the
+*     refined offset (off-bin tones read their true level)
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_PEAKS_H
+#define __FFT_PEAKS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "fft_window.h"
+
+// Peak search configuration
+#define FFT_PEAKS_MAX_PEAKS 16              // Longest peak list
+#define FFT_PEAKS_SCALLOP_STEPS 32          // Scalloping table resolution over 0 to 0.5 bin
+
+// Bin interpolation methods (values match PEAK_INTERPOLATION in config_settings.h)
+typedef enum {
+    FFT_PEAKS_INTERP_NONE = 0,              // Bin center, no amplitude correction
+    FFT_PEAKS_INTERP_PARABOLIC = 1,         // Parabola through the linear magnitudes
+    FFT_PEAKS_INTERP_GAUSSIAN = 2,          // Parabola through the dB values
+    FFT_PEAKS_INTERP_COUNT = 3
+} fft_peaks_interp_t;
+
+// One spectral peak
+typedef struct {
+    float frequency_hz;                     // Interpolated frequency
+    float bin;                              // Fractional bin index
+    float dbm;                              // Window-corrected level
+} fft_peak_t;
+
+// Peak search state
+typedef struct {
+    fft_peak_t peaks[FFT_PEAKS_MAX_PEAKS];  // Strongest first
+    int peak_count;
+    int max_peaks;
+    float threshold_dbm;                    // Maxima below this are ignored
+    fft_peaks_interp_t method;
+    
+    // Scalloping loss of the active window (dB, 0 at the bin center)
+    float scallop_db[FFT_PEAKS_SCALLOP_STEPS + 1];
+    fft_window_type_t window_type;          // Window and size the table was built for
+    int window_size;
+} fft_peaks_state_t;
+
+// ========================================
+// 🔧 Peak Search API
+// ========================================
+
+/**
+ * Configure the peak search
+ * @param max_peaks List length (1 to FFT_PEAKS_MAX_PEAKS)
+ * @param threshold_dbm Lowest level reported
+ * @param method Bin interpolation method
+ * @return true if successful, false on invalid parameters
+ */
+bool fft_peaks_init(int max_peaks, float threshold_dbm, fft_peaks_interp_t method);
+
+/**
+ * Find the strongest peaks of one spectrum
+ * The spectrum must be windowed with the active window at FFT size 2 * bins
+ * (main spectrum mode); bins 0 and bins-1 are never reported
+ * @param spectrum_dbm Magnitude spectrum in dBm
+ * @param bins Number of bins (FFT size / 2)
+ * @param bin_width_hz Bin spacing in Hz
+ * @return Number of peaks found (0 to max_peaks)
+ */
+int fft_peaks_find(const float* spectrum_dbm, int bins, float bin_width_hz);
+
+/**
+ * Get the peak list of the last search
+ * @return Peaks sorted by level, strongest first
+ */
+const fft_peak_t* fft_peaks_get(void);
+
+/**
+ * Get the number of peaks of the last search
+ * @return Peak count
+ */
+int fft_peaks_get_count(void);
+
+/**
+ * Get interpolation method name as string
+ * @param method Interpolation method
+ * @return Method name
+ */
+const char* fft_peaks_get_method_name(fft_peaks_interp_t method);
+
+#endif // __FFT_PEAKS_H
@@ -0,0 +1,270 @@
+/*****************************************************************************
+* | File      	:   fft_pipeline.c
+* | Author      :   PicoFFT Project
+* | Function    :   Two-core analysis/render pipeline: spectrum slot handoff
+* | Info        :
+*   - Each side keeps private state; only FIFO words cross cores
+*   - The command mailbox is the one shared structure: two counters with
+*     release/acquire ordering hand the command to core 1 and its result back
+*   - At most slot_count words are in flight in both directions together,
+*     which fits the 4-word RP2350 FIFOs, so pushes never stall a core
+*   - Build with FFT_PIPELINE_HOST_PORT to link the host stand-in port
+*     instead of the SDK one
+*----------------
+******************************************************************************/
+
+#include "fft_pipeline.h"
+#include <stddef.h>
+
+#ifndef FFT_PIPELINE_HOST_PORT
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#endif
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Decode one FIFO word
+ * @return Slot index, -1 if the word is not a pipeline message
+ */
+static int _fft_pipeline_decode(uint32_t message, int slot_count) {
+    int slot = (int)(message & ~FFT_PIPELINE_MESSAGE_MASK);
+    if ((message & FFT_PIPELINE_MESSAGE_MASK) != FFT_PIPELINE_MESSAGE_TAG || slot >= slot_count) {
+        return -1;
+    }
+    return slot;
+}
+
+/**
+ * Collect returned slots and pick the next slot to fill
+ * @return Slot index, -1 while the consumer holds every other slot
+ */
+static int _fft_pipeline_next_slot(fft_pipeline_producer_t* producer) {
+    uint32_t message;
+    while (fft_pipeline_port_pop(&message)) {
+        int slot = _fft_pipeline_decode(message, producer->slot_count);
+        if (slot >= 0) {
+            producer->owned_mask |= 1u << slot;
+        }
+    }
+    
+    // The lowest free slot other than the current
+    uint32_t free_mask = producer->owned_mask & ~(1u << producer->current);
+    if (free_mask == 0) {
+        if (!producer->waiting) {
+            producer->waiting = true;
+            producer->stalls++;
+        }
+        return -1;
+    }
+    int next = 0;
+    while ((free_mask & (1u << next)) == 0) {
+        next++;
+    }
+    return next;
+}
+
+// ========================================
+// 🔧 Pipeline API Implementation
+// ========================================
+
+/**
+ * Reset the producer side
+ */
+bool fft_pipeline_producer_reset(fft_pipeline_producer_t* producer, int slot_count) {
+    if (slot_count < 2 || slot_count > FFT_PIPELINE_MAX_SLOTS) {
+        return false;
+    }
+    
+    producer->slot_count = slot_count;
+    producer->current = 0;
+    producer->owned_mask = (1u << slot_count) - 1;
+    producer->waiting = false;
+    producer->published = 0;
+    producer->stalls = 0;
+    return true;
+}
+
+/**
+ * Get the slot the producer fills
+ */
+int fft_pipeline_producer_slot(const fft_pipeline_producer_t* producer) {
+    return producer->current;
+}
+
+/**
+ * Check whether the current slot can be handed over now
+ */
+bool fft_pipeline_producer_ready(fft_pipeline_producer_t* producer) {
+    return _fft_pipeline_next_slot(producer) >= 0;
+}
+
+/**
+ * Hand the current slot to the consumer if another slot is free
+ */
+bool fft_pipeline_producer_publish(fft_pipeline_producer_t* producer) {
+    int next = _fft_pipeline_next_slot(producer);
+    if (next < 0) {
+        return false;
+    }
+    
+    // The barrier in the push orders the slot contents before the word
+    producer->owned_mask &= ~(1u << producer->current);
+    fft_pipeline_port_push(FFT_PIPELINE_MESSAGE_TAG | (uint32_t)producer->current);
+    producer->current = next;
+    producer->waiting = false;
+    producer->published++;
+    return true;
+}
+
+/**
+ * Reset the consumer side
+ */
+void fft_pipeline_consumer_reset(fft_pipeline_consumer_t* consumer, int slot_count) {
+    consumer->slot_count = slot_count;
+    consumer->held = -1;
+    consumer->taken = 0;
+    consumer->skipped = 0;
+    consumer->errors = 0;
+}
+
+/**
+ * Take the newest published slot
+ */
+int fft_pipeline_consumer_take(fft_pipeline_consumer_t* consumer) {
+    if (consumer->held >= 0) {
+        return -1;
+    }
+    
+    // Drain the FIFO: slots arrive in publish order, only the last is rendered
+    uint32_t message;
+    int newest = -1;
+    while (fft_pipeline_port_pop(&message)) {
+        int slot = _fft_pipeline_decode(message, consumer->slot_count);
+        if (slot < 0) {
+            consumer->errors++;
+            continue;
+        }
+        if (newest >= 0) {
+            fft_pipeline_port_push(FFT_PIPELINE_MESSAGE_TAG | (uint32_t)newest);
+            consumer->skipped++;
+        }
+        newest = slot;
+    }
+    
+    if (newest >= 0) {
+        consumer->held = newest;
+        consumer->taken++;
+    }
+    return newest;
+}
+
+/**
+ * Return the rendered slot to the producer
+ */
+void fft_pipeline_consumer_release(fft_pipeline_consumer_t* consumer) {
+    if (consumer->held < 0) {
+        return;
+    }
+    fft_pipeline_port_push(FFT_PIPELINE_MESSAGE_TAG | (uint32_t)consumer->held);
+    consumer->held = -1;
+}
+
+// ========================================
+// 🔧 Command Mailbox Implementation
+// ========================================
+
+/**
+ * Reset the command mailbox
+ */
+void fft_pipeline_mailbox_reset(fft_pipeline_mailbox_t* mailbox) {
+    atomic_init(&mailbox->posted, 0);
+    atomic_init(&mailbox->done, 0);
+    mailbox->command = NULL;
+    mailbox->argument = NULL;
+    mailbox->result = false;
+}
+
+/**
+ * Run a command on core 1 and wait for its result
+ */
+bool fft_pipeline_mailbox_call(fft_pipeline_mailbox_t* mailbox, fft_pipeline_command_t command,
+                               const void* argument) {
+    // Core 0 is the only poster and waits below, so the slot is free here
+    uint32_t sequence = atomic_load_explicit(&mailbox->posted, memory_order_relaxed) + 1;
+    mailbox->command = command;
+    mailbox->argument = argument;
+    atomic_store_explicit(&mailbox->posted, sequence, memory_order_release);
+    
+    while (atomic_load_explicit(&mailbox->done, memory_order_acquire) != sequence) {
+        fft_pipeline_port_idle();
+    }
+    return mailbox->result;
+}
+
+/**
+ * Run the pending command, if any
+ */
+bool fft_pipeline_mailbox_poll(fft_pipeline_mailbox_t* mailbox) {
+    uint32_t sequence = atomic_load_explicit(&mailbox->posted, memory_order_acquire);
+    if (sequence == atomic_load_explicit(&mailbox->done, memory_order_relaxed)) {
+        return false;
+    }
+    
+    mailbox->result = mailbox->command(mailbox->argument);
+    atomic_store_explicit(&mailbox->done, sequence, memory_order_release);
+    return true;
+}
+
+/**
+ * Get the number of completed commands
+ */
+uint32_t fft_pipeline_mailbox_generation(fft_pipeline_mailbox_t* mailbox) {
+    return atomic_load_explicit(&mailbox->done, memory_order_acquire);
+}
+
+#ifndef FFT_PIPELINE_HOST_PORT
+// ========================================
+// 🔧 Core Port Implementation (SDK multicore FIFOs)
+// ========================================
+
+/**
+ * Start the producer loop on core 1
+ */
+void fft_pipeline_port_launch(void (*entry)(void)) {
+    multicore_launch_core1(entry);
+}
+
+/**
+ * Push one word to the other core's FIFO
+ */
+void fft_pipeline_port_push(uint32_t message) {
+    // Slot contents written by this core become visible before the word
+    __dmb();
+    multicore_fifo_push_blocking(message);
+}
+
+/**
+ * Pop one word from this core's FIFO without blocking
+ */
+bool fft_pipeline_port_pop(uint32_t* message) {
+    if (!multicore_fifo_rvalid()) {
+        return false;
+    }
+    *message = multicore_fifo_pop_blocking();
+    
+    // Slot reads of this core happen after the word arrived
+    __dmb();
+    return true;
+}
+
+/**
+ * Pause briefly while waiting for the other core
+ */
+void fft_pipeline_port_idle(void) {
+    tight_loop_contents();
+}
+#endif
@@ -0,0 +1,188 @@
+/*****************************************************************************
+* | File      	:   fft_pipeline.h
+* | Author      :   PicoFFT Project
+* | Function    :   Two-core analysis/render pipeline: spectrum slot handoff
+* | Info        :
+*   - Core 1 (producer) consumes ADC frames and builds spectra, core 0
+*     (consumer) only renders them, so the FFT of the next display update
+*     overlaps the SPI transfer of the current one
+*   - Spectrum slots change owner by message: slot indices travel through
+*     the inter-core FIFOs (core 1 -> core 0 published, core 0 -> core 1
+*     returned), so no slot is ever written by both cores and no lock or
+*     shared counter is needed; a memory barrier precedes every push
+*   - The producer never waits: while the consumer holds the other slot it
+*     keeps merging frames into its slot and publishes once one is back
+*   - The consumer takes the newest published slot and returns older ones
+*   - Settings change through a command mailbox: core 0 posts a command and
+*     waits, core 1 runs it between two frames and acknowledges, so analysis
+*     state is only ever written by the core that runs the analysis
+*   - Core launch and FIFO access go through a small port: the SDK multicore
+*     FIFOs on the target, a thread-based stand-in on the host
+*     (tools/multicore_fifo_host.c, stress test tools/fft_pipeline_stress.c)
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_PIPELINE_H
+#define __FFT_PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Pipeline configuration
+#define FFT_PIPELINE_MAX_SLOTS 4            // Spectrum slots in flight (2 keep both cores busy)
+#define FFT_PIPELINE_MESSAGE_TAG 0x5FF70000u // FIFO word = tag | slot index
+#define FFT_PIPELINE_MESSAGE_MASK 0xFFFF0000u
+
+// Producer side state (core 1 only)
+typedef struct {
+    int slot_count;
+    int current;                            // Slot being filled
+    uint32_t owned_mask;                    // Slots held by the producer (current included)
+    bool waiting;                           // Current slot found no free successor yet
+    uint32_t published;                     // Slots handed to the consumer
+    uint32_t stalls;                        // Slots that kept merging while the consumer held every other slot
+} fft_pipeline_producer_t;
+
+// Consumer side state (core 0 only)
+typedef struct {
+    int slot_count;
+    int held;                               // Slot being rendered, -1 if none
+    uint32_t taken;                         // Slots rendered
+    uint32_t skipped;                       // Older published slots returned unrendered
+    uint32_t errors;                        // Unexpected FIFO words
+} fft_pipeline_consumer_t;
+
+// Command run by core 1 on behalf of core 0
+typedef bool (*fft_pipeline_command_t)(const void* argument);
+
+// Command mailbox: one command in flight, posted by core 0, run by core 1
+typedef struct {
+    atomic_uint_least32_t posted;           // Commands posted (core 0, release)
+    atomic_uint_least32_t done;             // Commands completed (core 1, release)
+    fft_pipeline_command_t command;         // Written before posted, read after it
+    const void* argument;
+    bool result;                            // Written before done, read after it
+} fft_pipeline_mailbox_t;
+
+// ========================================
+// 🔧 Pipeline API
+// ========================================
+
+/**
+ * Reset the producer side before core 1 starts: it owns every slot and fills slot 0
+ * @param producer Producer state
+ * @param slot_count Spectrum slots (2 to FFT_PIPELINE_MAX_SLOTS)
+ * @return true if successful, false on an invalid slot count
+ */
+bool fft_pipeline_producer_reset(fft_pipeline_producer_t* producer, int slot_count);
+
+/**
+ * Get the slot the producer fills
+ * @param producer Producer state
+ * @return Slot index
+ */
+int fft_pipeline_producer_slot(const fft_pipeline_producer_t* producer);
+
+/**
+ * Check whether the current slot can be handed over now
+ * Collects returned slots; lets the producer skip finishing work (e.g. a
+ * display mapping) for a slot that would not be published anyway
+ * @param producer Producer state
+ * @return true if fft_pipeline_producer_publish() will succeed
+ */
+bool fft_pipeline_producer_ready(fft_pipeline_producer_t* producer);
+
+/**
+ * Hand the current slot to the consumer if another slot is free
+ * Collects returned slots first; never blocks (the FIFO toward core 0
+ * cannot fill: at most slot_count words are in flight)
+ * @param producer Producer state
+ * @return true if published (fft_pipeline_producer_slot() changed and the
+ *         new slot must be cleared), false if the producer keeps its slot
+ */
+bool fft_pipeline_producer_publish(fft_pipeline_producer_t* producer);
+
+/**
+ * Reset the consumer side (core 0)
+ * @param consumer Consumer state
+ * @param slot_count Spectrum slots (same as the producer)
+ */
+void fft_pipeline_consumer_reset(fft_pipeline_consumer_t* consumer, int slot_count);
+
+/**
+ * Take the newest published slot (older published slots go straight back)
+ * @param consumer Consumer state
+ * @return Slot index to render, -1 if nothing new (or a slot is still held)
+ */
+int fft_pipeline_consumer_take(fft_pipeline_consumer_t* consumer);
+
+/**
+ * Return the rendered slot to the producer
+ * @param consumer Consumer state
+ */
+void fft_pipeline_consumer_release(fft_pipeline_consumer_t* consumer);
+
+/**
+ * Reset the command mailbox (before core 1 starts)
+ * @param mailbox Command mailbox
+ */
+void fft_pipeline_mailbox_reset(fft_pipeline_mailbox_t* mailbox);
+
+/**
+ * Run a command on core 1 and wait for its result (core 0)
+ * Blocks until core 1 polls the mailbox between two frames; the argument
+ * only has to live until this function returns
+ * @param mailbox Command mailbox
+ * @param command Command to run on core 1
+ * @param argument Command argument
+ * @return Result of the command
+ */
+bool fft_pipeline_mailbox_call(fft_pipeline_mailbox_t* mailbox, fft_pipeline_command_t command,
+                               const void* argument);
+
+/**
+ * Run the pending command, if any (core 1, between frames)
+ * @param mailbox Command mailbox
+ * @return true if a command ran (the analysis settings may have changed)
+ */
+bool fft_pipeline_mailbox_poll(fft_pipeline_mailbox_t* mailbox);
+
+/**
+ * Get the number of completed commands
+ * Stamped into every spectrum slot by core 1, so core 0 can tell slots
+ * analyzed before its last command from those analyzed after it
+ * @param mailbox Command mailbox
+ * @return Completed commands (acquire)
+ */
+uint32_t fft_pipeline_mailbox_generation(fft_pipeline_mailbox_t* mailbox);
+
+// ========================================
+// 🔧 Core Port (multicore FIFOs or host stand-in)
+// ========================================
+
+/**
+ * Start the producer loop on core 1
+ * @param entry Core 1 entry (never returns)
+ */
+void fft_pipeline_port_launch(void (*entry)(void));
+
+/**
+ * Push one word to the other core's FIFO (barrier first, blocks while full)
+ * @param message FIFO word
+ */
+void fft_pipeline_port_push(uint32_t message);
+
+/**
+ * Pop one word from this core's FIFO without blocking (barrier after)
+ * @param message Output: FIFO word
+ * @return true if a word was available
+ */
+bool fft_pipeline_port_pop(uint32_t* message);
+
+/**
+ * Pause briefly while waiting for the other core (mailbox acknowledge)
+ */
+void fft_pipeline_port_idle(void);
+
+#endif // __FFT_PIPELINE_H
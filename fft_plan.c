@@ -0,0 +1,302 @@
+/*****************************************************************************
+* | File      	:   fft_plan.c
+* | Author      :   PicoFFT Project
+* | Function    :   Cached FFT plan registry for runtime size switching
+* | Info        :   
+*   - Plans are carved out of one fft_arena block with kiss_fft's lenmem interface
+*   - Exact sizes are queried first so a too-small arena fails at startup
+*----------------
+******************************************************************************/
+
+#include "fft_plan.h"
+#include "fft_arena.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+_Static_assert(FFT_PLAN_MAX_SIZE <= FFT_WINDOW_MAX_SIZE,
+               "Window tables must hold FFT_PLAN_MAX_SIZE coefficients");
+_Static_assert(FFT_PLAN_TOTAL_POINTS <= FFT_WINDOW_POOL_SIZE,
+               "Window pool must hold tables for every registered size");
+_Static_assert(FFT_PLAN_SIZE_COUNT <= FFT_WINDOW_MAX_TABLES,
+               "Too many registered sizes for the window table cache");
+
+#define FFT_PLAN_ALIGN 8                    // Plan alignment inside the arena block
+
+// Supported FFT sizes
+static const int s_plan_sizes[FFT_PLAN_SIZE_COUNT] = FFT_PLAN_SIZE_LIST;
+
+// Global plan registry and its arena block (kept across re-initialization)
+static fft_plan_registry_t g_plan_registry = {0};
+static uint8_t* s_plan_mem = NULL;
+
+// ========================================
+// 🔧 Plan Construction (startup only)
+// ========================================
+
+/**
+ * Query the memory of one plan (mem == NULL only reports lenmem)
+ */
+static size_t _fft_plan_query(int size) {
+    size_t needed = 0;
+    
+    // kiss_fftr runs an N/2-point complex FFT; other radices fall back to a slow generic butterfly
+#if FFT_REAL_INPUT_ENABLED
+    const int complex_points = size / 2;
+#else
+    const int complex_points = size;
+#endif
+    if ((size & 1) != 0 || kiss_fft_next_fast_size(complex_points) != complex_points) {
+        printf("ERROR: FFT size %d is not a fast kiss_fft size (factors 2, 3, 5 only)\n", size);
+        return SIZE_MAX;
+    }
+    
+#ifdef FFT_BACKEND_GENERATED
+    // Generated kernel: const tables in flash, nothing to allocate
+    if (fft_kernel_find(size) != NULL) {
+        return 0;
+    }
+#endif
+    
+#if FFT_REAL_INPUT_ENABLED
+    kiss_fftr_alloc(size, 0, NULL, &needed);
+#else
+    kiss_fft_alloc(size, 0, NULL, &needed);
+#endif
+    return (needed + FFT_PLAN_ALIGN - 1) & ~(size_t)(FFT_PLAN_ALIGN - 1);
+}
+
+/**
+ * Build one plan in its share of the arena block through kiss_fft's lenmem interface
+ */
+static bool _fft_plan_build(fft_plan_t* plan, int size, void* mem, size_t needed) {
+#ifdef FFT_BACKEND_GENERATED
+    plan->kernel = fft_kernel_find(size);
+    if (plan->kernel != NULL) {
+        plan->size = size;
+        plan->cfg_bytes = 0;
+        return true;
+    }
+#endif
+    
+    size_t lenmem = needed;
+#if FFT_REAL_INPUT_ENABLED
+    plan->fftr_cfg = kiss_fftr_alloc(size, 0, mem, &lenmem);
+    bool success = (plan->fftr_cfg != NULL);
+#else
+    plan->fft_cfg = kiss_fft_alloc(size, 0, mem, &lenmem);
+    bool success = (plan->fft_cfg != NULL);
+#endif
+    if (!success) {
+        printf("ERROR: Failed to build FFT plan for N=%d\n", size);
+        return false;
+    }
+    
+    plan->size = size;
+    plan->cfg_bytes = needed;
+    return true;
+}
+
+// ========================================
+// 🔧 Plan Registry API Implementation
+// ========================================
+
+/**
+ * Build plans and window tables for all supported sizes
+ */
+bool fft_plan_init(int initial_size, fft_window_type_t window_type) {
+    memset(&g_plan_registry, 0, sizeof(g_plan_registry));
+    
+    // One arena block for every plan: an exhausted budget fails before any plan is built
+    size_t needed[FFT_PLAN_SIZE_COUNT];
+    size_t total = 0;
+    for (int i = 0; i < FFT_PLAN_SIZE_COUNT; i++) {
+        needed[i] = _fft_plan_query(s_plan_sizes[i]);
+        if (needed[i] == SIZE_MAX) {
+            return false;
+        }
+        total += needed[i];
+    }
+    if (s_plan_mem == NULL && total > 0) {
+        s_plan_mem = (uint8_t*)fft_arena_alloc(total, "fft_plan");
+        if (s_plan_mem == NULL) {
+            return false;
+        }
+    }
+    
+    size_t offset = 0;
+    for (int i = 0; i < FFT_PLAN_SIZE_COUNT; i++) {
+        if (!_fft_plan_build(&g_plan_registry.plans[i], s_plan_sizes[i], s_plan_mem + offset, needed[i])) {
+            return false;
+        }
+        offset += needed[i];
+    }
+    g_plan_registry.arena_bytes = total;
+    
+    if (!fft_window_init(s_plan_sizes, FFT_PLAN_SIZE_COUNT, window_type)) {
+        return false;
+    }
+    
+    g_plan_registry.initialized = true;
+    
+    if (!fft_plan_select(initial_size)) {
+        printf("ERROR: FFT size %d is not in the plan registry\n", initial_size);
+        g_plan_registry.initialized = false;
+        return false;
+    }
+    
+    printf("FFT plan registry initialized: %d sizes, %u arena bytes\n",
+           FFT_PLAN_SIZE_COUNT, (unsigned)g_plan_registry.arena_bytes);
+    return true;
+}
+
+/**
+ * Make a cached plan and its window table active
+ */
+bool fft_plan_select(int size) {
+    if (!g_plan_registry.initialized) {
+        return false;
+    }
+    
+    for (int i = 0; i < FFT_PLAN_SIZE_COUNT; i++) {
+        if (g_plan_registry.plans[i].size == size) {
+            if (!fft_window_set_size(size)) {
+                return false;
+            }
+            g_plan_registry.active = &g_plan_registry.plans[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Run the forward FFT of a plan
+ */
+void fft_plan_forward(const fft_plan_t* plan, const fft_kernel_input_t* input, kiss_fft_cpx* output) {
+#ifdef FFT_BACKEND_GENERATED
+    if (plan->kernel != NULL) {
+        plan->kernel->forward(input, output);
+        return;
+    }
+#endif
+#if FFT_REAL_INPUT_ENABLED
+    // Only bins 0..N/2 are produced; the upper half is the conjugate mirror
+    kiss_fftr(plan->fftr_cfg, input, output);
+#else
+    kiss_fft(plan->fft_cfg, input, output);
+#endif
+}
+
+/**
+ * Time every registered size
+ */
+void fft_plan_benchmark(fft_kernel_input_t* input, kiss_fft_cpx* output, int frames) {
+    if (!g_plan_registry.initialized || input == NULL || output == NULL || frames < 1) {
+        return;
+    }
+    
+    printf("=== FFT Size Benchmark (%d frames per size) ===\n", frames);
+    printf("     N  Bin Hz  us/frame  ns/point  ns/(N*log2 N)  Load @ hop N/%d\n", ADC_STFT_HOP_DIVISOR);
+    for (int i = 0; i < FFT_PLAN_SIZE_COUNT; i++) {
+        const fft_plan_t* plan = &g_plan_registry.plans[i];
+        const int size = plan->size;
+        uint32_t lcg = 12345u;
+        int64_t elapsed_us = 0;
+    
+        for (int f = 0; f < frames; f++) {
+            // Noise input, refilled per frame because the transform may run in place
+            for (int n = 0; n < size; n++) {
+                lcg = lcg * 1664525u + 1013904223u;
+                kiss_fft_scalar x = (kiss_fft_scalar)((int32_t)(lcg >> 21) - 1024);
+#if FFT_REAL_INPUT_ENABLED
+                input[n] = x;
+#else
+                input[n].r = x;
+                input[n].i = 0;
+#endif
+            }
+            absolute_time_t start = get_absolute_time();
+            fft_plan_forward(plan, input, output);
+            elapsed_us += absolute_time_diff_us(start, get_absolute_time());
+        }
+    
+        const char* note = (size & (size - 1)) != 0 ? "  (mixed radix)" : "";
+#ifdef FFT_BACKEND_GENERATED
+        if (plan->kernel != NULL) {
+            note = "  (generated kernel)";
+        }
+#endif
+        float us_per_frame = (float)elapsed_us / (float)frames;
+        float hop_us = (float)(size / ADC_STFT_HOP_DIVISOR) * 1000000.0f / (float)SAMPLING_RATE_HZ;
+        printf("  %4d  %6.1f  %8.1f  %8.2f  %13.3f  %5.1f%%%s\n", size,
+               (float)SAMPLING_RATE_HZ / (float)size, us_per_frame,
+               us_per_frame * 1000.0f / (float)size,
+               us_per_frame * 1000.0f / ((float)size * log2f((float)size)),
+               100.0f * us_per_frame / hop_us, note);
+    }
+}
+
+/**
+ * Get the active plan
+ */
+const fft_plan_t* fft_plan_get_active(void) {
+    return g_plan_registry.active;
+}
+
+/**
+ * Get the cached plan of a size
+ */
+const fft_plan_t* fft_plan_find(int size) {
+    if (!g_plan_registry.initialized) {
+        return NULL;
+    }
+    
+    for (int i = 0; i < FFT_PLAN_SIZE_COUNT; i++) {
+        if (g_plan_registry.plans[i].size == size) {
+            return &g_plan_registry.plans[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Get the active FFT size
+ */
+int fft_plan_get_size(void) {
+    return g_plan_registry.active ? g_plan_registry.active->size : 0;
+}
+
+/**
+ * Check whether a size has a cached plan
+ */
+bool fft_plan_is_supported(int size) {
+    for (int i = 0; i < FFT_PLAN_SIZE_COUNT; i++) {
+        if (s_plan_sizes[i] == size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Print registry contents and arena usage
+ */
+void fft_plan_print_registry(void) {
+    printf("=== FFT Plan Registry ===\n");
+    for (int i = 0; i < FFT_PLAN_SIZE_COUNT; i++) {
+        const fft_plan_t* plan = &g_plan_registry.plans[i];
+#ifdef FFT_BACKEND_GENERATED
+        if (plan->kernel != NULL) {
+            printf("  N=%4d: generated kernel, %6u flash bytes%s\n", plan->size,
+                   (unsigned)plan->kernel->rodata_bytes,
+                   plan == g_plan_registry.active ? " (active)" : "");
+            continue;
+        }
+#endif
+        printf("  N=%4d: %6u bytes%s\n", plan->size, (unsigned)plan->cfg_bytes,
+               plan == g_plan_registry.active ? " (active)" : "");
+    }
+    printf("  Arena: %u bytes\n", (unsigned)g_plan_registry.arena_bytes);
+}
@@ -0,0 +1,150 @@
+/*****************************************************************************
+* | File      	:   fft_plan.h
+* | Author      :   PicoFFT Project
+* | Function    :   Cached FFT plan registry for runtime size switching
+* | Info        :   
+*   - kiss_fft/kiss_fftr configurations for every supported size, built once
+*     at startup through kiss_fft's user-memory (lenmem) mode
+*   - Plans come from the static arena (fft_arena.h), window tables from a
+*     static pool (no malloc)
+*   - Switching size is a pointer swap, no allocation or twiddle recomputation
+*   - Mixed-radix sizes (1280, 1600) give decimal bin widths (100 Hz, 80 Hz)
+*   - With the generated backend, sizes that have a specialized kernel
+*     (fft_kernel.h) use it instead of a kiss_fft plan
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_PLAN_H
+#define __FFT_PLAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config_settings.h"
+#include "kiss_fft.h"
+#include "kiss_fftr.h"
+#include "fft_window.h"
+#include "fft_kernel.h"
+
+// Registry configuration: powers of two plus mixed-radix sizes with decimal bin
+// widths at 128 kHz (1280 = 100 Hz, 1600 = 80 Hz), so calibration tones on a
+// 100 Hz grid sit on bin centers. Every size must be even and a kiss_fft fast
+// size (factors 2, 3, 5 only)
+#define FFT_PLAN_SIZE_LIST {256, 512, 1024, 1280, 1600, 2048, 4096}
+#define FFT_PLAN_SIZE_COUNT 7
+#define FFT_PLAN_MIN_SIZE 256
+#define FFT_PLAN_MAX_SIZE 4096
+#define FFT_PLAN_TOTAL_POINTS 10816         // Sum of FFT_PLAN_SIZE_LIST
+#define FFT_PLAN_BENCH_FRAMES 32            // Transforms timed per size by fft_plan_benchmark()
+
+// Points that still need a kiss_fft plan (generated kernels keep their
+// twiddles in flash; their sizes must be registered sizes)
+#ifdef FFT_BACKEND_GENERATED
+#define FFT_PLAN_KISS_POINTS (FFT_PLAN_TOTAL_POINTS - FFT_KERNEL_TOTAL_POINTS)
+#else
+#define FFT_PLAN_KISS_POINTS FFT_PLAN_TOTAL_POINTS
+#endif
+
+// Plan memory estimate (sizes the arena): twiddles (+ kiss_fftr scratch and super twiddles) per point,
+// plus the state headers and factor tables of each plan
+#if FFT_REAL_INPUT_ENABLED
+#define FFT_PLAN_POOL_BYTES (sizeof(kiss_fft_cpx) * (FFT_PLAN_KISS_POINTS * 5 / 4) + \
+                             512 * FFT_PLAN_SIZE_COUNT)
+#else
+#define FFT_PLAN_POOL_BYTES (sizeof(kiss_fft_cpx) * FFT_PLAN_KISS_POINTS + \
+                             512 * FFT_PLAN_SIZE_COUNT)
+#endif
+
+// Cached plan for one FFT size
+typedef struct {
+    int size;                   // FFT size (points)
+#if FFT_REAL_INPUT_ENABLED
+    kiss_fftr_cfg fftr_cfg;     // Real-input configuration (in the arena)
+#else
+    kiss_fft_cfg fft_cfg;       // Complex configuration (in the arena)
+#endif
+    size_t cfg_bytes;           // Arena bytes used by this plan
+#ifdef FFT_BACKEND_GENERATED
+    const fft_kernel_t* kernel; // Specialized kernel (NULL = kiss_fft plan)
+#endif
+} fft_plan_t;
+
+// Plan registry
+typedef struct {
+    fft_plan_t plans[FFT_PLAN_SIZE_COUNT];  // One plan per supported size
+    const fft_plan_t* active;               // Plan used by the processing loop
+    size_t arena_bytes;                     // Arena bytes used by all plans
+    bool initialized;
+} fft_plan_registry_t;
+
+// ========================================
+// 🔧 Plan Registry API
+// ========================================
+
+/**
+ * Build plans and window tables for all supported sizes
+ * Fails fast if the arena or the window pool is too small
+ * @param initial_size Size made active after initialization
+ * @param window_type Initial window type
+ * @return true if successful, false on error
+ */
+bool fft_plan_init(int initial_size, fft_window_type_t window_type);
+
+/**
+ * Make a cached plan and its window table active
+ * @param size FFT size (one of FFT_PLAN_SIZE_LIST)
+ * @return true if successful, false if size is not registered
+ */
+bool fft_plan_select(int size);
+
+/**
+ * Run the forward FFT of a plan
+ * @param plan Plan from the registry
+ * @param input N real samples (or N complex samples without FFT_REAL_INPUT_ENABLED)
+ * @param output Bins 0..N/2 (or 0..N-1 without FFT_REAL_INPUT_ENABLED)
+ */
+void fft_plan_forward(const fft_plan_t* plan, const fft_kernel_input_t* input, kiss_fft_cpx* output);
+
+/**
+ * Time the forward transform of every registered size and print the
+ * throughput table (us/frame, ns/point, load at the configured STFT hop)
+ * Uses the caller's FFT buffers; call before sampling starts
+ * @param input FFT_PLAN_MAX_SIZE input samples (may alias output)
+ * @param output FFT_PLAN_MAX_SIZE/2+1 bins (FFT_PLAN_MAX_SIZE without FFT_REAL_INPUT_ENABLED)
+ * @param frames Transforms per size
+ */
+void fft_plan_benchmark(fft_kernel_input_t* input, kiss_fft_cpx* output, int frames);
+
+/**
+ * Get the active plan
+ * @return Active plan, NULL before initialization
+ */
+const fft_plan_t* fft_plan_get_active(void);
+
+/**
+ * Get the cached plan of a size without making it active
+ * (for stages that run their own transform, e.g. the baseband spectrum)
+ * @param size FFT size
+ * @return Plan, NULL if not registered or before initialization
+ */
+const fft_plan_t* fft_plan_find(int size);
+
+/**
+ * Get the active FFT size
+ * @return FFT size, 0 before initialization
+ */
+int fft_plan_get_size(void);
+
+/**
+ * Check whether a size has a cached plan
+ * @param size FFT size
+ * @return true if size is registered
+ */
+bool fft_plan_is_supported(int size);
+
+/**
+ * Print registry contents and arena usage
+ */
+void fft_plan_print_registry(void);
+
+#endif // __FFT_PLAN_H
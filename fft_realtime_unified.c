@@ -13,10 +13,24 @@
 #include "fft_realtime_unified.h"
 #include "adc_sampling.h"
 #include "fft_streaming_display.h"
+#include "fft_window.h"
+#include "fft_welch.h"
+#include "fft_zoom.h"
+#include "fft_baseband.h"
+#include "fft_goertzel.h"
+#include "fft_peaks.h"
+#include "fft_distortion.h"
+#include "fft_trace.h"
+#include "fft_octave.h"
+#include "fft_cross.h"
+#include "fft_sdft.h"
+#include "fft_arena.h"
+#include "fft_pipeline.h"
 #include "config_settings.h"
 #include "DEV_Config.h"
 #include "LCD_Driver.h"
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 // Performance monitoring variables
@@ -24,6 +38,69 @@ static absolute_time_t last_frame_time;
 static float actual_fps = 0.0f;
 static uint32_t frame_count = 0;
 static uint32_t error_count = 0;
+static uint32_t spectrum_count = 0;
+static fft_analysis_mode_t analysis_mode = (fft_analysis_mode_t)FFT_ANALYSIS_MODE;
+static bool zoom_enabled = false;
+static fft_tracker_mode_t tracker_mode = (fft_tracker_mode_t)GOERTZEL_TRACKER_MODE;
+
+// Stage settings kept in Hz so a sample rate change can rebuild the stages
+static float zoom_center_hz = FFT_ZOOM_CENTER_HZ;
+static float zoom_span_hz = FFT_ZOOM_SPAN_HZ;
+static float tracker_hz[FFT_GOERTZEL_MAX_TONES];
+static int tracker_count = 0;
+
+// Spectrum slot: everything one display update draws. The analysis side
+// fills it (peak detector over all frames merged since the last update, or
+// the PSD / sliding DFT result), the render side draws it and reuses the
+// buffers for the finished traces
+typedef struct {
+    float* spectrum;                        // Bins (fft_size / 2)
+    float* columns;                         // Constant-Q columns of the log axis (NULL without)
+    bool spectrum_ready;
+    bool columns_ready;
+    bool tracker_updated;
+    uint32_t frames;                        // ADC frames merged into this slot
+    int fft_size;                           // Settings the slot was analyzed with
+    float sample_rate;
+    fft_analysis_mode_t analysis_mode;
+    uint32_t generation;                    // Setter commands completed before the slot was filled
+} fft_spectrum_slot_t;
+
+#if DUAL_CORE_PIPELINE_ENABLED && !FFT_REAL_INPUT_ENABLED && !defined(FIXED_POINT)
+// The complex float build runs the baseband and octave FFTs in place, which
+// kiss_fft copies through an alloca() buffer larger than the core 1 stack
+#error "DUAL_CORE_PIPELINE_ENABLED needs FFT_REAL_INPUT_ENABLED or a FIXED_POINT build"
+#endif
+
+// Slot 0 is static, the second slot of the dual-core pipeline comes from the arena
+static float slot0_spectrum[FFT_SPECTRUM_SLOT_BINS];  // Two-channel mode caps the FFT size
+#if USE_LOG_FREQ_SCALE
+static float slot0_columns[STREAM_BUFFER_COLS];
+#endif
+static fft_spectrum_slot_t spectrum_slots[FFT_SPECTRUM_SLOTS];
+
+#if DUAL_CORE_PIPELINE_ENABLED
+// Each side's handoff state lives on its own core
+static fft_pipeline_producer_t pipeline_producer;
+static fft_pipeline_consumer_t pipeline_consumer;
+static uint32_t pipeline_stale = 0;          // Slots analyzed before the last setter, not rendered
+
+// Setters run on core 1 once it analyzes (set by core 0 before the launch)
+static fft_pipeline_mailbox_t pipeline_mailbox;
+static bool analysis_core_running = false;
+#endif
+
+// Called by the render loop between updates (runtime setters are safe there)
+static void (*control_hook)(void) = NULL;
+
+// Trace roles
+#define TRACE_SPECTRUM 0                    // Green spectrum
+#define TRACE_HOLD 1                        // Cyan hold line
+
+#if USE_LOG_FREQ_SCALE
+// Finished hold trace of the constant-Q columns
+static float column_hold[STREAM_BUFFER_COLS];
+#endif
 
 /**
  * Initialize unified real-time FFT analysis system
@@ -47,15 +124,97 @@ bool fft_realtime_unified_init(void) {
     printf("Streaming display system initialized.\n");
     
     // Initialize unified ADC sampling system
-    adc_sampling_mode_t mode = ADC_DMA_ENABLED ? ADC_MODE_DMA : ADC_MODE_MANUAL;
+    adc_sampling_mode_t mode = !ADC_DMA_ENABLED ? ADC_MODE_MANUAL :
+                               ADC_DMA_RING_BUFFER_MODE ? ADC_MODE_DMA_RING : ADC_MODE_DMA;
     printf("Initializing ADC sampling system in %s mode...\n", 
-           mode == ADC_MODE_DMA ? "DMA" : "Manual");
+           adc_sampling_get_mode_name(mode));
     
     if (!adc_sampling_init(mode)) {
         printf("ERROR: Failed to initialize ADC sampling system!\n");
         return false;
     }
     
+    // Initialize display traces (averaging and holds in the power domain)
+    int hold_frames = PEAK_HOLD_DURATION_MS * TARGET_FPS / 1000;
+    if (hold_frames > 255) hold_frames = 255;
+    if (!fft_trace_init(TRACE_COUNT, TRACE_AVERAGE_COUNT, hold_frames,
+                        TRACE_HOLD_DECAY_DB_PER_SEC / TARGET_FPS)) {
+        return false;
+    }
+    if (TRACE_COUNT > TRACE_HOLD && !fft_trace_set_mode(TRACE_HOLD, (fft_trace_mode_t)TRACE_HOLD_MODE)) {
+        return false;
+    }
+    
+    // Initialize Welch PSD accumulator and the startup analysis mode
+    if (!fft_welch_init(WELCH_SEGMENT_COUNT)) {
+        return false;
+    }
+    fft_realtime_unified_set_analysis_mode((fft_analysis_mode_t)FFT_ANALYSIS_MODE);
+    
+    // Initialize zoom FFT (runs alongside the main spectrum when enabled)
+    if (!fft_zoom_init()) {
+        return false;
+    }
+    fft_realtime_unified_set_zoom(FFT_ZOOM_ENABLED, FFT_ZOOM_CENTER_HZ, FFT_ZOOM_SPAN_HZ);
+    
+    // Decimated 0 - fs/16 baseband spectrum from the same stream
+    adc_sampling_set_baseband_enabled(FFT_BASEBAND_ENABLED);
+    
+    // Initialize Goertzel tracker on the marker frequencies
+    const int marker_hz[FREQ_MARKERS_COUNT] = FREQ_MARKERS_HZ_ARRAY;
+    for (int i = 0; i < FREQ_MARKERS_COUNT && i < FFT_GOERTZEL_MAX_TONES; i++) {
+        tracker_hz[tracker_count++] = (float)marker_hz[i];
+    }
+    if (!fft_goertzel_init(tracker_hz, tracker_count, GOERTZEL_BLOCK_SIZE, adc_sampling_get_nominal_rate())) {
+        return false;
+    }
+    fft_realtime_unified_set_tracker_mode((fft_tracker_mode_t)GOERTZEL_TRACKER_MODE);
+    
+    // Sub-bin peak list of the displayed spectrum
+    if (!fft_peaks_init(PEAK_LIST_COUNT, PEAK_THRESHOLD_DBM, (fft_peaks_interp_t)PEAK_INTERPOLATION)) {
+        return false;
+    }
+    
+    // Distortion measurement of every spectrum-mode frame
+    if (!fft_distortion_init(DISTORTION_MAX_HARMONIC, DISTORTION_FUNDAMENTAL_HZ)) {
+        return false;
+    }
+    
+#if USE_LOG_FREQ_SCALE
+    // Octave cascade resolving every column of the log frequency axis
+    if (!fft_octave_init(adc_sampling_get_nominal_rate(), (float)FREQUENCY_RANGE_MIN,
+                         (float)FREQUENCY_RANGE_MAX, STREAM_BUFFER_COLS)) {
+        return false;
+    }
+#endif
+    
+    // Spectrum slots of the analysis -> render handoff (slot 0 is static)
+    spectrum_slots[0].spectrum = slot0_spectrum;
+#if USE_LOG_FREQ_SCALE
+    spectrum_slots[0].columns = slot0_columns;
+#endif
+    for (int i = 1; i < FFT_SPECTRUM_SLOTS; i++) {
+        float* slot_buffer = (float*)fft_arena_alloc(FFT_SPECTRUM_SLOT_BYTES, "spectrum slot");
+        if (slot_buffer == NULL) {
+            return false;
+        }
+        spectrum_slots[i].spectrum = slot_buffer;
+        spectrum_slots[i].columns = USE_LOG_FREQ_SCALE ? slot_buffer + FFT_SPECTRUM_SLOT_BINS : NULL;
+    }
+    
+    // All long-lived buffers are carved: later arena allocations are errors
+    fft_arena_lock();
+    fft_arena_print_usage();
+    
+#if FFT_SIZE_BENCHMARK_ENABLED
+    // Power-of-two vs mixed-radix throughput on this target
+    adc_sampling_benchmark_fft(FFT_PLAN_BENCH_FRAMES);
+#endif
+#if USE_LOG_FREQ_SCALE && LOG_FREQ_BENCHMARK_ENABLED
+    // Per-bin log remap vs octave cascade on this target
+    fft_octave_benchmark(slot0_columns, adc_sampling_get_fft_size(), FFT_PLAN_BENCH_FRAMES);
+#endif
+    
     // Start ADC sampling
     if (!adc_sampling_start()) {
         printf("ERROR: Failed to start ADC sampling!\n");
@@ -66,62 +225,359 @@ bool fft_realtime_unified_init(void) {
     last_frame_time = get_absolute_time();
     frame_count = 0;
     error_count = 0;
+    spectrum_count = 0;
     actual_fps = 0.0f;
     
     printf("=== Unified Real-time FFT Analysis System Initialized ===\n");
     printf("Configuration:\n");
-    printf("  ADC Mode: %s\n", mode == ADC_MODE_DMA ? "DMA" : "Manual");
-    printf("  Sampling Rate: %d Hz\n", SAMPLING_RATE_HZ);
-    printf("  FFT Size: %d\n", 1024);
+    printf("  ADC Mode: %s\n", adc_sampling_get_mode_name(mode));
+    printf("  Sampling Rate: %.1f Hz (runtime %.0f - %.0f Hz)\n", adc_sampling_get_nominal_rate(),
+           ADC_SAMPLE_RATE_MIN_HZ, ADC_SAMPLE_RATE_MAX_HZ);
+    printf("  FFT Size: %d (bin %.1f Hz, cached plans: %d-%d)\n", adc_sampling_get_fft_size(),
+           adc_sampling_get_nominal_rate() / adc_sampling_get_fft_size(), FFT_PLAN_MIN_SIZE, FFT_PLAN_MAX_SIZE);
+#ifdef FIXED_POINT
+    printf("  Pipeline: Q%d fixed-point\n", FIXED_POINT == 32 ? 31 : 15);
+#else
+    printf("  Pipeline: float\n");
+#endif
     printf("  Target FPS: %d\n", TARGET_FPS);
     printf("  Window Function: %s (Type=%d)\n", 
-           fft_realtime_unified_get_window_name(), FFT_WINDOW_TYPE);
+           fft_realtime_unified_get_window_name(), fft_window_get_type());
+    printf("  Analysis Mode: %s\n", fft_realtime_unified_get_analysis_mode_name(analysis_mode));
+    printf("  Traces: Spectrum=%s, Hold=%s (N=%d)\n",
+           fft_trace_get_mode_name(fft_trace_get_mode(TRACE_SPECTRUM)),
+           TRACE_COUNT > TRACE_HOLD ? fft_trace_get_mode_name(fft_trace_get_mode(TRACE_HOLD)) : "off",
+           TRACE_AVERAGE_COUNT);
+    printf("  Zoom FFT: %s\n", zoom_enabled ? "enabled" : "disabled");
+    printf("  Baseband: %s (0-%.0f Hz, bin %.2f Hz)\n",
+           adc_sampling_is_baseband_enabled() ? "enabled" : "disabled",
+           fft_baseband_get_bin_width(adc_sampling_get_nominal_rate()) * FFT_BASEBAND_FFT_SIZE / 2.0f,
+           fft_baseband_get_bin_width(adc_sampling_get_nominal_rate()));
+    printf("  Goertzel Tracker: %s (%d tones, %.0f updates/s)\n",
+           fft_realtime_unified_get_tracker_mode_name(tracker_mode),
+           fft_goertzel_get_tone_count(), fft_goertzel_get_update_rate());
+    printf("  Peak List: top %d above %.0f dBm (%s)\n", PEAK_LIST_COUNT, PEAK_THRESHOLD_DBM,
+           fft_peaks_get_method_name((fft_peaks_interp_t)PEAK_INTERPOLATION));
+    printf("  Distortion: %s (harmonics 2-%d, %d leakage bins)\n",
+           DISTORTION_ENABLED ? "enabled" : "disabled", DISTORTION_MAX_HARMONIC,
+           fft_distortion_get_leakage_bins(fft_window_get_type()));
+    printf("  Cross Spectrum: %s (B/A, N=%d, FFT size up to %d)\n",
+           adc_sampling_get_channel_count() > 1 ? "enabled" : "disabled",
+           CROSS_SPECTRUM_AVERAGES, FFT_CROSS_MAX_SIZE);
+    printf("  Pipeline Cores: %s\n", DUAL_CORE_PIPELINE_ENABLED ?
+           "analysis on core 1, rendering on core 0" : "analysis and rendering on core 0");
     printf("  Frequency Range: %d - %d Hz\n", FREQUENCY_RANGE_MIN, FREQUENCY_RANGE_MAX);
+#if USE_LOG_FREQ_SCALE
+    printf("  Log Axis: constant-Q, %d octave stages x %d points (bin %.1f - %.1f Hz)\n",
+           FFT_OCTAVE_STAGES, FFT_OCTAVE_FFT_SIZE, fft_octave_get_bin_width(0),
+           fft_octave_get_bin_width(FFT_OCTAVE_STAGES - 1));
+#endif
     printf("  Amplitude Range: %d to %d dBm\n", AMPLITUDE_RANGE_MIN_DB, AMPLITUDE_RANGE_MAX_DB);
     
     return true;
 }
 
+// ========================================
+// 🔧 Analysis and Render Stages
+// ========================================
+
+static void _fft_realtime_draw(float* magnitude_spectrum, float* column_spectrum,
+                               int fft_size, float sample_rate);
+
+/**
+ * Empty a spectrum slot before the analysis side fills it again
+ */
+static void _fft_realtime_clear_slot(fft_spectrum_slot_t* slot) {
+    slot->spectrum_ready = false;
+    slot->columns_ready = false;
+    slot->tracker_updated = false;
+    slot->frames = 0;
+    slot->fft_size = adc_sampling_get_fft_size();
+    slot->sample_rate = adc_sampling_get_sample_rate();
+    slot->analysis_mode = analysis_mode;
+#if DUAL_CORE_PIPELINE_ENABLED
+    slot->generation = fft_pipeline_mailbox_generation(&pipeline_mailbox);
+#else
+    slot->generation = 0;
+#endif
+}
+
+/**
+ * Discard the state a torn frame fed into the stream stages
+ */
+static void _fft_realtime_reset_stream_stages(void) {
+    if (analysis_mode == FFT_ANALYSIS_SLIDING_DFT) {
+        fft_sdft_reset();
+    }
+    if (zoom_enabled) {
+        fft_zoom_reset();
+    }
+    if (USE_LOG_FREQ_SCALE) {
+        fft_octave_reset();
+    }
+    if (tracker_mode != FFT_TRACKER_OFF) {
+        fft_goertzel_reset();
+    }
+}
+
+/**
+ * Check whether a slot holds anything for the render side
+ */
+static bool _fft_realtime_slot_has_update(const fft_spectrum_slot_t* slot) {
+    return slot->spectrum_ready || (tracker_mode == FFT_TRACKER_ONLY && slot->tracker_updated);
+}
+
+/**
+ * Analysis stage: process every frame that became ready into a slot
+ * In ring mode several overlapped frames arrive per display frame; spectrum
+ * mode combines them with a positive-peak detector so short transients
+ * survive, Welch mode averages them in the linear power domain, and the
+ * sliding DFT advances sample by sample without a block FFT. Frames keep
+ * merging into the slot until it is cleared. A torn frame publishes nothing:
+ * the stream stages it fed are reset, and the tracker and sliding DFT only
+ * publish frames complete_processing() reports intact
+ * @return Frames processed by this call
+ */
+static int _fft_realtime_analyze(fft_spectrum_slot_t* slot) {
+    int frames_this_update = 0;
+    int bins = adc_sampling_get_fft_size() / 2;
+    float sample_rate = adc_sampling_get_sample_rate();
+    while (frames_this_update < MAX_FRAMES_PER_UPDATE && adc_sampling_is_ready()) {
+        bool tracker_block = false;
+        
+        // Stream stages see the raw samples once (only the new part of overlapped frames)
+        if (!adc_sampling_is_frame_torn() &&
+            (zoom_enabled || tracker_mode != FFT_TRACKER_OFF || USE_LOG_FREQ_SCALE ||
+             analysis_mode == FFT_ANALYSIS_SLIDING_DFT)) {
+            int new_count = 0;
+            const adc_sample_t* new_samples = adc_sampling_get_new_samples(&new_count);
+            if (analysis_mode == FFT_ANALYSIS_SLIDING_DFT) {
+                fft_sdft_process(new_samples, new_count);
+            }
+            if (zoom_enabled) {
+                fft_zoom_process(new_samples, new_count);
+            }
+            if (USE_LOG_FREQ_SCALE) {
+                fft_octave_process(new_samples, new_count);
+            }
+            if (tracker_mode != FFT_TRACKER_OFF) {
+                tracker_block = fft_goertzel_process(new_samples, new_count) > 0;
+            }
+            
+            // The stages have read the slot for the last time: a frame DMA
+            // reached meanwhile must not stay in any of their histories
+            if (!adc_sampling_check_frame()) {
+                _fft_realtime_reset_stream_stages();
+            }
+        }
+        
+        // Torn frame (here or in the baseband stage): nothing is published
+        if (adc_sampling_is_frame_torn()) {
+            frames_this_update++;
+            adc_sampling_complete_processing();
+            continue;
+        }
+        
+        // Tracker-only: no FFT for this frame
+        if (tracker_mode == FFT_TRACKER_ONLY) {
+            frames_this_update++;
+            if (adc_sampling_complete_processing() && tracker_block) {
+                slot->tracker_updated = true;
+            }
+            continue;
+        }
+        
+        // Sliding DFT: bins already hold the newest sample, no block FFT
+        if (analysis_mode == FFT_ANALYSIS_SLIDING_DFT) {
+            frames_this_update++;
+            spectrum_count++;
+            if (adc_sampling_complete_processing() && fft_sdft_get_magnitude(slot->spectrum)) {
+                slot->spectrum_ready = true;
+            }
+            continue;
+        }
+        if (tracker_block) {
+            slot->tracker_updated = true;
+        }
+        
+        // Process FFT on current buffer; a frame DMA overwrote while it was
+        // windowed is dropped here, before the detector, Welch or distortion
+        if (!adc_sampling_process_fft()) {
+            if (adc_sampling_is_frame_torn()) {
+                frames_this_update++;
+                adc_sampling_complete_processing();
+                continue;
+            }
+            error_count++;
+            printf("Warning: FFT processing failed (error #%lu)\n", error_count);
+            break;
+        }
+        
+        if (analysis_mode == FFT_ANALYSIS_WELCH_PSD) {
+            // One add per bin per segment; a PSD is published every K segments
+            // (copied: the accumulator keeps running while the slot is drawn)
+            if (fft_welch_accumulate(adc_sampling_get_fft_output(), 
+                                     adc_sampling_get_fft_size(), sample_rate)) {
+                memcpy(slot->spectrum, fft_welch_get_psd(), (size_t)bins * sizeof(float));
+                slot->spectrum_ready = true;
+            }
+        } else {
+            // Get FFT magnitude spectrum
+            float* magnitude = adc_sampling_get_magnitude_spectrum();
+            if (magnitude != NULL) {
+                if (DISTORTION_ENABLED) {
+                    fft_distortion_analyze(magnitude, bins, sample_rate / adc_sampling_get_fft_size());
+                }
+                for (int bin = 0; bin < bins; bin++) {
+                    if (!slot->spectrum_ready || magnitude[bin] > slot->spectrum[bin]) {
+                        slot->spectrum[bin] = magnitude[bin];
+                    }
+                }
+                slot->spectrum_ready = true;
+            }
+        }
+        frames_this_update++;
+        spectrum_count++;
+        
+        // Signal that processing is complete
+        adc_sampling_complete_processing();
+    }
+    
+    slot->frames += frames_this_update;
+    return frames_this_update;
+}
+
+/**
+ * Finish a slot on the analysis side: constant-Q columns of the log axis
+ * (the octave cascade belongs to the analysis stage like the other stream stages)
+ */
+static void _fft_realtime_finish(fft_spectrum_slot_t* slot) {
+#if USE_LOG_FREQ_SCALE
+    // PSD and sliding DFT keep the bin remap; until the lowest octave has
+    // filled, the bins are drawn as well
+    slot->columns_ready = (analysis_mode == FFT_ANALYSIS_SPECTRUM && slot->spectrum_ready &&
+                           fft_octave_get_columns(slot->columns));
+#else
+    slot->columns_ready = false;
+#endif
+}
+
+/**
+ * Render stage: draw a finished slot and update the performance counters
+ */
+static void _fft_realtime_render(fft_spectrum_slot_t* slot) {
+    if (slot->spectrum_ready) {
+        _fft_realtime_draw(slot->spectrum, slot->columns_ready ? slot->columns : NULL,
+                           slot->fft_size, slot->sample_rate);
+        
+        // Peak list of the displayed spectrum trace (the slot now holds it, or
+        // the detector output when the log axis draws constant-Q columns;
+        // level correction assumes the main window, so not PSD/SDFT)
+        if (slot->analysis_mode == FFT_ANALYSIS_SPECTRUM) {
+            fft_peaks_find(slot->spectrum, slot->fft_size / 2, slot->sample_rate / slot->fft_size);
+        }
+    }
+    
+    // Update performance counters
+    frame_count++;
+    
+    // Print periodic status (every 100 frames)
+    if (frame_count % 100 == 0) {
+        fft_realtime_unified_print_status();
+    }
+}
+
+#if DUAL_CORE_PIPELINE_ENABLED
+/**
+ * Core 1 entry: analysis stage of the dual-core pipeline
+ * Publishes one slot per display frame. While core 0 still draws the other
+ * slot, frames keep merging into this one, so rendering never drops a frame
+ * from the detector and the FFT of the next update overlaps the SPI transfer
+ */
+static void _fft_realtime_analysis_core(void) {
+    fft_spectrum_slot_t* slot = &spectrum_slots[fft_pipeline_producer_slot(&pipeline_producer)];
+    absolute_time_t last_publish_time = get_absolute_time();
+    _fft_realtime_clear_slot(slot);
+    
+    while (true) {
+        // Setters of core 0 run here, between frames; frames merged under
+        // the old settings are dropped with the slot
+        if (fft_pipeline_mailbox_poll(&pipeline_mailbox)) {
+            _fft_realtime_clear_slot(slot);
+        }
+        
+        if (_fft_realtime_analyze(slot) == 0) {
+            tight_loop_contents();
+        }
+        
+        // Columns are only computed for a slot that can be handed over now
+        absolute_time_t now = get_absolute_time();
+        if (_fft_realtime_slot_has_update(slot) &&
+            absolute_time_diff_us(last_publish_time, now) >= TARGET_FRAME_TIME_US &&
+            fft_pipeline_producer_ready(&pipeline_producer)) {
+            _fft_realtime_finish(slot);
+            fft_pipeline_producer_publish(&pipeline_producer);
+            last_publish_time = now;
+            
+            slot = &spectrum_slots[fft_pipeline_producer_slot(&pipeline_producer)];
+            _fft_realtime_clear_slot(slot);
+        }
+    }
+}
+#endif
+
 /**
  * Main unified real-time FFT analysis loop
  */
 void fft_realtime_unified_run(void) {
     printf("Starting unified real-time FFT analysis loop...\n");
     
+#if DUAL_CORE_PIPELINE_ENABLED
+    // Core 1 runs the analysis stage, this core only renders
+    fft_pipeline_producer_reset(&pipeline_producer, FFT_SPECTRUM_SLOTS);
+    fft_pipeline_consumer_reset(&pipeline_consumer, FFT_SPECTRUM_SLOTS);
+    fft_pipeline_mailbox_reset(&pipeline_mailbox);
+    analysis_core_running = true;
+    fft_pipeline_port_launch(_fft_realtime_analysis_core);
+    printf("Dual-core pipeline: analysis on core 1, rendering on core 0 (%d spectrum slots)\n",
+           FFT_SPECTRUM_SLOTS);
+#endif
+    
     // Main processing loop
     while (true) {
+        // Runtime setters of the application (no slot is held here)
+        if (control_hook != NULL) {
+            control_hook();
+        }
+        
         absolute_time_t frame_start = get_absolute_time();
         
-        // Check if new ADC data is available
-        if (adc_sampling_is_ready()) {
-            
-            // Process FFT on current buffer
-            if (adc_sampling_process_fft()) {
-                
-                // Get FFT magnitude spectrum
-                float* magnitude = adc_sampling_get_magnitude_spectrum();
-                if (magnitude != NULL) {
-                    
-                    // Update streaming display with new spectrum data
-                    fft_realtime_unified_update_display(magnitude);
-                    
-                    // Update performance counters
-                    frame_count++;
-                    
-                    // Print periodic status (every 100 frames)
-                    if (frame_count % 100 == 0) {
-                        fft_realtime_unified_print_status();
-                    }
-                }
-                
-                // Signal that processing is complete
-                adc_sampling_complete_processing();
-                
-            } else {
-                error_count++;
-                printf("Warning: FFT processing failed (error #%lu)\n", error_count);
-            }
+#if DUAL_CORE_PIPELINE_ENABLED
+        // Core 1 paces the slots at the target frame rate
+        int slot_index = fft_pipeline_consumer_take(&pipeline_consumer);
+        if (slot_index < 0) {
+            sleep_us(PIPELINE_POLL_INTERVAL_US);
+            continue;
+        }
+        
+        // Slots analyzed before the last setter hold the old bin layout
+        fft_spectrum_slot_t* slot = &spectrum_slots[slot_index];
+        if (slot->generation != fft_pipeline_mailbox_generation(&pipeline_mailbox)) {
+            fft_pipeline_consumer_release(&pipeline_consumer);
+            pipeline_stale++;
+            continue;
         }
+        _fft_realtime_render(slot);
+        fft_pipeline_consumer_release(&pipeline_consumer);
+#else
+        fft_spectrum_slot_t* slot = &spectrum_slots[0];
+        _fft_realtime_clear_slot(slot);
+        _fft_realtime_analyze(slot);
+        if (_fft_realtime_slot_has_update(slot)) {
+            _fft_realtime_finish(slot);
+            _fft_realtime_render(slot);
+        }
+#endif
         
         // Calculate frame timing
         absolute_time_t frame_end = get_absolute_time();
@@ -136,7 +592,7 @@ void fft_realtime_unified_run(void) {
         
         // Frame rate control
         int64_t target_frame_time_us = TARGET_FRAME_TIME_US;
-        if (frame_time_us < target_frame_time_us) {
+        if (!DUAL_CORE_PIPELINE_ENABLED && frame_time_us < target_frame_time_us) {
             int64_t sleep_time_us = target_frame_time_us - frame_time_us;
             if (sleep_time_us > 0) {
                 sleep_us(sleep_time_us);
@@ -153,6 +609,13 @@ void fft_realtime_unified_run(void) {
     }
 }
 
+/**
+ * Register the runtime control callback of the render loop
+ */
+void fft_realtime_unified_set_control_hook(void (*hook)(void)) {
+    control_hook = hook;
+}
+
 /**
  * Debug function: Print Y-axis amplitude mapping details
  */
@@ -169,10 +632,11 @@ void fft_realtime_unified_debug_amplitude_mapping(float* magnitude_spectrum) {
     printf("-------|--------------|------------|---------|-------------|----------\n");
     
     // Target 20kHz analysis
-    int fft_bin_20k = (int)(20000.0f * ADC_SAMPLING_FFT_SIZE / ADC_SAMPLING_RATE + 0.5f);
-    float raw_db = magnitude_spectrum[fft_bin_20k];
+    int fft_bin_20k = (int)(20000.0f * adc_sampling_get_fft_size() / adc_sampling_get_sample_rate() + 0.5f);
+    // Spectrum from the dB stage already includes the window correction
+    float corrected_db = magnitude_spectrum[fft_bin_20k];
     float window_correction = fft_realtime_unified_get_window_correction();
-    float corrected_db = raw_db + 20.0f * log10f(window_correction);
+    float raw_db = corrected_db - 20.0f * log10f(window_correction);
     
     // Calculate normalized position and Y coordinate (same as display system)
     float db_range = (float)(AMPLITUDE_RANGE_MAX_DB - AMPLITUDE_RANGE_MIN_DB);  // 120dB range
@@ -242,11 +706,17 @@ void fft_realtime_unified_debug_amplitude_mapping(float* magnitude_spectrum) {
  * Debug function: Print frequency mapping details
  */
 void fft_realtime_unified_debug_frequency_mapping(float* magnitude_spectrum) {
+    const int fft_size = adc_sampling_get_fft_size();
+    const float sample_rate = adc_sampling_get_sample_rate();
+    float range_min = 0.0f;
+    float range_max = 0.0f;
+    fft_streaming_display_get_frequency_range(&range_min, &range_max);
+    
     printf("\n=== 🔍 Frequency Mapping Debug ===\n");
-    printf("FFT_SIZE: %d, SAMPLE_RATE: %d Hz\n", ADC_SAMPLING_FFT_SIZE, ADC_SAMPLING_RATE);
+    printf("FFT_SIZE: %d, SAMPLE_RATE: %.1f Hz\n", fft_size, sample_rate);
     printf("STREAM_BUFFER_COLS: %d\n", STREAM_BUFFER_COLS);
     
-    int fft_bins_per_col = (ADC_SAMPLING_FFT_SIZE/2) / STREAM_BUFFER_COLS;
+    int fft_bins_per_col = (fft_size/2) / STREAM_BUFFER_COLS;
     if (fft_bins_per_col < 1) fft_bins_per_col = 1;
     printf("FFT bins per column: %d\n", fft_bins_per_col);
     
@@ -262,11 +732,11 @@ void fft_realtime_unified_debug_frequency_mapping(float* magnitude_spectrum) {
         float test_freq = test_freqs[i];
         
         // Calculate FFT bin for this frequency
-        int fft_bin = (int)(test_freq * ADC_SAMPLING_FFT_SIZE / ADC_SAMPLING_RATE + 0.5f);
-        float actual_bin_freq = (float)fft_bin * ADC_SAMPLING_RATE / ADC_SAMPLING_FFT_SIZE;
+        int fft_bin = (int)(test_freq * fft_size / sample_rate + 0.5f);
+        float actual_bin_freq = (float)fft_bin * sample_rate / fft_size;
         
         // Calculate axis label position (using display system's function)
-        float normalized_axis = (test_freq - FREQUENCY_RANGE_MIN) / (FREQUENCY_RANGE_MAX - FREQUENCY_RANGE_MIN);
+        float normalized_axis = (test_freq - range_min) / (range_max - range_min);
         int axis_x = STREAM_SPECTRUM_X + (int)(normalized_axis * STREAM_SPECTRUM_W);
         
         // Calculate spectrum display position (using display system's bin processing)
@@ -276,8 +746,8 @@ void fft_realtime_unified_debug_frequency_mapping(float* magnitude_spectrum) {
         
         // Simulate display system's bin-to-column mapping
         float bin_freq_for_display = actual_bin_freq;
-        if (bin_freq_for_display >= FREQUENCY_RANGE_MIN && bin_freq_for_display <= FREQUENCY_RANGE_MAX) {
-            float normalized_spectrum = (bin_freq_for_display - FREQUENCY_RANGE_MIN) / (FREQUENCY_RANGE_MAX - FREQUENCY_RANGE_MIN);
+        if (bin_freq_for_display >= range_min && bin_freq_for_display <= range_max) {
+            float normalized_spectrum = (bin_freq_for_display - range_min) / (range_max - range_min);
             spectrum_col = (int)(normalized_spectrum * STREAM_BUFFER_COLS);
             if (spectrum_col >= STREAM_BUFFER_COLS) spectrum_col = STREAM_BUFFER_COLS - 1;
             spectrum_x = STREAM_SPECTRUM_X + spectrum_col;
@@ -294,15 +764,15 @@ void fft_realtime_unified_debug_frequency_mapping(float* magnitude_spectrum) {
     printf("-----|-------------|-------|----------|----------\n");
     
     float freq_22_5k = 22500.0f;
-    int bin_22_5k = (int)(freq_22_5k * ADC_SAMPLING_FFT_SIZE / ADC_SAMPLING_RATE + 0.5f);
-    float actual_freq_from_bin = (float)bin_22_5k * ADC_SAMPLING_RATE / ADC_SAMPLING_FFT_SIZE;
+    int bin_22_5k = (int)(freq_22_5k * fft_size / sample_rate + 0.5f);
+    float actual_freq_from_bin = (float)bin_22_5k * sample_rate / fft_size;
     
     // Axis label position for 22.5kHz
-    float normalized_axis_22_5 = (freq_22_5k - FREQUENCY_RANGE_MIN) / (FREQUENCY_RANGE_MAX - FREQUENCY_RANGE_MIN);
+    float normalized_axis_22_5 = (freq_22_5k - range_min) / (range_max - range_min);
     int axis_x_22_5 = STREAM_SPECTRUM_X + (int)(normalized_axis_22_5 * STREAM_SPECTRUM_W);
     
     // Spectrum position for 22.5kHz signal
-    float normalized_spectrum_22_5 = (actual_freq_from_bin - FREQUENCY_RANGE_MIN) / (FREQUENCY_RANGE_MAX - FREQUENCY_RANGE_MIN);
+    float normalized_spectrum_22_5 = (actual_freq_from_bin - range_min) / (range_max - range_min);
     int spectrum_col_22_5 = (int)(normalized_spectrum_22_5 * STREAM_BUFFER_COLS);
     int spectrum_x_22_5 = STREAM_SPECTRUM_X + spectrum_col_22_5;
     
@@ -319,6 +789,19 @@ void fft_realtime_unified_debug_frequency_mapping(float* magnitude_spectrum) {
     printf("  6  | Spectrum X pos  | %6d px | %6d px | %6d px\n", 
            spectrum_x_22_5, axis_x_22_5, spectrum_x_22_5 - axis_x_22_5);
     
+    // Sub-bin peak search on the spectrum passed in (the bin estimate is off by up to half a bin)
+    if (magnitude_spectrum != NULL) {
+        int peak_count = fft_peaks_find(magnitude_spectrum, fft_size / 2, (float)sample_rate / fft_size);
+        const fft_peak_t* peaks = fft_peaks_get();
+        for (int i = 0; i < peak_count; i++) {
+            if (fabsf(peaks[i].frequency_hz - freq_22_5k) < 2.0f * sample_rate / fft_size) {
+                printf("  7  | Measured peak   | %8.1f Hz | %6.0f Hz | %6.1f Hz (%.2f dBm)\n",
+                       peaks[i].frequency_hz, freq_22_5k, peaks[i].frequency_hz - freq_22_5k, peaks[i].dbm);
+                break;
+            }
+        }
+    }
+    
     printf("\n🔍 Display System Simulation:\n");
     printf("The 22.5kHz signal should appear at X=%d, matching axis label at X=%d\n", 
            spectrum_x_22_5, axis_x_22_5);
@@ -341,9 +824,11 @@ void fft_realtime_unified_debug_frequency_mapping(float* magnitude_spectrum) {
 }
 
 /**
- * Update display with new spectrum data
+ * Draw one spectrum analyzed with the given FFT size and sample rate
+ * (render side: the traces and the display belong to core 0)
  */
-void fft_realtime_unified_update_display(float* magnitude_spectrum) {
+static void _fft_realtime_draw(float* magnitude_spectrum, float* column_spectrum,
+                               int fft_size, float sample_rate) {
     // Debug output for frequency and amplitude mapping (only first few times)
     static int debug_count = 0;
     if (debug_count < 3) {
@@ -352,22 +837,39 @@ void fft_realtime_unified_update_display(float* magnitude_spectrum) {
         debug_count++;
     }
     
-    // Convert FFT magnitude spectrum to display format
-    // The existing fft_streaming_display system expects magnitude_db array and sample_rate
-    
-    // ⚠️ IMPORTANT: The display system expects RAW FFT magnitude array, not pre-mapped!
-    // We pass the full magnitude_spectrum array directly, let display system do the mapping
+#if USE_LOG_FREQ_SCALE
+    // Log axis in spectrum mode: constant-Q columns replace the per-bin remap
+    // and the traces run per column
+    if (column_spectrum != NULL) {
+        fft_trace_update(column_spectrum, STREAM_BUFFER_COLS);
+        bool column_hold_ready = fft_trace_get_dbm(TRACE_HOLD, column_hold, STREAM_BUFFER_COLS);
+        if (fft_trace_get_dbm(TRACE_SPECTRUM, column_spectrum, STREAM_BUFFER_COLS)) {
+            fft_streaming_display_update_columns(column_spectrum, column_hold_ready ? column_hold : NULL);
+        }
+        return;
+    }
+#else
+    (void)column_spectrum;
+#endif
     
-    // Apply window correction to the entire spectrum
-    static float corrected_spectrum[ADC_SAMPLING_FFT_SIZE/2];
-    float window_correction = fft_realtime_unified_get_window_correction();
+    // Spectrum is already in window-corrected dBm (applied once as the dB stage
+    // offset in adc_sampling); averages and holds run on it in the power domain
+    fft_trace_update(magnitude_spectrum, fft_size / 2);
     
-    for (int bin = 0; bin < ADC_SAMPLING_FFT_SIZE/2; bin++) {
-        corrected_spectrum[bin] = magnitude_spectrum[bin] + 20.0f * log10f(window_correction);
+    // The display only draws finished traces (the input buffer is free again)
+    bool hold_ready = fft_trace_get_dbm(TRACE_HOLD, magnitude_spectrum, fft_size / 2);
+    fft_streaming_display_update_hold(hold_ready ? magnitude_spectrum : NULL, fft_size, sample_rate);
+    if (fft_trace_get_dbm(TRACE_SPECTRUM, magnitude_spectrum, fft_size / 2)) {
+        fft_streaming_display_update_spectrum(magnitude_spectrum, fft_size, sample_rate);
     }
-    
-    // Update streaming display with RAW spectrum and correct sample rate
-    fft_streaming_display_update_spectrum(corrected_spectrum, (float)ADC_SAMPLING_RATE);
+}
+
+/**
+ * Update display with new spectrum data
+ */
+void fft_realtime_unified_update_display(float* magnitude_spectrum, float* column_spectrum) {
+    _fft_realtime_draw(magnitude_spectrum, column_spectrum, adc_sampling_get_fft_size(),
+                       adc_sampling_get_sample_rate());
 }
 
 /**
@@ -377,21 +879,127 @@ void fft_realtime_unified_print_status(void) {
     printf("=== FFT Analysis Status (Frame #%lu) ===\n", frame_count);
     printf("Performance:\n");
     printf("  Actual FPS: %.1f (Target: %d)\n", actual_fps, TARGET_FPS);
+    printf("  Spectra Processed: %lu (hop %d samples)\n", spectrum_count, adc_sampling_get_hop_size());
     printf("  Processing Errors: %lu\n", error_count);
+#if DUAL_CORE_PIPELINE_ENABLED
+    // Counters of the other core are read as a snapshot (each one is a single word)
+    printf("  Pipeline: %lu slots published, %lu rendered (%lu skipped, %lu stale), %lu waits for a free slot\n",
+           pipeline_producer.published, pipeline_consumer.taken, pipeline_consumer.skipped,
+           pipeline_stale, pipeline_producer.stalls);
+#endif
     
     printf("ADC Sampling:\n");
-    printf("  Mode: %s\n", adc_sampling_get_mode() == ADC_MODE_DMA ? "DMA" : "Manual");
-    printf("  Actual Rate: %.1f Hz (Target: %d Hz)\n", 
-           adc_sampling_get_actual_rate(), SAMPLING_RATE_HZ);
+    printf("  Mode: %s\n", adc_sampling_get_mode_name(adc_sampling_get_mode()));
+    printf("  Actual Rate: %.1f Hz (Target: %.1f Hz)\n", 
+           adc_sampling_get_actual_rate(), adc_sampling_get_nominal_rate());
     printf("  Total Samples: %lu\n", adc_sampling_get_sample_count());
-    printf("  Buffer Overruns: %lu\n", adc_sampling_get_overrun_count());
+    printf("  Buffer Overruns: %lu (%lu torn frames dropped)\n", adc_sampling_get_overrun_count(),
+           adc_sampling_get_torn_count());
+    uint32_t queue_backlog = 0;
+    int queue_slots = adc_sampling_get_queue_slots(&queue_backlog);
+    if (queue_slots > 0) {
+        printf("  Frame Queue: %d slots (backlog %lu, lag up to %d frames without loss)\n",
+               queue_slots, (unsigned long)queue_backlog, queue_slots - 1);
+    }
     
     printf("Configuration:\n");
-    printf("  Window: %s (Type=%d, Correction=%.4f)\n", 
-           fft_realtime_unified_get_window_name(), FFT_WINDOW_TYPE,
-           fft_realtime_unified_get_window_correction());
-    printf("  Frequency Range: %d - %d Hz\n", FREQUENCY_RANGE_MIN, FREQUENCY_RANGE_MAX);
+    float sample_rate = adc_sampling_get_sample_rate();
+    float range_min = 0.0f;
+    float range_max = 0.0f;
+    fft_streaming_display_get_frequency_range(&range_min, &range_max);
+    printf("  FFT Size: %d (RBW %.1f Hz)\n", adc_sampling_get_fft_size(),
+           fft_window_get_enbw() * sample_rate / adc_sampling_get_fft_size());
+    printf("  Window: %s (Type=%d, Correction=%.4f, ENBW=%.3f bins)\n", 
+           fft_realtime_unified_get_window_name(), fft_window_get_type(),
+           fft_realtime_unified_get_window_correction(), fft_window_get_enbw());
+    printf("  Frequency Range: %.0f - %.0f Hz\n", range_min, range_max);
     printf("  Amplitude Range: %d to %d dBm\n", AMPLITUDE_RANGE_MIN_DB, AMPLITUDE_RANGE_MAX_DB);
+    printf("  Analysis: %s", fft_realtime_unified_get_analysis_mode_name(analysis_mode));
+    if (analysis_mode == FFT_ANALYSIS_SLIDING_DFT) {
+        printf(" (N=%d, bins %d-%d, %lu samples)", fft_sdft_get_size(), SDFT_FIRST_BIN,
+               SDFT_FIRST_BIN + SDFT_BIN_COUNT - 1, fft_sdft_get_sample_count());
+    }
+    if (analysis_mode == FFT_ANALYSIS_WELCH_PSD) {
+        printf(" (K=%d, %lu estimates, bin noise BW %.1f Hz)", fft_welch_get_segments(),
+               fft_welch_get_psd_count(),
+               fft_welch_get_bin_bandwidth(adc_sampling_get_fft_size(), sample_rate));
+    }
+    printf("\n");
+    
+    if (zoom_enabled) {
+        const float* zoom = fft_zoom_get_magnitude();
+        printf("  Zoom: %.1f Hz +/- %.1f Hz (bin %.2f Hz, %lu spectra)", 
+               fft_zoom_bin_to_frequency(FFT_ZOOM_FFT_SIZE / 2),
+               fft_zoom_get_span() / 2.0f,
+               fft_zoom_get_bin_width(), fft_zoom_get_spectrum_count());
+        if (zoom != NULL) {
+            int peak = 0;
+            for (int bin = 1; bin < FFT_ZOOM_FFT_SIZE; bin++) {
+                if (zoom[bin] > zoom[peak]) peak = bin;
+            }
+            printf(", peak %.2f Hz %.1f dBm", fft_zoom_bin_to_frequency(peak), zoom[peak]);
+        }
+        printf("\n");
+    }
+    
+#if USE_LOG_FREQ_SCALE
+    printf("  Log Axis: %lu constant-Q column spectra\n", fft_octave_get_update_count());
+#endif
+    
+    if (adc_sampling_is_baseband_enabled()) {
+        const float* baseband = adc_sampling_get_baseband_spectrum();
+        printf("  Baseband: 0-%.0f Hz (bin %.2f Hz, %lu spectra)",
+               adc_sampling_baseband_bin_to_frequency(adc_sampling_get_baseband_bins()),
+               fft_baseband_get_bin_width(sample_rate), fft_baseband_get_spectrum_count());
+        if (baseband != NULL) {
+            int peak = 1;
+            for (int bin = 2; bin < adc_sampling_get_baseband_bins(); bin++) {
+                if (baseband[bin] > baseband[peak]) peak = bin;
+            }
+            printf(", peak %.2f Hz %.1f dBm", adc_sampling_baseband_bin_to_frequency(peak), baseband[peak]);
+        }
+        printf("\n");
+    }
+    
+    if (analysis_mode == FFT_ANALYSIS_SPECTRUM && fft_peaks_get_count() > 0) {
+        const fft_peak_t* peaks = fft_peaks_get();
+        printf("  Peaks (%s):\n", fft_peaks_get_method_name((fft_peaks_interp_t)PEAK_INTERPOLATION));
+        for (int i = 0; i < fft_peaks_get_count(); i++) {
+            printf("    %9.2f Hz: %6.2f dBm\n", peaks[i].frequency_hz, peaks[i].dbm);
+        }
+    }
+    
+    const fft_distortion_result_t* distortion = fft_distortion_get_result();
+    if (DISTORTION_ENABLED && distortion != NULL) {
+        printf("  Distortion (%lu spectra): fundamental %.2f Hz %.2f dBm\n",
+               fft_distortion_get_measurement_count(), distortion->fundamental_hz,
+               distortion->fundamental_dbm);
+        printf("    THD %.2f dB (%.4f%%), THD+N %.2f dB, SNR %.2f dB\n",
+               distortion->thd_db, distortion->thd_percent, distortion->thdn_db, distortion->snr_db);
+        printf("    SINAD %.2f dB, SFDR %.2f dBc, ENOB %.2f bits\n",
+               distortion->sinad_db, distortion->sfdr_db, distortion->enob_bits);
+    }
+    
+    if (adc_sampling_get_channel_count() > 1 && fft_cross_get_frame_count() > 0) {
+        const int marker_hz[FREQ_MARKERS_COUNT] = FREQ_MARKERS_HZ_ARRAY;
+        printf("  Transfer B/A (H1, %lu frames):\n", fft_cross_get_frame_count());
+        for (int i = 0; i < FREQ_MARKERS_COUNT; i++) {
+            fft_cross_point_t point;
+            int bin = (int)((float)marker_hz[i] * adc_sampling_get_fft_size() / sample_rate + 0.5f);
+            if (fft_cross_get_point(bin, sample_rate, &point)) {
+                printf("    %8.1f Hz: %7.2f dB %7.1f deg, coherence %.3f\n",
+                       point.frequency_hz, point.gain_db, point.phase_deg, point.coherence);
+            }
+        }
+    }
+    
+    const float* tones = fft_goertzel_get_dbm();
+    if (tracker_mode != FFT_TRACKER_OFF && tones != NULL) {
+        printf("  Tracker (%lu blocks):\n", fft_goertzel_get_block_count());
+        for (int i = 0; i < fft_goertzel_get_tone_count(); i++) {
+            printf("    %8.1f Hz: %6.1f dBm\n", fft_goertzel_get_frequency(i), tones[i]);
+        }
+    }
     
     printf("===============================================\n");
 }
@@ -400,35 +1008,375 @@ void fft_realtime_unified_print_status(void) {
  * Get current window function name
  */
 const char* fft_realtime_unified_get_window_name(void) {
-    const char* window_names[] = {
-        "Rectangle", "Hamming", "Hann", "Blackman", 
-        "Blackman-Harris", "Kaiser-Bessel", "Flat-Top"
-    };
-    
-    if (FFT_WINDOW_TYPE >= 0 && FFT_WINDOW_TYPE < 7) {
-        return window_names[FFT_WINDOW_TYPE];
-    }
-    return "Unknown";
+    return fft_window_get_name(fft_window_get_type());
 }
 
 /**
  * Get current window function amplitude correction factor
  */
 float fft_realtime_unified_get_window_correction(void) {
-    const float window_corrections[] = {
-        WINDOW_AMPLITUDE_CORRECTION_RECTANGLE,
-        WINDOW_AMPLITUDE_CORRECTION_HAMMING,
-        WINDOW_AMPLITUDE_CORRECTION_HANN,
-        WINDOW_AMPLITUDE_CORRECTION_BLACKMAN,
-        WINDOW_AMPLITUDE_CORRECTION_BLACKMANHARRIS,
-        WINDOW_AMPLITUDE_CORRECTION_KAISER_BESSEL,
-        WINDOW_AMPLITUDE_CORRECTION_FLATTOP
-    };
-    
-    if (FFT_WINDOW_TYPE >= 0 && FFT_WINDOW_TYPE < 7) {
-        return window_corrections[FFT_WINDOW_TYPE];
-    }
-    return 1.0f;  // Default correction
+    return fft_window_get_amplitude_correction();
+}
+
+// ========================================
+// 🔧 Runtime Setters
+// ========================================
+
+// Setter arguments passed through the command mailbox
+typedef struct {
+    bool enabled;
+    float center_hz;
+    float span_hz;
+} zoom_command_t;
+
+typedef struct {
+    const float* frequencies_hz;
+    int count;
+} tracker_command_t;
+
+/**
+ * Run a setter on the analysis stage
+ * While core 1 analyzes, the setter is posted to it and runs between two
+ * frames while this core waits; before the launch (and in the single-core
+ * build) it runs right here
+ * @return Result of the setter
+ */
+static bool _fft_realtime_control(fft_pipeline_command_t command, const void* argument) {
+#if DUAL_CORE_PIPELINE_ENABLED
+    if (analysis_core_running) {
+        return fft_pipeline_mailbox_call(&pipeline_mailbox, command, argument);
+    }
+#endif
+    return command(argument);
+}
+
+/**
+ * Restart the display traces after an analysis change (render side)
+ */
+static void _fft_realtime_reset_traces(void) {
+    // Welch averaging replaces the spectrum trace average (and changes units)
+    fft_trace_set_mode(TRACE_SPECTRUM, analysis_mode == FFT_ANALYSIS_WELCH_PSD ? FFT_TRACE_CLEAR_WRITE :
+                                       (fft_trace_mode_t)TRACE_SPECTRUM_MODE);
+    fft_trace_reset();
+}
+
+/**
+ * Display span for a sample rate: keeps its place relative to Nyquist
+ */
+static void _fft_realtime_display_span(float sample_rate, float* range_min, float* range_max) {
+    float scale = sample_rate / (float)SAMPLING_RATE_HZ;
+    *range_min = (float)FREQUENCY_RANGE_MIN * scale;
+    *range_max = (float)FREQUENCY_RANGE_MAX * scale;
+}
+
+/**
+ * Analysis side of set_window (argument: int window type)
+ */
+static bool _fft_realtime_apply_window(const void* argument) {
+    int window_type = *(const int*)argument;
+    if (!adc_sampling_set_window((fft_window_type_t)window_type)) {
+        printf("ERROR: Invalid window type %d\n", window_type);
+        return false;
+    }
+    fft_welch_reset();  // Segments under different windows are not averaged together
+    printf("Window switched to %s (Correction=%.4f, ENBW=%.3f bins)\n",
+           fft_realtime_unified_get_window_name(),
+           fft_realtime_unified_get_window_correction(),
+           fft_window_get_enbw());
+    return true;
+}
+
+/**
+ * Analysis side of set_analysis_mode (argument: fft_analysis_mode_t)
+ */
+static bool _fft_realtime_apply_analysis_mode(const void* argument) {
+    fft_analysis_mode_t mode = *(const fft_analysis_mode_t*)argument;
+    if (mode < 0 || mode >= FFT_ANALYSIS_MODE_COUNT) {
+        printf("ERROR: Invalid analysis mode %d\n", mode);
+        return false;
+    }
+    if (mode == FFT_ANALYSIS_SLIDING_DFT &&
+        !fft_sdft_configure(adc_sampling_get_fft_size(), SDFT_FIRST_BIN, SDFT_BIN_COUNT, SDFT_HANN_WINDOW)) {
+        return false;
+    }
+    analysis_mode = mode;
+    fft_welch_reset();
+    printf("Analysis mode: %s\n", fft_realtime_unified_get_analysis_mode_name(mode));
+    return true;
+}
+
+/**
+ * Fall back to the spectrum mode when the sliding DFT cannot follow a change
+ */
+static void _fft_realtime_reconfigure_sdft(void) {
+    if (analysis_mode == FFT_ANALYSIS_SLIDING_DFT &&
+        !fft_sdft_configure(adc_sampling_get_fft_size(), SDFT_FIRST_BIN, SDFT_BIN_COUNT, SDFT_HANN_WINDOW)) {
+        fft_analysis_mode_t fallback = FFT_ANALYSIS_SPECTRUM;
+        _fft_realtime_apply_analysis_mode(&fallback);
+    }
+}
+
+/**
+ * Analysis side of set_fft_size (argument: int FFT size)
+ */
+static bool _fft_realtime_apply_fft_size(const void* argument) {
+    int fft_size = *(const int*)argument;
+    if (!adc_sampling_set_fft_size(fft_size)) {
+        printf("ERROR: FFT size %d has no cached plan\n", fft_size);
+        return false;
+    }
+    float sample_rate = adc_sampling_get_sample_rate();
+    printf("FFT size switched to %d (bin %.1f Hz, frame %.1f ms)\n",
+           fft_size, sample_rate / fft_size, 1000.0f * fft_size / sample_rate);
+    
+    // The sliding DFT window follows the FFT size (same display bin layout)
+    _fft_realtime_reconfigure_sdft();
+    return true;
+}
+
+/**
+ * Analysis side of set_overlap (argument: int hop divisor)
+ */
+static bool _fft_realtime_apply_overlap(const void* argument) {
+    int hop_divisor = *(const int*)argument;
+    if (!adc_sampling_set_hop_divisor(hop_divisor)) {
+        printf("ERROR: Invalid hop divisor %d (use 1, 2, 4 or 8)\n", hop_divisor);
+        return false;
+    }
+    printf("Frame hop set to %d samples (%.1f%% overlap)\n", adc_sampling_get_hop_size(),
+           100.0f * (1.0f - 1.0f / hop_divisor));
+    return true;
+}
+
+/**
+ * Analysis side of set_welch_segments (argument: int segment count)
+ */
+static bool _fft_realtime_apply_welch_segments(const void* argument) {
+    int segments = *(const int*)argument;
+    if (!fft_welch_set_segments(segments)) {
+        printf("ERROR: Invalid Welch segment count %d (max %d)\n", 
+               segments, FFT_WELCH_MAX_SEGMENTS);
+        return false;
+    }
+    printf("Welch averaging: K=%d segments\n", segments);
+    return true;
+}
+
+/**
+ * Analysis side of set_zoom (argument: zoom_command_t)
+ */
+static bool _fft_realtime_apply_zoom(const void* argument) {
+    const zoom_command_t* zoom = (const zoom_command_t*)argument;
+    if (!zoom->enabled) {
+        zoom_enabled = false;
+        return true;
+    }
+    if (!fft_zoom_configure(zoom->center_hz, zoom->span_hz, adc_sampling_get_nominal_rate())) {
+        return false;
+    }
+    zoom_center_hz = zoom->center_hz;
+    zoom_span_hz = zoom->span_hz;
+    zoom_enabled = true;
+    return true;
+}
+
+/**
+ * Analysis side of set_tracker_mode (argument: fft_tracker_mode_t)
+ */
+static bool _fft_realtime_apply_tracker_mode(const void* argument) {
+    fft_tracker_mode_t mode = *(const fft_tracker_mode_t*)argument;
+    if (mode < 0 || mode >= FFT_TRACKER_MODE_COUNT) {
+        printf("ERROR: Invalid tracker mode %d\n", mode);
+        return false;
+    }
+    tracker_mode = mode;
+    fft_goertzel_reset();
+    printf("Goertzel tracker: %s\n", fft_realtime_unified_get_tracker_mode_name(mode));
+    return true;
+}
+
+/**
+ * Analysis side of set_tracker_frequencies (argument: tracker_command_t)
+ */
+static bool _fft_realtime_apply_tracker_frequencies(const void* argument) {
+    const tracker_command_t* tracker = (const tracker_command_t*)argument;
+    if (!fft_goertzel_set_frequencies(tracker->frequencies_hz, tracker->count)) {
+        return false;
+    }
+    memcpy(tracker_hz, tracker->frequencies_hz, (size_t)tracker->count * sizeof(float));
+    tracker_count = tracker->count;
+    printf("Goertzel tracker: %d tones\n", tracker->count);
+    return true;
+}
+
+/**
+ * Analysis side of set_sample_rate (argument: float rate in Hz)
+ */
+static bool _fft_realtime_apply_sample_rate(const void* argument) {
+    if (!adc_sampling_set_sample_rate(*(const float*)argument)) {
+        return false;
+    }
+    float sample_rate = adc_sampling_get_nominal_rate();
+    float range_min = 0.0f;
+    float range_max = 0.0f;
+    _fft_realtime_display_span(sample_rate, &range_min, &range_max);
+    
+#if USE_LOG_FREQ_SCALE
+    // Octave column map and decimation follow the new rate and span
+    if (!fft_octave_init(sample_rate, range_min, range_max, STREAM_BUFFER_COLS)) {
+        return false;
+    }
+#endif
+    
+    // Goertzel coefficients: tones above the new Nyquist frequency are dropped
+    float tones[FFT_GOERTZEL_MAX_TONES];
+    int tone_count = 0;
+    for (int i = 0; i < tracker_count; i++) {
+        if (tracker_hz[i] <= sample_rate / 2.0f) {
+            tones[tone_count++] = tracker_hz[i];
+        }
+    }
+    if (tone_count == 0) {
+        // Keep the bank on the new rate for later tracker frequencies
+        printf("Goertzel tracker off: no tracked tone below %.0f Hz\n", sample_rate / 2.0f);
+        tracker_mode = FFT_TRACKER_OFF;
+        tones[tone_count++] = sample_rate / 4.0f;
+    }
+    if (!fft_goertzel_init(tones, tone_count, GOERTZEL_BLOCK_SIZE, sample_rate)) {
+        return false;
+    }
+    
+    // Zoom band in Hz: disabled if it no longer fits below Nyquist
+    if (zoom_enabled && !fft_zoom_configure(zoom_center_hz, zoom_span_hz, sample_rate)) {
+        printf("Zoom FFT disabled: band does not fit the new sample rate\n");
+        zoom_enabled = false;
+    }
+    fft_zoom_reset();
+    
+    // Welch average of the old bins, sliding DFT state of the old samples
+    fft_welch_reset();
+    _fft_realtime_reconfigure_sdft();
+    
+    printf("Sample rate set to %.1f Hz (bin %.1f Hz, display %.0f - %.0f Hz, %d tracker tones)\n",
+           sample_rate, sample_rate / adc_sampling_get_fft_size(), range_min, range_max, tone_count);
+    return true;
+}
+
+/**
+ * Switch window function at runtime
+ */
+bool fft_realtime_unified_set_window(int window_type) {
+    return _fft_realtime_control(_fft_realtime_apply_window, &window_type);
+}
+
+/**
+ * Switch FFT size at runtime
+ */
+bool fft_realtime_unified_set_fft_size(int fft_size) {
+    fft_analysis_mode_t previous_mode = analysis_mode;
+    bool result = _fft_realtime_control(_fft_realtime_apply_fft_size, &fft_size);
+    if (analysis_mode != previous_mode) {
+        _fft_realtime_reset_traces();
+    }
+    return result;
+}
+
+/**
+ * Set frame overlap of ring mode at runtime
+ */
+bool fft_realtime_unified_set_overlap(int hop_divisor) {
+    return _fft_realtime_control(_fft_realtime_apply_overlap, &hop_divisor);
+}
+
+/**
+ * Switch analysis mode at runtime
+ */
+bool fft_realtime_unified_set_analysis_mode(fft_analysis_mode_t mode) {
+    if (!_fft_realtime_control(_fft_realtime_apply_analysis_mode, &mode)) {
+        return false;
+    }
+    _fft_realtime_reset_traces();
+    return true;
+}
+
+/**
+ * Get current analysis mode
+ */
+fft_analysis_mode_t fft_realtime_unified_get_analysis_mode(void) {
+    return analysis_mode;
+}
+
+/**
+ * Get analysis mode name as string
+ */
+const char* fft_realtime_unified_get_analysis_mode_name(fft_analysis_mode_t mode) {
+    switch (mode) {
+        case FFT_ANALYSIS_SPECTRUM:  return "Spectrum (dBm)";
+        case FFT_ANALYSIS_WELCH_PSD: return "Welch PSD (dBm/Hz)";
+        case FFT_ANALYSIS_SLIDING_DFT: return "Sliding DFT (dBm)";
+        default:                     return "Unknown";
+    }
+}
+
+/**
+ * Set the number of segments averaged per Welch PSD estimate
+ */
+bool fft_realtime_unified_set_welch_segments(int segments) {
+    return _fft_realtime_control(_fft_realtime_apply_welch_segments, &segments);
+}
+
+/**
+ * Enable or disable the zoom FFT stage
+ */
+bool fft_realtime_unified_set_zoom(bool enabled, float center_hz, float span_hz) {
+    zoom_command_t zoom = { enabled, center_hz, span_hz };
+    return _fft_realtime_control(_fft_realtime_apply_zoom, &zoom);
+}
+
+/**
+ * Switch the Goertzel tracker mode at runtime
+ */
+bool fft_realtime_unified_set_tracker_mode(fft_tracker_mode_t mode) {
+    return _fft_realtime_control(_fft_realtime_apply_tracker_mode, &mode);
+}
+
+/**
+ * Get tracker mode name as string
+ */
+const char* fft_realtime_unified_get_tracker_mode_name(fft_tracker_mode_t mode) {
+    switch (mode) {
+        case FFT_TRACKER_OFF:       return "Off";
+        case FFT_TRACKER_ALONGSIDE: return "Alongside FFT";
+        case FFT_TRACKER_ONLY:      return "Instead of FFT";
+        default:                    return "Unknown";
+    }
+}
+
+/**
+ * Replace the frequencies tracked by the Goertzel bank
+ */
+bool fft_realtime_unified_set_tracker_frequencies(const float* frequencies_hz, int count) {
+    tracker_command_t tracker = { frequencies_hz, count };
+    return _fft_realtime_control(_fft_realtime_apply_tracker_frequencies, &tracker);
+}
+
+/**
+ * Change the ADC sample rate at runtime
+ */
+bool fft_realtime_unified_set_sample_rate(float rate_hz) {
+    float previous_rate = adc_sampling_get_nominal_rate();
+    bool result = _fft_realtime_control(_fft_realtime_apply_sample_rate, &rate_hz);
+    
+    // Display span, tick labels, averages and holds belong to the render side
+    float sample_rate = adc_sampling_get_nominal_rate();
+    if (sample_rate != previous_rate) {
+        float range_min = 0.0f;
+        float range_max = 0.0f;
+        _fft_realtime_display_span(sample_rate, &range_min, &range_max);
+        fft_streaming_display_set_frequency_range(range_min, range_max);
+        _fft_realtime_reset_traces();
+    }
+    return result;
 }
 
 /**
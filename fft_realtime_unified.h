@@ -16,10 +16,44 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "pico/stdlib.h"
+#include "config_settings.h"
+#include "fft_plan.h"
+#include "fft_cross.h"
 
 // Display configuration (should match streaming display system)
 #define STREAM_BUFFER_COLS 240  // LCD width for spectrum columns
 
+// Frames combined into one display update (ring mode delivers one per hop)
+#define MAX_FRAMES_PER_UPDATE 8
+
+// Spectrum slots between the analysis and render stages: one when both run
+// on core 0, two for the dual-core pipeline (the second comes from the arena)
+#if DUAL_CORE_PIPELINE_ENABLED
+#define FFT_SPECTRUM_SLOTS 2
+#else
+#define FFT_SPECTRUM_SLOTS 1
+#endif
+#define FFT_SPECTRUM_SLOT_BINS ((DUAL_CHANNEL_ENABLED ? FFT_CROSS_MAX_SIZE : FFT_PLAN_MAX_SIZE) / 2)
+#define FFT_SPECTRUM_SLOT_BYTES ((FFT_SPECTRUM_SLOT_BINS + (USE_LOG_FREQ_SCALE ? STREAM_BUFFER_COLS : 0)) * sizeof(float))
+#define FFT_SPECTRUM_ARENA_BYTES ((FFT_SPECTRUM_SLOTS - 1) * FFT_SPECTRUM_SLOT_BYTES) // Sizes the arena
+#define PIPELINE_POLL_INTERVAL_US 250   // Render core wait while no slot is published
+
+// Analysis modes (values match FFT_ANALYSIS_MODE in config_settings.h)
+typedef enum {
+    FFT_ANALYSIS_SPECTRUM = 0,      // Periodogram per frame, peak-detected (dBm)
+    FFT_ANALYSIS_WELCH_PSD = 1,     // Welch averaged PSD (dBm/Hz)
+    FFT_ANALYSIS_SLIDING_DFT = 2,   // Sliding DFT over a bin subset, updated per sample (dBm)
+    FFT_ANALYSIS_MODE_COUNT
+} fft_analysis_mode_t;
+
+// Goertzel tracker modes (values match GOERTZEL_TRACKER_MODE in config_settings.h)
+typedef enum {
+    FFT_TRACKER_OFF = 0,            // FFT only
+    FFT_TRACKER_ALONGSIDE = 1,      // Goertzel bank and FFT on the same samples
+    FFT_TRACKER_ONLY = 2,           // Goertzel bank instead of the FFT (no spectrum display)
+    FFT_TRACKER_MODE_COUNT
+} fft_tracker_mode_t;
+
 // ========================================
 // 🔧 Unified Real-time FFT API
 // ========================================
@@ -46,18 +80,35 @@ bool fft_realtime_unified_init(void);
  * - Monitors performance and errors
  * - Controls frame rate
  * 
+ * With DUAL_CORE_PIPELINE_ENABLED the analysis stage (ADC frames, FFT and
+ * every stream stage) runs on core 1 and this core only renders the spectrum
+ * slots it publishes. The runtime setters below are posted to core 1, run
+ * there between two frames and return its result; slots analyzed before
+ * the change are not drawn
+ * 
  * Note: This function runs indefinitely until system reset
  */
 void fft_realtime_unified_run(void);
 
+/**
+ * Register a callback run by the main loop before every display update
+ * The place for runtime control (buttons, serial commands): the runtime
+ * setters may be called from it on either pipeline build. Not for
+ * interrupt handlers, which must not call the setters
+ * @param hook Callback, NULL to remove
+ */
+void fft_realtime_unified_set_control_hook(void (*hook)(void));
+
 /**
  * Update display with new spectrum data
  * Converts FFT magnitude spectrum to display format and updates
- * the streaming display system
+ * the streaming display system. Both buffers receive the finished traces
  * 
- * @param magnitude_spectrum Pointer to FFT magnitude array (512 elements)
+ * @param magnitude_spectrum Pointer to FFT magnitude array (fft_size / 2 elements)
+ * @param column_spectrum Constant-Q columns of the log axis (STREAM_BUFFER_COLS
+ *                        elements) drawn instead of the bins, NULL for the bins
  */
-void fft_realtime_unified_update_display(float* magnitude_spectrum);
+void fft_realtime_unified_update_display(float* magnitude_spectrum, float* column_spectrum);
 
 /**
  * Debug function: Print frequency mapping details
@@ -94,10 +145,113 @@ const char* fft_realtime_unified_get_window_name(void);
 
 /**
  * Get current window function amplitude correction factor
+ * Read from the window table (1 / measured coherent gain)
  * @return Amplitude correction factor for current window
  */
 float fft_realtime_unified_get_window_correction(void);
 
+/**
+ * Switch window function at runtime
+ * The coefficient table is rebuilt once here, never in the processing loop
+ * @param window_type Window type (0-6, same numbering as FFT_WINDOW_TYPE)
+ * @return true if successful, false on invalid type
+ */
+bool fft_realtime_unified_set_window(int window_type);
+
+/**
+ * Switch FFT size at runtime
+ * Uses the cached plan and window table for the new size (no allocation);
+ * smaller sizes update faster, larger sizes resolve closer tones
+ * @param fft_size FFT size (256, 512, 1024, 2048 or 4096)
+ * @return true if successful, false if the size has no cached plan
+ */
+bool fft_realtime_unified_set_fft_size(int fft_size);
+
+/**
+ * Set frame overlap of ring mode at runtime
+ * More overlap gives more spectra per second from the same sample stream
+ * @param hop_divisor Hop = FFT size / hop_divisor (1, 2=50%, 4=75%, 8=87.5%)
+ * @return true if successful, false on invalid divisor
+ */
+bool fft_realtime_unified_set_overlap(int hop_divisor);
+
+/**
+ * Switch analysis mode at runtime
+ * The sliding DFT uses the active FFT size as its window length and the
+ * SDFT_* bin subset from config_settings.h
+ * @param mode FFT_ANALYSIS_SPECTRUM, FFT_ANALYSIS_WELCH_PSD or FFT_ANALYSIS_SLIDING_DFT
+ * @return true if successful, false on invalid mode
+ */
+bool fft_realtime_unified_set_analysis_mode(fft_analysis_mode_t mode);
+
+/**
+ * Get current analysis mode
+ * @return Active analysis mode
+ */
+fft_analysis_mode_t fft_realtime_unified_get_analysis_mode(void);
+
+/**
+ * Get analysis mode name as string
+ * @param mode Analysis mode
+ * @return String name of mode
+ */
+const char* fft_realtime_unified_get_analysis_mode_name(fft_analysis_mode_t mode);
+
+/**
+ * Set the number of segments averaged per Welch PSD estimate
+ * @param segments K (1 to FFT_WELCH_MAX_SEGMENTS)
+ * @return true if successful, false on invalid count
+ */
+bool fft_realtime_unified_set_welch_segments(int segments);
+
+/**
+ * Enable or disable the zoom FFT stage
+ * The zoom runs on the raw sample stream before the main FFT and resolves
+ * output rate/1024 Hz per bin around the center, with the span inside the
+ * flat band of the decimation FIR (fft_zoom_get_span()); its peak is shown
+ * in the status print
+ * @param enabled true to run the zoom stage
+ * @param center_hz Center frequency in Hz
+ * @param span_hz Total span in Hz (e.g. 2000 for +/-1kHz at ~3.9Hz/bin)
+ * @return true if successful, false on invalid band
+ */
+bool fft_realtime_unified_set_zoom(bool enabled, float center_hz, float span_hz);
+
+/**
+ * Switch the Goertzel tracker mode at runtime
+ * @param mode FFT_TRACKER_OFF, FFT_TRACKER_ALONGSIDE or FFT_TRACKER_ONLY
+ * @return true if successful, false on invalid mode
+ */
+bool fft_realtime_unified_set_tracker_mode(fft_tracker_mode_t mode);
+
+/**
+ * Get tracker mode name as string
+ * @param mode Tracker mode
+ * @return String name of mode
+ */
+const char* fft_realtime_unified_get_tracker_mode_name(fft_tracker_mode_t mode);
+
+/**
+ * Replace the frequencies tracked by the Goertzel bank
+ * @param frequencies_hz Tracked frequencies in Hz
+ * @param count Number of tones (1 to FFT_GOERTZEL_MAX_TONES)
+ * @return true if successful, false on invalid frequencies
+ */
+bool fft_realtime_unified_set_tracker_frequencies(const float* frequencies_hz, int count);
+
+/**
+ * Change the ADC sample rate at runtime (e.g. 8kHz for audio detail, 500kHz
+ * for the widest span)
+ * The display span scales with the rate (FREQUENCY_RANGE_MIN/MAX at
+ * SAMPLING_RATE_HZ) and its tick labels are regenerated; zoom, Goertzel and
+ * octave stages are rebuilt for the new divider, tracked tones above Nyquist
+ * are dropped. Bin frequencies, axis mapping and RBW then follow the rate
+ * measured from DMA completion timestamps
+ * @param rate_hz Rate per channel in Hz (ADC_SAMPLE_RATE_MIN_HZ to ADC_SAMPLE_RATE_MAX_HZ)
+ * @return true if successful, false if out of range or a stage cannot be rebuilt
+ */
+bool fft_realtime_unified_set_sample_rate(float rate_hz);
+
 /**
  * Cleanup and shutdown unified system
  * Stops sampling, prints final statistics, and cleans up resources
@@ -0,0 +1,195 @@
+/*****************************************************************************
+* | File      	:   fft_sdft.c
+* | Author      :   PicoFFT Project
+* | Function    :   Modulated sliding DFT over a bin subset
+* | Info        :
+*   - Y_k(n) = Y_k(n-1) + (x[n] - x[n-N]) * e^(-j2*pi*k*(n mod N)/N)
+*   - A second, add-only accumulator rebuilds each Y_k exactly every N
+*     samples, so float rounding cannot random-walk over long runs
+*   - Hann is applied in the frequency domain (0.5, -0.25, -0.25 kernel)
+*----------------
+******************************************************************************/
+
+#include "fft_sdft.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+
+// Global sliding DFT state
+static fft_sdft_state_t g_sdft = {0};
+
+// ========================================
+// 🔧 Sliding DFT API Implementation
+// ========================================
+
+/**
+ * Configure the sliding DFT
+ */
+bool fft_sdft_configure(int size, int first_bin, int bin_count, bool hann) {
+    if (size < 8 || size > FFT_SDFT_MAX_SIZE || (size % 4) != 0 ||
+        first_bin < FFT_SDFT_GUARD_BINS || bin_count < 1 || bin_count > FFT_SDFT_MAX_BINS ||
+        first_bin + bin_count > size / 2) {
+        printf("ERROR: Invalid sliding DFT configuration (N=%d, bins %d+%d)\n",
+               size, first_bin, bin_count);
+        return false;
+    }
+    
+    g_sdft.size = size;
+    g_sdft.first_bin = first_bin;
+    g_sdft.bin_count = bin_count;
+    g_sdft.hann = hann;
+    
+    for (int i = 0; i < size; i++) {
+        g_sdft.cos_table[i] = (float)cos(2.0 * M_PI * i / size);
+    }
+    
+    // Tracked bins include one guard bin on each side for the Hann kernel
+    for (int b = 0; b < bin_count + 2 * FFT_SDFT_GUARD_BINS; b++) {
+        g_sdft.bins[b].twiddle_step = (uint32_t)(first_bin - FFT_SDFT_GUARD_BINS + b);
+    }
+    
+    // Tone of amplitude A: |X| = A * N * CG / 2 (CG = 1 rectangular, 0.5 Hann)
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT * (hann ? 2.0f : 1.0f) /
+                            ((float)size * DB_REFERENCE_VOLTAGE_0DBM);
+    fft_db_stage_configure(&g_sdft.db_stage, 20.0f * log10f(amplitude_scale));
+    
+    g_sdft.configured = true;
+    fft_sdft_reset();
+    return true;
+}
+
+/**
+ * Clear history and accumulators
+ */
+void fft_sdft_reset(void) {
+    for (int b = 0; b < g_sdft.bin_count + 2 * FFT_SDFT_GUARD_BINS; b++) {
+        g_sdft.bins[b].sliding_r = 0.0f;
+        g_sdft.bins[b].sliding_i = 0.0f;
+        g_sdft.bins[b].block_r = 0.0f;
+        g_sdft.bins[b].block_i = 0.0f;
+        g_sdft.bins[b].twiddle_index = 0;
+    }
+    memset(g_sdft.history, 0, sizeof(g_sdft.history));
+    g_sdft.phase = 0;
+    g_sdft.sample_count = 0;
+    g_sdft.filled = 0;
+}
+
+/**
+ * Advance every bin of the subset by each sample
+ */
+void fft_sdft_process(const adc_sample_t* samples, int count) {
+    if (!g_sdft.configured || samples == NULL) {
+        return;
+    }
+    
+    const uint32_t size = (uint32_t)g_sdft.size;
+    const uint32_t quarter = size * 3 / 4;     // sin(t) = cos(t - pi/2)
+    const int tracked = g_sdft.bin_count + 2 * FFT_SDFT_GUARD_BINS;
+    const float* cos_table = g_sdft.cos_table;
+    
+    for (int i = 0; i < count; i++) {
+        int32_t x = ADC_SAMPLE_CENTER(samples[i]);
+        float delta = (float)(x - g_sdft.history[g_sdft.phase]);
+        float sample = (float)x;
+        g_sdft.history[g_sdft.phase] = (int16_t)x;
+    
+        for (int b = 0; b < tracked; b++) {
+            fft_sdft_bin_t* bin = &g_sdft.bins[b];
+            float c = cos_table[bin->twiddle_index];
+            uint32_t sin_index = bin->twiddle_index + quarter;
+            float s = cos_table[sin_index >= size ? sin_index - size : sin_index];
+    
+            // Multiply by e^(-j*theta) = c - j*s
+            bin->sliding_r += delta * c;
+            bin->sliding_i -= delta * s;
+            bin->block_r += sample * c;
+            bin->block_i -= sample * s;
+            // Indices stay below N and steps are at most N/2, so one wrap suffices (any N, not only 2^k)
+            bin->twiddle_index += bin->twiddle_step;
+            if (bin->twiddle_index >= size) {
+                bin->twiddle_index -= size;
+            }
+        }
+    
+        // Block complete: the add-only sum is exactly the window's DFT
+        if (++g_sdft.phase == size) {
+            g_sdft.phase = 0;
+            for (int b = 0; b < tracked; b++) {
+                fft_sdft_bin_t* bin = &g_sdft.bins[b];
+                bin->sliding_r = bin->block_r;
+                bin->sliding_i = bin->block_i;
+                bin->block_r = 0.0f;
+                bin->block_i = 0.0f;
+            }
+        }
+    }
+    g_sdft.sample_count += (uint32_t)count;
+    g_sdft.filled = (count >= g_sdft.size - g_sdft.filled) ? g_sdft.size : g_sdft.filled + count;
+}
+
+/**
+ * Get the spectrum of the last N samples
+ */
+bool fft_sdft_get_magnitude(float* db_out) {
+    if (!g_sdft.configured || db_out == NULL || g_sdft.filled < g_sdft.size) {
+        return false;
+    }
+    
+    // X_k = Y_k * e^(j2*pi*k*q/N) with q = samples mod N; only |X| is needed,
+    // so the neighbours are aligned to bin k with rot = e^(j2*pi*q/N)
+    const uint32_t size = (uint32_t)g_sdft.size;
+    const uint32_t q = g_sdft.phase;
+    const uint32_t sin_index = q + size * 3 / 4;
+    const float rot_r = g_sdft.cos_table[q];
+    const float rot_i = g_sdft.cos_table[sin_index >= size ? sin_index - size : sin_index];
+    float power[FFT_SDFT_MAX_BINS];
+    
+    for (int k = 0; k < g_sdft.bin_count; k++) {
+        const fft_sdft_bin_t* center = &g_sdft.bins[k + FFT_SDFT_GUARD_BINS];
+        float real = center->sliding_r;
+        float imag = center->sliding_i;
+    
+        if (g_sdft.hann) {
+            const fft_sdft_bin_t* lower = center - 1;
+            const fft_sdft_bin_t* upper = center + 1;
+            // lower * conj(rot) + upper * rot
+            float side_r = lower->sliding_r * rot_r + lower->sliding_i * rot_i +
+                           upper->sliding_r * rot_r - upper->sliding_i * rot_i;
+            float side_i = lower->sliding_i * rot_r - lower->sliding_r * rot_i +
+                           upper->sliding_i * rot_r + upper->sliding_r * rot_i;
+            real = 0.5f * real - 0.25f * side_r;
+            imag = 0.5f * imag - 0.25f * side_i;
+        }
+        power[k] = real * real + imag * imag;
+    }
+    
+    const int last_bin = g_sdft.first_bin + g_sdft.bin_count;
+    for (int i = 0; i < g_sdft.size / 2; i++) {
+        if (i < g_sdft.first_bin || i >= last_bin) {
+            db_out[i] = FFT_DB_FLOOR;
+        }
+    }
+    fft_db_stage_convert_power(&g_sdft.db_stage, power,
+                               &db_out[g_sdft.first_bin], g_sdft.bin_count);
+    return true;
+}
+
+/**
+ * Get the window length
+ */
+int fft_sdft_get_size(void) {
+    return g_sdft.size;
+}
+
+/**
+ * Get the number of samples processed since configuration
+ */
+uint32_t fft_sdft_get_sample_count(void) {
+    return g_sdft.sample_count;
+}
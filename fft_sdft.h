@@ -0,0 +1,103 @@
+/*****************************************************************************
+* | File      	:   fft_sdft.h
+* | Author      :   PicoFFT Project
+* | Function    :   Modulated sliding DFT over a bin subset
+* | Info        :
+*   - Every bin of the subset is updated with each new sample
+*   - Modulated form: twiddles come from a table indexed by n mod N, so no
+*     recursive rotation accumulates error
+*   - Results use the magnitude array layout of the block FFT (fft_size/2 dBm),
+*     written into a caller buffer (no spectrum copy of its own)
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_SDFT_H
+#define __FFT_SDFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "fft_db.h"
+#include "fft_plan.h"
+#include "adc_convert.h"
+
+// Sliding DFT configuration
+#define FFT_SDFT_MAX_SIZE FFT_PLAN_MAX_SIZE     // Window length N
+#define FFT_SDFT_MAX_BINS 64                    // Bins in the subset
+#define FFT_SDFT_GUARD_BINS 1                   // Neighbours kept for the Hann kernel
+
+// Per-bin accumulators (absolute-time phase reference)
+typedef struct {
+    float sliding_r;                // Y_k over the last N samples
+    float sliding_i;
+    float block_r;                  // Fresh sum of the current N-sample block
+    float block_i;
+    uint32_t twiddle_index;         // k * n mod N
+    uint32_t twiddle_step;          // k
+} fft_sdft_bin_t;
+
+// Sliding DFT state
+typedef struct {
+    int size;                                   // N
+    int first_bin;                              // First published bin
+    int bin_count;                              // Published bins
+    bool hann;                                  // Periodic Hann via frequency-domain kernel
+    fft_sdft_bin_t bins[FFT_SDFT_MAX_BINS + 2 * FFT_SDFT_GUARD_BINS];
+    int16_t history[FFT_SDFT_MAX_SIZE];         // Last N centered samples
+    float cos_table[FFT_SDFT_MAX_SIZE];         // cos(2*pi*i/N)
+    uint32_t phase;                             // Samples processed mod N
+    fft_db_stage_t db_stage;
+    uint32_t sample_count;
+    int filled;                                 // Samples since reset (up to N)
+    bool configured;
+} fft_sdft_state_t;
+
+// ========================================
+// 🔧 Sliding DFT API
+// ========================================
+
+/**
+ * Configure the sliding DFT (clears the history)
+ * @param size Window length N (multiple of 4, up to FFT_SDFT_MAX_SIZE)
+ * @param first_bin First bin of the subset (>= 1)
+ * @param bin_count Bins in the subset (1 to FFT_SDFT_MAX_BINS, last bin < N/2)
+ * @param hann true for a periodic Hann window, false for rectangular
+ * @return true if successful, false on invalid parameters
+ */
+bool fft_sdft_configure(int size, int first_bin, int bin_count, bool hann);
+
+/**
+ * Clear history and accumulators
+ */
+void fft_sdft_reset(void);
+
+/**
+ * Advance every bin of the subset by each sample
+ * @param samples Raw ADC samples (adc_sample_t), contiguous in time
+ * @param count Number of samples
+ */
+void fft_sdft_process(const adc_sample_t* samples, int count);
+
+/**
+ * Get the spectrum of the last N samples
+ * Computed on demand from the accumulators, so it reflects the newest sample
+ * @param db_out Output array (size/2 bins in dBm, block FFT layout,
+ *               FFT_DB_FLOOR outside the subset)
+ * @return true if written, false if not configured or fewer than N samples
+ *         arrived since the last reset
+ */
+bool fft_sdft_get_magnitude(float* db_out);
+
+/**
+ * Get the window length
+ * @return N
+ */
+int fft_sdft_get_size(void);
+
+/**
+ * Get the number of samples processed since configuration
+ * @return Sample count
+ */
+uint32_t fft_sdft_get_sample_count(void);
+
+#endif // __FFT_SDFT_H
@@ -3,7 +3,8 @@
  * 
  * Features:
  * - Real-time spectrum streaming with optimized updates
- * - Fixed axis labels with logarithmic frequency scale (100Hz-50kHz)
+ * - Frequency axis range set at runtime (follows the sample rate), tick
+ *   labels generated for the range on a linear or logarithmic scale
  * - Linear dB amplitude scale (-100dBm to +20dBm)
  * - Bright white axis labels for high visibility
  * - Anti-flashing optimized display buffer
@@ -11,7 +12,6 @@
 
 #include "fft_streaming_display.h"
 #include "config_settings.h"  // 設定定数
-#include "main.h"  // main.cで定義された配列にアクセス
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
@@ -19,15 +19,21 @@
 
 // Internal buffer for streaming display
 static SpectrumPoint spectrum_buffer[STREAM_BUFFER_COLS];
-static SpectrumHold hold_buffer[STREAM_BUFFER_COLS];  // Peak hold buffer for 0.5s hold
+static float hold_buffer[STREAM_BUFFER_COLS];  // Hold trace per column (dBm, from fft_trace)
 static bool buffer_initialized = false;
 
+// Frequency axis range (changes with the sample rate)
+static float freq_range_min_hz = (float)FREQUENCY_RANGE_MIN;
+static float freq_range_max_hz = (float)FREQUENCY_RANGE_MAX;
+
+#define FREQ_LABEL_CHAR_W 6         // Glyph advance of the axis labels (4x6 glyph + gap)
+#define FREQ_LABEL_Y (STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H + 18)
+
 /**
  * Initialize streaming display system
  * 
  * 機能: FFTストリーミング表示システムの初期化
- * - スペクトラムバッファとピークホールドバッファの初期化
- * - 2秒間のピークホールド機能の準備
+ * - スペクトラムバッファとホールド線バッファの初期化
  * - LCD画面のクリアと軸の描画
  * 
  * 引数: なし
@@ -38,11 +44,10 @@ void fft_streaming_display_init(void) {
     memset(hold_buffer, 0, sizeof(hold_buffer));
     buffer_initialized = true;
     
-    // Initialize hold buffer with very low values for 2-second peak hold
-    // ピークホールドバッファを低い値で初期化（2秒間保持用）
+    // Hold line starts below the display range (not drawn until a hold trace arrives)
+    // ホールド線は表示範囲外の値で初期化（ホールドトレース受信まで非表示）
     for (int i = 0; i < STREAM_BUFFER_COLS; i++) {
-        hold_buffer[i].peak_db = -200.0f;  // Very low initial value (background level)
-        hold_buffer[i].hold_time = get_absolute_time(); // Set current time as baseline
+        hold_buffer[i] = -200.0f;
     }
     
     fft_streaming_display_clear();
@@ -64,21 +69,52 @@ void fft_streaming_display_clear(void) {
  * Supports both linear and logarithmic scaling
  */
 float fft_streaming_display_freq_to_position(float freq_hz) {
-    if (freq_hz < FREQUENCY_RANGE_MIN) return 0.0f;
-    if (freq_hz > FREQUENCY_RANGE_MAX) return 1.0f;
+    if (freq_hz < freq_range_min_hz) return 0.0f;
+    if (freq_hz > freq_range_max_hz) return 1.0f;
     
     if (USE_LOG_FREQ_SCALE) {
-        // Logarithmic scale (main.cで設定)
+        // Logarithmic scale (config_settings.hで設定)
         float log_freq = log10f(freq_hz);
-        float log_min = log10f(FREQUENCY_RANGE_MIN);
-        float log_max = log10f(FREQUENCY_RANGE_MAX);
+        float log_min = log10f(freq_range_min_hz);
+        float log_max = log10f(freq_range_max_hz);
         return (log_freq - log_min) / (log_max - log_min);
     } else {
-        // Linear scale (main.cで設定)
-        return (freq_hz - FREQUENCY_RANGE_MIN) / (FREQUENCY_RANGE_MAX - FREQUENCY_RANGE_MIN);
+        // Linear scale (config_settings.hで設定)
+        return (freq_hz - freq_range_min_hz) / (freq_range_max_hz - freq_range_min_hz);
     }
 }
 
+/**
+ * Set the displayed frequency range
+ * Clears the old tick labels and redraws the axes; the next spectrum update
+ * maps bins to the new range
+ */
+bool fft_streaming_display_set_frequency_range(float min_hz, float max_hz) {
+    if (min_hz <= 0.0f || max_hz <= min_hz) {
+        printf("ERROR: Invalid display frequency range %.1f - %.1f Hz\n", min_hz, max_hz);
+        return false;
+    }
+    freq_range_min_hz = min_hz;
+    freq_range_max_hz = max_hz;
+    
+    // Tick and label strip below the spectrum area (labels may overhang both ends)
+    GUI_DrawRectangle(STREAM_SPECTRUM_X - 20, STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H + 2,
+                      STREAM_SPECTRUM_X + STREAM_SPECTRUM_W + 20, FREQ_LABEL_Y + 7,
+                      STREAM_COLOR_BG, DRAW_FULL, DOT_PIXEL_1X1);
+    if (buffer_initialized) {
+        fft_streaming_display_draw_axes();
+    }
+    return true;
+}
+
+/**
+ * Get the displayed frequency range
+ */
+void fft_streaming_display_get_frequency_range(float* min_hz, float* max_hz) {
+    *min_hz = freq_range_min_hz;
+    *max_hz = freq_range_max_hz;
+}
+
 /**
  * Convert frequency to display column
  */
@@ -200,6 +236,40 @@ static void draw_digit_8(int x, int y) {
     }
 }
 
+static void draw_digit_9(int x, int y) {
+    // 9 pattern (4x6) - larger and thicker
+    for (int i = 0; i < 4; i++) {
+        LCD_SetPointlColor(x+i, y+0, STREAM_COLOR_AXIS); // top
+        LCD_SetPointlColor(x+i, y+2, STREAM_COLOR_AXIS); // middle
+        LCD_SetPointlColor(x+i, y+5, STREAM_COLOR_AXIS); // bottom
+    }
+    for (int i = 0; i < 3; i++) {
+        LCD_SetPointlColor(x+0, y+i, STREAM_COLOR_AXIS); // upper left
+    }
+    for (int i = 0; i < 6; i++) {
+        LCD_SetPointlColor(x+3, y+i, STREAM_COLOR_AXIS); // right
+    }
+}
+
+/**
+ * Draw one decimal digit
+ */
+static void draw_digit(int digit, int x, int y) {
+    switch (digit) {
+        case 0: draw_digit_0(x, y); break;
+        case 1: draw_digit_1(x, y); break;
+        case 2: draw_digit_2(x, y); break;
+        case 3: draw_digit_3(x, y); break;
+        case 4: draw_digit_4(x, y); break;
+        case 5: draw_digit_5(x, y); break;
+        case 6: draw_digit_6(x, y); break;
+        case 7: draw_digit_7(x, y); break;
+        case 8: draw_digit_8(x, y); break;
+        case 9: draw_digit_9(x, y); break;
+        default: break;
+    }
+}
+
 static void draw_minus_sign(int x, int y) {
     // - pattern (4x2) - larger and thicker
     for (int i = 0; i < 4; i++) {
@@ -254,6 +324,96 @@ static void draw_plus_sign(int x, int y) {
     LCD_SetPointlColor(x+2, y+4, STREAM_COLOR_AXIS);
 }
 
+/**
+ * Width of a frequency label in pixels
+ * Whole kHz are written as "<n>k", everything else in Hz digits
+ */
+static int freq_label_width(uint32_t frequency) {
+    uint32_t value = (frequency >= 1000 && frequency % 1000 == 0) ? frequency / 1000 : frequency;
+    int chars = (value != frequency) ? 1 : 0;  // 'k'
+    do {
+        chars++;
+        value /= 10;
+    } while (value > 0);
+    return chars * FREQ_LABEL_CHAR_W;
+}
+
+/**
+ * Draw a frequency tick with its label centered below it
+ */
+static void draw_freq_marker(uint32_t frequency, int x) {
+    // Frequency marker tick (thicker and longer)
+    for (int tick_y = 0; tick_y < 12; tick_y++) {
+        LCD_SetPointlColor(x, STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H + 2 + tick_y, STREAM_COLOR_AXIS);
+        LCD_SetPointlColor(x-1, STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H + 2 + tick_y, STREAM_COLOR_AXIS);
+    }
+    
+    bool kilo = (frequency >= 1000 && frequency % 1000 == 0);
+    uint32_t value = kilo ? frequency / 1000 : frequency;
+    int digits = freq_label_width(frequency) / FREQ_LABEL_CHAR_W - (kilo ? 1 : 0);
+    int label_x = x - freq_label_width(frequency) / 2;
+    
+    // Digits right to left, then the unit
+    for (int d = digits - 1; d >= 0; d--) {
+        draw_digit((int)(value % 10), label_x + d * FREQ_LABEL_CHAR_W, FREQ_LABEL_Y);
+        value /= 10;
+    }
+    if (kilo) {
+        draw_letter_k(label_x + digits * FREQ_LABEL_CHAR_W, FREQ_LABEL_Y);
+    }
+}
+
+/**
+ * Draw the frequency ticks of the current range
+ * Linear axis: the finest 1-2-5 step whose labels do not touch.
+ * Log axis: 1-2-5 ticks of every decade, skipping labels that would
+ * overlap the previous one
+ */
+static void draw_freq_markers(void) {
+    static const uint32_t steps[3] = {1, 2, 5};
+    float span = freq_range_max_hz - freq_range_min_hz;
+    
+    if (!USE_LOG_FREQ_SCALE) {
+        uint32_t step = 0;
+        for (uint32_t decade = 1; step == 0 && decade <= 100000000u; decade *= 10) {
+            for (int m = 0; m < 3; m++) {
+                uint32_t candidate = steps[m] * decade;
+                uint32_t last = (uint32_t)(freq_range_max_hz / candidate) * candidate;
+                float pitch_px = (float)candidate / span * STREAM_SPECTRUM_W;
+                if (pitch_px >= freq_label_width(last) + FREQ_LABEL_CHAR_W || (float)candidate >= span) {
+                    step = candidate;
+                    break;
+                }
+            }
+        }
+        if (step == 0) return;
+        
+        for (uint32_t frequency = (uint32_t)ceilf(freq_range_min_hz / step) * step;
+             (float)frequency <= freq_range_max_hz; frequency += step) {
+            float normalized = fft_streaming_display_freq_to_position((float)frequency);
+            draw_freq_marker(frequency, STREAM_SPECTRUM_X + (int)(normalized * STREAM_SPECTRUM_W));
+        }
+        return;
+    }
+    
+    int last_right = -1000;
+    for (uint32_t decade = 1; (float)decade <= freq_range_max_hz && decade <= 100000000u; decade *= 10) {
+        for (int m = 0; m < 3; m++) {
+            uint32_t frequency = steps[m] * decade;
+            if ((float)frequency < freq_range_min_hz) continue;
+            if ((float)frequency > freq_range_max_hz) break;
+    
+            float normalized = fft_streaming_display_freq_to_position((float)frequency);
+            int x = STREAM_SPECTRUM_X + (int)(normalized * STREAM_SPECTRUM_W);
+            int left = x - freq_label_width(frequency) / 2;
+            if (left < last_right + FREQ_LABEL_CHAR_W) continue;
+    
+            draw_freq_marker(frequency, x);
+            last_right = left + freq_label_width(frequency);
+        }
+    }
+}
+
 /**
  * Draw fixed axis labels and scale markers
  */
@@ -270,83 +430,8 @@ void fft_streaming_display_draw_axes(void) {
         LCD_SetPointlColor(STREAM_SPECTRUM_X - 1, y, STREAM_COLOR_AXIS);
     }
     
-    
-    for (int i = 0; i < FREQ_MARKERS_COUNT; i++) {
-        // main.cで定義された周波数マーカーを使用
-        uint32_t frequency = FREQ_MARKERS_HZ[i];
-        
-        // Use unified frequency-to-position function
-        float normalized = fft_streaming_display_freq_to_position(frequency);
-        int x = STREAM_SPECTRUM_X + (int)(normalized * STREAM_SPECTRUM_W);
-        
-        // printf("  %dHz: norm=%.3f, x=%d (scale: %s)\n", 
-        //         frequency, normalized, x, USE_LOG_FREQ_SCALE ? "Log" : "Linear");
-        
-        // Draw frequency marker tick (thicker and longer)
-        for (int tick_y = 0; tick_y < 12; tick_y++) {
-            LCD_SetPointlColor(x, STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H + 2 + tick_y, STREAM_COLOR_AXIS);
-            LCD_SetPointlColor(x-1, STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H + 2 + tick_y, STREAM_COLOR_AXIS);
-        }
-        
-        // Draw frequency labels - 5kHz刻みの動的表示
-        int label_y = STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H + 18;
-        
-        // 周波数に応じて適切なラベルを描画 (1k, 5k, 10k, 15k, 20k, 25k, 30k, 35k, 40k, 45k, 50k)
-        if (frequency == 1000) {
-            // "1k"
-            draw_digit_1(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 5000) {
-            // "5k"
-            draw_digit_5(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 10000) {
-            // "10"
-            draw_digit_1(x - 12, label_y);
-            draw_digit_0(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 15000) {
-            // "15"
-            draw_digit_1(x - 12, label_y);
-            draw_digit_5(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 20000) {
-            // "20"
-            draw_digit_2(x - 12, label_y);
-            draw_digit_0(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 25000) {
-            // "25"
-            draw_digit_2(x - 12, label_y);
-            draw_digit_5(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 30000) {
-            // "30"
-            draw_digit_3(x - 12, label_y);
-            draw_digit_0(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 35000) {
-            // "35"
-            draw_digit_3(x - 12, label_y);
-            draw_digit_5(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 40000) {
-            // "40"
-            draw_digit_4(x - 12, label_y);
-            draw_digit_0(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 45000) {
-            // "45"
-            draw_digit_4(x - 12, label_y);
-            draw_digit_5(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        } else if (frequency == 50000) {
-            // "50"
-            draw_digit_5(x - 12, label_y);
-            draw_digit_0(x - 6, label_y);
-            draw_letter_k(x, label_y);
-        }
-    }
+    // Frequency ticks and labels of the current range
+    draw_freq_markers();
     
     // Vertical axis (amplitude) markers with linear dBm scale - 8レベル表示
     const int amp_markers = 8;
@@ -466,51 +551,39 @@ void fft_streaming_display_draw_grid(void) {
  * 
  * 機能: FFT振幅データを用いてリアルタイムスペクトラム表示を更新する
  * 引数: 
- *   - magnitude_db: FFT振幅データ配列（dB値、FFT_SIZE/2要素）
+ *   - magnitude_db: FFT振幅データ配列（dB値、fft_size/2要素）
+ *   - fft_size: 現在のFFTサイズ（実行時に切替可能）
  *   - sample_rate: 実際のサンプリング周波数（Hz）
  * 戻り値: なし
  * 
  * 処理内容:
- * - 30FPS高速表示に最適化された平滑化処理
- * - 周波数ビンから表示ピクセル位置への対数マッピング
- * - アンチフリッカー処理（指数移動平均）
+ * - 周波数ビンから表示ピクセル位置へのマッピング（同じ列のビンは最大値）
  * - 設計要件範囲内での振幅制限（-100dB to +20dB）
+ * - 平均化・ホールドは fft_trace.c で線形電力領域で実施済み（ここでは行わない）
  */
-void fft_streaming_display_update_spectrum(const float* magnitude_db, float sample_rate) {
+void fft_streaming_display_update_spectrum(const float* magnitude_db, int fft_size, float sample_rate) {
     if (!buffer_initialized) return;
     
-    // 30FPS高速表示用アンチフリッカー平滑化バッファ（指数移動平均）
-    // Smoothing buffer optimized for 30FPS high-speed display (exponential moving average)
-    static float smooth_buffer[STREAM_BUFFER_COLS] = {0};
-    static bool smooth_init = false;
-    const float smooth_factor = 0.4f;  // 30FPS高速表示用に調整（0.3f→0.4f）- より応答性重視
+    // Column level: strongest bin mapped to each column (the trace is already averaged)
+    // 列毎のレベル（同じ列に入るビンの最大値、平均化はトレース処理で済んでいる）
+    static float column_db[STREAM_BUFFER_COLS];
+    for (int i = 0; i < STREAM_BUFFER_COLS; i++) {
+        column_db[i] = (float)AMPLITUDE_RANGE_MIN_DB;
+    }
     
     // Clear the entire spectrum buffer first
     for (int i = 0; i < STREAM_BUFFER_COLS; i++) {
-        int display_x = STREAM_SPECTRUM_X + i;
-        
-#if ENABLE_FREQUENCY_OFFSET_CORRECTION
-        // Apply frequency offset correction
-        float freq_range = (float)(FREQUENCY_RANGE_MAX - FREQUENCY_RANGE_MIN);
-        float offset_pixels = ((float)FREQUENCY_DISPLAY_OFFSET_HZ / freq_range) * (STREAM_BUFFER_COLS - 1);
-        display_x += (int)offset_pixels;
-        
-        // Clamp to display bounds
-        if (display_x < STREAM_SPECTRUM_X) display_x = STREAM_SPECTRUM_X;
-        if (display_x >= STREAM_SPECTRUM_X + STREAM_BUFFER_COLS) display_x = STREAM_SPECTRUM_X + STREAM_BUFFER_COLS - 1;
-#endif
-        
-        spectrum_buffer[i].x = display_x;
+        spectrum_buffer[i].x = STREAM_SPECTRUM_X + i;
         spectrum_buffer[i].y = STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H; // Bottom line (no signal)
     }
     
-    // Map each FFT bin directly to its correct frequency position with smoothing
-    for (int bin = 1; bin < STREAM_FFT_SIZE / 2; bin++) {  // Skip DC component (bin 0)
+    // Map each FFT bin directly to its correct frequency position
+    for (int bin = 1; bin < fft_size / 2; bin++) {  // Skip DC component (bin 0)
         // Convert FFT bin to frequency using actual sample rate
-        float bin_freq = (float)bin * sample_rate / (float)STREAM_FFT_SIZE;
+        float bin_freq = (float)bin * sample_rate / (float)fft_size;
         
-        // Skip frequencies outside our display range (100Hz - 50kHz)
-        if (bin_freq < FREQUENCY_RANGE_MIN || bin_freq > FREQUENCY_RANGE_MAX) continue;
+        // Skip frequencies outside the display range
+        if (bin_freq < freq_range_min_hz || bin_freq > freq_range_max_hz) continue;
         
         // Convert frequency to display column using unified scaling function
         int col = fft_streaming_display_freq_to_column(bin_freq);
@@ -522,59 +595,26 @@ void fft_streaming_display_update_spectrum(const float* magnitude_db, float samp
         if (db_value < -100.0f) db_value = -100.0f;
         if (db_value > 20.0f) db_value = 20.0f;
         
-        // Apply exponential moving average for smoothing
-        if (!smooth_init) {
-            smooth_buffer[col] = db_value;
-        } else {
-            smooth_buffer[col] = smooth_buffer[col] * (1.0f - smooth_factor) + db_value * smooth_factor;
+        if (db_value > column_db[col]) {
+            column_db[col] = db_value;
         }
         
-        // Peak hold functionality: 2-second peak hold implementation
-        // ピークホールド機能: 2秒間のピーク保持実装（dBmベース）
-        absolute_time_t current_time = get_absolute_time();
-        if (smooth_buffer[col] > hold_buffer[col].peak_db || 
-            absolute_time_diff_us(hold_buffer[col].hold_time, current_time) > PEAK_HOLD_DURATION_MS * 1000) {
-            hold_buffer[col].peak_db = smooth_buffer[col];      // Update peak dBm
-            hold_buffer[col].hold_time = current_time;          // Reset hold timer
-        }
-        
-        // Convert smoothed dBm to pixel coordinates (linear scale: -100dBm to +20dBm)
+        // Convert dBm to pixel coordinates (linear scale: -100dBm to +20dBm)
         float db_range = (float)(AMPLITUDE_RANGE_MAX_DB - AMPLITUDE_RANGE_MIN_DB);
-        float normalized_db = (smooth_buffer[col] - AMPLITUDE_RANGE_MIN_DB) / db_range;
+        float normalized_db = (column_db[col] - AMPLITUDE_RANGE_MIN_DB) / db_range;
         int height = (int)(normalized_db * STREAM_SPECTRUM_H);
         if (height < 0) height = 0;
         if (height >= STREAM_SPECTRUM_H) height = STREAM_SPECTRUM_H - 1;
         
-        // Store in buffer with correct mapping and optional frequency offset correction
-        int display_x = STREAM_SPECTRUM_X + col;
-        
-#if ENABLE_FREQUENCY_OFFSET_CORRECTION
-        // Apply frequency offset correction: convert offset from Hz to pixels
-        float freq_range = (float)(FREQUENCY_RANGE_MAX - FREQUENCY_RANGE_MIN);
-        float offset_pixels = ((float)FREQUENCY_DISPLAY_OFFSET_HZ / freq_range) * (STREAM_BUFFER_COLS - 1);
-        display_x += (int)offset_pixels;
-        
-        // Clamp to display bounds
-        if (display_x < STREAM_SPECTRUM_X) display_x = STREAM_SPECTRUM_X;
-        if (display_x >= STREAM_SPECTRUM_X + STREAM_BUFFER_COLS) display_x = STREAM_SPECTRUM_X + STREAM_BUFFER_COLS - 1;
-#endif
-        
-        spectrum_buffer[col].x = display_x;
+        // Store in buffer (the bin frequency uses the measured sample rate, so no offset correction)
+        spectrum_buffer[col].x = STREAM_SPECTRUM_X + col;
         spectrum_buffer[col].y = STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H - height;
         
         // Debug: Log 22.5kHz area spectrum buffer values (first few updates only)
         static int debug_update_count = 0;
         if (debug_update_count < 3 && col >= 100 && col <= 110) {
-#if ENABLE_FREQUENCY_OFFSET_CORRECTION
-            float freq_range = (float)(FREQUENCY_RANGE_MAX - FREQUENCY_RANGE_MIN);
-            float offset_pixels = ((float)FREQUENCY_DISPLAY_OFFSET_HZ / freq_range) * (STREAM_BUFFER_COLS - 1);
-            int original_x = STREAM_SPECTRUM_X + col;
-            // printf("Spectrum Buffer Debug: col=%d, freq=%.0fHz, x=%d->%d (offset=%.1fpx), y=%d, dB=%.1f\n", 
-            //        col, bin_freq, original_x, spectrum_buffer[col].x, offset_pixels, spectrum_buffer[col].y, smooth_buffer[col]);
-#else
             // printf("Spectrum Buffer Debug: col=%d, freq=%.0fHz, x=%d, y=%d, dB=%.1f\n", 
-            //        col, bin_freq, spectrum_buffer[col].x, spectrum_buffer[col].y, smooth_buffer[col]);
-#endif
+            //        col, bin_freq, spectrum_buffer[col].x, spectrum_buffer[col].y, column_db[col]);
         }
         // if (debug_update_count < 3 && col == STREAM_BUFFER_COLS - 1) {
         //     debug_update_count++;
@@ -586,19 +626,19 @@ void fft_streaming_display_update_spectrum(const float* magnitude_db, float samp
             
         //     for (int peak_col = 100; peak_col <= 110; peak_col++) {
         //         // Correct frequency calculation for display columns
-        //         float peak_freq = FREQUENCY_RANGE_MIN + ((float)peak_col / (STREAM_BUFFER_COLS - 1)) * (FREQUENCY_RANGE_MAX - FREQUENCY_RANGE_MIN);
+        //         float peak_freq = freq_range_min_hz + ((float)peak_col / (STREAM_BUFFER_COLS - 1)) * (freq_range_max_hz - freq_range_min_hz);
         //         bool is_peak = false;
                 
         //         // Simple peak detection: higher than neighbors
         //         if (peak_col > 0 && peak_col < STREAM_BUFFER_COLS - 1) {
-        //             if (smooth_buffer[peak_col] > smooth_buffer[peak_col-1] && 
-        //                 smooth_buffer[peak_col] > smooth_buffer[peak_col+1]) {
+        //             if (column_db[peak_col] > column_db[peak_col-1] && 
+        //                 column_db[peak_col] > column_db[peak_col+1]) {
         //                 is_peak = true;
         //             }
         //         }
                 
         //         printf("%3d | %8.0f | %8.1f | %s\n", 
-        //                peak_col, peak_freq, smooth_buffer[peak_col], is_peak ? "YES" : "no");
+        //                peak_col, peak_freq, column_db[peak_col], is_peak ? "YES" : "no");
         //     }
         //     printf("\n");
         // }
@@ -607,14 +647,12 @@ void fft_streaming_display_update_spectrum(const float* magnitude_db, float samp
         // static int debug_counter = 0;
         // if ((bin >= 7 && bin <= 9) && debug_counter % 180 == 0) {  // Bins around 1kHz, every 3 seconds at 60FPS
         //     float pos = fft_streaming_display_freq_to_position(bin_freq);
-        //     printf("Freq mapping: bin %d (%.1fHz) -> col %d, pos %.3f, raw %.1fdBm, smooth %.1fdBm\n", 
-        //            bin, bin_freq, col, pos, db_value, smooth_buffer[col]);
+        //     printf("Freq mapping: bin %d (%.1fHz) -> col %d, pos %.3f, raw %.1fdBm, column %.1fdBm\n", 
+        //            bin, bin_freq, col, pos, db_value, column_db[col]);
         // }
         // debug_counter++;
     }
     
-    smooth_init = true;
-    
     // Render the spectrum display buffer
     fft_streaming_display_render_buffer();
 }
@@ -653,7 +691,7 @@ void fft_streaming_display_render_buffer(void) {
             // - 現在のスペクトラム（緑）の上にピーク値を水平線で表示
             // - 測定値の最大値を設定時間視覚的に保持し、ちらつきを防止
             float db_range = (float)(AMPLITUDE_RANGE_MAX_DB - AMPLITUDE_RANGE_MIN_DB);
-            float hold_normalized_db = (hold_buffer[col].peak_db - AMPLITUDE_RANGE_MIN_DB) / db_range;
+            float hold_normalized_db = (hold_buffer[col] - AMPLITUDE_RANGE_MIN_DB) / db_range;
             int hold_height = (int)(hold_normalized_db * STREAM_SPECTRUM_H);
             if (hold_height < 0) hold_height = 0;
             if (hold_height >= STREAM_SPECTRUM_H) hold_height = STREAM_SPECTRUM_H - 1;
@@ -679,6 +717,70 @@ void fft_streaming_display_render_buffer(void) {
     fft_streaming_display_draw_axes();
 }
 
+/**
+ * Update the hold line from a finished hold trace
+ * 
+ * 機能: ホールドトレース（fft_trace.c で計算済み）を列毎のホールド線に変換する
+ * 引数:
+ *   - hold_db: ホールドトレース（dBm、fft_size/2要素）、NULLでホールド線を消去
+ *   - fft_size: 現在のFFTサイズ
+ *   - sample_rate: 実際のサンプリング周波数（Hz）
+ * 戻り値: なし（描画は次の fft_streaming_display_update_spectrum() で行う）
+ */
+void fft_streaming_display_update_hold(const float* hold_db, int fft_size, float sample_rate) {
+    if (!buffer_initialized) return;
+    
+    for (int i = 0; i < STREAM_BUFFER_COLS; i++) {
+        hold_buffer[i] = -200.0f;
+    }
+    if (hold_db == NULL) return;
+    
+    for (int bin = 1; bin < fft_size / 2; bin++) {  // Skip DC component (bin 0)
+        float bin_freq = (float)bin * sample_rate / (float)fft_size;
+        if (bin_freq < freq_range_min_hz || bin_freq > freq_range_max_hz) continue;
+        
+        int col = fft_streaming_display_freq_to_column(bin_freq);
+        if (hold_db[bin] > hold_buffer[col]) {
+            hold_buffer[col] = hold_db[bin];
+        }
+    }
+}
+
+/**
+ * Update the display from per-column levels
+ * 
+ * 機能: 列毎に分解済みのスペクトラム（対数軸の定Q解析、fft_octave.c）を描画する
+ * 引数:
+ *   - column_db: 列毎のレベル（dBm、STREAM_BUFFER_COLS要素）
+ *   - hold_db: 列毎のホールドトレース（dBm）、NULLでホールド線を消去
+ * 戻り値: なし
+ * 
+ * 処理内容:
+ * - ビン→列の写像は不要（列の周波数範囲は fft_octave_init() で対応付け済み）
+ * - 振幅制限は fft_streaming_display_update_spectrum() と同じ
+ */
+void fft_streaming_display_update_columns(const float* column_db, const float* hold_db) {
+    if (!buffer_initialized || column_db == NULL) return;
+    
+    float db_range = (float)(AMPLITUDE_RANGE_MAX_DB - AMPLITUDE_RANGE_MIN_DB);
+    for (int col = 0; col < STREAM_BUFFER_COLS; col++) {
+        float db_value = column_db[col];
+        if (db_value < -100.0f) db_value = -100.0f;
+        if (db_value > 20.0f) db_value = 20.0f;
+        
+        int height = (int)((db_value - AMPLITUDE_RANGE_MIN_DB) / db_range * STREAM_SPECTRUM_H);
+        if (height < 0) height = 0;
+        if (height >= STREAM_SPECTRUM_H) height = STREAM_SPECTRUM_H - 1;
+        
+        spectrum_buffer[col].x = STREAM_SPECTRUM_X + col;
+        spectrum_buffer[col].y = STREAM_SPECTRUM_Y + STREAM_SPECTRUM_H - height;
+        hold_buffer[col] = (hold_db != NULL) ? hold_db[col] : -200.0f;
+    }
+    
+    // Render the spectrum display buffer
+    fft_streaming_display_render_buffer();
+}
+
 /**
  * Get current spectrum display statistics
  */
@@ -691,8 +793,8 @@ void fft_streaming_display_get_stats(fft_streaming_display_stats_t* stats) {
     stats->spectrum_area_y = STREAM_SPECTRUM_Y;
     stats->spectrum_area_w = STREAM_SPECTRUM_W;
     stats->spectrum_area_h = STREAM_SPECTRUM_H;
-    stats->frequency_range_hz_min = 100;
-    stats->frequency_range_hz_max = 50000;
+    stats->frequency_range_hz_min = (int)freq_range_min_hz;
+    stats->frequency_range_hz_max = (int)freq_range_max_hz;
     stats->amplitude_range_dbm_min = -100;
     stats->amplitude_range_dbm_max = 20;
 }
@@ -725,7 +827,7 @@ void fft_streaming_display_test_axes_only(void) {
                       0x2104, DRAW_FULL, DOT_PIXEL_1X1);  // Dark gray
     
     // Draw the axes FIRST - this is the main purpose of this test
-    printf("Drawing fixed axis labels...\n");
+    printf("Drawing axis labels...\n");
     fft_streaming_display_draw_axes();
     printf("Axis labels drawn.\n");
     
@@ -763,7 +865,7 @@ void fft_streaming_display_test_axes_only(void) {
     
     printf("Axis and visual test complete. Check LCD display.\n");
     printf("You should see:\n");
-    printf("- Fixed axis labels (100Hz-50kHz, -100dBm to +20dBm)\n");
+    printf("- Axis labels (%.0f-%.0f Hz, -100dBm to +20dBm)\n", freq_range_min_hz, freq_range_max_hz);
     printf("- White border around entire screen\n");
     printf("- Red border around spectrum area at (%d,%d) to (%d,%d)\n", 
            STREAM_SPECTRUM_X, STREAM_SPECTRUM_Y,
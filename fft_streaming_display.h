@@ -2,7 +2,9 @@
  * fft_streaming_display.h - Fixed Scale FFT Streaming Display
  * 
  * Features:
- * - Fixed axis scales: 100Hz-50kHz (logarithmic), -100dBm to +20dBm (linear)
+ * - Frequency axis: runtime range (FREQUENCY_RANGE_MIN/MAX scaled with the
+ *   sample rate), linear or logarithmic, tick labels generated per range
+ * - Amplitude axis: -100dBm to +20dBm (linear)
  * - Bright white axis labels for high visibility
  * - Anti-flashing optimized streaming display
  * - Configurable update rate and display dimensions (320x240 landscape)
@@ -21,16 +23,12 @@
 #define STREAM_SPECTRUM_W 240       // Width (320-40-40 for margins)
 #define STREAM_SPECTRUM_H 180       // Height (240-20-40 for X-axis labels)
 
-#define STREAM_FFT_SIZE 1024        // FFT size (must match analyzer - CORRECTED from 512 to 1024)
 #define STREAM_BUFFER_COLS 240      // Buffer columns (matches spectrum width)
 #define STREAM_UPDATE_WIDTH 4       // Pixels to update per frame
 
-// Fixed axis scale constants - main.cで定義された値を使用
-#define STREAM_FREQ_MIN_HZ 1000     // Minimum frequency (1kHz) - main.cで設定
-#define STREAM_FREQ_MAX_HZ 50000    // Maximum frequency (50kHz) - main.cで設定
-
-// Frequency axis scale configuration - main.cで定義された設定を使用
-// 設定は main.c の USE_LOG_FREQ_SCALE 定数で制御されます
+// Frequency axis range - 起動時は config_settings.h の FREQUENCY_RANGE_MIN/MAX、
+// サンプリング周波数の変更時は fft_streaming_display_set_frequency_range() で更新
+// 軸のスケールは config_settings.h の USE_LOG_FREQ_SCALE 定数で制御されます
 #define STREAM_AMP_MIN_DBM -100     // Minimum amplitude (-100dBm)
 #define STREAM_AMP_MAX_DBM 20       // Maximum amplitude (+20dBm)
 
@@ -45,14 +43,8 @@ typedef struct {
     int x, y;
 } SpectrumPoint;
 
-// Hold buffer structure for 2 second peak hold functionality
-typedef struct {
-    float peak_db;           // Peak dB value (stored in dB)
-    absolute_time_t hold_time; // Time when this peak was set (absolute time)
-} SpectrumHold;
-
-// Display configuration for hold functionality - main.cで定義された設定を使用
-// ピークホールド時間は main.c の PEAK_HOLD_DURATION_MS 定数で制御されます
+// Hold line color - ホールド線のトレース（最大ホールド等）は fft_trace.c で計算され
+// fft_streaming_display_update_hold() で渡されます
 #define STREAM_HOLD_COLOR 0x07FF      // Cyan color for held peaks
 
 // Display statistics structure
@@ -68,13 +60,17 @@ typedef struct {
 // Core display functions
 void fft_streaming_display_init(void);
 void fft_streaming_display_clear(void);
-void fft_streaming_display_update_spectrum(const float* magnitude_db, float sample_rate);
+void fft_streaming_display_update_spectrum(const float* magnitude_db, int fft_size, float sample_rate);
+void fft_streaming_display_update_hold(const float* hold_db, int fft_size, float sample_rate);
+void fft_streaming_display_update_columns(const float* column_db, const float* hold_db);
 void fft_streaming_display_render_buffer(void);
 void fft_streaming_display_get_stats(fft_streaming_display_stats_t* stats);
 
 // Frequency scaling functions
 float fft_streaming_display_freq_to_position(float freq_hz);
 int fft_streaming_display_freq_to_column(float freq_hz);
+bool fft_streaming_display_set_frequency_range(float min_hz, float max_hz);
+void fft_streaming_display_get_frequency_range(float* min_hz, float* max_hz);
 
 // Axis and grid drawing functions
 void fft_streaming_display_draw_axes(void);
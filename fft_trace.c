@@ -0,0 +1,223 @@
+/*****************************************************************************
+* | File      	:   fft_trace.c
+* | Author      :   PicoFFT Project
+* | Function    :   Trace averaging and hold modes in the linear power domain
+* | Info        :
+*   - dBm -> power costs one exp2f per bin and update, shared by all traces;
+*     power -> dB on read uses the table-based log2 of fft_db.c
+*   - The mode switch sits outside the bin loops (one tight loop per mode)
+*----------------
+******************************************************************************/
+
+#include "fft_trace.h"
+#include "fft_db.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#define FFT_TRACE_LOG2_10_OVER_10 0.33219281f  // 10^(dB / 10) = 2^(dB * log2(10) / 10)
+#define FFT_TRACE_MIN_POWER 1e-20f             // FFT_DB_FLOOR in linear power
+
+// Global trace set
+static fft_trace_set_t g_trace = {0};
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Advance one trace over a block of bins
+ */
+static void _fft_trace_update_block(int trace, const float* power, int first, int count) {
+    float* state = &g_trace.power[trace][first];
+    uint32_t frame = g_trace.frames[trace];
+    
+    // The first frame (after a restart) seeds every mode
+    if (frame == 0) {
+        memcpy(state, power, (size_t)count * sizeof(float));
+        if (g_trace.mode[trace] == FFT_TRACE_HOLD_DECAY) {
+            memset(&g_trace.hold_age[trace][first], 0, (size_t)count);
+        }
+        return;
+    }
+    
+    switch (g_trace.mode[trace]) {
+        case FFT_TRACE_CLEAR_WRITE:
+            memcpy(state, power, (size_t)count * sizeof(float));
+            break;
+    
+        case FFT_TRACE_AVERAGE_RMS:
+        case FFT_TRACE_AVERAGE_EXP: {
+            // Running mean over k frames; RMS restarts after N, exponential
+            // keeps weight 1/N (unbiased while it fills up)
+            uint32_t k = frame + 1;
+            if (g_trace.mode[trace] == FFT_TRACE_AVERAGE_RMS) {
+                k = frame % (uint32_t)g_trace.average_count + 1;
+            } else if (k > (uint32_t)g_trace.average_count) {
+                k = (uint32_t)g_trace.average_count;
+            }
+            float weight = 1.0f / (float)k;
+            for (int i = 0; i < count; i++) {
+                state[i] += (power[i] - state[i]) * weight;
+            }
+            break;
+        }
+    
+        case FFT_TRACE_MAX_HOLD:
+            for (int i = 0; i < count; i++) {
+                if (power[i] > state[i]) state[i] = power[i];
+            }
+            break;
+    
+        case FFT_TRACE_MIN_HOLD:
+            for (int i = 0; i < count; i++) {
+                if (power[i] < state[i]) state[i] = power[i];
+            }
+            break;
+    
+        case FFT_TRACE_HOLD_DECAY: {
+            uint8_t* age = &g_trace.hold_age[trace][first];
+            for (int i = 0; i < count; i++) {
+                if (power[i] >= state[i]) {
+                    state[i] = power[i];
+                    age[i] = 0;
+                } else if (age[i] < g_trace.hold_frames) {
+                    age[i]++;
+                } else {
+                    state[i] *= g_trace.decay_factor;
+                    if (state[i] < power[i]) state[i] = power[i];
+                }
+            }
+            break;
+        }
+    
+        default:
+            break;
+    }
+}
+
+// ========================================
+// 🔧 Trace API Implementation
+// ========================================
+
+/**
+ * Initialize the trace set
+ */
+bool fft_trace_init(int trace_count, int average_count, int hold_frames, float decay_db) {
+    if (trace_count < 1 || trace_count > FFT_TRACE_MAX_TRACES || average_count < 1 ||
+        hold_frames < 0 || hold_frames > 255 || decay_db < 0.0f) {
+        printf("ERROR: Invalid trace settings (%d traces, N=%d, hold %d, decay %.2f dB)\n",
+               trace_count, average_count, hold_frames, decay_db);
+        return false;
+    }
+    
+    memset(&g_trace, 0, sizeof(g_trace));
+    g_trace.trace_count = trace_count;
+    g_trace.average_count = average_count;
+    g_trace.hold_frames = hold_frames;
+    g_trace.decay_factor = exp2f(-decay_db * FFT_TRACE_LOG2_10_OVER_10);
+    return true;
+}
+
+/**
+ * Set the mode of one trace
+ */
+bool fft_trace_set_mode(int trace, fft_trace_mode_t mode) {
+    if (trace < 0 || trace >= g_trace.trace_count || mode < 0 || mode >= FFT_TRACE_MODE_COUNT) {
+        printf("ERROR: Invalid trace %d or mode %d\n", trace, mode);
+        return false;
+    }
+    g_trace.mode[trace] = mode;
+    g_trace.frames[trace] = 0;
+    return true;
+}
+
+/**
+ * Get the mode of one trace
+ */
+fft_trace_mode_t fft_trace_get_mode(int trace) {
+    if (trace < 0 || trace >= g_trace.trace_count) {
+        return FFT_TRACE_CLEAR_WRITE;
+    }
+    return g_trace.mode[trace];
+}
+
+/**
+ * Restart every trace
+ */
+void fft_trace_reset(void) {
+    memset(g_trace.frames, 0, sizeof(g_trace.frames));
+}
+
+/**
+ * Feed one spectrum into every trace
+ */
+void fft_trace_update(const float* spectrum_dbm, int bins) {
+    float power[FFT_TRACE_BLOCK];
+    
+    if (spectrum_dbm == NULL || bins < 1 || bins > FFT_TRACE_MAX_BINS) {
+        return;
+    }
+    if (bins != g_trace.bins) {
+        g_trace.bins = bins;
+        fft_trace_reset();
+    }
+    
+    for (int first = 0; first < bins; first += FFT_TRACE_BLOCK) {
+        int count = bins - first;
+        if (count > FFT_TRACE_BLOCK) count = FFT_TRACE_BLOCK;
+    
+        for (int i = 0; i < count; i++) {
+            power[i] = exp2f(spectrum_dbm[first + i] * FFT_TRACE_LOG2_10_OVER_10);
+        }
+        for (int trace = 0; trace < g_trace.trace_count; trace++) {
+            _fft_trace_update_block(trace, power, first, count);
+        }
+    }
+    
+    for (int trace = 0; trace < g_trace.trace_count; trace++) {
+        g_trace.frames[trace]++;
+    }
+}
+
+/**
+ * Read one trace in dB
+ */
+bool fft_trace_get_dbm(int trace, float* out, int bins) {
+    if (trace < 0 || trace >= g_trace.trace_count || out == NULL ||
+        g_trace.frames[trace] == 0 || bins != g_trace.bins) {
+        return false;
+    }
+    
+    const float* state = g_trace.power[trace];
+    for (int i = 0; i < bins; i++) {
+        out[i] = (state[i] > FFT_TRACE_MIN_POWER) ? FFT_DB_PER_LOG2 * fft_db_fast_log2(state[i])
+                                                   : FFT_DB_FLOOR;
+    }
+    return true;
+}
+
+/**
+ * Get the number of frames in one trace
+ */
+uint32_t fft_trace_get_frame_count(int trace) {
+    if (trace < 0 || trace >= g_trace.trace_count) {
+        return 0;
+    }
+    return g_trace.frames[trace];
+}
+
+/**
+ * Get trace mode name as string
+ */
+const char* fft_trace_get_mode_name(fft_trace_mode_t mode) {
+    switch (mode) {
+        case FFT_TRACE_CLEAR_WRITE: return "Clear/Write";
+        case FFT_TRACE_AVERAGE_RMS: return "RMS Average";
+        case FFT_TRACE_AVERAGE_EXP: return "Exponential Average";
+        case FFT_TRACE_MAX_HOLD:    return "Max Hold";
+        case FFT_TRACE_MIN_HOLD:    return "Min Hold";
+        case FFT_TRACE_HOLD_DECAY:  return "Hold + Decay";
+        default:                    return "Unknown";
+    }
+}
@@ -0,0 +1,119 @@
+/*****************************************************************************
+* | File      	:   fft_trace.h
+* | Author      :   PicoFFT Project
+* | Function    :   Trace averaging and hold modes in the linear power domain
+* | Info        :
+*   - Several traces fed from one dBm spectrum per display update: clear/write,
+*     RMS average over N frames, exponential average, max/min hold and
+*     hold with decay
+*   - All modes work on linear power (averaging dB values would bias the
+*     noise floor low by up to 2.5 dB)
+*   - Struct-of-arrays layout: one contiguous power array per trace, the
+*     input converted to power once per block and shared by all traces
+*   - The display only reads finished traces (fft_trace_get_dbm())
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_TRACE_H
+#define __FFT_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "fft_window.h"
+
+// Trace configuration
+#define FFT_TRACE_MAX_TRACES TRACE_COUNT    // Traces held at once (sizes the power arrays)
+#define FFT_TRACE_MAX_BINS (FFT_WINDOW_MAX_SIZE / 2)
+#define FFT_TRACE_BLOCK 64                  // Bins converted to power per pass over the traces
+
+// Trace modes (values match TRACE_*_MODE in config_settings.h)
+typedef enum {
+    FFT_TRACE_CLEAR_WRITE = 0,              // Latest spectrum
+    FFT_TRACE_AVERAGE_RMS = 1,              // Mean power of N frames, then restart
+    FFT_TRACE_AVERAGE_EXP = 2,              // Exponential power average, weight 1/N after N frames
+    FFT_TRACE_MAX_HOLD = 3,
+    FFT_TRACE_MIN_HOLD = 4,
+    FFT_TRACE_HOLD_DECAY = 5,               // Max hold for hold_frames, then falling at decay rate
+    FFT_TRACE_MODE_COUNT = 6
+} fft_trace_mode_t;
+
+// Trace set (struct of arrays: per-trace parameters, then per-trace bins)
+typedef struct {
+    fft_trace_mode_t mode[FFT_TRACE_MAX_TRACES];
+    uint32_t frames[FFT_TRACE_MAX_TRACES];  // Frames since the trace was (re)started
+    float power[FFT_TRACE_MAX_TRACES][FFT_TRACE_MAX_BINS]; // Linear power (mW)
+    uint8_t hold_age[FFT_TRACE_MAX_TRACES][FFT_TRACE_MAX_BINS]; // Updates since the held peak (hold decay)
+    int trace_count;
+    int bins;                               // Bins of the current spectrum (restart on change)
+    int average_count;                      // N of the RMS and exponential averages
+    int hold_frames;                        // Updates a hold-decay peak stays put
+    float decay_factor;                     // Power factor per update after the hold time
+} fft_trace_set_t;
+
+// ========================================
+// 🔧 Trace API
+// ========================================
+
+/**
+ * Initialize the trace set (all traces in clear/write mode)
+ * @param trace_count Number of traces (1 to FFT_TRACE_MAX_TRACES)
+ * @param average_count Frames of the RMS and exponential averages (>= 1)
+ * @param hold_frames Updates a hold-decay peak is held (0 to 255)
+ * @param decay_db Fall per update after the hold time in dB (>= 0)
+ * @return true if successful, false on invalid parameters
+ */
+bool fft_trace_init(int trace_count, int average_count, int hold_frames, float decay_db);
+
+/**
+ * Set the mode of one trace (restarts that trace)
+ * @param trace Trace index
+ * @param mode New mode
+ * @return true if successful, false on invalid trace or mode
+ */
+bool fft_trace_set_mode(int trace, fft_trace_mode_t mode);
+
+/**
+ * Get the mode of one trace
+ * @param trace Trace index
+ * @return Trace mode (clear/write for an invalid index)
+ */
+fft_trace_mode_t fft_trace_get_mode(int trace);
+
+/**
+ * Restart every trace (averages and holds start over)
+ */
+void fft_trace_reset(void);
+
+/**
+ * Feed one spectrum into every trace
+ * A change of bin count (FFT size switch) restarts the traces
+ * @param spectrum_dbm Spectrum in dBm (or dBm/Hz)
+ * @param bins Number of bins (1 to FFT_TRACE_MAX_BINS)
+ */
+void fft_trace_update(const float* spectrum_dbm, int bins);
+
+/**
+ * Read one trace in dB
+ * @param trace Trace index
+ * @param out Output buffer (bins elements)
+ * @param bins Number of bins to read (the count passed to fft_trace_update())
+ * @return true if the trace holds data, false otherwise
+ */
+bool fft_trace_get_dbm(int trace, float* out, int bins);
+
+/**
+ * Get the number of frames in one trace
+ * @param trace Trace index
+ * @return Frames since the trace was (re)started
+ */
+uint32_t fft_trace_get_frame_count(int trace);
+
+/**
+ * Get trace mode name as string
+ * @param mode Trace mode
+ * @return Mode name
+ */
+const char* fft_trace_get_mode_name(fft_trace_mode_t mode);
+
+#endif // __FFT_TRACE_H
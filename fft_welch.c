@@ -0,0 +1,123 @@
+/*****************************************************************************
+* | File      	:   fft_welch.c
+* | Author      :   PicoFFT Project
+* | Function    :   Welch averaged power spectral density
+* | Info        :   
+*   - Power accumulated as |X|^2 in FFT units; the dB stage offset converts
+*     the mean to window-corrected dBm, the ENBW term turns it into dBm/Hz
+*   - Variance of each bin drops by about K (less with strong overlap)
+*----------------
+******************************************************************************/
+
+#include "fft_welch.h"
+#include "fft_window.h"
+#include "fft_db.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+// Global Welch accumulator
+static fft_welch_state_t g_welch = {0};
+
+// ========================================
+// 🔧 Welch PSD API Implementation
+// ========================================
+
+/**
+ * Initialize the Welch accumulator
+ */
+bool fft_welch_init(int segments) {
+    memset(&g_welch, 0, sizeof(g_welch));
+    if (!fft_welch_set_segments(segments)) {
+        printf("ERROR: Invalid Welch segment count %d (max %d)\n", 
+               segments, FFT_WELCH_MAX_SEGMENTS);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Change the number of averaged segments
+ */
+bool fft_welch_set_segments(int segments) {
+    if (segments < 1 || segments > FFT_WELCH_MAX_SEGMENTS) {
+        return false;
+    }
+    g_welch.segment_target = segments;
+    fft_welch_reset();
+    return true;
+}
+
+/**
+ * Get the number of averaged segments
+ */
+int fft_welch_get_segments(void) {
+    return g_welch.segment_target;
+}
+
+/**
+ * Discard the partial accumulation
+ */
+void fft_welch_reset(void) {
+    memset(g_welch.power_sum, 0, sizeof(g_welch.power_sum));
+    g_welch.segments_accumulated = 0;
+}
+
+/**
+ * Add one FFT segment to the accumulator
+ */
+bool fft_welch_accumulate(const kiss_fft_cpx* spectrum, int fft_size, float sample_rate) {
+    if (spectrum == NULL || fft_size < 2 || fft_size / 2 > FFT_WELCH_MAX_BINS) {
+        return false;
+    }
+    
+    // Segments of different length cannot be averaged together
+    if (fft_size != g_welch.fft_size) {
+        g_welch.fft_size = fft_size;
+        g_welch.psd_ready = false;
+        fft_welch_reset();
+    }
+    
+    const int bins = fft_size / 2;
+    for (int i = 0; i < bins; i++) {
+        float real = (float)spectrum[i].r;
+        float imag = (float)spectrum[i].i;
+        g_welch.power_sum[i] += real * real + imag * imag;
+    }
+    
+    if (++g_welch.segments_accumulated < g_welch.segment_target) {
+        return false;
+    }
+    
+    // Mean power -> dBm/Hz: 1/K folds into the offset together with the bin
+    // noise bandwidth, so the log runs once per bin per estimate
+    float bandwidth_hz = fft_welch_get_bin_bandwidth(fft_size, sample_rate);
+    float adjust_db = -10.0f * log10f((float)g_welch.segments_accumulated * bandwidth_hz);
+    fft_db_convert_power(g_welch.power_sum, g_welch.psd_db, bins, adjust_db);
+    
+    g_welch.psd_ready = true;
+    g_welch.psd_count++;
+    fft_welch_reset();
+    return true;
+}
+
+/**
+ * Get the last completed PSD estimate
+ */
+const float* fft_welch_get_psd(void) {
+    return g_welch.psd_ready ? g_welch.psd_db : NULL;
+}
+
+/**
+ * Get the noise bandwidth of one bin for the active window
+ */
+float fft_welch_get_bin_bandwidth(int fft_size, float sample_rate) {
+    return fft_window_get_enbw() * sample_rate / (float)fft_size;
+}
+
+/**
+ * Get the number of completed PSD estimates
+ */
+uint32_t fft_welch_get_psd_count(void) {
+    return g_welch.psd_count;
+}
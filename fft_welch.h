@@ -0,0 +1,95 @@
+/*****************************************************************************
+* | File      	:   fft_welch.h
+* | Author      :   PicoFFT Project
+* | Function    :   Welch averaged power spectral density
+* | Info        :   
+*   - Averages K windowed (overlapped) segments in the linear power domain
+*   - Streaming accumulator: one add per bin per segment, no history buffer
+*   - Output in dBm/Hz, normalized by the window's ENBW x bin width
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_WELCH_H
+#define __FFT_WELCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "kiss_fft.h"
+#include "fft_plan.h"
+
+// Welch configuration
+#define FFT_WELCH_MAX_SEGMENTS 256          // Upper limit for K
+#define FFT_WELCH_MAX_BINS (FFT_PLAN_MAX_SIZE / 2)
+
+// Welch accumulator state
+typedef struct {
+    float power_sum[FFT_WELCH_MAX_BINS];    // Sum of |X|^2 over accumulated segments
+    float psd_db[FFT_WELCH_MAX_BINS];       // Last completed PSD (dBm/Hz)
+    int fft_size;                           // FFT size of the accumulated segments
+    int segment_target;                     // K: segments per PSD estimate
+    int segments_accumulated;               // Segments in power_sum
+    uint32_t psd_count;                     // Completed PSD estimates
+    bool psd_ready;                         // psd_db holds a completed estimate
+} fft_welch_state_t;
+
+// ========================================
+// 🔧 Welch PSD API
+// ========================================
+
+/**
+ * Initialize the Welch accumulator
+ * @param segments Segments averaged per estimate (1 to FFT_WELCH_MAX_SEGMENTS)
+ * @return true if successful, false on invalid segment count
+ */
+bool fft_welch_init(int segments);
+
+/**
+ * Change the number of averaged segments (restarts accumulation)
+ * @param segments Segments averaged per estimate (1 to FFT_WELCH_MAX_SEGMENTS)
+ * @return true if successful, false on invalid segment count
+ */
+bool fft_welch_set_segments(int segments);
+
+/**
+ * Get the number of averaged segments
+ * @return K
+ */
+int fft_welch_get_segments(void);
+
+/**
+ * Discard the partial accumulation (call after window or size changes)
+ */
+void fft_welch_reset(void);
+
+/**
+ * Add one FFT segment to the accumulator
+ * When K segments are collected the PSD is computed and accumulation restarts
+ * @param spectrum FFT output bins (windowed segment)
+ * @param fft_size FFT size of the segment
+ * @param sample_rate Sample rate of the segment in Hz (sets the bin bandwidth)
+ * @return true if this segment completed a PSD estimate
+ */
+bool fft_welch_accumulate(const kiss_fft_cpx* spectrum, int fft_size, float sample_rate);
+
+/**
+ * Get the last completed PSD estimate
+ * @return Pointer to PSD array in dBm/Hz (fft_size/2 elements), NULL if none yet
+ */
+const float* fft_welch_get_psd(void);
+
+/**
+ * Get the noise bandwidth of one bin for the active window
+ * @param fft_size FFT size
+ * @param sample_rate Sampling rate in Hz
+ * @return ENBW x fs / N in Hz
+ */
+float fft_welch_get_bin_bandwidth(int fft_size, float sample_rate);
+
+/**
+ * Get the number of completed PSD estimates
+ * @return Estimate count since initialization
+ */
+uint32_t fft_welch_get_psd_count(void);
+
+#endif // __FFT_WELCH_H
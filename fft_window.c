@@ -0,0 +1,335 @@
+/*****************************************************************************
+* | File      	:   fft_window.c
+* | Author      :   PicoFFT Project
+* | Function    :   Precomputed FFT window coefficient tables
+* | Info        :   
+*   - Builds window coefficients once instead of per sample and frame
+*   - Measures coherent gain and ENBW directly from the coefficients
+*   - Tables for all registered FFT sizes share one static pool
+*----------------
+******************************************************************************/
+
+#include "fft_window.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Global window table cache
+static fft_window_table_t g_window_table = {0};
+
+// ========================================
+// 🔧 Window Generation (cold path only)
+// ========================================
+
+/**
+ * Zeroth-order modified Bessel function of the first kind (series expansion)
+ */
+static double _fft_window_bessel_i0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    double half_x = x / 2.0;
+    
+    for (int k = 1; k < 32; k++) {
+        term *= (half_x / k) * (half_x / k);
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+/**
+ * Calculate a single window coefficient
+ */
+static double _fft_window_coefficient(fft_window_type_t type, int i, int size) {
+    if (size <= 1) return 1.0;
+    
+    double phase = 2.0 * M_PI * i / (size - 1);
+    
+    switch (type) {
+        case FFT_WINDOW_RECTANGLE:
+            return 1.0;
+        case FFT_WINDOW_HAMMING:
+            return 0.54 - 0.46 * cos(phase);
+        case FFT_WINDOW_HANN:
+            return 0.5 * (1.0 - cos(phase));
+        case FFT_WINDOW_BLACKMAN:
+            return 0.42 - 0.5 * cos(phase) + 0.08 * cos(2.0 * phase);
+        case FFT_WINDOW_BLACKMAN_HARRIS:
+            return 0.35875 - 0.48829 * cos(phase) + 
+                   0.14128 * cos(2.0 * phase) - 
+                   0.01168 * cos(3.0 * phase);
+        case FFT_WINDOW_KAISER_BESSEL: {
+            // Kaiser window: I0(beta * sqrt(1 - x^2)) / I0(beta)
+            double alpha = (size - 1) / 2.0;
+            double x = (i - alpha) / alpha;
+            double arg = 1.0 - x * x;
+            if (arg < 0.0) arg = 0.0;
+            return _fft_window_bessel_i0(KAISER_BESSEL_BETA * sqrt(arg)) /
+                   _fft_window_bessel_i0(KAISER_BESSEL_BETA);
+        }
+        case FFT_WINDOW_FLATTOP:
+            return 1.0 - 1.93 * cos(phase) + 
+                   1.29 * cos(2.0 * phase) - 
+                   0.388 * cos(3.0 * phase) + 
+                   0.032 * cos(4.0 * phase);
+        default:
+            return 1.0;
+    }
+}
+
+/**
+ * Measure coherent gain and ENBW of a window type
+ */
+static void _fft_window_measure(fft_window_type_t type, int size, fft_window_info_t* info) {
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    
+    for (int i = 0; i < size; i++) {
+        double w = _fft_window_coefficient(type, i, size);
+        sum += w;
+        sum_sq += w * w;
+    }
+    
+    info->coherent_gain = (float)(sum / size);
+    info->enbw_bins = (sum != 0.0) ? (float)(size * sum_sq / (sum * sum)) : 1.0f;
+}
+
+/**
+ * Fill the coefficient table of one slot
+ */
+static void _fft_window_build_table(fft_window_slot_t* slot, fft_window_type_t type) {
+    float* coefficients = &g_window_table.coefficients[slot->offset];
+    float peak = 1.0f;
+    for (int i = 0; i < slot->size; i++) {
+        float w = (float)_fft_window_coefficient(type, i, slot->size);
+        coefficients[i] = w;
+        if (fabsf(w) > peak) peak = fabsf(w);
+    }
+    
+#ifdef FIXED_POINT
+    // Q15 copy, normalized so that the peak coefficient fits below 1.0
+    int16_t* coefficients_q15 = &g_window_table.coefficients_q15[slot->offset];
+    slot->q15_scale = peak;
+    for (int i = 0; i < slot->size; i++) {
+        float q15 = floorf(coefficients[i] / peak * 32768.0f + 0.5f);
+        if (q15 > 32767.0f) q15 = 32767.0f;
+        if (q15 < -32768.0f) q15 = -32768.0f;
+        coefficients_q15[i] = (int16_t)q15;
+    }
+#else
+    (void)peak;
+#endif
+}
+
+/**
+ * Get the active slot
+ */
+static inline const fft_window_slot_t* _fft_window_active(void) {
+    return &g_window_table.slots[g_window_table.active_slot];
+}
+
+/**
+ * Find the slot built for an FFT size
+ */
+static const fft_window_slot_t* _fft_window_find(int size) {
+    for (int s = 0; s < g_window_table.slot_count; s++) {
+        if (g_window_table.slots[s].size == size) {
+            return &g_window_table.slots[s];
+        }
+    }
+    return NULL;
+}
+
+// ========================================
+// 🔧 Window Table API Implementation
+// ========================================
+
+/**
+ * Build window tables for a set of FFT sizes
+ */
+bool fft_window_init(const int* sizes, int size_count, fft_window_type_t type) {
+    if (sizes == NULL || size_count < 1 || size_count > FFT_WINDOW_MAX_TABLES) {
+        printf("ERROR: Invalid window table count %d (max %d)\n", size_count, FFT_WINDOW_MAX_TABLES);
+        return false;
+    }
+    if (type < 0 || type >= FFT_WINDOW_TYPE_COUNT) {
+        printf("ERROR: Invalid window type %d\n", type);
+        return false;
+    }
+    
+    memset(&g_window_table, 0, sizeof(g_window_table));
+    
+    int offset = 0;
+    for (int s = 0; s < size_count; s++) {
+        int size = sizes[s];
+        if (size < 1 || size > FFT_WINDOW_MAX_SIZE) {
+            printf("ERROR: Invalid window table size %d (max %d)\n", size, FFT_WINDOW_MAX_SIZE);
+            return false;
+        }
+        if (offset + size > FFT_WINDOW_POOL_SIZE) {
+            printf("ERROR: Window pool exhausted at N=%d (%d + %d > %d)\n",
+                   size, offset, size, FFT_WINDOW_POOL_SIZE);
+            return false;
+        }
+        
+        fft_window_slot_t* slot = &g_window_table.slots[s];
+        slot->size = size;
+        slot->offset = offset;
+        offset += size;
+        
+        // Figures of merit for every window type (used for correction and PSD scaling)
+        for (int t = 0; t < FFT_WINDOW_TYPE_COUNT; t++) {
+            _fft_window_measure((fft_window_type_t)t, size, &slot->info[t]);
+        }
+        _fft_window_build_table(slot, type);
+    }
+    
+    g_window_table.slot_count = size_count;
+    g_window_table.active_slot = 0;
+    g_window_table.type = type;
+    g_window_table.initialized = true;
+    
+    printf("Window tables initialized: %s, %d sizes, %d/%d coefficients\n",
+           fft_window_get_name(type), size_count, offset, FFT_WINDOW_POOL_SIZE);
+    return true;
+}
+
+/**
+ * Switch the active window type
+ */
+bool fft_window_select(fft_window_type_t type) {
+    if (!g_window_table.initialized || type < 0 || type >= FFT_WINDOW_TYPE_COUNT) {
+        return false;
+    }
+    
+    // In place: a second pool would not fit in RAM. The caller guarantees no
+    // reader (windowing, stream stages, peak table) runs until this returns;
+    // the type is published last so derived tables rebuild from finished data
+    if (type != g_window_table.type) {
+        for (int s = 0; s < g_window_table.slot_count; s++) {
+            _fft_window_build_table(&g_window_table.slots[s], type);
+        }
+        g_window_table.type = type;
+    }
+    return true;
+}
+
+/**
+ * Switch the active table to another prebuilt FFT size
+ */
+bool fft_window_set_size(int size) {
+    for (int s = 0; s < g_window_table.slot_count; s++) {
+        if (g_window_table.slots[s].size == size) {
+            g_window_table.active_slot = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Get FFT size of the active table
+ */
+int fft_window_get_size(void) {
+    return _fft_window_active()->size;
+}
+
+/**
+ * Get active window type
+ */
+fft_window_type_t fft_window_get_type(void) {
+    return g_window_table.type;
+}
+
+/**
+ * Get active window coefficient table
+ */
+const float* fft_window_get_coefficients(void) {
+    return &g_window_table.coefficients[_fft_window_active()->offset];
+}
+
+#ifdef FIXED_POINT
+/**
+ * Get active window coefficient table in Q15 format
+ */
+const int16_t* fft_window_get_coefficients_q15(void) {
+    return &g_window_table.coefficients_q15[_fft_window_active()->offset];
+}
+
+/**
+ * Get the normalization applied to the Q15 table
+ */
+float fft_window_get_q15_scale(void) {
+    float scale = _fft_window_active()->q15_scale;
+    return (scale > 0.0f) ? scale : 1.0f;
+}
+#endif
+
+/**
+ * Get coherent gain of the active window
+ */
+float fft_window_get_coherent_gain(void) {
+    if (!g_window_table.initialized) return 1.0f;
+    return _fft_window_active()->info[g_window_table.type].coherent_gain;
+}
+
+/**
+ * Get equivalent noise bandwidth of the active window
+ */
+float fft_window_get_enbw(void) {
+    if (!g_window_table.initialized) return 1.0f;
+    return _fft_window_active()->info[g_window_table.type].enbw_bins;
+}
+
+/**
+ * Get amplitude correction factor of the active window
+ */
+float fft_window_get_amplitude_correction(void) {
+    float gain = fft_window_get_coherent_gain();
+    return (gain > 0.0f) ? 1.0f / gain : 1.0f;
+}
+
+/**
+ * Get the coefficient table of another prebuilt FFT size
+ */
+const float* fft_window_get_coefficients_for_size(int size) {
+    const fft_window_slot_t* slot = _fft_window_find(size);
+    return (slot != NULL) ? &g_window_table.coefficients[slot->offset] : NULL;
+}
+
+/**
+ * Get figures of merit of the active window type for another prebuilt FFT size
+ */
+const fft_window_info_t* fft_window_get_info_for_size(int size) {
+    const fft_window_slot_t* slot = _fft_window_find(size);
+    return (slot != NULL) ? &slot->info[g_window_table.type] : NULL;
+}
+
+/**
+ * Get figures of merit for any window type
+ */
+const fft_window_info_t* fft_window_get_info(fft_window_type_t type) {
+    if (!g_window_table.initialized || type < 0 || type >= FFT_WINDOW_TYPE_COUNT) {
+        return NULL;
+    }
+    return &_fft_window_active()->info[type];
+}
+
+/**
+ * Get window function name as string
+ */
+const char* fft_window_get_name(fft_window_type_t type) {
+    static const char* window_names[FFT_WINDOW_TYPE_COUNT] = {
+        "Rectangle", "Hamming", "Hann", "Blackman", 
+        "Blackman-Harris", "Kaiser-Bessel", "Flat-Top"
+    };
+    
+    if (type >= 0 && type < FFT_WINDOW_TYPE_COUNT) {
+        return window_names[type];
+    }
+    return "Unknown";
+}
@@ -0,0 +1,183 @@
+/*****************************************************************************
+* | File      	:   fft_window.h
+* | Author      :   PicoFFT Project
+* | Function    :   Precomputed FFT window coefficient tables
+* | Info        :   
+*   - Window coefficients built once per FFT size (no cosf() in the hot loop)
+*   - Coherent gain and ENBW measured from the table for every window type
+*   - Runtime window switching: tables rebuilt in place by the analysis
+*     stage between two frames (the pool is too large to double-buffer)
+*   - One table per registered FFT size, so size switching is a pointer swap
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_WINDOW_H
+#define __FFT_WINDOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "kiss_fft.h"   // FIXED_POINT build selection
+
+// Window table configuration
+#define FFT_WINDOW_MAX_SIZE 4096            // Largest table (FFT_PLAN_MAX_SIZE)
+#define FFT_WINDOW_MAX_TABLES 8             // Number of FFT sizes held at once
+#define FFT_WINDOW_POOL_SIZE 10816          // Total coefficients (256+512+1024+1280+1600+2048+4096)
+
+// Window function types (values match FFT_WINDOW_TYPE in config_settings.h)
+typedef enum {
+    FFT_WINDOW_RECTANGLE = 0,
+    FFT_WINDOW_HAMMING = 1,
+    FFT_WINDOW_HANN = 2,
+    FFT_WINDOW_BLACKMAN = 3,
+    FFT_WINDOW_BLACKMAN_HARRIS = 4,
+    FFT_WINDOW_KAISER_BESSEL = 5,
+    FFT_WINDOW_FLATTOP = 6,
+    FFT_WINDOW_TYPE_COUNT = 7
+} fft_window_type_t;
+
+// Per-window figures of merit (measured from the coefficient table)
+typedef struct {
+    float coherent_gain;        // sum(w) / N
+    float enbw_bins;            // N * sum(w^2) / sum(w)^2
+} fft_window_info_t;
+
+// Window table for one FFT size (coefficients live in the shared pool)
+typedef struct {
+    int size;                                   // Table length (FFT size)
+    int offset;                                 // Start index in the coefficient pool
+#ifdef FIXED_POINT
+    float q15_scale;                            // Peak normalization of the Q15 table (>= 1.0)
+#endif
+    fft_window_info_t info[FFT_WINDOW_TYPE_COUNT]; // Gain/ENBW for every window type
+} fft_window_slot_t;
+
+// Window table cache
+typedef struct {
+    fft_window_type_t type;                     // Active window type (shared by all sizes)
+    fft_window_slot_t slots[FFT_WINDOW_MAX_TABLES]; // One table per FFT size
+    int slot_count;                             // Number of tables built
+    int active_slot;                            // Table used by the processing loop
+    float coefficients[FFT_WINDOW_POOL_SIZE];   // Coefficient pool (all sizes)
+#ifdef FIXED_POINT
+    int16_t coefficients_q15[FFT_WINDOW_POOL_SIZE]; // Coefficients / q15_scale (Q15)
+#endif
+    bool initialized;
+} fft_window_table_t;
+
+// ========================================
+// 🔧 Window Table API
+// ========================================
+
+/**
+ * Build window tables for a set of FFT sizes
+ * Computes coherent gain/ENBW for all window types and the coefficient
+ * table of the initial window type for every size; the first size is active
+ * @param sizes FFT sizes (each 1 to FFT_WINDOW_MAX_SIZE)
+ * @param size_count Number of sizes (1 to FFT_WINDOW_MAX_TABLES)
+ * @param type Initial window type
+ * @return true if successful, false on invalid parameters or pool overflow
+ */
+bool fft_window_init(const int* sizes, int size_count, fft_window_type_t type);
+
+/**
+ * Switch the active window type
+ * Rebuilds the coefficient tables of all sizes in place, so it may only run
+ * where no table is read meanwhile: on the analysis stage between frames,
+ * i.e. through the runtime setters (with the dual-core pipeline they run on
+ * core 1 while core 0 waits for the acknowledge). Stages holding results
+ * derived from the table compare fft_window_get_type() and rebuild them
+ * @param type New window type
+ * @return true if successful, false on invalid type
+ */
+bool fft_window_select(fft_window_type_t type);
+
+/**
+ * Switch the active table to another prebuilt FFT size (no recomputation)
+ * @param size FFT size passed to fft_window_init()
+ * @return true if successful, false if no table exists for size
+ */
+bool fft_window_set_size(int size);
+
+/**
+ * Get FFT size of the active table
+ * @return Table length
+ */
+int fft_window_get_size(void);
+
+/**
+ * Get active window type
+ * @return Active window type
+ */
+fft_window_type_t fft_window_get_type(void);
+
+/**
+ * Get active window coefficient table
+ * @return Pointer to coefficient array (FFT size elements)
+ */
+const float* fft_window_get_coefficients(void);
+
+#ifdef FIXED_POINT
+/**
+ * Get active window coefficient table in Q15 format (fixed-point pipeline)
+ * Windows peaking above 1.0 (Flat-Top) are stored divided by their peak;
+ * see fft_window_get_q15_scale()
+ * @return Pointer to Q15 coefficient array (FFT size elements)
+ */
+const int16_t* fft_window_get_coefficients_q15(void);
+
+/**
+ * Get the normalization applied to the Q15 table
+ * @return Factor that restores the true window amplitude (>= 1.0)
+ */
+float fft_window_get_q15_scale(void);
+#endif
+
+/**
+ * Get coherent gain of the active window
+ * @return Coherent gain (sum(w)/N)
+ */
+float fft_window_get_coherent_gain(void);
+
+/**
+ * Get equivalent noise bandwidth of the active window
+ * @return ENBW in FFT bins
+ */
+float fft_window_get_enbw(void);
+
+/**
+ * Get amplitude correction factor of the active window
+ * @return 1 / coherent gain
+ */
+float fft_window_get_amplitude_correction(void);
+
+/**
+ * Get the coefficient table of another prebuilt FFT size
+ * Lets secondary analyses (zoom FFT) share the tables without switching the active size
+ * @param size FFT size passed to fft_window_init()
+ * @return Pointer to coefficient array (size elements), NULL if no table exists
+ */
+const float* fft_window_get_coefficients_for_size(int size);
+
+/**
+ * Get figures of merit of the active window type for another prebuilt FFT size
+ * @param size FFT size passed to fft_window_init()
+ * @return Pointer to window info, NULL if no table exists
+ */
+const fft_window_info_t* fft_window_get_info_for_size(int size);
+
+/**
+ * Get figures of merit for any window type (active FFT size)
+ * @param type Window type
+ * @return Pointer to window info, NULL on invalid type
+ */
+const fft_window_info_t* fft_window_get_info(fft_window_type_t type);
+
+/**
+ * Get window function name as string
+ * @param type Window type
+ * @return String name of window function
+ */
+const char* fft_window_get_name(fft_window_type_t type);
+
+#endif // __FFT_WINDOW_H
@@ -0,0 +1,302 @@
+/*****************************************************************************
+* | File      	:   fft_zoom.c
+* | Author      :   PicoFFT Project
+* | Function    :   Zoom FFT (digital down-converter + complex FFT)
+* | Info        :   
+*   - Mixer products are formed in Q15 scale so the CIC stays integer
+*   - A tone reads the same dBm as in the main spectrum: mixing halves the
+*     amplitude, exactly like the one-sided bin of a real FFT
+*   - Each sample is mixed once; overlap comes from the baseband history
+*   - 10kHz +/- 1kHz at 128kHz: 16x CIC + 2x FIR -> 4kHz, flat to
+*     0.22 * 8kHz = +/-1.76kHz; 64x would leave only +/-880Hz flat and fold
+*     1.0-1.12kHz back onto the outer 120Hz
+*----------------
+******************************************************************************/
+
+#include "fft_zoom.h"
+#include "fft_arena.h"
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FFT_ZOOM_MIX_SCALE 32768.0f         // Q15 scale of the mixer products
+
+// Global zoom state and plan memory (arena block, kept across re-initialization)
+static fft_zoom_state_t g_zoom = {0};
+static void* s_zoom_cfg_mem = NULL;
+static size_t s_zoom_cfg_bytes = 0;
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Recompute the dB offset for the active window
+ * Float: kiss_fft is unscaled, so divide by N (same as the main path).
+ * Fixed: kiss_fft scales by 1/N; undo the input shift instead
+ */
+static void _fft_zoom_update_db_offset(void) {
+    const fft_window_info_t* info = fft_window_get_info_for_size(FFT_ZOOM_FFT_SIZE);
+    float correction = (info != NULL && info->coherent_gain > 0.0f) ? 1.0f / info->coherent_gain : 1.0f;
+    
+#ifdef FIXED_POINT
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT /
+                            ((float)(1 << ADC_FIXED_INPUT_SHIFT) * DB_REFERENCE_VOLTAGE_0DBM);
+#else
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT /
+                            ((float)FFT_ZOOM_FFT_SIZE * DB_REFERENCE_VOLTAGE_0DBM);
+#endif
+    amplitude_scale *= correction;
+    
+    fft_db_stage_configure(&g_zoom.db_stage, 20.0f * log10f(amplitude_scale));
+    g_zoom.window_type = fft_window_get_type();
+}
+
+/**
+ * Window the baseband history and compute one fftshifted dBm spectrum
+ */
+static void _fft_zoom_compute_spectrum(void) {
+    const float* window = fft_window_get_coefficients_for_size(FFT_ZOOM_FFT_SIZE);
+    const int half = FFT_ZOOM_FFT_SIZE / 2;
+    
+    if (g_zoom.window_type != fft_window_get_type()) {
+        _fft_zoom_update_db_offset();
+    }
+    
+    // Oldest sample first (history is full, so it starts at the write position)
+    int pos = g_zoom.baseband_pos;
+    for (int i = 0; i < FFT_ZOOM_FFT_SIZE; i++) {
+#ifdef FIXED_POINT
+        const float max_scalar = (float)((1u << (FIXED_POINT - 1)) - 1);
+        float gain = window[i] * (float)(1 << ADC_FIXED_INPUT_SHIFT);
+        float real = g_zoom.baseband_i[pos] * gain;
+        float imag = g_zoom.baseband_q[pos] * gain;
+        if (real > max_scalar) real = max_scalar;
+        if (real < -max_scalar) real = -max_scalar;
+        if (imag > max_scalar) imag = max_scalar;
+        if (imag < -max_scalar) imag = -max_scalar;
+        g_zoom.fft_input[i].r = (kiss_fft_scalar)lrintf(real);
+        g_zoom.fft_input[i].i = (kiss_fft_scalar)lrintf(imag);
+#else
+        g_zoom.fft_input[i].r = g_zoom.baseband_i[pos] * window[i];
+        g_zoom.fft_input[i].i = g_zoom.baseband_q[pos] * window[i];
+#endif
+        if (++pos == FFT_ZOOM_FFT_SIZE) {
+            pos = 0;
+        }
+    }
+    
+    kiss_fft(g_zoom.fft_cfg, g_zoom.fft_input, g_zoom.fft_output);
+    
+    // fftshift while converting: negative frequencies first, then 0..+span/2
+    fft_db_stage_convert_spectrum(&g_zoom.db_stage, &g_zoom.fft_output[half],
+                                  g_zoom.magnitude, half);
+    fft_db_stage_convert_spectrum(&g_zoom.db_stage, g_zoom.fft_output,
+                                  &g_zoom.magnitude[half], half);
+    
+    // Transition band: neither flat nor free of aliases
+    for (int i = 0; i < half - FFT_ZOOM_FLAT_BINS; i++) {
+        g_zoom.magnitude[i] = FFT_DB_FLOOR;
+        g_zoom.magnitude[FFT_ZOOM_FFT_SIZE - 1 - i] = FFT_DB_FLOOR;
+    }
+    
+    g_zoom.spectrum_ready = true;
+    g_zoom.spectrum_count++;
+}
+
+// ========================================
+// 🔧 Zoom FFT API Implementation
+// ========================================
+
+/**
+ * Initialize the zoom FFT
+ */
+bool fft_zoom_init(void) {
+    memset(&g_zoom, 0, sizeof(g_zoom));
+    
+    if (s_zoom_cfg_mem == NULL) {
+        kiss_fft_alloc(FFT_ZOOM_FFT_SIZE, 0, NULL, &s_zoom_cfg_bytes);
+        s_zoom_cfg_mem = fft_arena_alloc(s_zoom_cfg_bytes, "fft_zoom");
+        if (s_zoom_cfg_mem == NULL) {
+            return false;
+        }
+    }
+    size_t lenmem = s_zoom_cfg_bytes;
+    g_zoom.fft_cfg = kiss_fft_alloc(FFT_ZOOM_FFT_SIZE, 0, s_zoom_cfg_mem, &lenmem);
+    if (g_zoom.fft_cfg == NULL) {
+        printf("ERROR: Failed to build zoom FFT plan\n");
+        return false;
+    }
+    
+    if (fft_window_get_coefficients_for_size(FFT_ZOOM_FFT_SIZE) == NULL) {
+        printf("ERROR: No window table for zoom FFT size %d\n", FFT_ZOOM_FFT_SIZE);
+        return false;
+    }
+    _fft_zoom_update_db_offset();
+    return true;
+}
+
+/**
+ * Select the analyzed band
+ */
+bool fft_zoom_configure(float center_hz, float span_hz, float sample_rate) {
+    if (g_zoom.fft_cfg == NULL) {
+        printf("ERROR: Zoom FFT not initialized\n");
+        return false;
+    }
+    if (center_hz < 0.0f || center_hz > sample_rate / 2.0f ||
+        span_hz < FFT_ZOOM_FLAT_FRACTION * sample_rate / FFT_ZOOM_MAX_DECIMATION ||
+        span_hz > FFT_ZOOM_FLAT_FRACTION * sample_rate / FFT_ZOOM_MIN_DECIMATION) {
+        printf("ERROR: Invalid zoom band %.1f Hz +/- %.1f Hz\n", center_hz, span_hz / 2.0f);
+        return false;
+    }
+    
+    // Largest power-of-two decimation whose flat band still covers the span
+    // (the FIR is flat to +/- FFT_DECIM_FIR_PASS_EDGE of twice the output rate)
+    int decimation = FFT_ZOOM_MIN_DECIMATION;
+    while (decimation * 2 <= FFT_ZOOM_MAX_DECIMATION &&
+           FFT_ZOOM_FLAT_FRACTION * sample_rate / (decimation * 2) >= span_hz) {
+        decimation *= 2;
+    }
+    
+    // CIC takes everything but the final 2:1, which the FIR does
+    if (!fft_decimator_init(&g_zoom.decim_i, decimation / 2, 2, FFT_ZOOM_FIR_TAPS) ||
+        !fft_decimator_init(&g_zoom.decim_q, decimation / 2, 2, FFT_ZOOM_FIR_TAPS)) {
+        return false;
+    }
+    
+    double step = 2.0 * M_PI * center_hz / sample_rate;
+    g_zoom.nco_step_cos = (float)cos(step);
+    g_zoom.nco_step_sin = (float)sin(step);
+    g_zoom.center_hz = center_hz;
+    g_zoom.decimation = decimation;
+    g_zoom.output_rate = sample_rate / decimation;
+    g_zoom.span_hz = FFT_ZOOM_FLAT_FRACTION * g_zoom.output_rate;
+    g_zoom.spectrum_count = 0;
+    g_zoom.configured = true;
+    fft_zoom_reset();
+    
+    printf("Zoom FFT: %.1f Hz +/- %.1f Hz, decimation %d, bin %.2f Hz\n",
+           center_hz, g_zoom.span_hz / 2.0f, decimation, fft_zoom_get_bin_width());
+    return true;
+}
+
+/**
+ * Discard filter state and baseband history
+ */
+void fft_zoom_reset(void) {
+    fft_decimator_reset(&g_zoom.decim_i);
+    fft_decimator_reset(&g_zoom.decim_q);
+    g_zoom.nco_cos = 1.0f;
+    g_zoom.nco_sin = 0.0f;
+    g_zoom.baseband_pos = 0;
+    g_zoom.baseband_filled = 0;
+    g_zoom.new_since_fft = 0;
+    g_zoom.spectrum_ready = false;
+}
+
+/**
+ * Feed raw ADC samples through the mixer and decimators
+ */
+bool fft_zoom_process(const adc_sample_t* samples, int count) {
+    int32_t mixed_i[FFT_ZOOM_CHUNK];
+    int32_t mixed_q[FFT_ZOOM_CHUNK];
+    float out_i[FFT_ZOOM_CHUNK / FFT_ZOOM_MIN_DECIMATION + 1];
+    float out_q[FFT_ZOOM_CHUNK / FFT_ZOOM_MIN_DECIMATION + 1];
+    bool produced = false;
+    
+    if (!g_zoom.configured || samples == NULL) {
+        return false;
+    }
+    
+    for (int start = 0; start < count; start += FFT_ZOOM_CHUNK) {
+        int chunk = count - start;
+        if (chunk > FFT_ZOOM_CHUNK) chunk = FFT_ZOOM_CHUNK;
+    
+        // Mix down: x * e^(-j*w*n), products in Q15 scale for the integer CIC
+        float c = g_zoom.nco_cos;
+        float s = g_zoom.nco_sin;
+        for (int i = 0; i < chunk; i++) {
+            float x = (float)ADC_SAMPLE_CENTER(samples[start + i]) * FFT_ZOOM_MIX_SCALE;
+            mixed_i[i] = (int32_t)(x * c);
+            mixed_q[i] = (int32_t)(-x * s);
+    
+            float next_c = c * g_zoom.nco_step_cos - s * g_zoom.nco_step_sin;
+            s = s * g_zoom.nco_step_cos + c * g_zoom.nco_step_sin;
+            c = next_c;
+        }
+    
+        // Pull the phasor back onto the unit circle (first-order 1/sqrt)
+        float norm = 1.5f - 0.5f * (c * c + s * s);
+        g_zoom.nco_cos = c * norm;
+        g_zoom.nco_sin = s * norm;
+    
+        int outputs = fft_decimator_process(&g_zoom.decim_i, mixed_i, chunk, out_i);
+        fft_decimator_process(&g_zoom.decim_q, mixed_q, chunk, out_q);
+    
+        for (int i = 0; i < outputs; i++) {
+            g_zoom.baseband_i[g_zoom.baseband_pos] = out_i[i] * (1.0f / FFT_ZOOM_MIX_SCALE);
+            g_zoom.baseband_q[g_zoom.baseband_pos] = out_q[i] * (1.0f / FFT_ZOOM_MIX_SCALE);
+            if (++g_zoom.baseband_pos == FFT_ZOOM_FFT_SIZE) {
+                g_zoom.baseband_pos = 0;
+            }
+            if (g_zoom.baseband_filled < FFT_ZOOM_FFT_SIZE) {
+                g_zoom.baseband_filled++;
+            }
+    
+            if (g_zoom.baseband_filled == FFT_ZOOM_FFT_SIZE && ++g_zoom.new_since_fft >= FFT_ZOOM_HOP) {
+                g_zoom.new_since_fft = 0;
+                _fft_zoom_compute_spectrum();
+                produced = true;
+            }
+        }
+    }
+    
+    return produced;
+}
+
+/**
+ * Get the last zoom spectrum
+ */
+const float* fft_zoom_get_magnitude(void) {
+    return g_zoom.spectrum_ready ? g_zoom.magnitude : NULL;
+}
+
+/**
+ * Convert a zoom bin to frequency in Hz
+ */
+float fft_zoom_bin_to_frequency(int bin) {
+    return g_zoom.center_hz + (float)(bin - FFT_ZOOM_FFT_SIZE / 2) * fft_zoom_get_bin_width();
+}
+
+/**
+ * Get the zoom bin spacing
+ */
+float fft_zoom_get_bin_width(void) {
+    return g_zoom.output_rate / (float)FFT_ZOOM_FFT_SIZE;
+}
+
+/**
+ * Get the flat span of the configured band
+ */
+float fft_zoom_get_span(void) {
+    return g_zoom.span_hz;
+}
+
+/**
+ * Get the total decimation of the configured band
+ */
+int fft_zoom_get_decimation(void) {
+    return g_zoom.decimation;
+}
+
+/**
+ * Get the number of zoom spectra computed
+ */
+uint32_t fft_zoom_get_spectrum_count(void) {
+    return g_zoom.spectrum_count;
+}
@@ -0,0 +1,153 @@
+/*****************************************************************************
+* | File      	:   fft_zoom.h
+* | Author      :   PicoFFT Project
+* | Function    :   Zoom FFT (digital down-converter + complex FFT)
+* | Info        :   
+*   - NCO mixer shifts a user-chosen center frequency to 0Hz
+*   - CIC + FIR decimation (fft_decimator.c) narrows the band to the span;
+*     the final 2x FIR is flat to 0.22 * 2 * output rate, so only +/-0.44 *
+*     output rate is flat and alias-free (0.56 folds onto 0.44), and the
+*     decimation keeps the span inside that
+*   - Complex kiss_fft of the baseband resolves output rate/N per bin; the
+*     bins outside the flat span (transition band) read FFT_DB_FLOOR
+*   - Consumes the raw sample stream before adc_sampling_process_fft()
+*----------------
+******************************************************************************/
+
+#ifndef __FFT_ZOOM_H
+#define __FFT_ZOOM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config_settings.h"
+#include "kiss_fft.h"
+#include "fft_db.h"
+#include "fft_decimator.h"
+#include "fft_window.h"
+#include "adc_convert.h"
+
+// Zoom configuration
+#define FFT_ZOOM_FFT_SIZE 1024              // Baseband FFT size (must have a window table)
+#define FFT_ZOOM_HOP (FFT_ZOOM_FFT_SIZE / 4) // New baseband samples per spectrum (75% overlap)
+#define FFT_ZOOM_CHUNK 64                   // Input samples mixed per block
+#define FFT_ZOOM_MIN_DECIMATION 2
+#define FFT_ZOOM_MAX_DECIMATION (FFT_DECIM_MAX_CIC_RATIO * 2)
+#define FFT_ZOOM_FIR_TAPS 95
+#define FFT_ZOOM_FLAT_FRACTION (4.0f * FFT_DECIM_FIR_PASS_EDGE)  // Flat span / output rate (+/- pass edge of 2x rate)
+#define FFT_ZOOM_FLAT_BINS ((int)(FFT_ZOOM_FLAT_FRACTION * FFT_ZOOM_FFT_SIZE / 2)) // Published bins each side of the center
+#define FFT_ZOOM_CFG_BYTES (sizeof(kiss_fft_cpx) * FFT_ZOOM_FFT_SIZE + 512) // Plan memory estimate (sizes the arena)
+
+// Zoom state
+typedef struct {
+    // Configuration
+    float center_hz;                        // Frequency mapped to 0Hz
+    float span_hz;                          // Flat span (FFT_ZOOM_FLAT_FRACTION * output rate)
+    float output_rate;                      // Baseband sample rate = fs / decimation
+    int decimation;                         // Total decimation (power of two)
+    fft_window_type_t window_type;          // Window the dB offset was computed for
+    
+    // NCO (rotating phasor, renormalized every chunk)
+    float nco_cos;
+    float nco_sin;
+    float nco_step_cos;
+    float nco_step_sin;
+    
+    // Decimators for I and Q
+    fft_decimator_t decim_i;
+    fft_decimator_t decim_q;
+    
+    // Baseband history (circular, oldest sample at baseband_pos once full)
+    float baseband_i[FFT_ZOOM_FFT_SIZE];
+    float baseband_q[FFT_ZOOM_FFT_SIZE];
+    int baseband_pos;
+    int baseband_filled;
+    int new_since_fft;
+    
+    // Complex FFT
+    kiss_fft_cfg fft_cfg;
+    kiss_fft_cpx fft_input[FFT_ZOOM_FFT_SIZE];
+    kiss_fft_cpx fft_output[FFT_ZOOM_FFT_SIZE];
+    fft_db_stage_t db_stage;                // Own offset (different FFT scaling than the main path)
+    float magnitude[FFT_ZOOM_FFT_SIZE];     // fftshifted spectrum in dBm, lowest frequency first
+    uint32_t spectrum_count;
+    bool spectrum_ready;
+    bool configured;
+} fft_zoom_state_t;
+
+// ========================================
+// 🔧 Zoom FFT API
+// ========================================
+
+/**
+ * Initialize the zoom FFT (builds the complex plan from static memory)
+ * Requires fft_window_init() with FFT_ZOOM_FFT_SIZE among the table sizes
+ * @return true if successful, false on error
+ */
+bool fft_zoom_init(void);
+
+/**
+ * Select the analyzed band
+ * The decimation is the largest power of two whose flat span
+ * (FFT_ZOOM_FLAT_FRACTION of the output rate) still covers the requested
+ * span; fft_zoom_get_span() reports the flat span actually analyzed
+ * @param center_hz Center frequency (0 to fs/2)
+ * @param span_hz Total span in Hz (FFT_ZOOM_FLAT_FRACTION * fs/FFT_ZOOM_MAX_DECIMATION
+ *                to FFT_ZOOM_FLAT_FRACTION * fs/FFT_ZOOM_MIN_DECIMATION)
+ * @param sample_rate ADC sample rate in Hz (reconfigure after a rate change)
+ * @return true if successful, false on invalid band
+ */
+bool fft_zoom_configure(float center_hz, float span_hz, float sample_rate);
+
+/**
+ * Discard filter state and baseband history (keeps the band)
+ */
+void fft_zoom_reset(void);
+
+/**
+ * Feed raw ADC samples through the mixer and decimators
+ * A spectrum is computed every FFT_ZOOM_HOP baseband samples
+ * @param samples Raw ADC samples (adc_sample_t), contiguous in time
+ * @param count Number of samples
+ * @return true if at least one new zoom spectrum was produced
+ */
+bool fft_zoom_process(const adc_sample_t* samples, int count);
+
+/**
+ * Get the last zoom spectrum
+ * @return Pointer to FFT_ZOOM_FFT_SIZE bins in dBm (center at index N/2, bins
+ *         more than FFT_ZOOM_FLAT_BINS from it at FFT_DB_FLOOR), NULL if none yet
+ */
+const float* fft_zoom_get_magnitude(void);
+
+/**
+ * Convert a zoom bin to frequency in Hz
+ * @param bin Bin index (0 to FFT_ZOOM_FFT_SIZE-1)
+ * @return Absolute frequency in Hz
+ */
+float fft_zoom_bin_to_frequency(int bin);
+
+/**
+ * Get the zoom bin spacing
+ * @return Output rate / FFT_ZOOM_FFT_SIZE in Hz
+ */
+float fft_zoom_get_bin_width(void);
+
+/**
+ * Get the flat span of the configured band
+ * @return Span in Hz, at least the requested one (FFT_ZOOM_FLAT_FRACTION * output rate)
+ */
+float fft_zoom_get_span(void);
+
+/**
+ * Get the total decimation of the configured band
+ * @return fs / baseband rate
+ */
+int fft_zoom_get_decimation(void);
+
+/**
+ * Get the number of zoom spectra computed
+ * @return Spectrum count since configuration
+ */
+uint32_t fft_zoom_get_spectrum_count(void);
+
+#endif // __FFT_ZOOM_H
@@ -12,6 +12,7 @@
 #include "lcd_partial_update.h"
 #include "LCD_Driver.h"
 #include "DEV_Config.h"
+#include "fft_arena.h"
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
@@ -30,9 +31,13 @@ static uint16_t* temp_buffer = NULL;
  * Initialize partial update system
  */
 bool partial_update_init(void) {
-    // Allocate screen buffer to track current state
-    screen_buffer = (uint16_t*)malloc(LCD_X_MAXPIXEL * LCD_Y_MAXPIXEL * sizeof(uint16_t));
-    temp_buffer = (uint16_t*)malloc(LCD_X_MAXPIXEL * sizeof(uint16_t));
+    // Carve the screen buffer out of the startup arena (once; kept across cleanup)
+    if (!screen_buffer) {
+        screen_buffer = (uint16_t*)fft_arena_alloc(LCD_X_MAXPIXEL * LCD_Y_MAXPIXEL * sizeof(uint16_t), "partial_update");
+    }
+    if (screen_buffer && !temp_buffer) {
+        temp_buffer = (uint16_t*)fft_arena_alloc(LCD_X_MAXPIXEL * sizeof(uint16_t), "partial_update");
+    }
     
     if (!screen_buffer || !temp_buffer) {
         partial_update_cleanup();
@@ -50,16 +55,9 @@ bool partial_update_init(void) {
 
 /**
  * Cleanup partial update system
+ * Arena memory is never freed: the buffers stay reserved for the next init
  */
 void partial_update_cleanup(void) {
-    if (screen_buffer) {
-        free(screen_buffer);
-        screen_buffer = NULL;
-    }
-    if (temp_buffer) {
-        free(temp_buffer);
-        temp_buffer = NULL;
-    }
     g_partial_update.enabled = false;
 }
 
@@ -11,6 +11,7 @@
 
 #include "fft_analyzer.h"
 #include "config_settings.h"
+#include "fft_arena.h"
 
 // Global FFT analyzer instance
 fft_analyzer_t g_fft_analyzer = {0};
@@ -30,8 +31,18 @@ void fft_analyzer_init(void) {
     // Using direct adc_read() calls, so no need for specific timing here
     adc_set_clkdiv(390.0f);  // Maintain 128kHz rate for consistency
     
-    // Initialize kiss_fft configuration
-    g_fft_analyzer.fft_cfg = kiss_fft_alloc(FFT_SIZE, 0, NULL, NULL);
+    // Initialize kiss_fft configuration in the startup arena (lenmem mode, no malloc)
+    static void* cfg_mem = NULL;
+    static size_t cfg_bytes = 0;
+    if (cfg_mem == NULL) {
+        kiss_fft_alloc(FFT_SIZE, 0, NULL, &cfg_bytes);
+        cfg_mem = fft_arena_alloc(cfg_bytes, "fft_analyzer");
+        if (cfg_mem == NULL) {
+            return;
+        }
+    }
+    size_t lenmem = cfg_bytes;
+    g_fft_analyzer.fft_cfg = kiss_fft_alloc(FFT_SIZE, 0, cfg_mem, &lenmem);
     if (g_fft_analyzer.fft_cfg == NULL) {
         printf("ERROR: Failed to allocate kiss_fft configuration!\n");
         return;
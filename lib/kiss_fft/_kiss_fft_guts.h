@@ -41,19 +41,19 @@ struct kiss_fft_state{
    C_ADDTO( res , a)    : res += a
  * */
 #ifdef FIXED_POINT
-#if (SAMPLE_BITS+SAMPLE_BITS) > 32
-#  define KISS_FFT_COS(phase)  floor(.5+SAMP_MAX * cos (phase))
-#  define KISS_FFT_SIN(phase)  floor(.5+SAMP_MAX * sin (phase))
-#  define HALF_OF(x) ((x)>>1)
-#elif defined(USE_SIMD)
-#  define KISS_FFT_COS(phase) _mm_set1_ps( cos(phase) )
-#  define KISS_FFT_SIN(phase) _mm_set1_ps( sin(phase) )
-#  define HALF_OF(x) ((x)*_mm_set1_ps(.5))
+#if (FIXED_POINT==32)
+# define FRACBITS 31
+# define SAMPPROD int64_t
+# define SAMP_MAX 2147483647
 #else
+# define FRACBITS 15
+# define SAMPPROD int32_t
+# define SAMP_MAX 32767
+#endif
+
 #  define KISS_FFT_COS(phase)  floor(.5+SAMP_MAX * cos (phase))
 #  define KISS_FFT_SIN(phase)  floor(.5+SAMP_MAX * sin (phase))
 #  define HALF_OF(x) ((x)>>1)
-#endif
 
 #  define  kf_cexp(x,phase) \
 	do{ \
@@ -145,10 +145,8 @@ struct kiss_fft_state{
 #endif
 
 #ifdef FIXED_POINT
-#define SAMP_MAX 2147483647
-#define sround( x )  (short)( .5 + (x) )
-#define smul(a,b) ( (long)(a)*(b) )
-#define sround( x )  (short)( .5 + (x) )
+#define smul(a,b) ( (SAMPPROD)(a)*(b) )
+#define sround( x )  (kiss_fft_scalar)( ( (x) + ((SAMPPROD)1<<(FRACBITS-1)) ) >> FRACBITS )
 #define S_MUL(a,b) sround( smul(a,b) )
 #else
 #define S_MUL(a,b) ( (a)*(b) )
@@ -36,7 +36,11 @@ extern "C" {
 
 #ifdef FIXED_POINT
 #include <stdint.h>
-# define kiss_fft_scalar int16_t
+# if (FIXED_POINT == 32)
+#  define kiss_fft_scalar int32_t
+# else
+#  define kiss_fft_scalar int16_t
+# endif
 #else
 # ifndef kiss_fft_scalar
 /*  default is float */
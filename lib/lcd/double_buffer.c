@@ -13,6 +13,7 @@
 #include "LCD_Driver.h"
 #include "LCD_GUI.h"
 #include "DEV_Config.h"
+#include "fft_arena.h"
 #include "hardware/dma.h"
 #include "pico/stdlib.h"
 
@@ -29,9 +30,13 @@ double_buffer_t g_double_buffer = {
  * @return true if successful, false if failed
  */
 bool double_buffer_init(void) {
-    // Allocate memory for front and back buffers
-    g_double_buffer.front_buffer = (uint16_t*)malloc(BUFFER_SIZE * sizeof(uint16_t));
-    g_double_buffer.back_buffer = (uint16_t*)malloc(BUFFER_SIZE * sizeof(uint16_t));
+    // Carve front and back buffers out of the startup arena (once; kept across cleanup)
+    if (!g_double_buffer.front_buffer) {
+        g_double_buffer.front_buffer = (uint16_t*)fft_arena_alloc(BUFFER_SIZE * sizeof(uint16_t), "double_buffer");
+    }
+    if (g_double_buffer.front_buffer && !g_double_buffer.back_buffer) {
+        g_double_buffer.back_buffer = (uint16_t*)fft_arena_alloc(BUFFER_SIZE * sizeof(uint16_t), "double_buffer");
+    }
     
     if (!g_double_buffer.front_buffer || !g_double_buffer.back_buffer) {
         double_buffer_cleanup();
@@ -50,18 +55,9 @@ bool double_buffer_init(void) {
 
 /**
  * Cleanup double buffering resources
+ * Arena memory is never freed: the buffers stay reserved for the next init
  */
 void double_buffer_cleanup(void) {
-    if (g_double_buffer.front_buffer) {
-        free(g_double_buffer.front_buffer);
-        g_double_buffer.front_buffer = NULL;
-    }
-    
-    if (g_double_buffer.back_buffer) {
-        free(g_double_buffer.back_buffer);
-        g_double_buffer.back_buffer = NULL;
-    }
-    
     g_double_buffer.using_double_buffer = false;
     g_double_buffer.buffer_ready = false;
 }
@@ -44,6 +44,7 @@
 #include "hardware/dma.h"
 #include "hardware/irq.h"
 #include "kiss_fft.h"
+#include "fft_arena.h"
 
 /**
  * LCD機能テスト関数
@@ -213,13 +214,15 @@ int fft_realtime_analysis(void) {
         fft_analyzer_init();
         printf("FFT analyzer initialized.\n");
         
-        // 振幅スペクトラム表示用メモリ確保（FFTサイズの半分 = 正の周波数のみ）
-        // Allocate magnitude buffer for display (half FFT size = positive frequencies only)
-        magnitude_db = (float*)malloc(sizeof(float) * FFT_SIZE / 2);
-        if (!magnitude_db) {
+        // 振幅スペクトラム表示用メモリ確保（FFTサイズの半分 = 正の周波数のみ、静的アリーナから）
+        // Allocate magnitude buffer for display (half FFT size = positive frequencies only, from the static arena)
+        magnitude_db = (float*)fft_arena_alloc(sizeof(float) * FFT_SIZE / 2, "magnitude_db");
+        if (!magnitude_db || !g_fft_analyzer.fft_cfg) {
             printf("ERROR: Failed to allocate FFT buffer\n");
             return -1;
         }
+        fft_arena_lock();
+        fft_arena_print_usage();
         
         printf("Starting ultra-high-speed real-time FFT analysis (60FPS)...\n");
         printf("ADC Input: GP26 (12-bit, 0-3.3V)\n");
@@ -497,7 +500,7 @@ int fft_realtime_analysis(void) {
         printf("\n");
         
         // Update streaming display
-        fft_streaming_display_update_spectrum(magnitude_db, sample_rate);
+        fft_streaming_display_update_spectrum(magnitude_db, FFT_SIZE, sample_rate);
         
         frame_count++;
         
@@ -557,7 +560,6 @@ int fft_realtime_analysis(void) {
     }
     
     // This point is never reached due to infinite loop
-    // But added for proper function structure
-    free(magnitude_db);
+    // But added for proper function structure (arena memory is never freed)
     return 0;
 }
@@ -63,7 +63,8 @@ int main() {
             DB_REFERENCE_VOLTAGE_0DBM, DB_REFERENCE_IMPEDANCE);
     printf("ADC Input: Zin = %.0fkΩ, Source = %.0fΩ, Correction = %.5f\n",
             ADC_INPUT_IMPEDANCE/1000, SIGNAL_SOURCE_IMPEDANCE, IMPEDANCE_CORRECTION_FACTOR);
-    printf("Peak Hold: %.1f seconds\n", PEAK_HOLD_DURATION_MS/1000.0);
+    printf("Peak Hold: %d ms (%d frames), then %.0f dB/s decay\n", PEAK_HOLD_DURATION_MS,
+            PEAK_HOLD_DURATION_MS * TARGET_FPS / 1000, TRACE_HOLD_DECAY_DB_PER_SEC);
     printf("Display: Green=Current Spectrum, Cyan=Peak Hold\n");
     
     // システム選択に基づいてFFT解析開始
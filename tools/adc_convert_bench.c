@@ -0,0 +1,197 @@
+/*****************************************************************************
+* | File      	:   adc_convert_bench.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host check and benchmark of the ADC windowing kernels (adc_convert.c)
+* | Info        :
+*   - Check: the 8-bit kernel must match the 12-bit kernel on the same
+*     levels shifted back to 12 bits, and a plain per-sample 8-bit
+*     reference, bit for bit (float and Q15/Q31 builds)
+*   - Times the 12-bit kernel, the 8-bit reference and the 8-bit kernel
+*     for every FFT size in ns per sample
+*   - Host numbers only: the word loads and the table pay off more on the
+*     Cortex-M33 (no vector unit, slow int-to-float), so repeat on target
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. -Ilib/kiss_fft tools/adc_convert_bench.c adc_convert.c \
+*         fft_window.c -lm -o adc_convert_bench
+*     (add -DFIXED_POINT=16 or -DFIXED_POINT=32 for the fixed-point kernels)
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "adc_convert.h"
+#include "fft_window.h"
+
+#define BENCH_MAX_SIZE 4096
+#define BENCH_SAMPLES_PER_TRIAL 1000000     // Samples converted per timing trial
+#define BENCH_TRIALS 7                      // Best of N (filters host scheduling noise)
+
+static uint8_t s_samples_u8[BENCH_MAX_SIZE + 3];   // +3: unaligned start check
+static uint16_t s_samples_u16[BENCH_MAX_SIZE];
+static kiss_fft_scalar s_output[BENCH_MAX_SIZE * 2];
+static kiss_fft_scalar s_expected[BENCH_MAX_SIZE * 2];
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Monotonic time in nanoseconds
+ */
+static double _bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Active window table of the build
+ */
+static const adc_window_coef_t* _bench_window(void) {
+#ifdef FIXED_POINT
+    return fft_window_get_coefficients_q15();
+#else
+    return fft_window_get_coefficients();
+#endif
+}
+
+/**
+ * Straightforward 8-bit kernel: per-sample subtract and scale
+ */
+static void _bench_reference_u8(const uint8_t* samples, int count, const adc_window_coef_t* window,
+                                kiss_fft_scalar* out, int stride) {
+    const int shift = ADC_RESOLUTION_BITS - 8;
+    uint32_t dc_sum = 0;
+    for (int i = 0; i < count; i++) {
+        dc_sum += samples[i];
+    }
+    
+#ifdef FIXED_POINT
+    int32_t dc_offset = (int32_t)(((dc_sum << shift) + (uint32_t)count / 2) / (uint32_t)count);
+    for (int i = 0; i < count; i++) {
+        adc_fixed_product_t centered =
+            (adc_fixed_product_t)(((int32_t)samples[i] << shift) - dc_offset) * (1 << ADC_FIXED_INPUT_SHIFT);
+        out[i * stride] = (kiss_fft_scalar)((centered * window[i] + (1 << 14)) >> 15);
+    }
+#else
+    float dc_offset = (float)dc_sum / count;
+    for (int i = 0; i < count; i++) {
+        out[i * stride] = ((float)samples[i] - dc_offset) * (float)(1 << shift) * window[i];
+    }
+#endif
+}
+
+/**
+ * Fill the sample buffers: tone plus noise around midscale, 8-bit levels
+ * and the same levels in 12-bit units
+ */
+static void _bench_fill(int count, uint32_t seed) {
+    uint32_t lcg = seed;
+    for (int i = 0; i < count + 3; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        int level = 128 + (int)((i * 37) % 97) - 48 + (int)(lcg >> 29);
+        s_samples_u8[i] = (uint8_t)level;
+    }
+    for (int i = 0; i < count; i++) {
+        s_samples_u16[i] = (uint16_t)(s_samples_u8[i] << (ADC_RESOLUTION_BITS - 8));
+    }
+}
+
+/**
+ * Compare two outputs bit for bit
+ * @return Number of mismatching scalars
+ */
+static int _bench_compare(const kiss_fft_scalar* a, const kiss_fft_scalar* b, int count) {
+    int mismatches = 0;
+    for (int i = 0; i < count; i++) {
+        if (memcmp(&a[i], &b[i], sizeof(kiss_fft_scalar)) != 0) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Check the 8-bit kernel, then time all kernels per FFT size
+ */
+int main(void) {
+    const int sizes[] = {256, 512, 1024, 2048, 4096};
+    const int size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    int failures = 0;
+    
+    if (!fft_window_init(sizes, size_count, FFT_WINDOW_HANN)) {
+        return 1;
+    }
+    
+#ifdef FIXED_POINT
+    printf("ADC windowing kernels (Q%d output)\n", FIXED_POINT == 32 ? 31 : 15);
+#else
+    printf("ADC windowing kernels (float output)\n");
+#endif
+    
+    // Check: 8-bit kernel == 12-bit kernel on the same levels == reference,
+    // for both strides and an unaligned start
+    for (int s = 0; s < size_count; s++) {
+        const int n = sizes[s];
+        fft_window_set_size(n);
+        const adc_window_coef_t* window = _bench_window();
+        for (int stride = 1; stride <= 2; stride++) {
+            for (int offset = 0; offset < 4; offset += 3) {
+                _bench_fill(n, 0xC0FFEEu + (uint32_t)(n * stride + offset));
+                if (offset > 0) {
+                    memmove(s_samples_u8 + offset, s_samples_u8, (size_t)n);
+                }
+                memset(s_output, 0, sizeof(s_output));
+                memset(s_expected, 0, sizeof(s_expected));
+                adc_convert_window_u8(s_samples_u8 + offset, n, window, s_output, stride);
+                adc_convert_window_u16(s_samples_u16, n, window, s_expected, stride);
+                int mismatches = _bench_compare(s_output, s_expected, n * stride);
+                _bench_reference_u8(s_samples_u8 + offset, n, window, s_expected, stride);
+                mismatches += _bench_compare(s_output, s_expected, n * stride);
+                if (mismatches > 0) {
+                    printf("  ERROR: N=%d stride %d offset %d: %d mismatching outputs\n",
+                           n, stride, offset, mismatches);
+                    failures++;
+                }
+            }
+        }
+    }
+    printf("Check: 8-bit kernel vs 12-bit kernel and reference: %s\n", failures == 0 ? "identical" : "MISMATCH");
+    
+    // Timing (ns per sample, best of BENCH_TRIALS)
+    printf("\n  N     12-bit   8-bit ref   8-bit   (ns/sample)\n");
+    for (int s = 0; s < size_count; s++) {
+        const int n = sizes[s];
+        const int frames = BENCH_SAMPLES_PER_TRIAL / n;
+        fft_window_set_size(n);
+        const adc_window_coef_t* window = _bench_window();
+        _bench_fill(n, 12345u);
+        double best[3] = {1e30, 1e30, 1e30};
+        for (int trial = 0; trial < BENCH_TRIALS; trial++) {
+            for (int kernel = 0; kernel < 3; kernel++) {
+                double start = _bench_now_ns();
+                for (int f = 0; f < frames; f++) {
+                    if (kernel == 0) {
+                        adc_convert_window_u16(s_samples_u16, n, window, s_output, 1);
+                    } else if (kernel == 1) {
+                        _bench_reference_u8(s_samples_u8, n, window, s_output, 1);
+                    } else {
+                        adc_convert_window_u8(s_samples_u8, n, window, s_output, 1);
+                    }
+                    __asm__ volatile("" : : "r"(s_output) : "memory");  // Keep every frame
+                }
+                double elapsed = (_bench_now_ns() - start) / ((double)frames * n);
+                if (elapsed < best[kernel]) best[kernel] = elapsed;
+            }
+        }
+        printf("  %4d  %7.2f  %9.2f  %7.2f\n", n, best[0], best[1], best[2]);
+    }
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,374 @@
+/*****************************************************************************
+* | File      	:   dma_chain_model.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host model of the chained capture DMA feeding the frame queue
+* | Info        :
+*   - Steps the ping/pong capture of adc_sampling.c one ADC conversion at a
+*     time: the capture channel writes one sample per step; on completion it
+*     chains to the control channel, which reads the next slot address from
+*     the table through its read ring (same table_bits and &table[1] start
+*     as _adc_dma_start) and re-triggers the capture; the completion IRQ
+*     pushes to adc_frame_queue.c a given number of steps later (IRQ
+*     latency, 0 up to a quarter frame); the queue's DMA slot source reads the
+*     control channel's read address like _adc_dma_capture_slot
+*   - Every sample carries its stream index, so the consumer can tell the
+*     samples it read from the ones it should have read
+*   - The consumer follows adc_sampling: pop, read the slot at
+*     MODEL_READ_RATE samples per step (one per MODEL_SLOW_READ_PERIOD steps
+*     for half the frames under overload, so DMA overtakes the read, as it
+*     does a slow per-sample stream stage), intact() after the last
+*     read (torn frames are dropped), process, release
+*   - The samples also feed a recursive stream stage (sliding DFT, Goertzel,
+*     decimators in _fft_realtime_analyze): a torn frame resets it, and a
+*     result is published only for a frame release() reports intact once the
+*     stage has MODEL_STAGE_WINDOW samples; publishing while the stage holds
+*     a sample that was not its frame's own fails
+*   - Keeping up (read plus processing shorter than a frame): fails unless
+*     every frame is consumed in order, the sample stream is contiguous
+*     across frames, no overrun is counted and the stream stage publishes
+*     every frame once it has filled
+*   - Overload (processing of 0.5 to 3.5 frames): fails if a sequence gap is
+*     not reported as dropped, a frame passes intact() with a sample that
+*     is not its own, release() disagrees with whether DMA moved into the
+*     slot while it was in use, or the counters do not add up
+*   - 2 and 4 slots, every latency in s_latencies, starting
+*     MODEL_WRAP_MARGIN frames below the 2^32 sequence wrap;
+*     tools/frame_queue_stress.c covers the threaded case
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. tools/dma_chain_model.c adc_frame_queue.c -o dma_chain_model
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "adc_frame_queue.h"
+
+#define MODEL_FRAME_SAMPLES 64              // Samples per slot
+#define MODEL_FRAMES 20000u                 // Frames captured per run
+#define MODEL_WRAP_MARGIN 5000u             // Runs cross the 2^32 sequence wrap
+#define MODEL_READ_RATE 4                   // Samples the consumer reads per ADC conversion
+#define MODEL_SLOW_READ_PERIOD 2            // ADC conversions per sample of a slow read
+#define MODEL_KEEP_UP_PROCESS 24            // Processing steps per frame when keeping up
+#define MODEL_OVERLOAD_MIN_PROCESS (MODEL_FRAME_SAMPLES / 2)
+#define MODEL_OVERLOAD_MAX_PROCESS (MODEL_FRAME_SAMPLES * 7 / 2)
+#define MODEL_STAGE_WINDOW (MODEL_FRAME_SAMPLES * 2)   // Stream stage samples before it publishes
+
+// Chained DMA state (capture plus control channel)
+typedef struct {
+    uint32_t memory[ADC_FRAME_QUEUE_MAX_SLOTS * MODEL_FRAME_SAMPLES];
+    int table[ADC_FRAME_QUEUE_MAX_SLOTS];   // Slot start offsets (s_capture_addresses)
+    int table_bits;                         // Control read ring size (log2 bytes)
+    int control_read;                       // Control read address, bytes into the table
+    int write_index;                        // Capture write address (sample offset)
+    int transfer_count;                     // Capture transfers left
+    uint32_t stream_index;                  // Index of the next sample
+    uint32_t sequence;                      // Frame being written
+    int irq_latency;                        // Steps from completion to the push
+    int irq_delay;                          // Steps until the pending push, -1 for none
+} model_dma_t;
+
+// Consumer state (adc_sampling main loop)
+typedef struct {
+    bool holding;                           // A frame is popped
+    adc_frame_info_t frame;
+    int read;                               // Samples read so far
+    int read_rate;                          // Samples read per read step for this frame
+    int read_period;                        // Steps per read step for this frame
+    int read_wait;                          // Steps since the last read step
+    int process_left;                       // Processing steps left after the read
+    bool data_torn;                         // A read sample was not the frame's own
+    bool checked_intact;                    // The frame passed intact()
+    int stage_filled;                       // Stream stage: samples since its reset
+    bool stage_foreign;                     // Stream stage holds a sample not its frame's own
+    bool had_frame;
+    uint32_t last_sequence;
+    uint32_t last_sample;                   // Stream index of the last sample consumed
+    uint32_t popped;
+    uint32_t consumed;                      // Intact frames
+    uint32_t torn_seen;                     // Frames dropped at intact()
+    uint32_t release_torn;                  // Frames release() reported torn
+    uint32_t published;                     // Stream stage results published
+    uint32_t dropped_reported;              // Sum of frame.dropped
+    uint32_t lcg;
+} model_consumer_t;
+
+static model_dma_t s_dma;
+static adc_frame_queue_t s_queue;
+
+// Completion IRQ latencies (steps): with 2 slots a frame can be used for one
+// frame period minus the latency, which the keep-up consumer must still meet
+static const int s_latencies[] = {0, 1, MODEL_FRAME_SAMPLES / 8, MODEL_FRAME_SAMPLES / 4};
+
+// ========================================
+// 🔧 Chained DMA Model
+// ========================================
+
+/**
+ * Slot the capture channel is writing (same derivation as
+ * _adc_dma_capture_slot: the control read address is one entry ahead)
+ */
+static int _model_dma_slot(void) {
+    int next = s_dma.control_read / (int)sizeof(uint32_t);
+    return (next + s_queue.slot_count - 1) % s_queue.slot_count;
+}
+
+/**
+ * Arm the capture at slot 0 and the control channel at &table[1]
+ * (_adc_dma_start), with the queue and DMA at sequence `start`
+ */
+static bool _model_dma_start(int slots, uint32_t start, int irq_latency) {
+    if (!adc_frame_queue_reset(&s_queue, slots) || (start % (uint32_t)slots) != 0) {
+        return false;
+    }
+    s_dma.table_bits = 2;
+    while ((1 << s_dma.table_bits) < slots * (int)sizeof(uint32_t)) {
+        s_dma.table_bits++;
+    }
+    for (int slot = 0; slot < slots; slot++) {
+        s_dma.table[slot] = slot * MODEL_FRAME_SAMPLES;
+    }
+    s_dma.control_read = (int)sizeof(uint32_t);
+    s_dma.write_index = s_dma.table[0];
+    s_dma.transfer_count = MODEL_FRAME_SAMPLES;
+    s_dma.stream_index = start * MODEL_FRAME_SAMPLES;
+    s_dma.sequence = start;
+    s_dma.irq_latency = irq_latency;
+    s_dma.irq_delay = -1;
+    adc_frame_queue_set_dma_slot(&s_queue, _model_dma_slot);
+    
+    // White box: start the queue just below the sequence wrap
+    atomic_store(&s_queue.completed, start);
+    s_queue.next = start;
+    return true;
+}
+
+/**
+ * One ADC conversion: capture write, chain to the control channel on
+ * completion, and the delayed completion IRQ
+ */
+static void _model_dma_step(void) {
+    if (s_dma.irq_delay >= 0 && s_dma.irq_delay-- == 0) {
+        adc_frame_queue_push(&s_queue, s_dma.stream_index, 0);
+    }
+    
+    s_dma.memory[s_dma.write_index++] = s_dma.stream_index++;
+    if (--s_dma.transfer_count > 0) {
+        return;
+    }
+    
+    // Control channel: one word from the read ring into WRITE_ADDR_TRIG;
+    // the transfer count reloads and the capture restarts
+    s_dma.write_index = s_dma.table[s_dma.control_read / (int)sizeof(uint32_t)];
+    s_dma.control_read = (s_dma.control_read + (int)sizeof(uint32_t)) & ((1 << s_dma.table_bits) - 1);
+    s_dma.transfer_count = MODEL_FRAME_SAMPLES;
+    s_dma.sequence++;
+    s_dma.irq_delay = s_dma.irq_latency;
+}
+
+/**
+ * Check whether the capture has moved into the slot of `sequence` again
+ * (re-armed on it, whether or not the first sample is written yet)
+ */
+static bool _model_dma_reentered(uint32_t sequence) {
+    return s_dma.sequence - sequence >= (uint32_t)s_queue.slot_count;
+}
+
+// ========================================
+// 🔧 Consumer Model
+// ========================================
+
+/**
+ * Processing steps of the next frame (fixed, or random under overload)
+ */
+static int _model_process_steps(model_consumer_t* consumer, bool overload) {
+    if (!overload) {
+        return MODEL_KEEP_UP_PROCESS;
+    }
+    consumer->lcg = consumer->lcg * 1664525u + 1013904223u;
+    return MODEL_OVERLOAD_MIN_PROCESS +
+           (int)((consumer->lcg >> 8) % (MODEL_OVERLOAD_MAX_PROCESS - MODEL_OVERLOAD_MIN_PROCESS + 1));
+}
+
+/**
+ * One consumer step, checking each frame against the model
+ * @return Number of failures found in this step
+ */
+static int _model_consumer_step(model_consumer_t* consumer, bool overload) {
+    int failures = 0;
+    
+    if (!consumer->holding) {
+        if (!adc_frame_queue_pop(&s_queue, &consumer->frame)) {
+            return 0;
+        }
+        const adc_frame_info_t* frame = &consumer->frame;
+        uint32_t gap = consumer->had_frame ? frame->sequence - consumer->last_sequence - 1 : 0;
+        if (gap != frame->dropped || (gap > 0) != ((frame->flags & ADC_FRAME_FLAG_DROPPED) != 0) ||
+            frame->slot != (int)(frame->sequence % (uint32_t)s_queue.slot_count)) {
+            printf("    ERROR: sequence %lu: gap %lu reported as %lu dropped (slot %d)\n",
+                   (unsigned long)frame->sequence, (unsigned long)gap, (unsigned long)frame->dropped, frame->slot);
+            failures++;
+        }
+        consumer->dropped_reported += frame->dropped;
+        consumer->had_frame = true;
+        consumer->last_sequence = frame->sequence;
+        consumer->holding = true;
+        consumer->read = 0;
+        consumer->data_torn = false;
+        consumer->checked_intact = false;
+        consumer->process_left = _model_process_steps(consumer, overload);
+        bool slow = overload && (consumer->lcg & 0x10000u);
+        consumer->read_rate = slow ? 1 : MODEL_READ_RATE;
+        consumer->read_period = slow ? MODEL_SLOW_READ_PERIOD : 1;
+        consumer->read_wait = 0;
+        consumer->popped++;
+        return failures;
+    }
+    
+    // Read the slot into the stream stage, then check intact() like
+    // adc_sampling_check_frame()
+    if (consumer->read < MODEL_FRAME_SAMPLES) {
+        if (++consumer->read_wait < consumer->read_period) {
+            return 0;
+        }
+        consumer->read_wait = 0;
+        const uint32_t* samples = &s_dma.memory[consumer->frame.slot * MODEL_FRAME_SAMPLES];
+        const uint32_t first = consumer->frame.sequence * MODEL_FRAME_SAMPLES;
+        for (int i = 0; i < consumer->read_rate && consumer->read < MODEL_FRAME_SAMPLES; i++, consumer->read++) {
+            if (samples[consumer->read] != first + (uint32_t)consumer->read) {
+                consumer->data_torn = true;
+                consumer->stage_foreign = true;
+            }
+            if (consumer->stage_filled < MODEL_STAGE_WINDOW) {
+                consumer->stage_filled++;
+            }
+        }
+        if (consumer->read < MODEL_FRAME_SAMPLES) {
+            return 0;
+        }
+        if (adc_frame_queue_intact(&s_queue)) {
+            if (consumer->data_torn) {
+                printf("    ERROR: sequence %lu passed intact() with overwritten samples\n",
+                       (unsigned long)consumer->frame.sequence);
+                failures++;
+            }
+            if (consumer->consumed > 0 && first != consumer->last_sample + 1 && !overload) {
+                printf("    ERROR: stream gap before sequence %lu\n", (unsigned long)consumer->frame.sequence);
+                failures++;
+            }
+            consumer->last_sample = first + MODEL_FRAME_SAMPLES - 1;
+            consumer->consumed++;
+            consumer->checked_intact = true;
+        } else {
+            // _fft_realtime_reset_stream_stages()
+            consumer->torn_seen++;
+            consumer->stage_filled = 0;
+            consumer->stage_foreign = false;
+        }
+        return failures;
+    }
+    
+    if (consumer->process_left-- > 0) {
+        return 0;
+    }
+    
+    // Release: torn exactly when DMA moved into the slot while in use
+    bool reentered = _model_dma_reentered(consumer->frame.sequence);
+    bool intact = adc_frame_queue_release(&s_queue);
+    if (intact == reentered) {
+        printf("    ERROR: sequence %lu: release() says %s, DMA %s the slot\n",
+               (unsigned long)consumer->frame.sequence, intact ? "intact" : "torn",
+               reentered ? "moved into" : "did not move into");
+        failures++;
+    }
+    if (!intact) {
+        consumer->release_torn++;
+    }
+    
+    // Stream stage result: only for a frame complete_processing() reports intact
+    if (intact && consumer->checked_intact && consumer->stage_filled == MODEL_STAGE_WINDOW) {
+        if (consumer->stage_foreign) {
+            printf("    ERROR: sequence %lu: stream stage published a torn sample\n",
+                   (unsigned long)consumer->frame.sequence);
+            failures++;
+        }
+        consumer->published++;
+    }
+    consumer->holding = false;
+    return failures;
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Run one slot count in one load case
+ * @return Number of failures
+ */
+static int _model_run(int slots, int irq_latency, bool overload) {
+    const uint32_t start = 0u - MODEL_WRAP_MARGIN * (uint32_t)ADC_FRAME_QUEUE_MAX_SLOTS;
+    model_consumer_t consumer = {.lcg = 0x5EEDu + (uint32_t)slots};
+    int failures = 0;
+    
+    if (!_model_dma_start(slots, start, irq_latency)) {
+        printf("    ERROR: cannot start %d slots\n", slots);
+        return 1;
+    }
+    for (uint32_t step = 0; step < MODEL_FRAMES * MODEL_FRAME_SAMPLES; step++) {
+        _model_dma_step();
+        failures += _model_consumer_step(&consumer, overload);
+    }
+    
+    // Every completed frame was popped, dropped or is still queued (drops
+    // after the last pop are still waiting to be reported)
+    uint32_t completed = adc_frame_queue_get_completed(&s_queue) - start;
+    uint32_t accounted = consumer.popped + s_queue.dropped + adc_frame_queue_get_backlog(&s_queue);
+    printf("  %d slots  %7d  %-8s  %6lu  %6lu  %6lu  %7lu  %7lu  %9lu\n", slots, irq_latency,
+           overload ? "overload" : "keep-up",
+           (unsigned long)completed, (unsigned long)consumer.consumed, (unsigned long)s_queue.dropped,
+           (unsigned long)consumer.torn_seen, (unsigned long)s_queue.torn, (unsigned long)consumer.published);
+    if (accounted != completed || consumer.dropped_reported + s_queue.unreported != s_queue.dropped ||
+        consumer.release_torn != s_queue.torn ||
+        adc_frame_queue_get_overruns(&s_queue) != s_queue.dropped + s_queue.torn) {
+        printf("    ERROR: counters do not add up (%lu accounted of %lu)\n",
+               (unsigned long)accounted, (unsigned long)completed);
+        failures++;
+    }
+    if (!overload && (consumer.consumed + 1 < completed || adc_frame_queue_get_overruns(&s_queue) != 0)) {
+        printf("    ERROR: consumer kept up but frames were lost\n");
+        failures++;
+    }
+    if (overload && (s_queue.dropped == 0 || s_queue.torn == 0)) {
+        printf("    ERROR: overload produced no drops or no torn frames\n");
+        failures++;
+    }
+    if (!overload && consumer.published + MODEL_STAGE_WINDOW / MODEL_FRAME_SAMPLES - 1 != consumer.consumed) {
+        printf("    ERROR: stream stage skipped intact frames (%lu published)\n",
+               (unsigned long)consumer.published);
+        failures++;
+    }
+    return failures;
+}
+
+/**
+ * Run 2 and 4 slots at every IRQ latency, keeping up and overloaded
+ */
+int main(void) {
+    const int slot_counts[] = {2, 4};
+    int failures = 0;
+    
+    printf("Chained DMA model into the frame queue (%d-sample frames, %u frames per run)\n",
+           MODEL_FRAME_SAMPLES, MODEL_FRAMES);
+    printf("\n  slots    latency  load      frames  intact  dropped  torn(rd)  torn(rel)  published\n");
+    for (int i = 0; i < (int)(sizeof(slot_counts) / sizeof(slot_counts[0])); i++) {
+        for (int l = 0; l < (int)(sizeof(s_latencies) / sizeof(s_latencies[0])); l++) {
+            failures += _model_run(slot_counts[i], s_latencies[l], false);
+            failures += _model_run(slot_counts[i], s_latencies[l], true);
+        }
+    }
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,235 @@
+/*****************************************************************************
+* | File      	:   fft_db_bench.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host check and benchmark of the power-to-dB stage (fft_db.c)
+* | Info        :
+*   - Check: sweeps -200..+20 dBm in DB_BENCH_STEP_DB steps through
+*     fft_db_convert_spectrum with the main analyzer's offset (1024-point
+*     Hann) and compares each bin with 10*log10(|X|^2) + offset in double.
+*     Bins of the fixed-point builds are rounded to integers first and
+*     compared with the exact power of the rounded bin; targets outside
+*     the scalar range are skipped and the covered range is reported
+*   - Fails if any error exceeds DB_BENCH_MAX_ERROR_DB: the documented
+*     bound in fft_db.h (5.3e-4 dB float, 6.7e-4 dB on the Q16 path), or
+*     if a bin below the floor does not read FFT_DB_FLOOR
+*   - Times the stage against the conversion it replaced
+*     (20*log10f(sqrtf(|X|^2) * scale)) and 10*log10f(|X|^2) + offset, in
+*     ns per bin (host numbers; log10f costs more on the Cortex-M33)
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. -Ilib/kiss_fft tools/fft_db_bench.c fft_db.c fft_window.c \
+*         -lm -o fft_db_bench
+*     (add -DFIXED_POINT=16 or -DFIXED_POINT=32 for the Q16 integer path)
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "fft_db.h"
+#include "fft_window.h"
+#include "adc_convert.h"
+
+#define DB_BENCH_SIZE 1024                  // Analyzer configuration whose offset is used
+#define DB_BENCH_MIN_DBM -200.0
+#define DB_BENCH_MAX_DBM 20.0
+#define DB_BENCH_STEP_DB 0.0001             // 2.2M sweep points
+#define DB_BENCH_BINS 2048                  // Bins per timed conversion
+#define DB_BENCH_MIN_BINS 20000000          // Bins converted per timing trial
+#define DB_BENCH_TRIALS 5                   // Best of N (filters host scheduling noise)
+
+#ifdef FIXED_POINT
+#define DB_BENCH_MAX_ERROR_DB 6.7e-4        // Table bound plus Q16 rounding
+#define DB_BENCH_SCALAR_MAX (FIXED_POINT == 32 ? 2147483647.0 : 32767.0)
+#else
+#define DB_BENCH_MAX_ERROR_DB 5.3e-4        // Table bound (1.8e-4 log2 units)
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static kiss_fft_cpx s_bins[DB_BENCH_BINS];
+static float s_db[DB_BENCH_BINS];
+static double s_expected[DB_BENCH_BINS];
+static volatile float s_sink;
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Monotonic time in nanoseconds
+ */
+static double _bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * dBm offset of the main analyzer (same terms as _adc_update_db_offset)
+ */
+static float _bench_db_offset(void) {
+#ifdef FIXED_POINT
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT * fft_window_get_q15_scale() /
+                            ((float)(1 << ADC_FIXED_INPUT_SHIFT) * DB_REFERENCE_VOLTAGE_0DBM);
+#else
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT / ((float)DB_BENCH_SIZE * DB_REFERENCE_VOLTAGE_0DBM);
+#endif
+    amplitude_scale *= fft_window_get_amplitude_correction();
+    return 20.0f * log10f(amplitude_scale);
+}
+
+/**
+ * Bin of the requested level at a sweep-dependent phase
+ * @param exact_power Output: |X|^2 of the bin actually produced (double)
+ * @return false if the bin is outside the scalar range or rounds to zero
+ */
+static bool _bench_make_bin(double dbm, double offset_db, double phase, kiss_fft_cpx* bin,
+                            double* exact_power) {
+    double magnitude = sqrt(pow(10.0, (dbm - offset_db) / 10.0));
+    double re = magnitude * cos(phase);
+    double im = magnitude * sin(phase);
+#ifdef FIXED_POINT
+    re = nearbyint(re);
+    im = nearbyint(im);
+    if (fabs(re) > DB_BENCH_SCALAR_MAX || fabs(im) > DB_BENCH_SCALAR_MAX) return false;
+    if (re == 0.0 && im == 0.0) return false;
+#endif
+    bin->r = (kiss_fft_scalar)re;
+    bin->i = (kiss_fft_scalar)im;
+    *exact_power = (double)bin->r * bin->r + (double)bin->i * bin->i;
+    return true;
+}
+
+/**
+ * Conversion before the dB stage: magnitude, scale, then 20*log10f
+ */
+static void _bench_reference_magnitude(const kiss_fft_cpx* bins, float* out, int count, float scale) {
+    for (int i = 0; i < count; i++) {
+        float re = (float)bins[i].r;
+        float im = (float)bins[i].i;
+        out[i] = 20.0f * log10f(sqrtf(re * re + im * im) * scale + 1e-20f);
+    }
+}
+
+/**
+ * Direct conversion: 10*log10f of the power plus the folded offset
+ */
+static void _bench_reference_power(const kiss_fft_cpx* bins, float* out, int count, float offset_db) {
+    for (int i = 0; i < count; i++) {
+        float re = (float)bins[i].r;
+        float im = (float)bins[i].i;
+        out[i] = 10.0f * log10f(re * re + im * im + 1e-30f) + offset_db;
+    }
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Sweep the error over the level range, then time the conversions
+ */
+int main(void) {
+    const int sizes[] = {DB_BENCH_SIZE};
+    int failures = 0;
+    
+    if (!fft_window_init(sizes, 1, FFT_WINDOW_HANN)) {
+        return 1;
+    }
+    const float offset_db = _bench_db_offset();
+    fft_db_configure(offset_db);
+    
+#ifdef FIXED_POINT
+    printf("dB stage check (Q%d bins, Q16 log2), offset %.3f dB\n", FIXED_POINT == 32 ? 31 : 15, offset_db);
+#else
+    printf("dB stage check (float bins), offset %.3f dB\n", offset_db);
+#endif
+    
+    // Sweep in chunks of DB_BENCH_BINS so the stage sees whole arrays
+    const long steps = lrint((DB_BENCH_MAX_DBM - DB_BENCH_MIN_DBM) / DB_BENCH_STEP_DB);
+    double max_error = 0.0;
+    double worst_dbm = 0.0;
+    double covered_min = 1e9;
+    double covered_max = -1e9;
+    long checked = 0;
+    long step = 0;
+    while (step <= steps) {
+        int count = 0;
+        for (; count < DB_BENCH_BINS && step <= steps; step++) {
+            double dbm = DB_BENCH_MIN_DBM + step * DB_BENCH_STEP_DB;
+            double power;
+            if (!_bench_make_bin(dbm, offset_db, 0.7 * step, &s_bins[count], &power)) continue;
+            s_expected[count] = 10.0 * log10(power) + offset_db;
+            count++;
+        }
+        fft_db_convert_spectrum(s_bins, s_db, count);
+        for (int i = 0; i < count; i++) {
+            if (s_expected[i] <= FFT_DB_FLOOR) continue;   // Floor bins checked below
+            double error = fabs(s_db[i] - s_expected[i]);
+            if (error > max_error) {
+                max_error = error;
+                worst_dbm = s_expected[i];
+            }
+            if (s_expected[i] < covered_min) covered_min = s_expected[i];
+            if (s_expected[i] > covered_max) covered_max = s_expected[i];
+            checked++;
+        }
+    }
+    printf("  %ld levels over %.2f..%.2f dBm: max error %.2e dB at %.3f dBm (bound %.1e)\n",
+           checked, covered_min, covered_max, max_error, worst_dbm, DB_BENCH_MAX_ERROR_DB);
+    if (max_error > DB_BENCH_MAX_ERROR_DB) {
+        printf("  ERROR: error above the bound\n");
+        failures++;
+    }
+    
+    // Below the floor and zero bins must read FFT_DB_FLOOR
+    s_bins[0].r = 0;
+    s_bins[0].i = 0;
+    double power;
+    int floor_bins = 1;
+    if (_bench_make_bin(FFT_DB_FLOOR - 10.0, offset_db, 0.0, &s_bins[1], &power)) floor_bins++;
+    fft_db_convert_spectrum(s_bins, s_db, floor_bins);
+    for (int i = 0; i < floor_bins; i++) {
+        if (s_db[i] != FFT_DB_FLOOR) {
+            printf("  ERROR: bin below the floor reads %.3f dBm\n", s_db[i]);
+            failures++;
+        }
+    }
+    
+    // Timing (ns per bin): spread levels over the analyzer's range
+    for (int i = 0; i < DB_BENCH_BINS; i++) {
+        double dbm = -120.0 + 130.0 * i / DB_BENCH_BINS;
+        if (!_bench_make_bin(dbm, offset_db, 0.37 * i, &s_bins[i], &power)) {
+            s_bins[i].r = 1;
+            s_bins[i].i = 0;
+        }
+    }
+    const float scale = powf(10.0f, offset_db / 20.0f);
+    const int rounds = DB_BENCH_MIN_BINS / DB_BENCH_BINS;
+    double best[3] = {1e30, 1e30, 1e30};
+    for (int trial = 0; trial < DB_BENCH_TRIALS; trial++) {
+        for (int kernel = 0; kernel < 3; kernel++) {
+            double start = _bench_now_ns();
+            for (int r = 0; r < rounds; r++) {
+                if (kernel == 0) {
+                    fft_db_convert_spectrum(s_bins, s_db, DB_BENCH_BINS);
+                } else if (kernel == 1) {
+                    _bench_reference_magnitude(s_bins, s_db, DB_BENCH_BINS, scale);
+                } else {
+                    _bench_reference_power(s_bins, s_db, DB_BENCH_BINS, offset_db);
+                }
+                __asm__ volatile("" : : "r"(s_db) : "memory");  // Keep every round
+            }
+            double elapsed = (_bench_now_ns() - start) / ((double)rounds * DB_BENCH_BINS);
+            if (elapsed < best[kernel]) best[kernel] = elapsed;
+        }
+    }
+    s_sink = s_db[0];
+    printf("\n  dB stage   20*log10f(sqrtf)   10*log10f   (ns/bin)\n");
+    printf("  %8.2f   %16.2f   %9.2f\n", best[0], best[1], best[2]);
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
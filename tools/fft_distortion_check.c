@@ -0,0 +1,247 @@
+/*****************************************************************************
+* | File      	:   fft_distortion_check.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host check of the distortion engine (fft_distortion.c) on synthetic sines
+* | Info        :
+*   - Builds 12-bit frames of a sine with 2nd/3rd harmonics at known dBc
+*     plus Gaussian noise, runs them through the firmware chain
+*     (adc_convert_window_u16 -> kiss_fftr -> fft_db, 1024 points) and
+*     averages fft_distortion_analyze over DIST_CHECK_FRAMES frames
+*   - Cases: off-bin fundamental, fundamental whose harmonics alias above
+*     fs/2, and a quantization-only near full-scale sine (ENOB)
+*   - Compares THD and SNR with the analytic values of the synthetic
+*     signal (SNR includes the 1/12 LSB^2 quantization noise) and ENOB
+*     with the quantization-only theory, (SNR - 1.76) / 6.02
+*   - Fails beyond DIST_CHECK_MAX_THD_ERROR_DB (flat-top:
+*     DIST_CHECK_MAX_FLATTOP_THD_ERROR_DB), DIST_CHECK_MAX_SNR_ERROR_DB or
+*     DIST_CHECK_MAX_ENOB_ERROR, for every window but the rectangle (its
+*     leakage hides off-bin harmonics). The quantization-only case (74 dB
+*     SNR) checks SNR/ENOB with Blackman-Harris only, the one window whose
+*     sidelobes stay below that floor. Hamming SNR/ENOB are
+*     reported only: its far sidelobes (-43 dB, 6 dB/octave) put leakage
+*     of an off-bin fundamental above a 54 dB noise floor. The Q15 build
+*     checks THD against DIST_CHECK_MAX_Q15_THD_ERROR_DB only, its own
+*     noise floor sits near 60 dB SNR
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. -Ilib/kiss_fft tools/fft_distortion_check.c fft_distortion.c \
+*         adc_convert.c fft_window.c fft_db.c lib/kiss_fft/kiss_fft.c \
+*         lib/kiss_fft/kiss_fftr.c -lm -o fft_distortion_check
+*     (add -DFIXED_POINT=16 or -DFIXED_POINT=32 for the fixed-point builds)
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "fft_distortion.h"
+#include "fft_db.h"
+#include "adc_convert.h"
+#include "kiss_fftr.h"
+
+#define DIST_CHECK_SIZE 1024
+#define DIST_CHECK_FRAMES 20                // Frames averaged per case
+#define DIST_CHECK_MAX_THD_ERROR_DB 0.1
+#define DIST_CHECK_MAX_FLATTOP_THD_ERROR_DB 0.5
+#define DIST_CHECK_MAX_SNR_ERROR_DB 1.0
+#define DIST_CHECK_MAX_ENOB_ERROR 0.2         // Quantization harmonics (~-81 dBc) count as THD: ~0.14 bit
+
+#define DIST_CHECK_MAX_Q15_THD_ERROR_DB 1.0
+
+#if defined(FIXED_POINT) && FIXED_POINT == 16
+#define DIST_CHECK_NOISE_METRICS 0          // Q15 floor limits SNR near 60 dB
+#else
+#define DIST_CHECK_NOISE_METRICS 1
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// One synthetic signal
+typedef struct {
+    const char* name;
+    double amplitude_lsb;                   // Fundamental, peak
+    double cycles;                          // Fundamental in cycles per sample
+    double h2_dbc;                          // 2nd harmonic, -999 for none
+    double h3_dbc;                          // 3rd harmonic
+    double noise_lsb;                       // Gaussian RMS before quantization
+    bool enob_case;                         // Check ENOB against quantization-only theory
+} dist_check_case_t;
+
+static const dist_check_case_t s_cases[] = {
+    {"off-bin",          1500.0, 0.07313, -40.0, -50.0, 2.0, false},
+    {"aliased harmonics", 1500.0, 0.37107, -40.0, -50.0, 2.0, false},
+    {"quantization only", 2040.0, 0.08617, -999.0, -999.0, 0.0, true},
+};
+
+static uint16_t s_samples[DIST_CHECK_SIZE];
+static kiss_fft_scalar s_fft[DIST_CHECK_SIZE + 2];    // In place: N scalars in, N/2+1 bins out
+static float s_db[DIST_CHECK_SIZE / 2];
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Active window table of the build
+ */
+static const adc_window_coef_t* _dist_check_window(void) {
+#ifdef FIXED_POINT
+    return fft_window_get_coefficients_q15();
+#else
+    return fft_window_get_coefficients();
+#endif
+}
+
+/**
+ * dBm offset of the main analyzer (same terms as _adc_update_db_offset)
+ */
+static float _dist_check_db_offset(void) {
+#ifdef FIXED_POINT
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT * fft_window_get_q15_scale() /
+                            ((float)(1 << ADC_FIXED_INPUT_SHIFT) * DB_REFERENCE_VOLTAGE_0DBM);
+#else
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT / ((float)DIST_CHECK_SIZE * DB_REFERENCE_VOLTAGE_0DBM);
+#endif
+    amplitude_scale *= fft_window_get_amplitude_correction();
+    return 20.0f * log10f(amplitude_scale);
+}
+
+/**
+ * Standard normal sample (Box-Muller on an LCG)
+ */
+static double _dist_check_gaussian(uint32_t* lcg) {
+    *lcg = *lcg * 1664525u + 1013904223u;
+    double u1 = ((*lcg >> 8) + 1.0) / 16777217.0;
+    *lcg = *lcg * 1664525u + 1013904223u;
+    double u2 = (*lcg >> 8) / 16777216.0;
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/**
+ * Harmonic amplitude from its level in dBc (0 for none)
+ */
+static double _dist_check_harmonic(const dist_check_case_t* c, double dbc) {
+    return dbc < -900.0 ? 0.0 : c->amplitude_lsb * pow(10.0, dbc / 20.0);
+}
+
+/**
+ * One dBm spectrum of the case, frame `frame` (new phase and noise)
+ */
+static void _dist_check_spectrum(kiss_fftr_cfg cfg, const dist_check_case_t* c, int frame, uint32_t* lcg) {
+    double phase = 0.9 * frame;
+    double h2 = _dist_check_harmonic(c, c->h2_dbc);
+    double h3 = _dist_check_harmonic(c, c->h3_dbc);
+    for (int i = 0; i < DIST_CHECK_SIZE; i++) {
+        double t = 2.0 * M_PI * c->cycles * i + phase;
+        double value = 2048.0 + c->amplitude_lsb * sin(t) + h2 * sin(2.0 * t + 0.3) + h3 * sin(3.0 * t + 1.1) +
+                       c->noise_lsb * _dist_check_gaussian(lcg);
+        s_samples[i] = (uint16_t)lrint(value);
+    }
+    adc_convert_window_u16(s_samples, DIST_CHECK_SIZE, _dist_check_window(), s_fft, 1);
+    kiss_fftr(cfg, s_fft, (kiss_fft_cpx*)s_fft);
+    fft_db_convert_spectrum((const kiss_fft_cpx*)s_fft, s_db, DIST_CHECK_SIZE / 2);
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Run every case with every window and compare with the analytic values
+ */
+int main(void) {
+    const int sizes[] = {DIST_CHECK_SIZE};
+    const int case_count = (int)(sizeof(s_cases) / sizeof(s_cases[0]));
+    const float bin_width = (float)SAMPLING_RATE_HZ / DIST_CHECK_SIZE;
+    int failures = 0;
+    
+    kiss_fftr_cfg cfg = kiss_fftr_alloc(DIST_CHECK_SIZE, 0, NULL, NULL);
+    if (cfg == NULL || !fft_window_init(sizes, 1, FFT_WINDOW_HANN) ||
+        !fft_distortion_init(DISTORTION_MAX_HARMONIC, 0.0f)) {
+        return 1;
+    }
+    
+#ifdef FIXED_POINT
+    printf("Distortion engine on synthetic sines (Q%d, N=%d, %d frames)\n",
+           FIXED_POINT == 32 ? 31 : 15, DIST_CHECK_SIZE, DIST_CHECK_FRAMES);
+#else
+    printf("Distortion engine on synthetic sines (float, N=%d, %d frames)\n", DIST_CHECK_SIZE, DIST_CHECK_FRAMES);
+#endif
+    
+    for (int ci = 0; ci < case_count; ci++) {
+        const dist_check_case_t* c = &s_cases[ci];
+        double h2 = _dist_check_harmonic(c, c->h2_dbc);
+        double h3 = _dist_check_harmonic(c, c->h3_dbc);
+        double signal_power = c->amplitude_lsb * c->amplitude_lsb / 2.0;
+        double noise_power = c->noise_lsb * c->noise_lsb + 1.0 / 12.0;
+        double thd_expected = 10.0 * log10((h2 * h2 + h3 * h3) / 2.0 / signal_power);
+        double snr_expected = 10.0 * log10(signal_power / noise_power);
+        double enob_expected = (snr_expected - 1.76) / 6.02;
+    
+        printf("\n  %s: %.0f LSB at %.5f fs", c->name, c->amplitude_lsb, c->cycles);
+        if (h2 > 0.0) {
+            printf(", THD %.2f dB", thd_expected);
+        }
+        printf(", SNR %.2f dB", snr_expected);
+        if (c->enob_case) {
+            printf(", ENOB %.2f", enob_expected);
+        }
+        printf("\n");
+        printf("    window            THD dB     SNR dB    ENOB\n");
+    
+        for (int w = 0; w < FFT_WINDOW_TYPE_COUNT; w++) {
+            fft_window_type_t type = (fft_window_type_t)w;
+            if (type == FFT_WINDOW_RECTANGLE) continue;
+            fft_window_select(type);
+            fft_db_configure(_dist_check_db_offset());
+    
+            uint32_t lcg = 0x1234u + (uint32_t)ci;
+            double thd = 0.0;
+            double snr = 0.0;
+            double enob = 0.0;
+            int measured = 0;
+            for (int frame = 0; frame < DIST_CHECK_FRAMES; frame++) {
+                _dist_check_spectrum(cfg, c, frame, &lcg);
+                if (!fft_distortion_analyze(s_db, DIST_CHECK_SIZE / 2, bin_width)) continue;
+                const fft_distortion_result_t* result = fft_distortion_get_result();
+                thd += result->thd_db;
+                snr += result->snr_db;
+                enob += result->enob_bits;
+                measured++;
+            }
+            if (measured != DIST_CHECK_FRAMES) {
+                printf("    ERROR: %s: fundamental found in %d of %d frames\n",
+                       fft_window_get_name(type), measured, DIST_CHECK_FRAMES);
+                failures++;
+                continue;
+            }
+            thd /= measured;
+            snr /= measured;
+            enob /= measured;
+            printf("    %-16s  %8.2f  %9.2f  %6.2f\n", fft_window_get_name(type), thd, snr, enob);
+    
+            double thd_limit = type == FFT_WINDOW_FLATTOP ? DIST_CHECK_MAX_FLATTOP_THD_ERROR_DB
+                                                          : DIST_CHECK_MAX_THD_ERROR_DB;
+            if (!DIST_CHECK_NOISE_METRICS) thd_limit = DIST_CHECK_MAX_Q15_THD_ERROR_DB;
+            bool noise_checked = DIST_CHECK_NOISE_METRICS && type != FFT_WINDOW_HAMMING &&
+                                 (!c->enob_case || type == FFT_WINDOW_BLACKMAN_HARRIS);
+            if (h2 > 0.0 && fabs(thd - thd_expected) > thd_limit) {
+                printf("    ERROR: THD off by %.2f dB (limit %.2f)\n", fabs(thd - thd_expected), thd_limit);
+                failures++;
+            }
+            if (noise_checked && fabs(snr - snr_expected) > DIST_CHECK_MAX_SNR_ERROR_DB) {
+                printf("    ERROR: SNR off by %.2f dB (limit %.2f)\n", fabs(snr - snr_expected),
+                       DIST_CHECK_MAX_SNR_ERROR_DB);
+                failures++;
+            }
+            if (noise_checked && c->enob_case && fabs(enob - enob_expected) > DIST_CHECK_MAX_ENOB_ERROR) {
+                printf("    ERROR: ENOB off by %.2f bits (limit %.2f)\n", fabs(enob - enob_expected),
+                       DIST_CHECK_MAX_ENOB_ERROR);
+                failures++;
+            }
+        }
+    }
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
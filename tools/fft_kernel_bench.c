@@ -0,0 +1,106 @@
+/*****************************************************************************
+* | File      	:   fft_kernel_bench.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host benchmark: generated FFT kernels vs kiss_fft
+* | Info        :
+*   - Times the forward transform of every generated size against the
+*     kiss_fftr (or kiss_fft) plan of the same size on the same input
+*   - Host numbers only: the Cortex-M33 also pays for flash (XIP) twiddle
+*     reads and has no double FPU, so repeat the comparison on target
+*   - Host only (not part of the firmware build):
+*     python3 tools/gen_fft_kernel.py --out-dir gen --sizes 256 512 1024 2048
+*     gcc -O2 -DFFT_BACKEND_GENERATED -I. -Igen -Ilib/kiss_fft \
+*         tools/fft_kernel_bench.c gen/fft_kernel_generated.c \
+*         lib/kiss_fft/kiss_fft.c lib/kiss_fft/kiss_fftr.c -lm -o fft_kernel_bench
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "fft_kernel.h"
+#include "kiss_fftr.h"
+
+#define BENCH_MAX_SIZE 8192
+#define BENCH_MIN_POINTS 2000000            // Points transformed per trial
+#define BENCH_TRIALS 7                      // Best of N (filters host scheduling noise)
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const int s_bench_sizes[] = {16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192};
+
+static fft_kernel_input_t s_input[BENCH_MAX_SIZE];
+static kiss_fft_cpx s_output[BENCH_MAX_SIZE + 1];
+
+/**
+ * Monotonic time in nanoseconds
+ */
+static double _bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void) {
+#ifdef FIXED_POINT
+    printf("Build without FIXED_POINT: generated kernels are float only\n");
+    return 1;
+#else
+    for (int n = 0; n < BENCH_MAX_SIZE; n++) {
+        float x = (float)(900.0 * sin(2.0 * M_PI * 0.0781 * n) + (n % 3));
+#if FFT_REAL_INPUT_ENABLED
+        s_input[n] = x;
+#else
+        s_input[n].r = x;
+        s_input[n].i = 0.0f;
+#endif
+    }
+    
+    printf("   N  kiss ns/frame  generated ns/frame  speedup  rodata bytes\n");
+    for (unsigned s = 0; s < sizeof(s_bench_sizes) / sizeof(s_bench_sizes[0]); s++) {
+        const int size = s_bench_sizes[s];
+        const fft_kernel_t* kernel = fft_kernel_find(size);
+        if (kernel == NULL) {
+            continue;
+        }
+#if FFT_REAL_INPUT_ENABLED
+        kiss_fftr_cfg cfg = kiss_fftr_alloc(size, 0, NULL, NULL);
+#else
+        kiss_fft_cfg cfg = kiss_fft_alloc(size, 0, NULL, NULL);
+#endif
+        if (cfg == NULL) {
+            return 1;
+        }
+        const int iterations = BENCH_MIN_POINTS / size;
+    
+        double kiss_ns = 1e30;
+        double kernel_ns = 1e30;
+        for (int trial = 0; trial < BENCH_TRIALS; trial++) {
+            double start = _bench_now_ns();
+            for (int it = 0; it < iterations; it++) {
+#if FFT_REAL_INPUT_ENABLED
+                kiss_fftr(cfg, s_input, s_output);
+#else
+                kiss_fft(cfg, s_input, s_output);
+#endif
+            }
+            double elapsed = (_bench_now_ns() - start) / iterations;
+            if (elapsed < kiss_ns) kiss_ns = elapsed;
+    
+            start = _bench_now_ns();
+            for (int it = 0; it < iterations; it++) {
+                kernel->forward(s_input, s_output);
+            }
+            elapsed = (_bench_now_ns() - start) / iterations;
+            if (elapsed < kernel_ns) kernel_ns = elapsed;
+        }
+        printf("%4d  %13.0f  %18.0f  %6.2fx  %12u\n", size, kiss_ns, kernel_ns,
+               kiss_ns / kernel_ns, (unsigned)kernel->rodata_bytes);
+        free(cfg);
+    }
+    return 0;
+#endif
+}
@@ -0,0 +1,160 @@
+/*****************************************************************************
+* | File      	:   fft_kernel_check.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host accuracy check: generated FFT kernels vs kiss_fft
+* | Info        :
+*   - Runs every generated size on deterministic inputs (tone + noise,
+*     impulse, full-scale square) and compares against kiss_fftr/kiss_fft
+*     and a double-precision DFT
+*   - Also runs each kernel in place and requires the same bits as the
+*     out-of-place call
+*   - Reports bit-identical bins, the largest bin difference in float ULPs
+*     of the spectrum peak and each backend's error against the double DFT
+*   - Fails if the generated kernel is less accurate than kiss_fft beyond
+*     FFT_CHECK_ERROR_RATIO, or differs from it by more than FFT_CHECK_MAX_ULPS
+*   - Host only (not part of the firmware build):
+*     python3 tools/gen_fft_kernel.py --out-dir gen --sizes 256 512 1024 2048
+*     gcc -O2 -DFFT_BACKEND_GENERATED -I. -Igen -Ilib/kiss_fft \
+*         tools/fft_kernel_check.c gen/fft_kernel_generated.c \
+*         lib/kiss_fft/kiss_fft.c lib/kiss_fft/kiss_fftr.c -lm -o fft_kernel_check
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <float.h>
+#include <string.h>
+#include <math.h>
+#include "fft_kernel.h"
+#include "kiss_fftr.h"
+
+#define CHECK_MAX_SIZE 8192
+#define FFT_CHECK_MAX_ULPS 64.0             // Largest allowed |generated - kiss| in peak ULPs
+#define FFT_CHECK_ERROR_RATIO 1.5           // Allowed RMS error vs kiss (both against double)
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const int s_check_sizes[] = {16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192};
+
+static fft_kernel_input_t s_input[CHECK_MAX_SIZE];
+static kiss_fft_cpx s_kernel_out[CHECK_MAX_SIZE + 1];
+static kiss_fft_cpx s_kiss_out[CHECK_MAX_SIZE + 1];
+static kiss_fft_cpx s_in_place[CHECK_MAX_SIZE + 1];
+static double s_ref_r[CHECK_MAX_SIZE];
+static double s_ref_i[CHECK_MAX_SIZE];
+static double s_signal[CHECK_MAX_SIZE];
+
+/**
+ * Deterministic test signals
+ */
+static void _check_make_signal(int kind, int size) {
+    uint32_t lcg = 12345u;
+    for (int n = 0; n < size; n++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        double noise = ((double)(lcg >> 8) / (1 << 24) - 0.5) * 4.0;
+        switch (kind) {
+            case 0: s_signal[n] = 900.0 * sin(2.0 * M_PI * 37.3 * n / size) + noise; break;
+            case 1: s_signal[n] = (n == 3) ? 2047.0 : 0.0; break;
+            default: s_signal[n] = ((n / 8) & 1) ? 2047.0 : -2048.0; break;
+        }
+#if FFT_REAL_INPUT_ENABLED
+        s_input[n] = (float)s_signal[n];
+#else
+        s_input[n].r = (float)s_signal[n];
+        s_input[n].i = 0.0f;
+#endif
+        s_signal[n] = (double)(float)s_signal[n];
+    }
+}
+
+/**
+ * Double-precision DFT of s_signal
+ */
+static void _check_reference(int size, int bins) {
+    for (int k = 0; k < bins; k++) {
+        double re = 0.0, im = 0.0;
+        for (int n = 0; n < size; n++) {
+            double angle = -2.0 * M_PI * (double)((long)k * n % size) / size;
+            re += s_signal[n] * cos(angle);
+            im += s_signal[n] * sin(angle);
+        }
+        s_ref_r[k] = re;
+        s_ref_i[k] = im;
+    }
+}
+
+int main(void) {
+#ifdef FIXED_POINT
+    printf("Build without FIXED_POINT: generated kernels are float only\n");
+    return 1;
+#else
+    static const char* signal_names[] = {"tone+noise", "impulse", "square"};
+    int checked = 0;
+    int failures = 0;
+    
+    printf("   N  signal       identical  max|gen-kiss| (ULPs)  RMS err gen  RMS err kiss\n");
+    for (unsigned s = 0; s < sizeof(s_check_sizes) / sizeof(s_check_sizes[0]); s++) {
+        const int size = s_check_sizes[s];
+        const fft_kernel_t* kernel = fft_kernel_find(size);
+        if (kernel == NULL) {
+            continue;
+        }
+#if FFT_REAL_INPUT_ENABLED
+        const int bins = size / 2 + 1;
+        kiss_fftr_cfg cfg = kiss_fftr_alloc(size, 0, NULL, NULL);
+#else
+        const int bins = size;
+        kiss_fft_cfg cfg = kiss_fft_alloc(size, 0, NULL, NULL);
+#endif
+        if (cfg == NULL) {
+            return 1;
+        }
+    
+        for (int kind = 0; kind < 3; kind++) {
+            _check_make_signal(kind, size);
+            _check_reference(size, bins);
+            kernel->forward(s_input, s_kernel_out);
+            memcpy(s_in_place, s_input, sizeof(fft_kernel_input_t) * size);
+            kernel->forward((const fft_kernel_input_t*)s_in_place, s_in_place);
+            bool in_place_match = (memcmp(s_in_place, s_kernel_out, sizeof(kiss_fft_cpx) * bins) == 0);
+#if FFT_REAL_INPUT_ENABLED
+            kiss_fftr(cfg, s_input, s_kiss_out);
+#else
+            kiss_fft(cfg, s_input, s_kiss_out);
+#endif
+    
+            double peak = 0.0, max_diff = 0.0, err_kernel = 0.0, err_kiss = 0.0;
+            int identical = 0;
+            for (int k = 0; k < bins; k++) {
+                peak = fmax(peak, hypot(s_ref_r[k], s_ref_i[k]));
+                identical += (s_kernel_out[k].r == s_kiss_out[k].r && s_kernel_out[k].i == s_kiss_out[k].i);
+                max_diff = fmax(max_diff, fabs((double)s_kernel_out[k].r - s_kiss_out[k].r));
+                max_diff = fmax(max_diff, fabs((double)s_kernel_out[k].i - s_kiss_out[k].i));
+                err_kernel += pow(s_kernel_out[k].r - s_ref_r[k], 2) + pow(s_kernel_out[k].i - s_ref_i[k], 2);
+                err_kiss += pow(s_kiss_out[k].r - s_ref_r[k], 2) + pow(s_kiss_out[k].i - s_ref_i[k], 2);
+            }
+            double ulp = peak * FLT_EPSILON;        // One float ULP at the spectrum peak
+            double ulps = max_diff / ulp;
+            err_kernel = sqrt(err_kernel / bins);
+            err_kiss = sqrt(err_kiss / bins);
+            bool pass = in_place_match && (ulps <= FFT_CHECK_MAX_ULPS) &&
+                        (err_kernel <= err_kiss * FFT_CHECK_ERROR_RATIO + ulp);
+            printf("%4d  %-11s  %8.1f%%  %20.1f  %11.3g  %12.3g  %s\n", size, signal_names[kind],
+                   100.0 * identical / bins, ulps, err_kernel, err_kiss, pass ? "ok" : "FAIL");
+            checked++;
+            failures += pass ? 0 : 1;
+        }
+        free(cfg);
+    }
+    
+    if (checked == 0) {
+        printf("No generated kernels to check\n");
+        return 1;
+    }
+    printf("%d checks, %d failures\n", checked, failures);
+    return failures == 0 ? 0 : 1;
+#endif
+}
@@ -0,0 +1,159 @@
+/*****************************************************************************
+* | File      	:   fft_peaks_check.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host check of the sub-bin peak search (fft_peaks.c) on off-bin tones
+* | Info        :
+*   - Sweeps a 12-bit tone from half a bin below to half a bin above
+*     PEAKS_CHECK_BASE_BIN in 2 * PEAKS_CHECK_STEPS steps through the firmware chain
+*     (adc_convert_window_u16 -> kiss_fftr -> fft_db, 1024 points) and
+*     runs fft_peaks_find on every spectrum, for each window and
+*     interpolation method
+*   - Reports the largest frequency error (bins) and level error (dB) of
+*     the strongest peak against the true tone
+*   - Fails if Gaussian interpolation exceeds PEAKS_CHECK_MAX_BIN_ERROR /
+*     PEAKS_CHECK_MAX_LEVEL_ERROR_DB on a window with a smooth main lobe
+*     (Hamming, Hann, Blackman, Blackman-Harris, Kaiser), or the flat-top
+*     level error PEAKS_CHECK_MAX_LEVEL_ERROR_DB / frequency error
+*     PEAKS_CHECK_MAX_FLATTOP_BIN_ERROR (its flat main lobe defeats the
+*     interpolation); rectangle and the parabolic method are reported only
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. -Ilib/kiss_fft tools/fft_peaks_check.c fft_peaks.c \
+*         adc_convert.c fft_window.c fft_db.c lib/kiss_fft/kiss_fft.c \
+*         lib/kiss_fft/kiss_fftr.c -lm -o fft_peaks_check
+*     (add -DFIXED_POINT=16 or -DFIXED_POINT=32 for the fixed-point builds)
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "fft_peaks.h"
+#include "fft_db.h"
+#include "adc_convert.h"
+#include "kiss_fftr.h"
+
+#define PEAKS_CHECK_SIZE 1024
+#define PEAKS_CHECK_TONE_LSB 800.0          // Tone amplitude (12-bit LSBs, peak)
+#define PEAKS_CHECK_BASE_BIN 180            // 22.5 kHz at 128 kHz / 1024
+#define PEAKS_CHECK_STEPS 20                // Steps per half bin
+#define PEAKS_CHECK_MAX_BIN_ERROR 0.02
+#define PEAKS_CHECK_MAX_FLATTOP_BIN_ERROR 0.2
+#define PEAKS_CHECK_MAX_LEVEL_ERROR_DB 0.1
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static uint16_t s_samples[PEAKS_CHECK_SIZE];
+static kiss_fft_scalar s_fft[PEAKS_CHECK_SIZE + 2];   // In place: N scalars in, N/2+1 bins out
+static float s_db[PEAKS_CHECK_SIZE / 2];
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Active window table of the build
+ */
+static const adc_window_coef_t* _peaks_check_window(void) {
+#ifdef FIXED_POINT
+    return fft_window_get_coefficients_q15();
+#else
+    return fft_window_get_coefficients();
+#endif
+}
+
+/**
+ * dBm offset of the main analyzer (same terms as _adc_update_db_offset)
+ */
+static float _peaks_check_db_offset(void) {
+#ifdef FIXED_POINT
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT * fft_window_get_q15_scale() /
+                            ((float)(1 << ADC_FIXED_INPUT_SHIFT) * DB_REFERENCE_VOLTAGE_0DBM);
+#else
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT / ((float)PEAKS_CHECK_SIZE * DB_REFERENCE_VOLTAGE_0DBM);
+#endif
+    amplitude_scale *= fft_window_get_amplitude_correction();
+    return 20.0f * log10f(amplitude_scale);
+}
+
+/**
+ * One dBm spectrum of a tone at fractional bin `bin`
+ */
+static void _peaks_check_spectrum(kiss_fftr_cfg cfg, double bin) {
+    for (int i = 0; i < PEAKS_CHECK_SIZE; i++) {
+        double value = 2048.0 + PEAKS_CHECK_TONE_LSB * sin(2.0 * M_PI * bin * i / PEAKS_CHECK_SIZE + 0.4);
+        s_samples[i] = (uint16_t)lrint(value);
+    }
+    adc_convert_window_u16(s_samples, PEAKS_CHECK_SIZE, _peaks_check_window(), s_fft, 1);
+    kiss_fftr(cfg, s_fft, (kiss_fft_cpx*)s_fft);
+    fft_db_convert_spectrum((const kiss_fft_cpx*)s_fft, s_db, PEAKS_CHECK_SIZE / 2);
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Sweep the tone offset for every window and method
+ */
+int main(void) {
+    const int sizes[] = {PEAKS_CHECK_SIZE};
+    const float bin_width = (float)SAMPLING_RATE_HZ / PEAKS_CHECK_SIZE;
+    const double expected_dbm = 20.0 * log10(PEAKS_CHECK_TONE_LSB / 2.0 * ADC_VOLTAGE_PER_BIT /
+                                             DB_REFERENCE_VOLTAGE_0DBM);
+    int failures = 0;
+    
+    kiss_fftr_cfg cfg = kiss_fftr_alloc(PEAKS_CHECK_SIZE, 0, NULL, NULL);
+    if (cfg == NULL || !fft_window_init(sizes, 1, FFT_WINDOW_HANN)) {
+        return 1;
+    }
+    
+#ifdef FIXED_POINT
+    printf("Peak search on off-bin tones (Q%d, N=%d)\n", FIXED_POINT == 32 ? 31 : 15, PEAKS_CHECK_SIZE);
+#else
+    printf("Peak search on off-bin tones (float, N=%d)\n", PEAKS_CHECK_SIZE);
+#endif
+    printf("\n  window            method      max bin err  max dB err\n");
+    
+    for (int w = 0; w < FFT_WINDOW_TYPE_COUNT; w++) {
+        fft_window_type_t type = (fft_window_type_t)w;
+        fft_window_select(type);
+        fft_db_configure(_peaks_check_db_offset());
+        for (int m = FFT_PEAKS_INTERP_PARABOLIC; m < FFT_PEAKS_INTERP_COUNT; m++) {
+            fft_peaks_interp_t method = (fft_peaks_interp_t)m;
+            if (!fft_peaks_init(1, -60.0f, method)) {
+                return 1;
+            }
+            double max_bin_error = 0.0;
+            double max_level_error = 0.0;
+            for (int step = -PEAKS_CHECK_STEPS; step <= PEAKS_CHECK_STEPS; step++) {
+                double bin = PEAKS_CHECK_BASE_BIN + 0.5 * step / PEAKS_CHECK_STEPS;
+                _peaks_check_spectrum(cfg, bin);
+                if (fft_peaks_find(s_db, PEAKS_CHECK_SIZE / 2, bin_width) < 1) {
+                    max_bin_error = INFINITY;
+                    continue;
+                }
+                const fft_peak_t* peak = &fft_peaks_get()[0];
+                double bin_error = fabs(peak->bin - bin);
+                double level_error = fabs(peak->dbm - expected_dbm);
+                if (bin_error > max_bin_error) max_bin_error = bin_error;
+                if (level_error > max_level_error) max_level_error = level_error;
+            }
+            printf("  %-16s  %-10s  %11.4f  %10.3f\n", fft_window_get_name(type),
+                   fft_peaks_get_method_name(method), max_bin_error, max_level_error);
+    
+            // Gaussian: every window but the rectangle must meet its limits
+            if (method != FFT_PEAKS_INTERP_GAUSSIAN || type == FFT_WINDOW_RECTANGLE) continue;
+            double bin_limit = type == FFT_WINDOW_FLATTOP ? PEAKS_CHECK_MAX_FLATTOP_BIN_ERROR
+                                                          : PEAKS_CHECK_MAX_BIN_ERROR;
+            if (max_bin_error > bin_limit || max_level_error > PEAKS_CHECK_MAX_LEVEL_ERROR_DB) {
+                printf("  ERROR: %s: above %.2f bin / %.2f dB\n", fft_window_get_name(type),
+                       bin_limit, PEAKS_CHECK_MAX_LEVEL_ERROR_DB);
+                failures++;
+            }
+        }
+    }
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,320 @@
+/*****************************************************************************
+* | File      	:   fft_pipeline_stress.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host stress test of the two-core spectrum pipeline (fft_pipeline.c)
+* | Info        :
+*   - Core 1 (thread) plays the analysis stage: it merges numbered frames
+*     into its slot and publishes whenever another slot is free, with
+*     random frame times; core 0 (main thread) renders with random times
+*   - Every rendered slot must hold exactly the frames its header names
+*     (recomputed from the frame numbers), frames must arrive in order, and
+*     with two slots no frame may be lost (merging absorbs every stall)
+*   - The FIFOs must never block (at most slot_count words in flight)
+*   - Core 0 changes a setting through the command mailbox now and then:
+*     the command must return its result, and every slot rendered after the
+*     acknowledge must be analyzed under the new setting (older slots are
+*     recognized by their generation and dropped, like the firmware does)
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -pthread -DFFT_PIPELINE_HOST_PORT -I. -Itools \
+*         tools/fft_pipeline_stress.c tools/multicore_fifo_host.c \
+*         fft_pipeline.c -o fft_pipeline_stress
+*     (add -fsanitize=thread to check that no slot is touched by both cores)
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include "fft_pipeline.h"
+#include "multicore_fifo_host.h"
+
+#define STRESS_FRAMES 100000u               // Frames analyzed per slot count
+#define STRESS_BINS 64                      // Payload words per slot
+#define STRESS_MAX_FRAME_YIELDS 3           // Analysis time per frame (random)
+#define STRESS_MAX_RENDER_YIELDS 12         // Render time per slot (random)
+#define STRESS_COMMAND_MASK 63u             // A setting change every ~64 render loops
+
+// Spectrum slot stand-in
+typedef struct {
+    uint32_t first_frame;
+    uint32_t last_frame;
+    uint32_t frames;
+    uint32_t setting;                       // Setting the frames were analyzed under
+    uint32_t generation;                    // Commands completed when the slot was started
+    uint32_t payload[STRESS_BINS];          // Running hash of every merged frame
+} stress_slot_t;
+
+static stress_slot_t s_slots[FFT_PIPELINE_MAX_SLOTS];
+static fft_pipeline_producer_t s_producer;
+static fft_pipeline_consumer_t s_consumer;
+static fft_pipeline_mailbox_t s_mailbox;
+static atomic_bool s_producer_done;
+static atomic_bool s_consumer_done;
+static atomic_uint s_publish_errors;
+static atomic_uint s_dropped_frames;         // Merged frames dropped by a setting change
+static uint32_t s_setting;                  // Analysis setting (core 1 only, changed by command)
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Small per-thread pseudo random generator (xorshift32)
+ */
+static uint32_t _stress_random(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * Give the other thread the CPU a number of times
+ */
+static void _stress_yield(uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        sched_yield();
+    }
+}
+
+/**
+ * Merge one frame into a payload word
+ */
+static uint32_t _stress_merge(uint32_t word, uint32_t frame, uint32_t setting, int bin) {
+    return word * 31u + (frame ^ setting) * 2654435761u + (uint32_t)bin;
+}
+
+/**
+ * Setting change command (runs on core 1 between frames)
+ * @return true for an odd setting, so core 0 can check the result travels back
+ */
+static bool _stress_set_setting(const void* argument) {
+    s_setting = *(const uint32_t*)argument;
+    return (s_setting & 1u) != 0;
+}
+
+/**
+ * Core 1: run a pending command; the slot restarts under the new setting
+ */
+static void _stress_poll_commands(void) {
+    if (fft_pipeline_mailbox_poll(&s_mailbox)) {
+        stress_slot_t* slot = &s_slots[fft_pipeline_producer_slot(&s_producer)];
+        atomic_fetch_add(&s_dropped_frames, slot->frames);
+        slot->frames = 0;
+    }
+}
+
+// ========================================
+// 🔧 Analysis Core and Render Core
+// ========================================
+
+/**
+ * Core 1: analyze frames into the producer slot, publish when possible
+ */
+static void _stress_analysis_core(void) {
+    uint32_t random_state = 0x9E3779B9u;
+    
+    for (uint32_t frame = 1; frame <= STRESS_FRAMES; frame++) {
+        _stress_poll_commands();
+    
+        stress_slot_t* slot = &s_slots[fft_pipeline_producer_slot(&s_producer)];
+        if (slot->frames == 0) {
+            slot->first_frame = frame;
+            slot->setting = s_setting;
+            slot->generation = fft_pipeline_mailbox_generation(&s_mailbox);
+            for (int bin = 0; bin < STRESS_BINS; bin++) {
+                slot->payload[bin] = 0;
+            }
+        }
+        for (int bin = 0; bin < STRESS_BINS; bin++) {
+            slot->payload[bin] = _stress_merge(slot->payload[bin], frame, slot->setting, bin);
+        }
+        slot->last_frame = frame;
+        slot->frames++;
+    
+        _stress_yield(_stress_random(&random_state) % (STRESS_MAX_FRAME_YIELDS + 1));
+    
+        // Once per display update worth of frames (sometimes every frame);
+        // a ready slot must publish (the application finishes it in between)
+        if ((_stress_random(&random_state) & 3u) == 0 && fft_pipeline_producer_ready(&s_producer)) {
+            if (!fft_pipeline_producer_publish(&s_producer)) {
+                atomic_fetch_add(&s_publish_errors, 1);
+            }
+            s_slots[fft_pipeline_producer_slot(&s_producer)].frames = 0;
+        }
+    }
+    
+    // Hand over the last partial slot (core 0 may wait on a command meanwhile)
+    while (s_slots[fft_pipeline_producer_slot(&s_producer)].frames > 0) {
+        _stress_poll_commands();
+        if (fft_pipeline_producer_publish(&s_producer)) {
+            s_slots[fft_pipeline_producer_slot(&s_producer)].frames = 0;
+        } else {
+            _stress_yield(1);
+        }
+    }
+    atomic_store(&s_producer_done, true);
+    
+    // Like the firmware loop, keep serving commands until core 0 stops
+    while (!atomic_load(&s_consumer_done)) {
+        _stress_poll_commands();
+        _stress_yield(1);
+    }
+}
+
+/**
+ * Core 0: render slots until the producer is done and nothing is left
+ * @return Number of errors
+ */
+static uint32_t _stress_render_core(uint32_t* rendered_frames, uint32_t* lost_frames,
+                                    uint32_t* stale_frames, uint32_t* commands) {
+    uint32_t random_state = 0x12345678u;
+    uint32_t expected = 1;
+    uint32_t errors = 0;
+    uint32_t setting = 0;
+    
+    for (;;) {
+        // Setting change between renders (no slot held), as from the control hook
+        if ((_stress_random(&random_state) & STRESS_COMMAND_MASK) == 0) {
+            uint32_t next_setting = setting + 1 + (_stress_random(&random_state) & 0xFFu);
+            bool result = fft_pipeline_mailbox_call(&s_mailbox, _stress_set_setting, &next_setting);
+            if (result != ((next_setting & 1u) != 0)) {
+                if (errors++ < 8) {
+                    printf("  ERROR: command result %d for setting %u\n", result, (unsigned)next_setting);
+                }
+            }
+            setting = next_setting;
+            (*commands)++;
+        }
+    
+        bool done = atomic_load(&s_producer_done);
+        int index = fft_pipeline_consumer_take(&s_consumer);
+        if (index < 0) {
+            if (done) {
+                break;
+            }
+            _stress_yield(1);
+            continue;
+        }
+    
+        // Slot contents must match their header exactly
+        const stress_slot_t* slot = &s_slots[index];
+        bool valid = (slot->frames == slot->last_frame - slot->first_frame + 1);
+        for (int bin = 0; bin < STRESS_BINS && valid; bin++) {
+            uint32_t word = 0;
+            for (uint32_t frame = slot->first_frame; frame <= slot->last_frame; frame++) {
+                word = _stress_merge(word, frame, slot->setting, bin);
+            }
+            valid = (word == slot->payload[bin]);
+        }
+        if (!valid || slot->first_frame < expected) {
+            if (errors++ < 8) {
+                printf("  ERROR: slot %d frames %u-%u (%u merged), expected from %u\n", index,
+                       (unsigned)slot->first_frame, (unsigned)slot->last_frame,
+                       (unsigned)slot->frames, (unsigned)expected);
+            }
+        }
+        *lost_frames += slot->first_frame - expected;
+        expected = slot->last_frame + 1;
+    
+        // Slots of an older generation are dropped; current ones must carry the new setting
+        uint32_t generation = fft_pipeline_mailbox_generation(&s_mailbox);
+        if (slot->generation != generation) {
+            *stale_frames += slot->frames;
+            fft_pipeline_consumer_release(&s_consumer);
+            continue;
+        }
+        if (slot->setting != setting) {
+            if (errors++ < 8) {
+                printf("  ERROR: slot %d analyzed under setting %u after setting %u was acknowledged\n",
+                       index, (unsigned)slot->setting, (unsigned)setting);
+            }
+        }
+        *rendered_frames += slot->frames;
+    
+        _stress_yield(_stress_random(&random_state) % (STRESS_MAX_RENDER_YIELDS + 1));
+        fft_pipeline_consumer_release(&s_consumer);
+    }
+    
+    *lost_frames += (STRESS_FRAMES + 1) - expected;
+    return errors;
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Run the pipeline once per slot count
+ */
+int main(void) {
+    int failures = 0;
+    
+    printf("Two-core pipeline stress test: %u frames per slot count\n", (unsigned)STRESS_FRAMES);
+    
+    for (int slot_count = 2; slot_count <= FFT_PIPELINE_MAX_SLOTS; slot_count++) {
+        uint32_t rendered_frames = 0;
+        uint32_t lost_frames = 0;
+        uint32_t stale_frames = 0;
+        uint32_t commands = 0;
+    
+        multicore_fifo_host_reset();
+        for (int i = 0; i < FFT_PIPELINE_MAX_SLOTS; i++) {
+            s_slots[i].frames = 0;
+        }
+        fft_pipeline_producer_reset(&s_producer, slot_count);
+        fft_pipeline_consumer_reset(&s_consumer, slot_count);
+        fft_pipeline_mailbox_reset(&s_mailbox);
+        s_setting = 0;
+        atomic_store(&s_producer_done, false);
+        atomic_store(&s_consumer_done, false);
+        atomic_store(&s_publish_errors, 0);
+        atomic_store(&s_dropped_frames, 0);
+    
+        fft_pipeline_port_launch(_stress_analysis_core);
+        uint32_t errors = _stress_render_core(&rendered_frames, &lost_frames, &stale_frames, &commands);
+        atomic_store(&s_consumer_done, true);
+        multicore_fifo_host_join();
+    
+        // Two slots: merging absorbs every stall, so only setting changes
+        // drop frames; more slots: slots skipped for a newer one lose frames too
+        uint32_t dropped_frames = atomic_load(&s_dropped_frames);
+        if ((slot_count == 2 || s_consumer.skipped == 0) && lost_frames != dropped_frames) {
+            printf("  ERROR: %u frames lost without a skipped slot (%u dropped by commands)\n",
+                   (unsigned)lost_frames, (unsigned)dropped_frames);
+            errors++;
+        }
+        if (rendered_frames + stale_frames + lost_frames != STRESS_FRAMES) {
+            printf("  ERROR: %u rendered + %u stale + %u lost of %u frames\n", (unsigned)rendered_frames,
+                   (unsigned)stale_frames, (unsigned)lost_frames, (unsigned)STRESS_FRAMES);
+            errors++;
+        }
+        multicore_fifo_host_stats_t to_core0, to_core1;
+        multicore_fifo_host_get_stats(0, &to_core0);
+        multicore_fifo_host_get_stats(1, &to_core1);
+        if (to_core0.blocked + to_core1.blocked > 0 || s_consumer.errors > 0 ||
+            atomic_load(&s_publish_errors) > 0) {
+            printf("  ERROR: %u blocked pushes, %u bad FIFO words, %u failed publishes after ready\n",
+                   (unsigned)(to_core0.blocked + to_core1.blocked), (unsigned)s_consumer.errors,
+                   (unsigned)atomic_load(&s_publish_errors));
+            errors++;
+        }
+    
+        printf("  %d slots: %u published, %u rendered (%u skipped), %u frames rendered, %u lost, "
+               "%u commands (%u dropped, %u stale), %u producer stalls, FIFO depth %d/%d, %u errors\n",
+               slot_count, (unsigned)s_producer.published, (unsigned)s_consumer.taken,
+               (unsigned)s_consumer.skipped, (unsigned)rendered_frames, (unsigned)lost_frames,
+               (unsigned)commands, (unsigned)dropped_frames, (unsigned)stale_frames,
+               (unsigned)s_producer.stalls, to_core0.max_depth, to_core1.max_depth, (unsigned)errors);
+        if (errors > 0) {
+            failures++;
+        }
+    }
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
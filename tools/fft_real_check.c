@@ -0,0 +1,259 @@
+/*****************************************************************************
+* | File      	:   fft_real_check.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host check: real-input FFT path (kiss_fftr) vs complex kiss_fft
+* | Info        :
+*   - Feeds the same 12-bit frame (on-bin tone, small tone, noise, DC)
+*     through adc_convert_window_u16 into both paths: stride 1 for
+*     kiss_fftr, stride 2 with zero imaginary parts for kiss_fft
+*   - Fails if a bin of the two paths differs by more than
+*     CHECK_MAX_BIN_ERROR (relative to the peak bin in float, in scalar
+*     LSBs in the Q15/Q31 builds), if a dBm bin within
+*     CHECK_DB_COMPARE_RANGE of the peak differs by more than
+*     CHECK_MAX_DB_ERROR, if the tone level misses its expected dBm by
+*     more than CHECK_MAX_TONE_ERROR_DB, or if kiss_fftr run in place is
+*     not bit-identical to the out-of-place call
+*   - Also reports the time per frame of both transforms (host numbers)
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. -Ilib/kiss_fft tools/fft_real_check.c adc_convert.c \
+*         fft_window.c fft_db.c lib/kiss_fft/kiss_fft.c \
+*         lib/kiss_fft/kiss_fftr.c -lm -o fft_real_check
+*     (add -DFIXED_POINT=16 or -DFIXED_POINT=32 for the fixed-point paths)
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "adc_convert.h"
+#include "fft_window.h"
+#include "fft_db.h"
+#include "kiss_fftr.h"
+
+#define CHECK_MAX_SIZE 4096
+#define CHECK_TONE_LSB 800.0                // Main tone amplitude (12-bit LSBs, peak)
+#define CHECK_SMALL_TONE_LSB 6.0            // Second tone amplitude
+#define CHECK_TONE_CYCLES 0.0711            // Main tone in cycles per sample (rounded to a bin center)
+#define CHECK_SMALL_TONE_CYCLES 0.3013      // Second tone, off-bin
+#define CHECK_TIME_MIN_POINTS 2000000       // Points transformed per timing trial
+#define CHECK_TRIALS 5                      // Best of N (filters host scheduling noise)
+
+// Tolerances per build
+#if defined(FIXED_POINT) && FIXED_POINT == 32
+#define CHECK_MAX_BIN_ERROR 4.0             // Scalar LSBs (different rounding order only)
+#define CHECK_DB_COMPARE_RANGE 80.0f        // dBm bins compared: within this of the peak
+#define CHECK_MAX_DB_ERROR 0.01f
+#define CHECK_MAX_TONE_ERROR_DB 0.01
+#elif defined(FIXED_POINT)
+#define CHECK_MAX_BIN_ERROR 4.0             // Scalar LSBs (different rounding order only)
+#define CHECK_DB_COMPARE_RANGE 30.0f        // Q15 bins 60 dB down are 1-2 LSBs
+#define CHECK_MAX_DB_ERROR 0.25f
+#define CHECK_MAX_TONE_ERROR_DB 0.05
+#else
+#define CHECK_MAX_BIN_ERROR 1e-5            // Fraction of the peak bin magnitude
+#define CHECK_DB_COMPARE_RANGE 80.0f
+#define CHECK_MAX_DB_ERROR 0.01f
+#define CHECK_MAX_TONE_ERROR_DB 0.01
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static uint16_t s_samples[CHECK_MAX_SIZE];
+static kiss_fft_scalar s_real_input[CHECK_MAX_SIZE];
+static kiss_fft_cpx s_real_output[CHECK_MAX_SIZE / 2 + 1];
+static kiss_fft_cpx s_in_place[CHECK_MAX_SIZE / 2 + 1];
+static kiss_fft_cpx s_complex_input[CHECK_MAX_SIZE];
+static kiss_fft_cpx s_complex_output[CHECK_MAX_SIZE];
+static float s_real_db[CHECK_MAX_SIZE / 2];
+static float s_complex_db[CHECK_MAX_SIZE / 2];
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Monotonic time in nanoseconds
+ */
+static double _check_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Active window table of the build
+ */
+static const adc_window_coef_t* _check_window(void) {
+#ifdef FIXED_POINT
+    return fft_window_get_coefficients_q15();
+#else
+    return fft_window_get_coefficients();
+#endif
+}
+
+/**
+ * dBm offset of the main analyzer (same terms as _adc_update_db_offset)
+ */
+static float _check_db_offset(int n) {
+#ifdef FIXED_POINT
+    (void)n;
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT * fft_window_get_q15_scale() /
+                            ((float)(1 << ADC_FIXED_INPUT_SHIFT) * DB_REFERENCE_VOLTAGE_0DBM);
+#else
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT / ((float)n * DB_REFERENCE_VOLTAGE_0DBM);
+#endif
+    amplitude_scale *= fft_window_get_amplitude_correction();
+    return 20.0f * log10f(amplitude_scale);
+}
+
+/**
+ * Fill one 12-bit frame: main tone on bin `tone_bin`, an off-bin small
+ * tone, +/-2 LSB noise, midscale DC
+ */
+static void _check_fill(int n, int tone_bin, uint32_t seed) {
+    uint32_t lcg = seed;
+    for (int i = 0; i < n; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        double value = 2048.0 +
+                       CHECK_TONE_LSB * sin(2.0 * M_PI * tone_bin * i / n) +
+                       CHECK_SMALL_TONE_LSB * sin(2.0 * M_PI * CHECK_SMALL_TONE_CYCLES * i) +
+                       (double)(lcg >> 30) - 1.5;
+        s_samples[i] = (uint16_t)lrint(value);
+    }
+}
+
+/**
+ * Magnitude of one bin as double
+ */
+static double _check_magnitude(kiss_fft_cpx bin) {
+    return sqrt((double)bin.r * bin.r + (double)bin.i * bin.i);
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Compare both paths per FFT size, then time them
+ */
+int main(void) {
+    const int sizes[] = {256, 512, 1024, 2048, 4096};
+    const int size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    int failures = 0;
+    
+    if (!fft_window_init(sizes, size_count, FFT_WINDOW_HANN)) {
+        return 1;
+    }
+    
+#ifdef FIXED_POINT
+    printf("Real-input vs complex FFT path (Q%d)\n", FIXED_POINT == 32 ? 31 : 15);
+#else
+    printf("Real-input vs complex FFT path (float)\n");
+#endif
+    printf("\n  N     max bin diff   max dB diff   tone dBm  expected   in place   real ns  complex ns  ratio\n");
+    
+    for (int s = 0; s < size_count; s++) {
+        const int n = sizes[s];
+        const int tone_bin = (int)lrint(CHECK_TONE_CYCLES * n);
+        kiss_fftr_cfg real_cfg = kiss_fftr_alloc(n, 0, NULL, NULL);
+        kiss_fft_cfg complex_cfg = kiss_fft_alloc(n, 0, NULL, NULL);
+        if (real_cfg == NULL || complex_cfg == NULL) {
+            printf("  ERROR: N=%d: plan allocation failed\n", n);
+            return 1;
+        }
+        fft_window_set_size(n);
+        fft_db_configure(_check_db_offset(n));
+        const adc_window_coef_t* window = _check_window();
+    
+        // Same frame through both paths
+        _check_fill(n, tone_bin, 0xC0FFEEu + (uint32_t)n);
+        adc_convert_window_u16(s_samples, n, window, s_real_input, 1);
+        memset(s_complex_input, 0, sizeof(s_complex_input));
+        adc_convert_window_u16(s_samples, n, window, (kiss_fft_scalar*)s_complex_input, 2);
+        kiss_fftr(real_cfg, s_real_input, s_real_output);
+        kiss_fft(complex_cfg, s_complex_input, s_complex_output);
+    
+        // In place: the firmware transforms its input buffer into itself
+        memcpy(s_in_place, s_real_input, (size_t)n * sizeof(kiss_fft_scalar));
+        kiss_fftr(real_cfg, (const kiss_fft_scalar*)s_in_place, s_in_place);
+        bool in_place_identical =
+            memcmp(s_in_place, s_real_output, (size_t)(n / 2 + 1) * sizeof(kiss_fft_cpx)) == 0;
+    
+        // Bin difference
+        double peak = 0.0;
+        double max_diff = 0.0;
+        for (int k = 0; k <= n / 2; k++) {
+            double magnitude = _check_magnitude(s_complex_output[k]);
+            if (magnitude > peak) peak = magnitude;
+            double error = fmax(fabs((double)s_real_output[k].r - s_complex_output[k].r),
+                                fabs((double)s_real_output[k].i - s_complex_output[k].i));
+            if (error > max_diff) max_diff = error;
+        }
+#ifndef FIXED_POINT
+        max_diff /= peak;
+#endif
+    
+        // dBm difference near the top of the spectrum, and the tone level
+        fft_db_convert_spectrum(s_real_output, s_real_db, n / 2);
+        fft_db_convert_spectrum(s_complex_output, s_complex_db, n / 2);
+        float peak_db = s_complex_db[tone_bin];
+        float max_db_diff = 0.0f;
+        for (int k = 1; k < n / 2; k++) {
+            if (s_complex_db[k] < peak_db - CHECK_DB_COMPARE_RANGE) continue;
+            float diff = fabsf(s_real_db[k] - s_complex_db[k]);
+            if (diff > max_db_diff) max_db_diff = diff;
+        }
+        double expected_db = 20.0 * log10(CHECK_TONE_LSB / 2.0 * ADC_VOLTAGE_PER_BIT / DB_REFERENCE_VOLTAGE_0DBM);
+        double tone_error = fabs(s_real_db[tone_bin] - expected_db);
+    
+        // Timing
+        const int frames = CHECK_TIME_MIN_POINTS / n;
+        double best[2] = {1e30, 1e30};
+        for (int trial = 0; trial < CHECK_TRIALS; trial++) {
+            for (int path = 0; path < 2; path++) {
+                double start = _check_now_ns();
+                for (int f = 0; f < frames; f++) {
+                    if (path == 0) {
+                        kiss_fftr(real_cfg, s_real_input, s_real_output);
+                    } else {
+                        kiss_fft(complex_cfg, s_complex_input, s_complex_output);
+                    }
+                    __asm__ volatile("" : : "r"(s_real_output), "r"(s_complex_output) : "memory");
+                }
+                double elapsed = (_check_now_ns() - start) / frames;
+                if (elapsed < best[path]) best[path] = elapsed;
+            }
+        }
+    
+        printf("  %4d  %12.3g  %12.2e  %9.3f  %8.3f   %-9s %8.0f  %10.0f  %5.2f\n",
+               n, max_diff, max_db_diff, s_real_db[tone_bin], expected_db,
+               in_place_identical ? "identical" : "DIFFERS", best[0], best[1], best[0] / best[1]);
+    
+        if (max_diff > CHECK_MAX_BIN_ERROR) {
+            printf("  ERROR: N=%d: bin difference %.3g above %.3g\n", n, max_diff, CHECK_MAX_BIN_ERROR);
+            failures++;
+        }
+        if (max_db_diff > CHECK_MAX_DB_ERROR) {
+            printf("  ERROR: N=%d: dBm difference %.3g above %.3g\n", n, max_db_diff, CHECK_MAX_DB_ERROR);
+            failures++;
+        }
+        if (tone_error > CHECK_MAX_TONE_ERROR_DB) {
+            printf("  ERROR: N=%d: tone level off by %.3f dB\n", n, tone_error);
+            failures++;
+        }
+        if (!in_place_identical) {
+            printf("  ERROR: N=%d: in-place kiss_fftr differs from out of place\n", n);
+            failures++;
+        }
+    
+        kiss_fftr_free(real_cfg);
+        kiss_fft_free(complex_cfg);
+    }
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/*****************************************************************************
+* | File      	:   fft_sdft_check.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host check of the sliding DFT (fft_sdft.c) against the block FFT
+* | Info        :
+*   - Streams 12-bit samples (on-bin and off-bin tone in the subset, a
+*     strong tone outside it, noise) through fft_sdft_process in views of
+*     SDFT_CHECK_VIEW samples, so block boundaries fall inside a view
+*   - At every checkpoint, up to SDFT_CHECK_TOTAL_SAMPLES, runs kiss_fftr
+*     over the last N samples (periodic Hann applied in time for the Hann
+*     mode) and compares the subset bins in dBm, for N = 256, 1024 and
+*     4096, rectangular and Hann
+*   - Fails if a bin within SDFT_CHECK_STRONG_RANGE_DB of the strongest
+*     subset bin differs by more than SDFT_CHECK_MAX_STRONG_ERROR_DB (the
+*     dB table error plus float rounding), a bin within
+*     SDFT_CHECK_WEAK_RANGE_DB by more than SDFT_CHECK_MAX_WEAK_ERROR_DB,
+*     or the on-bin tone misses its expected dBm by more than
+*     SDFT_CHECK_MAX_LEVEL_ERROR_DB with Hann (rectangular leakage of the
+*     off-bin tone moves it by a few hundredths of a dB)
+*   - Float build only: the sliding DFT runs in float in every build and
+*     the float kiss_fftr is the reference
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. -Ilib/kiss_fft tools/fft_sdft_check.c fft_sdft.c fft_db.c \
+*         lib/kiss_fft/kiss_fft.c lib/kiss_fft/kiss_fftr.c -lm -o fft_sdft_check
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fft_sdft.h"
+#include "kiss_fftr.h"
+
+#ifdef FIXED_POINT
+#error "fft_sdft_check compares against the float kiss_fftr: build without FIXED_POINT"
+#endif
+
+#define SDFT_CHECK_MAX_SIZE 4096
+#define SDFT_CHECK_BINS 16                  // Subset width
+#define SDFT_CHECK_VIEW 1000                // Samples per fft_sdft_process call (not a divisor of N)
+#define SDFT_CHECK_TOTAL_SAMPLES 3000000
+#define SDFT_CHECK_INTERVAL 250000          // Samples between checkpoints
+#define SDFT_CHECK_TONE_LSB 600.0           // On-bin tone in the subset (12-bit LSBs, peak)
+#define SDFT_CHECK_OFF_TONE_LSB 60.0        // Off-bin tone in the subset
+#define SDFT_CHECK_OUTSIDE_LSB 900.0        // Tone outside the subset
+#define SDFT_CHECK_STRONG_RANGE_DB 40.0     // Bins within this of the strongest subset bin...
+#define SDFT_CHECK_MAX_STRONG_ERROR_DB 1e-3 // ...must match this closely
+#define SDFT_CHECK_WEAK_RANGE_DB 80.0
+#define SDFT_CHECK_MAX_WEAK_ERROR_DB 0.03
+#define SDFT_CHECK_MAX_LEVEL_ERROR_DB 0.01
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static adc_sample_t s_stream[SDFT_CHECK_MAX_SIZE + SDFT_CHECK_VIEW];    // Last N samples plus one view
+static float s_input[SDFT_CHECK_MAX_SIZE];
+static kiss_fft_cpx s_output[SDFT_CHECK_MAX_SIZE / 2 + 1];
+static float s_sdft_db[SDFT_CHECK_MAX_SIZE / 2];
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Sample `index` of the test stream (12-bit level)
+ */
+static adc_sample_t _sdft_check_sample(long index, int n, int first_bin, uint32_t* lcg) {
+    *lcg = *lcg * 1664525u + 1013904223u;
+    double value = 2048.0 +
+                   SDFT_CHECK_TONE_LSB * sin(2.0 * M_PI * (first_bin + 4) * (double)(index % n) / n) +
+                   SDFT_CHECK_OFF_TONE_LSB * sin(2.0 * M_PI * (first_bin + 10.37) * index / n + 0.3) +
+                   SDFT_CHECK_OUTSIDE_LSB * sin(2.0 * M_PI * 0.31 * index) +
+                   (double)(*lcg >> 30) - 1.5;
+    return (adc_sample_t)lrint(value);
+}
+
+/**
+ * dBm offset of the sliding DFT (same terms as fft_sdft_configure)
+ */
+static double _sdft_check_offset(int n, bool hann) {
+    return 20.0 * log10(ADC_VOLTAGE_PER_BIT * (hann ? 2.0 : 1.0) / ((double)n * DB_REFERENCE_VOLTAGE_0DBM));
+}
+
+/**
+ * Compare the sliding DFT with kiss_fftr over the newest N samples
+ * @param max_error Largest dB difference so far: [0] strong bins, [1] weak bins (updated)
+ */
+static void _sdft_check_compare(kiss_fftr_cfg cfg, const adc_sample_t* newest, int n, int first_bin,
+                                bool hann, double* max_error) {
+    for (int i = 0; i < n; i++) {
+        float window = hann ? 0.5f - 0.5f * (float)cos(2.0 * M_PI * i / n) : 1.0f;
+        s_input[i] = (float)ADC_SAMPLE_CENTER(newest[i]) * window;
+    }
+    kiss_fftr(cfg, s_input, s_output);
+    fft_sdft_get_magnitude(s_sdft_db);
+    
+    double offset = _sdft_check_offset(n, hann);
+    double reference[SDFT_CHECK_BINS];
+    double strongest = -1e30;
+    for (int k = 0; k < SDFT_CHECK_BINS; k++) {
+        kiss_fft_cpx bin = s_output[first_bin + k];
+        reference[k] = 10.0 * log10((double)bin.r * bin.r + (double)bin.i * bin.i) + offset;
+        if (reference[k] > strongest) strongest = reference[k];
+    }
+    for (int k = 0; k < SDFT_CHECK_BINS; k++) {
+        double error = fabs(s_sdft_db[first_bin + k] - reference[k]);
+        if (reference[k] >= strongest - SDFT_CHECK_STRONG_RANGE_DB) {
+            if (error > max_error[0]) max_error[0] = error;
+        } else if (reference[k] >= strongest - SDFT_CHECK_WEAK_RANGE_DB) {
+            if (error > max_error[1]) max_error[1] = error;
+        }
+    }
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Stream each configuration and compare at every checkpoint
+ */
+int main(void) {
+    const int sizes[] = {256, 1024, 4096};
+    const int size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    int failures = 0;
+    
+    printf("Sliding DFT vs block FFT (last N samples, %d bins)\n", SDFT_CHECK_BINS);
+    printf("\n  N     window   checks   strong bins   weak bins   tone dBm  expected   (max dB diff)\n");
+    
+    for (int s = 0; s < size_count; s++) {
+        const int n = sizes[s];
+        const int first_bin = n / 128;
+        kiss_fftr_cfg cfg = kiss_fftr_alloc(n, 0, NULL, NULL);
+        if (cfg == NULL) {
+            return 1;
+        }
+        for (int hann = 0; hann <= 1; hann++) {
+            if (!fft_sdft_configure(n, first_bin, SDFT_CHECK_BINS, hann != 0)) {
+                return 1;
+            }
+    
+            // Stream in views; s_stream keeps the newest N samples in front of the view
+            uint32_t lcg = 0xABCDu + (uint32_t)n;
+            long position = 0;
+            long next_check = SDFT_CHECK_INTERVAL;
+            int checks = 0;
+            double max_error[2] = {0.0, 0.0};
+            while (position < SDFT_CHECK_TOTAL_SAMPLES) {
+                adc_sample_t* view = &s_stream[n];
+                for (int i = 0; i < SDFT_CHECK_VIEW; i++) {
+                    view[i] = _sdft_check_sample(position + i, n, first_bin, &lcg);
+                }
+                fft_sdft_process(view, SDFT_CHECK_VIEW);
+                position += SDFT_CHECK_VIEW;
+    
+                if (position >= next_check) {
+                    _sdft_check_compare(cfg, &s_stream[SDFT_CHECK_VIEW], n, first_bin, hann != 0, max_error);
+                    checks++;
+                    next_check += SDFT_CHECK_INTERVAL;
+                }
+                for (int i = 0; i < n; i++) {
+                    s_stream[i] = s_stream[i + SDFT_CHECK_VIEW];
+                }
+            }
+    
+            double expected = 20.0 * log10(SDFT_CHECK_TONE_LSB / 2.0 * ADC_VOLTAGE_PER_BIT / DB_REFERENCE_VOLTAGE_0DBM);
+            double tone = s_sdft_db[first_bin + 4];
+            printf("  %4d  %-7s  %6d   %11.2e  %10.2e  %9.3f  %8.3f\n", n, hann ? "Hann" : "rect", checks,
+                   max_error[0], max_error[1], tone, expected);
+            if (max_error[0] > SDFT_CHECK_MAX_STRONG_ERROR_DB || max_error[1] > SDFT_CHECK_MAX_WEAK_ERROR_DB) {
+                printf("  ERROR: N=%d: sliding DFT differs from the block FFT beyond %.0e / %.0e dB\n",
+                       n, SDFT_CHECK_MAX_STRONG_ERROR_DB, SDFT_CHECK_MAX_WEAK_ERROR_DB);
+                failures++;
+            }
+            if (hann && fabs(tone - expected) > SDFT_CHECK_MAX_LEVEL_ERROR_DB) {
+                printf("  ERROR: N=%d: on-bin tone off by %.3f dB\n", n, fabs(tone - expected));
+                failures++;
+            }
+        }
+        kiss_fftr_free(cfg);
+    }
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+/*****************************************************************************
+* | File      	:   fft_zoom_check.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host check of the zoom FFT stage (fft_zoom.c) on two close tones
+* | Info        :
+*   - Feeds fft_zoom_process with 12-bit samples at SAMPLING_RATE_HZ in
+*     ring-mode sized views: a strong tone on a zoom bin near
+*     FFT_ZOOM_CENTER_HZ, a weak tone ZOOM_CHECK_SPACING_HZ above it, a
+*     tone ZOOM_CHECK_EDGE_FRACTION of the way to the lower edge of the
+*     requested span and an out-of-band interferer
+*   - Fails if the tones do not show up as separate peaks with a dip of
+*     ZOOM_CHECK_MIN_DIP_DB below the weak tone between them, if the strong
+*     tone misses its expected dBm (main spectrum convention) by more than
+*     ZOOM_CHECK_MAX_LEVEL_ERROR_DB or the off-bin weak tone by more than
+*     the Hann scalloping loss, or if the bins the interferer folds onto
+*     reach ZOOM_CHECK_MAX_INTERFERER_DBM
+*   - Also fails if the published bins do not cover FFT_ZOOM_SPAN_HZ or the
+*     edge tone misses its dBm by more than ZOOM_CHECK_MAX_EDGE_ERROR_DB
+*     (the span must lie in the flat part of the decimation FIR)
+*   - fft_arena_alloc comes from malloc here (the arena needs the SDK)
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. -Ilib/kiss_fft tools/fft_zoom_check.c fft_zoom.c \
+*         fft_decimator.c fft_window.c fft_db.c lib/kiss_fft/kiss_fft.c \
+*         -lm -o fft_zoom_check
+*     (add -DFIXED_POINT=16 or -DFIXED_POINT=32 for the fixed-point builds)
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fft_zoom.h"
+#include "fft_arena.h"
+
+#define ZOOM_CHECK_STRONG_LSB 800.0         // Strong tone amplitude (12-bit LSBs, peak)
+#define ZOOM_CHECK_WEAK_LSB 40.0            // Weak tone, 26 dB down
+#define ZOOM_CHECK_INTERFERER_LSB 800.0     // Out-of-band tone
+#define ZOOM_CHECK_INTERFERER_HZ 14000.0
+#define ZOOM_CHECK_EDGE_LSB 200.0           // Tone near the lower edge of the span
+#define ZOOM_CHECK_EDGE_FRACTION 0.97       // Edge tone offset / requested half span
+#define ZOOM_CHECK_STRONG_OFFSET_BINS 51    // Strong tone position relative to the center (zoom bins)
+#define ZOOM_CHECK_SPACING_HZ 20.0          // Weak tone above the strong one (~5 bins at 3.9 Hz/bin)
+#define ZOOM_CHECK_VIEW 1024                // Samples per fft_zoom_process call (one new-sample view)
+#define ZOOM_CHECK_SPECTRA 8                // Spectra produced before the check (filters settled)
+#define ZOOM_CHECK_ALIAS_BINS 2             // Bins checked on each side of the folded interferer
+#define ZOOM_CHECK_MIN_DIP_DB 20.0f
+#define ZOOM_CHECK_MAX_LEVEL_ERROR_DB 0.05
+#define ZOOM_CHECK_MAX_SCALLOP_DB 1.5       // Hann loss at half a bin is 1.42 dB
+#define ZOOM_CHECK_MAX_EDGE_ERROR_DB 0.1
+#define ZOOM_CHECK_MAX_INTERFERER_DBM -100.0f
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static adc_sample_t s_view[ZOOM_CHECK_VIEW];
+
+// ========================================
+// 🔧 Host Stand-ins
+// ========================================
+
+/**
+ * Arena allocation on the host: plain malloc
+ */
+void* fft_arena_alloc(size_t bytes, const char* owner) {
+    (void)owner;
+    return malloc(bytes);
+}
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Expected dBm of a tone (main spectrum convention: half the peak amplitude
+ * against DB_REFERENCE_VOLTAGE_0DBM)
+ */
+static double _zoom_check_expected_dbm(double amplitude_lsb) {
+    return 20.0 * log10(amplitude_lsb / 2.0 * ADC_VOLTAGE_PER_BIT / DB_REFERENCE_VOLTAGE_0DBM);
+}
+
+/**
+ * Fill the next view of the sample stream (12-bit levels, sample index `start`)
+ */
+static void _zoom_check_fill(long start, double strong_hz, double weak_hz, double edge_hz) {
+    for (int i = 0; i < ZOOM_CHECK_VIEW; i++) {
+        double t = (double)(start + i) / SAMPLING_RATE_HZ;
+        double value = 2048.0 +
+                       ZOOM_CHECK_STRONG_LSB * sin(2.0 * M_PI * strong_hz * t) +
+                       ZOOM_CHECK_WEAK_LSB * sin(2.0 * M_PI * weak_hz * t + 0.5) +
+                       ZOOM_CHECK_EDGE_LSB * sin(2.0 * M_PI * edge_hz * t + 2.0) +
+                       ZOOM_CHECK_INTERFERER_LSB * sin(2.0 * M_PI * ZOOM_CHECK_INTERFERER_HZ * t + 1.0);
+        s_view[i] = (adc_sample_t)(lrint(value) >> ADC_SAMPLE_SHIFT);
+    }
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Run the zoom on the two-tone stream and check the last spectrum
+ */
+int main(void) {
+    const int sizes[] = {FFT_ZOOM_FFT_SIZE};
+    int failures = 0;
+    
+    if (!fft_window_init(sizes, 1, FFT_WINDOW_HANN) || !fft_zoom_init() ||
+        !fft_zoom_configure(FFT_ZOOM_CENTER_HZ, FFT_ZOOM_SPAN_HZ, (float)SAMPLING_RATE_HZ)) {
+        return 1;
+    }
+    
+#ifdef FIXED_POINT
+    printf("Zoom FFT two-tone check (Q%d)\n", FIXED_POINT == 32 ? 31 : 15);
+#else
+    printf("Zoom FFT two-tone check (float)\n");
+#endif
+    
+    const float bin_hz = fft_zoom_get_bin_width();
+    const int strong_bin = FFT_ZOOM_FFT_SIZE / 2 + ZOOM_CHECK_STRONG_OFFSET_BINS;
+    const int weak_bin = strong_bin + (int)lrint(ZOOM_CHECK_SPACING_HZ / bin_hz);
+    const double strong_hz = fft_zoom_bin_to_frequency(strong_bin);
+    const double weak_hz = strong_hz + ZOOM_CHECK_SPACING_HZ;
+    const int edge_bin = FFT_ZOOM_FFT_SIZE / 2 -
+                         (int)lrint(ZOOM_CHECK_EDGE_FRACTION * FFT_ZOOM_SPAN_HZ / 2.0 / bin_hz);
+    const double edge_hz = fft_zoom_bin_to_frequency(edge_bin);
+    printf("  tones %.2f Hz and %.2f Hz (%.2f Hz apart, bin %.3f Hz), edge %.2f Hz, interferer %.0f Hz\n",
+           strong_hz, weak_hz, ZOOM_CHECK_SPACING_HZ, bin_hz, edge_hz, ZOOM_CHECK_INTERFERER_HZ);
+    
+    long position = 0;
+    while (fft_zoom_get_spectrum_count() < ZOOM_CHECK_SPECTRA) {
+        _zoom_check_fill(position, strong_hz, weak_hz, edge_hz);
+        fft_zoom_process(s_view, ZOOM_CHECK_VIEW);
+        position += ZOOM_CHECK_VIEW;
+    }
+    const float* spectrum = fft_zoom_get_magnitude();
+    
+    // Both tones are local maxima with a dip between them
+    float dip = spectrum[strong_bin + 1];
+    for (int k = strong_bin + 1; k < weak_bin; k++) {
+        if (spectrum[k] < dip) dip = spectrum[k];
+    }
+    bool strong_peak = spectrum[strong_bin] > spectrum[strong_bin - 1] && spectrum[strong_bin] > spectrum[strong_bin + 1];
+    bool weak_peak = spectrum[weak_bin] > spectrum[weak_bin - 1] && spectrum[weak_bin] > spectrum[weak_bin + 1];
+    float dip_depth = spectrum[weak_bin] - dip;
+    printf("  strong %.3f dBm (expected %.3f), weak %.3f dBm (expected %.3f), dip %.1f dB below the weak tone\n",
+           spectrum[strong_bin], _zoom_check_expected_dbm(ZOOM_CHECK_STRONG_LSB),
+           spectrum[weak_bin], _zoom_check_expected_dbm(ZOOM_CHECK_WEAK_LSB), dip_depth);
+    if (!strong_peak || !weak_peak || dip_depth < ZOOM_CHECK_MIN_DIP_DB) {
+        printf("  ERROR: tones not resolved at bins %d and %d\n", strong_bin, weak_bin);
+        failures++;
+    }
+    if (fabs(spectrum[strong_bin] - _zoom_check_expected_dbm(ZOOM_CHECK_STRONG_LSB)) > ZOOM_CHECK_MAX_LEVEL_ERROR_DB) {
+        printf("  ERROR: strong tone off by more than %.2f dB\n", ZOOM_CHECK_MAX_LEVEL_ERROR_DB);
+        failures++;
+    }
+    if (fabs(spectrum[weak_bin] - _zoom_check_expected_dbm(ZOOM_CHECK_WEAK_LSB)) > ZOOM_CHECK_MAX_SCALLOP_DB) {
+        printf("  ERROR: weak tone off by more than %.2f dB\n", ZOOM_CHECK_MAX_SCALLOP_DB);
+        failures++;
+    }
+    
+    // The requested span is published and flat up to its edge
+    const float lowest_hz = fft_zoom_bin_to_frequency(FFT_ZOOM_FFT_SIZE / 2 - FFT_ZOOM_FLAT_BINS);
+    const float highest_hz = fft_zoom_bin_to_frequency(FFT_ZOOM_FFT_SIZE / 2 + FFT_ZOOM_FLAT_BINS);
+    printf("  span +/- %.1f Hz (requested +/- %.1f Hz), bins %.1f..%.1f Hz, edge tone %.3f dBm (expected %.3f)\n",
+           fft_zoom_get_span() / 2.0f, FFT_ZOOM_SPAN_HZ / 2.0f, lowest_hz, highest_hz,
+           spectrum[edge_bin], _zoom_check_expected_dbm(ZOOM_CHECK_EDGE_LSB));
+    if (fft_zoom_get_span() < FFT_ZOOM_SPAN_HZ || lowest_hz > FFT_ZOOM_CENTER_HZ - FFT_ZOOM_SPAN_HZ / 2.0f ||
+        highest_hz < FFT_ZOOM_CENTER_HZ + FFT_ZOOM_SPAN_HZ / 2.0f) {
+        printf("  ERROR: published bins do not cover the requested span\n");
+        failures++;
+    }
+    if (fabs(spectrum[edge_bin] - _zoom_check_expected_dbm(ZOOM_CHECK_EDGE_LSB)) > ZOOM_CHECK_MAX_EDGE_ERROR_DB) {
+        printf("  ERROR: edge tone off by more than %.2f dB\n", ZOOM_CHECK_MAX_EDGE_ERROR_DB);
+        failures++;
+    }
+    
+    // The interferer folds to its offset from the center modulo the output rate
+    const float output_rate = bin_hz * FFT_ZOOM_FFT_SIZE;
+    double folded_hz = fmod(ZOOM_CHECK_INTERFERER_HZ - FFT_ZOOM_CENTER_HZ + output_rate / 2.0, output_rate);
+    if (folded_hz < 0.0) folded_hz += output_rate;
+    const int alias_bin = (int)lrint(folded_hz / bin_hz);
+    float alias_level = FFT_DB_FLOOR;
+    for (int k = alias_bin - ZOOM_CHECK_ALIAS_BINS; k <= alias_bin + ZOOM_CHECK_ALIAS_BINS; k++) {
+        int bin = (k + FFT_ZOOM_FFT_SIZE) % FFT_ZOOM_FFT_SIZE;
+        if (spectrum[bin] > alias_level) alias_level = spectrum[bin];
+    }
+    printf("  interferer folds to %.2f Hz: %.1f dBm (limit %.0f dBm)\n",
+           fft_zoom_bin_to_frequency(alias_bin), alias_level, ZOOM_CHECK_MAX_INTERFERER_DBM);
+    if (alias_level > ZOOM_CHECK_MAX_INTERFERER_DBM) {
+        printf("  ERROR: interferer not rejected\n");
+        failures++;
+    }
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
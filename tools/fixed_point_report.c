@@ -0,0 +1,272 @@
+/*****************************************************************************
+* | File      	:   fixed_point_report.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host report: spectrum pipeline accuracy and speed per scalar build
+* | Info        :
+*   - Runs the firmware chain (adc_convert_window_u16 -> kiss_fftr ->
+*     fft_db_convert_spectrum, dBm offset as in adc_sampling.c) on a
+*     frame holding a strong tone, a small tone and ~0.5 LSB noise, and a
+*     double-precision reference (mean removal, float window table, DFT)
+*     on the same 12-bit samples
+*   - Reports per FFT size the strong and small tone levels, the median
+*     noise floor of both and the time per frame of the chain
+*   - Fails if a level misses the reference by more than the build's
+*     tolerance (REPORT_MAX_*): float and Q31 must track the reference,
+*     Q15 only the strong tone closely (its floor quantizes to zero)
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. -Ilib/kiss_fft tools/fixed_point_report.c adc_convert.c \
+*         fft_window.c fft_db.c lib/kiss_fft/kiss_fft.c \
+*         lib/kiss_fft/kiss_fftr.c -lm -o fixed_point_report
+*     (add -DFIXED_POINT=16 or -DFIXED_POINT=32 for the fixed-point builds)
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "adc_convert.h"
+#include "fft_window.h"
+#include "fft_db.h"
+#include "kiss_fftr.h"
+
+#define REPORT_MAX_SIZE 4096
+#define REPORT_TONE_LSB 340.0               // Strong tone amplitude (12-bit LSBs, peak), ~-6 dBm
+#define REPORT_SMALL_TONE_LSB 3.0           // Small tone, ~-47 dBm
+#define REPORT_NOISE_LSB 0.5                // Gaussian noise RMS before quantization
+#define REPORT_TONE_CYCLES 0.1              // Tone positions in cycles per sample (rounded to bins)
+#define REPORT_SMALL_TONE_CYCLES 0.3
+#define REPORT_GUARD_BINS 8                 // Bins around each tone left out of the floor
+#define REPORT_TIME_MIN_POINTS 2000000      // Points processed per timing trial
+#define REPORT_TRIALS 5                     // Best of N (filters host scheduling noise)
+
+// Tolerances against the double reference (dB)
+#if defined(FIXED_POINT) && FIXED_POINT == 32
+#define REPORT_MAX_TONE_ERROR_DB 0.01
+#define REPORT_MAX_SMALL_TONE_ERROR_DB 0.1
+#define REPORT_MAX_FLOOR_ERROR_DB 0.2
+#elif defined(FIXED_POINT)
+#define REPORT_MAX_TONE_ERROR_DB 0.05
+#define REPORT_MAX_SMALL_TONE_ERROR_DB 3.0  // Q15 output LSB is close to the small tone
+#define REPORT_MAX_FLOOR_ERROR_DB -1.0      // Not checked: the floor quantizes to zero
+#else
+#define REPORT_MAX_TONE_ERROR_DB 0.01
+#define REPORT_MAX_SMALL_TONE_ERROR_DB 0.1
+#define REPORT_MAX_FLOOR_ERROR_DB 0.2
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static uint16_t s_samples[REPORT_MAX_SIZE];
+static kiss_fft_scalar s_input[REPORT_MAX_SIZE + 2];    // In place: N scalars in, N/2+1 bins out
+static float s_db[REPORT_MAX_SIZE / 2];
+static float s_reference_db[REPORT_MAX_SIZE / 2];
+static double s_floor_scratch[REPORT_MAX_SIZE / 2];
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Monotonic time in nanoseconds
+ */
+static double _report_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Active window table of the build
+ */
+static const adc_window_coef_t* _report_window(void) {
+#ifdef FIXED_POINT
+    return fft_window_get_coefficients_q15();
+#else
+    return fft_window_get_coefficients();
+#endif
+}
+
+/**
+ * dBm offset of the main analyzer (same terms as _adc_update_db_offset)
+ */
+static float _report_db_offset(int n) {
+#ifdef FIXED_POINT
+    (void)n;
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT * fft_window_get_q15_scale() /
+                            ((float)(1 << ADC_FIXED_INPUT_SHIFT) * DB_REFERENCE_VOLTAGE_0DBM);
+#else
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT / ((float)n * DB_REFERENCE_VOLTAGE_0DBM);
+#endif
+    amplitude_scale *= fft_window_get_amplitude_correction();
+    return 20.0f * log10f(amplitude_scale);
+}
+
+/**
+ * Standard normal sample (Box-Muller on an LCG)
+ */
+static double _report_gaussian(uint32_t* lcg) {
+    *lcg = *lcg * 1664525u + 1013904223u;
+    double u1 = ((*lcg >> 8) + 1.0) / 16777217.0;
+    *lcg = *lcg * 1664525u + 1013904223u;
+    double u2 = (*lcg >> 8) / 16777216.0;
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/**
+ * Fill one 12-bit frame: strong and small tone on bin centers, noise, midscale DC
+ */
+static void _report_fill(int n, int tone_bin, int small_bin, uint32_t seed) {
+    uint32_t lcg = seed;
+    for (int i = 0; i < n; i++) {
+        double value = 2048.0 +
+                       REPORT_TONE_LSB * sin(2.0 * M_PI * tone_bin * i / n) +
+                       REPORT_SMALL_TONE_LSB * sin(2.0 * M_PI * small_bin * i / n + 1.0) +
+                       REPORT_NOISE_LSB * _report_gaussian(&lcg);
+        s_samples[i] = (uint16_t)lrint(value);
+    }
+}
+
+/**
+ * Double-precision reference spectrum in dBm on the same samples
+ */
+static void _report_reference(int n) {
+    const float* window = fft_window_get_coefficients();
+    double mean = 0.0;
+    for (int i = 0; i < n; i++) {
+        mean += s_samples[i];
+    }
+    mean /= n;
+    
+    double scale = ADC_VOLTAGE_PER_BIT * fft_window_get_amplitude_correction() /
+                   ((double)n * DB_REFERENCE_VOLTAGE_0DBM);
+    double offset_db = 20.0 * log10(scale);
+    for (int k = 0; k < n / 2; k++) {
+        double re = 0.0;
+        double im = 0.0;
+        for (int i = 0; i < n; i++) {
+            double x = (s_samples[i] - mean) * window[i];
+            int phase = (int)(((long long)k * i) % n);
+            re += x * cos(2.0 * M_PI * phase / n);
+            im -= x * sin(2.0 * M_PI * phase / n);
+        }
+        double power = re * re + im * im;
+        s_reference_db[k] = power > 0.0 ? (float)(10.0 * log10(power) + offset_db) : FFT_DB_FLOOR;
+    }
+}
+
+/**
+ * Compare function for qsort on doubles
+ */
+static int _report_compare(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Median dBm of the bins away from DC and both tones
+ */
+static double _report_floor(const float* db, int bins, int tone_bin, int small_bin) {
+    int count = 0;
+    for (int k = REPORT_GUARD_BINS; k < bins; k++) {
+        if (abs(k - tone_bin) <= REPORT_GUARD_BINS || abs(k - small_bin) <= REPORT_GUARD_BINS) continue;
+        s_floor_scratch[count++] = db[k];
+    }
+    qsort(s_floor_scratch, (size_t)count, sizeof(double), _report_compare);
+    return s_floor_scratch[count / 2];
+}
+
+/**
+ * One frame through the firmware chain (in place, like adc_sampling.c)
+ */
+static void _report_process(kiss_fftr_cfg cfg, int n, const adc_window_coef_t* window) {
+    adc_convert_window_u16(s_samples, n, window, s_input, 1);
+    kiss_fftr(cfg, s_input, (kiss_fft_cpx*)s_input);
+    fft_db_convert_spectrum((const kiss_fft_cpx*)s_input, s_db, n / 2);
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Report accuracy and speed per FFT size for this build
+ */
+int main(void) {
+    const int sizes[] = {256, 512, 1024, 2048, 4096};
+    const int size_count = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    int failures = 0;
+    
+    if (!fft_window_init(sizes, size_count, FFT_WINDOW_HANN)) {
+        return 1;
+    }
+    
+#ifdef FIXED_POINT
+    printf("Spectrum pipeline vs double reference (Q%d, Hann)\n", FIXED_POINT == 32 ? 31 : 15);
+#else
+    printf("Spectrum pipeline vs double reference (float, Hann)\n");
+#endif
+    printf("\n  N     tone dBm (ref)     small dBm (ref)      floor dBm (ref)     us/frame\n");
+    
+    for (int s = 0; s < size_count; s++) {
+        const int n = sizes[s];
+        const int tone_bin = (int)lrint(REPORT_TONE_CYCLES * n);
+        const int small_bin = (int)lrint(REPORT_SMALL_TONE_CYCLES * n);
+        kiss_fftr_cfg cfg = kiss_fftr_alloc(n, 0, NULL, NULL);
+        if (cfg == NULL) {
+            printf("  ERROR: N=%d: plan allocation failed\n", n);
+            return 1;
+        }
+        fft_window_set_size(n);
+        fft_db_configure(_report_db_offset(n));
+        const adc_window_coef_t* window = _report_window();
+    
+        _report_fill(n, tone_bin, small_bin, 0x5EEDu + (uint32_t)n);
+        _report_reference(n);
+        _report_process(cfg, n, window);
+    
+        double floor_ref = _report_floor(s_reference_db, n / 2, tone_bin, small_bin);
+        double floor_db = _report_floor(s_db, n / 2, tone_bin, small_bin);
+    
+        // Timing of the whole chain
+        const int frames = REPORT_TIME_MIN_POINTS / n;
+        double best = 1e30;
+        for (int trial = 0; trial < REPORT_TRIALS; trial++) {
+            double start = _report_now_ns();
+            for (int f = 0; f < frames; f++) {
+                _report_process(cfg, n, window);
+                __asm__ volatile("" : : "r"(s_db) : "memory");
+            }
+            double elapsed = (_report_now_ns() - start) / frames;
+            if (elapsed < best) best = elapsed;
+        }
+    
+        printf("  %4d  %7.3f (%7.3f)  %8.3f (%8.3f)  %8.2f%s (%8.2f)  %8.2f\n", n,
+               s_db[tone_bin], s_reference_db[tone_bin], s_db[small_bin], s_reference_db[small_bin],
+               floor_db, floor_db <= FFT_DB_FLOOR ? "*" : " ", floor_ref, best / 1000.0);
+    
+        double tone_error = fabs(s_db[tone_bin] - s_reference_db[tone_bin]);
+        double small_error = fabs(s_db[small_bin] - s_reference_db[small_bin]);
+        if (tone_error > REPORT_MAX_TONE_ERROR_DB) {
+            printf("  ERROR: N=%d: tone off by %.3f dB\n", n, tone_error);
+            failures++;
+        }
+        if (small_error > REPORT_MAX_SMALL_TONE_ERROR_DB) {
+            printf("  ERROR: N=%d: small tone off by %.3f dB\n", n, small_error);
+            failures++;
+        }
+        if (REPORT_MAX_FLOOR_ERROR_DB > 0.0 && fabs(floor_db - floor_ref) > REPORT_MAX_FLOOR_ERROR_DB) {
+            printf("  ERROR: N=%d: noise floor off by %.2f dB\n", n, fabs(floor_db - floor_ref));
+            failures++;
+        }
+        kiss_fftr_free(cfg);
+    }
+    printf("  (* floor quantized to zero: FFT_DB_FLOOR)\n");
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,268 @@
+/*****************************************************************************
+* | File      	:   frame_queue_stress.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host stress test of the SPSC frame queue (adc_frame_queue.c)
+* | Info        :
+*   - A producer thread plays the chained DMA: it fills slot after slot
+*     without ever waiting for the consumer, stamps every sample with the
+*     frame's sequence number and pushes one descriptor per frame
+*   - A consumer thread plays the main loop: it pops, checks sequence,
+*     timestamp and flags against the producer's rules, reads the samples
+*     while randomly lagging by up to several frames, then checks intact()
+*     like adc_sampling_process_fft(): torn frames are dropped, intact ones
+*     consumed, and the slot is released
+*   - Fails on any sequence gap not reported as dropped, any wrong
+*     descriptor, any consumed frame with overwritten samples, a release()
+*     that reports a dropped frame intact, or overrun counts that do not
+*     add up
+*   - Runs every slot count, starting just below the 2^32 sequence wrap
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -pthread -I. tools/frame_queue_stress.c adc_frame_queue.c \
+*         -o frame_queue_stress
+*     (add -fsanitize=thread to also check the memory ordering)
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "adc_frame_queue.h"
+
+#define STRESS_FRAMES 200000u               // Frames produced per slot count
+#define STRESS_FRAME_SAMPLES 64             // Samples per frame
+#define STRESS_START_SEQUENCE 0xFFFFF000u   // Crosses the 2^32 wrap early in the run
+#define STRESS_OVERFLOW_PERIOD 97u          // Producer flags every n-th frame as ADC overflow
+#define STRESS_MAX_LAG_FRAMES 12            // Consumer delay per frame (random, in producer frame periods)
+
+// Sample buffers: the DMA writes outside the C memory model, so both sides
+// use relaxed atomics here to keep the race on the data well defined
+static atomic_uint s_slots[ADC_FRAME_QUEUE_MAX_SLOTS][STRESS_FRAME_SAMPLES];
+
+static adc_frame_queue_t s_queue;
+static atomic_bool s_producer_done;
+
+// Consumer results
+typedef struct {
+    uint32_t popped;
+    uint32_t consumed;                      // Intact after the last read: results published
+    uint32_t dropped;
+    uint32_t torn;                          // Torn after the last read: dropped unpublished
+    uint32_t torn_corrupted;                // Torn frames whose samples really changed
+    uint32_t torn_late;                     // Consumed frames whose slot DMA reached before release
+    uint32_t errors;
+} stress_result_t;
+
+// ========================================
+// 🔧 Helpers
+// ========================================
+
+/**
+ * Small per-thread pseudo random generator (xorshift32)
+ */
+static uint32_t _stress_random(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * Give the other thread the CPU a number of times (one producer frame per
+ * yield on a single core, scheduling noise on several)
+ */
+static void _stress_yield(uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        sched_yield();
+    }
+}
+
+/**
+ * Expected sample value of one frame
+ */
+static uint32_t _stress_sample(uint32_t sequence, int index) {
+    return sequence * 2654435761u + (uint32_t)index;
+}
+
+// ========================================
+// 🔧 Producer and Consumer
+// ========================================
+
+/**
+ * Producer: fill slot sequence % slot_count, then push (never waits)
+ */
+static void* _stress_producer(void* arg) {
+    uint32_t random_state = 0x9E3779B9u;
+    (void)arg;
+    
+    for (uint32_t n = 0; n < STRESS_FRAMES; n++) {
+        uint32_t sequence = STRESS_START_SEQUENCE + n;
+        int slot = (int)(sequence % (uint32_t)s_queue.slot_count);
+        uint32_t split_at = _stress_random(&random_state) % STRESS_FRAME_SAMPLES;
+        for (int i = 0; i < STRESS_FRAME_SAMPLES; i++) {
+            // Sometimes stop mid-frame, so the consumer sees partly written slots
+            if (i == (int)split_at && (random_state & 3u) == 0) {
+                _stress_yield(1);
+            }
+            atomic_store_explicit(&s_slots[slot][i], _stress_sample(sequence, i), memory_order_relaxed);
+        }
+    
+        uint32_t flags = (sequence % STRESS_OVERFLOW_PERIOD == 0) ? ADC_FRAME_FLAG_ADC_OVERFLOW : 0;
+        adc_frame_queue_push(&s_queue, sequence ^ 0x5A5A5A5Au, flags);
+    
+        // End of the frame period
+        _stress_yield(1);
+    }
+    atomic_store_explicit(&s_producer_done, true, memory_order_release);
+    return NULL;
+}
+
+/**
+ * Consumer: pop, verify, lag, release
+ */
+static void* _stress_consumer(void* arg) {
+    stress_result_t* result = (stress_result_t*)arg;
+    uint32_t random_state = 0x12345678u;
+    uint32_t expected = STRESS_START_SEQUENCE;
+    
+    for (;;) {
+        adc_frame_info_t frame;
+        if (!adc_frame_queue_pop(&s_queue, &frame)) {
+            if (atomic_load_explicit(&s_producer_done, memory_order_acquire) &&
+                adc_frame_queue_get_backlog(&s_queue) == 0) {
+                break;
+            }
+            _stress_yield(1);
+            continue;
+        }
+        result->popped++;
+    
+        // Descriptor: every frame accounted for, flags as pushed
+        uint32_t expected_flags = (frame.sequence % STRESS_OVERFLOW_PERIOD == 0) ? ADC_FRAME_FLAG_ADC_OVERFLOW : 0;
+        if (frame.dropped > 0) {
+            expected_flags |= ADC_FRAME_FLAG_DROPPED;
+        }
+        if (frame.sequence != expected + frame.dropped ||
+            frame.timestamp_us != (frame.sequence ^ 0x5A5A5A5Au) ||
+            frame.flags != expected_flags ||
+            frame.slot != (int)(frame.sequence % (uint32_t)s_queue.slot_count)) {
+            if (result->errors++ < 8) {
+                printf("  ERROR: frame %08x (expected %08x + %u dropped), flags %x, slot %d\n",
+                       (unsigned)frame.sequence, (unsigned)expected, (unsigned)frame.dropped,
+                       (unsigned)frame.flags, frame.slot);
+            }
+        }
+        expected = frame.sequence + 1;
+        result->dropped += frame.dropped;
+    
+        // Process: read the samples, lagging somewhere inside (mostly short,
+        // sometimes longer than the queue)
+        bool corrupted = false;
+        uint32_t lag_at = _stress_random(&random_state) % STRESS_FRAME_SAMPLES;
+        uint32_t lag = _stress_random(&random_state) % (STRESS_MAX_LAG_FRAMES + 1);
+        if ((random_state & 7u) != 0 && lag > 1) {
+            lag = 1;
+        }
+        for (int i = 0; i < STRESS_FRAME_SAMPLES; i++) {
+            if (i == (int)lag_at) {
+                _stress_yield(lag);
+            }
+            uint32_t value = atomic_load_explicit(&s_slots[frame.slot][i], memory_order_relaxed);
+            if (value != _stress_sample(frame.sequence, i)) {
+                corrupted = true;
+            }
+        }
+    
+        // Publish only what was read intact; a torn frame is never consumed
+        bool intact = adc_frame_queue_intact(&s_queue);
+        if (intact) {
+            result->consumed++;
+            if (corrupted && result->errors++ < 8) {
+                printf("  ERROR: frame %08x overwritten but consumed as intact\n", (unsigned)frame.sequence);
+            }
+        } else {
+            result->torn++;
+            if (corrupted) {
+                result->torn_corrupted++;
+            }
+        }
+    
+        // Release repeats the test: a dropped frame stays torn
+        if (adc_frame_queue_release(&s_queue)) {
+            if (!intact && result->errors++ < 8) {
+                printf("  ERROR: frame %08x dropped as torn but released intact\n", (unsigned)frame.sequence);
+            }
+        } else if (intact) {
+            result->torn_late++;
+        }
+    }
+    
+    return NULL;
+}
+
+// ========================================
+// 🔧 Main
+// ========================================
+
+/**
+ * Run producer and consumer once per slot count
+ */
+int main(void) {
+    int failures = 0;
+    
+    printf("SPSC frame queue stress test: %u frames of %d samples per slot count\n",
+           (unsigned)STRESS_FRAMES, STRESS_FRAME_SAMPLES);
+    
+    for (int slot_count = 2; slot_count <= ADC_FRAME_QUEUE_MAX_SLOTS; slot_count *= 2) {
+        stress_result_t result = {0};
+        pthread_t producer, consumer;
+    
+        adc_frame_queue_reset(&s_queue, slot_count);
+    
+        // White box: start both sides just below the sequence wrap
+        atomic_store(&s_queue.completed, STRESS_START_SEQUENCE);
+        s_queue.next = STRESS_START_SEQUENCE;
+        atomic_store(&s_producer_done, false);
+    
+        pthread_create(&consumer, NULL, _stress_consumer, &result);
+        pthread_create(&producer, NULL, _stress_producer, NULL);
+        pthread_join(producer, NULL);
+        pthread_join(consumer, NULL);
+    
+        // Every produced frame was popped or dropped
+        uint32_t accounted = result.popped + result.dropped;
+        if (accounted != STRESS_FRAMES) {
+            printf("  ERROR: %u frames popped + dropped, %u produced\n",
+                   (unsigned)accounted, (unsigned)STRESS_FRAMES);
+            result.errors++;
+        }
+        if (result.consumed + result.torn != result.popped) {
+            printf("  ERROR: %u consumed + %u torn of %u popped\n", (unsigned)result.consumed,
+                   (unsigned)result.torn, (unsigned)result.popped);
+            result.errors++;
+        }
+        uint32_t overruns = result.dropped + result.torn + result.torn_late;
+        if (adc_frame_queue_get_overruns(&s_queue) != overruns) {
+            printf("  ERROR: queue counted %u overruns, consumer saw %u\n",
+                   (unsigned)adc_frame_queue_get_overruns(&s_queue), (unsigned)overruns);
+            result.errors++;
+        }
+    
+        printf("  %d slots: %u popped (%u consumed, %u torn and dropped, %u of them overwritten, "
+               "%u torn after the last read), %u dropped, %u errors\n",
+               slot_count, (unsigned)result.popped, (unsigned)result.consumed, (unsigned)result.torn,
+               (unsigned)result.torn_corrupted, (unsigned)result.torn_late, (unsigned)result.dropped,
+               (unsigned)result.errors);
+        if (result.errors > 0) {
+            failures++;
+        }
+    }
+    
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,351 @@
+#!/usr/bin/env python3
+"""
+PicoFFT Project - specialized FFT kernel generator
+
+Emits fft_kernel_generated.c / fft_kernel_generated.h with one forward FFT
+per requested size, specialized at build time:
+  - iterative radix-4 stages (one leading radix-2 stage for odd log2 sizes),
+    no recursion and no runtime factor/stride bookkeeping
+  - butterflies written out in full, and the unit-twiddle column of every
+    stage emitted without multiplies
+  - twiddles, digit-reversal swaps and real-split twiddles as const tables
+    (rodata, so they stay in flash instead of the kiss_fft plan pool)
+  - in place: the digit reversal is a list of swaps, so input and output
+    may be the same buffer (out-of-place calls copy first)
+
+Real-input builds (FFT_REAL_INPUT_ENABLED) get an N/2-point complex kernel
+plus the kiss_fftr split, done in place on the output buffer.
+
+Usage: gen_fft_kernel.py --out-dir DIR --sizes 256 512 1024 2048
+"""
+
+import argparse
+import math
+import os
+import sys
+
+MIN_SIZE = 16
+MAX_SIZE = 8192
+
+
+def radices_for(size):
+    """Stage radices, first (smallest span) to last."""
+    log2 = size.bit_length() - 1
+    radices = [4] * (log2 // 2)
+    if log2 % 2:
+        radices.insert(0, 2)
+    return radices
+
+
+def digit_reversal(size, radices):
+    """Input order for the DIT stages: the last stage splits by x[q + r*n]."""
+    if not radices:
+        return [0]
+    r = radices[-1]
+    sub = digit_reversal(size // r, radices[:-1])
+    return [q + r * s for q in range(r) for s in sub]
+
+
+def digit_reversal_swaps(perm):
+    """Swap sequence that applies out[i] = in[perm[i]] in place (one cycle at a time)."""
+    swaps = []
+    visited = [False] * len(perm)
+    for start in range(len(perm)):
+        if visited[start]:
+            continue
+        j = start
+        visited[j] = True
+        while not visited[perm[j]]:
+            swaps.append((j, perm[j]))
+            j = perm[j]
+            visited[j] = True
+    return swaps
+
+
+def c_float(value):
+    """Float literal with round-trip precision."""
+    if value == 0.0:
+        return "0.0f"
+    text = "%.9g" % value
+    if "e" not in text and "." not in text:
+        text += ".0"
+    return text + "f"
+
+
+def c_cpx_table(name, values, per_line=3):
+    """const kiss_fft_cpx table."""
+    lines = ["static const kiss_fft_cpx %s[%d] = {" % (name, len(values))]
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append("    " + " ".join("{%s, %s}," % (c_float(v.real), c_float(v.imag))
+                                       for v in chunk))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def c_index_table(name, values, per_line=16):
+    """const uint16_t table."""
+    lines = ["static const uint16_t %s[%d] = {" % (name, len(values))]
+    for i in range(0, len(values), per_line):
+        lines.append("    " + " ".join("%d," % v for v in values[i:i + per_line]))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def twiddle(k, span):
+    """Forward twiddle e^(-j*2*pi*k/span)."""
+    angle = -2.0 * math.pi * k / span
+    return complex(math.cos(angle), math.sin(angle))
+
+
+def emit_butterfly(radix, src, dst, twiddled, indent):
+    """Radix-2/4 butterfly on a0..a(r-1) (already loaded) written to dst[p]."""
+    pad = " " * indent
+    out = []
+    if twiddled:
+        # b_q = a_q * w_q (q >= 1)
+        for q in range(1, radix):
+            out.append("%sconst float b%dr = a%d.r * w%dr - a%d.i * w%di;" % (pad, q, q, q, q, q))
+            out.append("%sconst float b%di = a%d.r * w%di + a%d.i * w%dr;" % (pad, q, q, q, q, q))
+    else:
+        for q in range(1, radix):
+            out.append("%sconst float b%dr = a%d.r, b%di = a%d.i;" % (pad, q, q, q, q))
+    if radix == 2:
+        out.append("%s%s.r = a0.r + b1r; %s.i = a0.i + b1i;" % (pad, dst[0], dst[0]))
+        out.append("%s%s.r = a0.r - b1r; %s.i = a0.i - b1i;" % (pad, dst[1], dst[1]))
+        return out
+    # X0 = t0 + t2, X2 = t0 - t2, X1 = t1 - j*t3, X3 = t1 + j*t3
+    out.append("%sconst float t0r = a0.r + b2r, t0i = a0.i + b2i;" % pad)
+    out.append("%sconst float t1r = a0.r - b2r, t1i = a0.i - b2i;" % pad)
+    out.append("%sconst float t2r = b1r + b3r, t2i = b1i + b3i;" % pad)
+    out.append("%sconst float t3r = b1r - b3r, t3i = b1i - b3i;" % pad)
+    out.append("%s%s.r = t0r + t2r; %s.i = t0i + t2i;" % (pad, dst[0], dst[0]))
+    out.append("%s%s.r = t1r + t3i; %s.i = t1i - t3r;" % (pad, dst[1], dst[1]))
+    out.append("%s%s.r = t0r - t2r; %s.i = t0i - t2i;" % (pad, dst[2], dst[2]))
+    out.append("%s%s.r = t1r - t3i; %s.i = t1i + t3r;" % (pad, dst[3], dst[3]))
+    return out
+
+
+def emit_complex_kernel(size):
+    """Tables and body of one complex forward FFT; returns (code, rodata bytes)."""
+    radices = radices_for(size)
+    swaps = digit_reversal_swaps(digit_reversal(size, radices))
+    tables = [c_index_table("s_swap_%d" % size, [i for pair in swaps for i in pair])]
+    rodata = 4 * len(swaps)
+    body = []
+
+    # Digit reversal in place
+    body.append("    if (in != out) {")
+    body.append("        memcpy(out, in, sizeof(kiss_fft_cpx) * %d);" % size)
+    body.append("    }")
+    body.append("    for (int s = 0; s < %d; s++) {" % len(swaps))
+    body.append("        const uint16_t* p = &s_swap_%d[2 * s];" % size)
+    body.append("        const kiss_fft_cpx t = out[p[0]];")
+    body.append("        out[p[0]] = out[p[1]];")
+    body.append("        out[p[1]] = t;")
+    body.append("    }")
+    body.append("")
+
+    # Stage 1: span = radix, unit twiddles
+    r = radices[0]
+    body.append("    // Stage 1: radix-%d, no twiddles" % r)
+    body.append("    for (int g = 0; g < %d; g++) {" % (size // r))
+    body.append("        kiss_fft_cpx* y = &out[%d * g];" % r)
+    for q in range(r):
+        body.append("        const kiss_fft_cpx a%d = y[%d];" % (q, q))
+    body += emit_butterfly(r, "y", ["y[%d]" % p for p in range(r)], False, 8)
+    body.append("    }")
+
+    span = r
+    for stage, r in enumerate(radices[1:], start=2):
+        m = span
+        span *= r
+        groups = size // span
+        name = "s_tw_%d_s%d" % (size, stage)
+        values = [twiddle(q * k, span) for k in range(1, m) for q in range(1, r)]
+        tables.append(c_cpx_table(name, values, per_line=r - 1))
+        rodata += 8 * len(values)
+
+        body.append("")
+        body.append("    // Stage %d: radix-%d, span %d, %d groups" % (stage, r, span, groups))
+        body.append("    for (int g = 0; g < %d; g++) {" % groups)
+        body.append("        kiss_fft_cpx* y = &out[%d * g];" % span)
+        for q in range(r):
+            body.append("        const kiss_fft_cpx a%d = y[%d];" % (q, q * m))
+        body += emit_butterfly(r, "y", ["y[%d]" % (p * m) for p in range(r)], False, 8)
+        body.append("    }")
+        body.append("    for (int k = 1; k < %d; k++) {" % m)
+        body.append("        const kiss_fft_cpx* w = &%s[%d * (k - 1)];" % (name, r - 1))
+        for q in range(1, r):
+            body.append("        const float w%dr = w[%d].r, w%di = w[%d].i;" % (q, q - 1, q, q - 1))
+        body.append("        for (int g = 0; g < %d; g++) {" % groups)
+        body.append("            kiss_fft_cpx* y = &out[%d * g + k];" % span)
+        for q in range(r):
+            body.append("            const kiss_fft_cpx a%d = y[%d];" % (q, q * m))
+        body += emit_butterfly(r, "y", ["y[%d]" % (p * m) for p in range(r)], True, 12)
+        body.append("        }")
+        body.append("    }")
+
+    func = ["/**",
+            " * %d-point complex forward FFT (radix %s), in and out may alias"
+            % (size, ", ".join(str(x) for x in radices)),
+            " */",
+            "static void _fft_kernel_cfft_%d(const kiss_fft_cpx* in, kiss_fft_cpx* out) {" % size]
+    func += body
+    func.append("}")
+    return "\n\n".join(tables) + "\n\n" + "\n".join(func), rodata
+
+
+def emit_real_wrapper(size):
+    """kiss_fftr-style split of the packed N/2-point result; returns (code, rodata bytes)."""
+    half = size // 2
+    name = "s_split_%d" % size
+    values = []
+    for i in range(half // 2):
+        angle = -math.pi * ((i + 1) / half + 0.5)
+        values.append(complex(math.cos(angle), math.sin(angle)))
+    code = [c_cpx_table(name, values, per_line=3), "",
+            "/**",
+            " * %d-point real forward FFT: packed %d-point complex FFT + split" % (size, half),
+            " * Output bins 0..%d, split in place (pairs k and %d-k are read before written);" % (half, half),
+            " * in may alias out (N scalars in, N/2+1 bins out)",
+            " */",
+            "static void _fft_kernel_rfft_%d(const kiss_fft_scalar* in, kiss_fft_cpx* out) {" % size,
+            "    _fft_kernel_cfft_%d((const kiss_fft_cpx*)in, out);" % half,
+            "",
+            "    const float dc_r = out[0].r, dc_i = out[0].i;",
+            "    out[0].r = dc_r + dc_i;",
+            "    out[0].i = 0.0f;",
+            "    out[%d].r = dc_r - dc_i;" % half,
+            "    out[%d].i = 0.0f;" % half,
+            "",
+            "    for (int k = 1; k <= %d; k++) {" % (half // 2),
+            "        const kiss_fft_cpx fpk = out[k];",
+            "        const kiss_fft_cpx fpnk = out[%d - k];" % half,
+            "        const float f1r = fpk.r + fpnk.r, f1i = fpk.i - fpnk.i;",
+            "        const float f2r = fpk.r - fpnk.r, f2i = fpk.i + fpnk.i;",
+            "        const kiss_fft_cpx w = %s[k - 1];" % name,
+            "        const float twr = f2r * w.r - f2i * w.i;",
+            "        const float twi = f2r * w.i + f2i * w.r;",
+            "        out[k].r = 0.5f * (f1r + twr);",
+            "        out[k].i = 0.5f * (f1i + twi);",
+            "        out[%d - k].r = 0.5f * (f1r - twr);" % half,
+            "        out[%d - k].i = 0.5f * (twi - f1i);" % half,
+            "    }",
+            "}"]
+    return "\n".join(code), 8 * len(values)
+
+
+FILE_HEADER = """/*****************************************************************************
+* | File      	:   %s
+* | Author      :   PicoFFT Project
+* | Function    :   Specialized forward FFT kernels (GENERATED - do not edit)
+* | Info        :
+*   - Generated by tools/gen_fft_kernel.py for sizes: %s
+*   - Regenerated by the build when PICOFFT_FFT_BACKEND=generated
+*----------------
+******************************************************************************/
+"""
+
+
+def generate_header(sizes):
+    total = sum(sizes)
+    lines = [FILE_HEADER % ("fft_kernel_generated.h", " ".join(str(s) for s in sizes)),
+             "#ifndef __FFT_KERNEL_GENERATED_H",
+             "#define __FFT_KERNEL_GENERATED_H",
+             "",
+             "#define FFT_KERNEL_SIZE_COUNT %d" % len(sizes),
+             "#define FFT_KERNEL_TOTAL_POINTS %d          // Sum of the generated sizes" % total,
+             "",
+             "#endif // __FFT_KERNEL_GENERATED_H",
+             ""]
+    return "\n".join(lines)
+
+
+def generate_source(sizes):
+    parts = [FILE_HEADER % ("fft_kernel_generated.c", " ".join(str(s) for s in sizes)),
+             '#include "fft_kernel.h"',
+             '#include "fft_kernel_generated.h"',
+             "#include <string.h>",
+             "",
+             "#ifdef FIXED_POINT",
+             '#error "Generated FFT kernels are float only (build with PICOFFT_FIXED_POINT=0)"',
+             "#endif",
+             ""]
+
+    real_bytes = {}
+    complex_bytes = {}
+
+    # Real-input builds: N/2-point complex kernels + split
+    parts.append("#if FFT_REAL_INPUT_ENABLED")
+    parts.append("")
+    for size in sizes:
+        code, cbytes = emit_complex_kernel(size // 2)
+        split, sbytes = emit_real_wrapper(size)
+        parts += [code, "", split, ""]
+        real_bytes[size] = cbytes + sbytes
+    parts.append("#else // !FFT_REAL_INPUT_ENABLED")
+    parts.append("")
+    for size in sizes:
+        code, cbytes = emit_complex_kernel(size)
+        parts += [code, ""]
+        complex_bytes[size] = cbytes
+    parts.append("#endif // FFT_REAL_INPUT_ENABLED")
+    parts.append("")
+
+    table = ["// Kernel table (sorted by size)",
+             "static const fft_kernel_t s_kernels[FFT_KERNEL_SIZE_COUNT] = {",
+             "#if FFT_REAL_INPUT_ENABLED"]
+    table += ["    {%d, _fft_kernel_rfft_%d, %d}," % (s, s, real_bytes[s]) for s in sizes]
+    table.append("#else")
+    table += ["    {%d, _fft_kernel_cfft_%d, %d}," % (s, s, complex_bytes[s]) for s in sizes]
+    table += ["#endif",
+              "};",
+              "",
+              "/**",
+              " * Find the generated kernel for a size",
+              " */",
+              "const fft_kernel_t* fft_kernel_find(int size) {",
+              "    for (int i = 0; i < FFT_KERNEL_SIZE_COUNT; i++) {",
+              "        if (s_kernels[i].size == size) {",
+              "            return &s_kernels[i];",
+              "        }",
+              "    }",
+              "    return NULL;",
+              "}",
+              ""]
+    parts += table
+    return "\n".join(parts)
+
+
+def write_if_changed(path, text):
+    """Keep the timestamp when nothing changed (no needless rebuilds)."""
+    text = text.replace("\n", "\r\n")
+    if os.path.exists(path):
+        with open(path, "r", newline="") as f:
+            if f.read() == text:
+                return
+    with open(path, "w", newline="") as f:
+        f.write(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate specialized PicoFFT FFT kernels")
+    parser.add_argument("--out-dir", required=True, help="Directory for the generated files")
+    parser.add_argument("--sizes", type=int, nargs="+", required=True,
+                        help="Real FFT sizes (powers of two, %d..%d)" % (MIN_SIZE, MAX_SIZE))
+    args = parser.parse_args()
+
+    sizes = sorted(set(args.sizes))
+    for size in sizes:
+        if size < MIN_SIZE or size > MAX_SIZE or size & (size - 1):
+            sys.exit("gen_fft_kernel.py: invalid size %d (power of two, %d..%d)"
+                     % (size, MIN_SIZE, MAX_SIZE))
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    write_if_changed(os.path.join(args.out_dir, "fft_kernel_generated.h"), generate_header(sizes))
+    write_if_changed(os.path.join(args.out_dir, "fft_kernel_generated.c"), generate_source(sizes))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,179 @@
+/*****************************************************************************
+* | File      	:   goertzel_bench.c
+* | Author      :   PicoFFT Project
+* | Function    :   Host benchmark: Goertzel tracker bank vs 1024-point FFT
+* | Info        :
+*   - Times the float spectrum path (DC removal, window, kiss_fftr, dB of
+*     512 bins) against the Goertzel bank for 1..FFT_GOERTZEL_MAX_TONES tones
+*   - Both process the same 1024 samples; prints the break-even tone count
+*   - Sanity check: with both paths on the main analyzer's dBm reference
+*     (full-scale offset and window coherent gain), the FFT bin of the
+*     BENCH_TONE_HZ tone and a Goertzel tone at the same frequency must
+*     agree within BENCH_SANITY_MAX_DIFF_DB and each read the tone's
+*     expected dBm within BENCH_SANITY_MAX_LEVEL_ERROR_DB (fails otherwise)
+*   - Host numbers only: relative costs shift on the Cortex-M33, so repeat
+*     the comparison on target before relying on the exact break-even
+*   - Host only (not part of the firmware build):
+*     gcc -O2 -I. -Ilib/kiss_fft tools/goertzel_bench.c fft_goertzel.c \
+*         adc_convert.c fft_window.c fft_db.c lib/kiss_fft/kiss_fft.c lib/kiss_fft/kiss_fftr.c \
+*         -lm -o goertzel_bench
+*----------------
+******************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "fft_goertzel.h"
+#include "fft_window.h"
+#include "fft_db.h"
+#include "adc_convert.h"
+#include "kiss_fftr.h"
+
+#define BENCH_FFT_SIZE 1024
+#define BENCH_ITERATIONS 500
+#define BENCH_TRIALS 7                      // Best of N (filters host scheduling noise)
+#define BENCH_TONE_HZ 10000.0               // Strong tone (on a bin at 128 kHz / 1024)
+#define BENCH_TONE_LSB 900.0                // Its amplitude (12-bit LSBs, peak)
+#define BENCH_SANITY_MAX_DIFF_DB 0.05
+#define BENCH_SANITY_MAX_LEVEL_ERROR_DB 0.1
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static adc_sample_t s_samples[BENCH_FFT_SIZE];
+static kiss_fft_scalar s_fft_input[BENCH_FFT_SIZE];
+static kiss_fft_cpx s_fft_output[BENCH_FFT_SIZE / 2 + 1];
+static float s_magnitude[BENCH_FFT_SIZE / 2];
+
+/**
+ * Monotonic time in nanoseconds
+ */
+static double _bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * dBm offset of the main analyzer (same terms as _adc_update_db_offset, float)
+ */
+static float _bench_db_offset(void) {
+    float amplitude_scale = ADC_VOLTAGE_PER_BIT / ((float)BENCH_FFT_SIZE * DB_REFERENCE_VOLTAGE_0DBM);
+    amplitude_scale *= fft_window_get_amplitude_correction();
+    return 20.0f * log10f(amplitude_scale);
+}
+
+/**
+ * One frame of the float spectrum path in adc_sampling.c
+ */
+static void _bench_fft_frame(kiss_fftr_cfg cfg) {
+    adc_convert_window(s_samples, BENCH_FFT_SIZE, fft_window_get_coefficients(), s_fft_input, 1);
+    kiss_fftr(cfg, s_fft_input, s_fft_output);
+    fft_db_convert_spectrum(s_fft_output, s_magnitude, BENCH_FFT_SIZE / 2);
+}
+
+/**
+ * Time both paths, then check that they agree on the same tone
+ */
+int main(void) {
+#ifdef FIXED_POINT
+    printf("Build without FIXED_POINT: the benchmark compares the float paths\n");
+    return 1;
+#else
+    const int window_sizes[] = {BENCH_FFT_SIZE};
+    if (!fft_window_init(window_sizes, 1, FFT_WINDOW_HANN)) {
+        return 1;
+    }
+    fft_db_configure(_bench_db_offset());
+    
+    kiss_fftr_cfg cfg = kiss_fftr_alloc(BENCH_FFT_SIZE, 0, NULL, NULL);
+    if (cfg == NULL) {
+        return 1;
+    }
+    
+    // Two tones plus a little dither
+    for (int i = 0; i < BENCH_FFT_SIZE; i++) {
+        double t = i / (double)SAMPLING_RATE_HZ;
+        long level = lrint(2048.0 + BENCH_TONE_LSB * sin(2.0 * M_PI * BENCH_TONE_HZ * t) +
+                           200.0 * sin(2.0 * M_PI * 31000.0 * t) + (i % 3));
+        s_samples[i] = (adc_sample_t)(level >> ADC_SAMPLE_SHIFT);
+    }
+    
+    // FFT path
+    double fft_ns = 1e30;
+    for (int trial = 0; trial < BENCH_TRIALS; trial++) {
+        double start = _bench_now_ns();
+        for (int it = 0; it < BENCH_ITERATIONS; it++) {
+            _bench_fft_frame(cfg);
+        }
+        double elapsed = (_bench_now_ns() - start) / BENCH_ITERATIONS;
+        if (elapsed < fft_ns) fft_ns = elapsed;
+    }
+    printf("FFT %d (window + kiss_fftr + dB): %8.0f ns per frame\n", BENCH_FFT_SIZE, fft_ns);
+    
+    // Goertzel bank with the same block length (same resolution), 1..MAX tones
+    float frequencies[FFT_GOERTZEL_MAX_TONES];
+    for (int t = 0; t < FFT_GOERTZEL_MAX_TONES; t++) {
+        frequencies[t] = 1000.0f + 1500.0f * t;
+    }
+    
+    int break_even = 0;
+    printf("Tones  Goertzel ns/frame  vs FFT\n");
+    for (int tones = 1; tones <= FFT_GOERTZEL_MAX_TONES; tones++) {
+        if (!fft_goertzel_init(frequencies, tones, BENCH_FFT_SIZE, (float)SAMPLING_RATE_HZ)) {
+            return 1;
+        }
+        double goertzel_ns = 1e30;
+        for (int trial = 0; trial < BENCH_TRIALS; trial++) {
+            double start = _bench_now_ns();
+            for (int it = 0; it < BENCH_ITERATIONS; it++) {
+                fft_goertzel_process(s_samples, BENCH_FFT_SIZE);
+            }
+            double elapsed = (_bench_now_ns() - start) / BENCH_ITERATIONS;
+            if (elapsed < goertzel_ns) goertzel_ns = elapsed;
+        }
+        printf("%5d  %17.0f  %5.2fx\n", tones, goertzel_ns, goertzel_ns / fft_ns);
+        if (break_even == 0 && goertzel_ns >= fft_ns) {
+            break_even = tones;
+        }
+    }
+    
+    if (break_even > 0) {
+        printf("Break-even: %d tones (fewer tones -> Goertzel bank is cheaper)\n", break_even);
+    } else {
+        printf("Break-even: above %d tones\n", FFT_GOERTZEL_MAX_TONES);
+    }
+    
+    // Sanity: the tone's FFT bin and a Goertzel tone on the same frequency,
+    // both in dBm (the FFT stage already uses the main analyzer's offset)
+    const int tone_bin = (int)lrint(BENCH_TONE_HZ * BENCH_FFT_SIZE / SAMPLING_RATE_HZ);
+    const float tone_hz = (float)BENCH_TONE_HZ;
+    const double expected_dbm = 20.0 * log10(BENCH_TONE_LSB / 2.0 * ADC_VOLTAGE_PER_BIT / DB_REFERENCE_VOLTAGE_0DBM);
+    _bench_fft_frame(cfg);
+    if (!fft_goertzel_init(&tone_hz, 1, BENCH_FFT_SIZE, (float)SAMPLING_RATE_HZ) ||
+        fft_goertzel_process(s_samples, BENCH_FFT_SIZE) < 1) {
+        return 1;
+    }
+    const double fft_dbm = s_magnitude[tone_bin];
+    const double goertzel_dbm = fft_goertzel_get_dbm()[0];
+    printf("Sanity: %.0f Hz: FFT bin %d %.3f dBm, Goertzel %.3f dBm, expected %.3f dBm\n",
+           BENCH_TONE_HZ, tone_bin, fft_dbm, goertzel_dbm, expected_dbm);
+    
+    int failures = 0;
+    if (fabs(fft_dbm - goertzel_dbm) > BENCH_SANITY_MAX_DIFF_DB) {
+        printf("ERROR: FFT and Goertzel differ by %.3f dB (limit %.2f)\n",
+               fabs(fft_dbm - goertzel_dbm), BENCH_SANITY_MAX_DIFF_DB);
+        failures++;
+    }
+    if (fabs(fft_dbm - expected_dbm) > BENCH_SANITY_MAX_LEVEL_ERROR_DB ||
+        fabs(goertzel_dbm - expected_dbm) > BENCH_SANITY_MAX_LEVEL_ERROR_DB) {
+        printf("ERROR: tone level off by more than %.2f dB\n", BENCH_SANITY_MAX_LEVEL_ERROR_DB);
+        failures++;
+    }
+    
+    kiss_fftr_free(cfg);
+    printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+#endif
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+PicoFFT Project - static RAM budget report
+
+Lists every statically allocated buffer (.data/.bss symbols, including
+function-local statics) of the given object files, grouped by module, and
+checks the total against the RP2350 SRAM budget with room for an LCD
+framebuffer and the stack/heap reserve.
+
+Firmware build:  cmake --build . --target memory_report
+Host build:      gcc -c ... && python3 tools/memory_report.py *.o
+
+Usage: memory_report.py [--nm NM] [--sram-kb 520] [--framebuffer 320x240]
+                        [--reserve-kb 32] [--min-bytes 0] OBJECTS...
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+# nm symbol types that occupy RAM (data, bss, common; upper and lower case)
+RAM_TYPES = set("bBdDcCsSvV")
+
+
+def read_symbols(nm, path):
+    """(symbol, bytes, type) of the RAM symbols in one object."""
+    try:
+        output = subprocess.run([nm, "-S", "-t", "d", path], check=True,
+                                capture_output=True, text=True).stdout
+    except (OSError, subprocess.CalledProcessError) as error:
+        sys.exit("memory_report.py: %s failed on %s: %s" % (nm, path, error))
+
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split()
+        # address size type name (undefined symbols have no size)
+        if len(fields) != 4 or fields[2] not in RAM_TYPES:
+            continue
+        size = int(fields[1], 10)
+        if size > 0:
+            symbols.append((fields[3], size, "bss" if fields[2] in "bBcCsS" else "data"))
+    return symbols
+
+
+def module_name(path):
+    """fft_plan.c.obj / fft_plan.c.o / fft_plan.o -> fft_plan.c"""
+    name = os.path.basename(path)
+    for suffix in (".obj", ".o"):
+        if name.endswith(suffix):
+            name = name[:-len(suffix)]
+    return name
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Static RAM budget of PicoFFT objects")
+    parser.add_argument("objects", nargs="+", help="Object files (or a linked ELF)")
+    parser.add_argument("--nm", default="nm", help="nm of the toolchain that built the objects")
+    parser.add_argument("--sram-kb", type=int, default=520, help="SRAM size (RP2350: 520 KB)")
+    parser.add_argument("--framebuffer", default="320x240",
+                        help="RGB565 framebuffer to reserve, WxH (0 for none; default: "
+                             "the 320x240 landscape panel of the streaming display)")
+    parser.add_argument("--reserve-kb", type=int, default=32,
+                        help="Stack, heap and SDK reserve")
+    parser.add_argument("--min-bytes", type=int, default=0,
+                        help="Fold symbols smaller than this into one line per module")
+    args = parser.parse_args()
+
+    if args.framebuffer in ("0", ""):
+        framebuffer = 0
+    else:
+        width, height = (int(v) for v in args.framebuffer.lower().split("x"))
+        framebuffer = width * height * 2
+
+    modules = []
+    for path in args.objects:
+        symbols = read_symbols(args.nm, path)
+        if symbols:
+            modules.append((module_name(path), symbols))
+    modules.sort(key=lambda m: -sum(s[1] for s in m[1]))
+
+    total = 0
+    print("%-28s %-36s %5s %9s" % ("Module", "Buffer", "Sect", "Bytes"))
+    print("-" * 81)
+    for name, symbols in modules:
+        module_total = sum(s[1] for s in symbols)
+        total += module_total
+        small = [s for s in symbols if s[1] < args.min_bytes]
+        for symbol, size, section in sorted(symbols, key=lambda s: -s[1]):
+            if size >= args.min_bytes:
+                print("%-28s %-36s %5s %9d" % (name, symbol, section, size))
+        if small:
+            print("%-28s %-36s %5s %9d" % (name, "(%d smaller symbols)" % len(small), "",
+                                          sum(s[1] for s in small)))
+        print("%-28s %-36s %5s %9d" % ("", "= %s total" % name, "", module_total))
+    print("-" * 81)
+
+    sram = args.sram_kb * 1024
+    reserve = args.reserve_kb * 1024
+    headroom = sram - framebuffer - reserve - total
+    print("%-71s %9d" % ("Static buffers", total))
+    print("%-71s %9d" % ("Framebuffer (%s RGB565)" % args.framebuffer, framebuffer))
+    print("%-71s %9d" % ("Stack / heap / SDK reserve", reserve))
+    print("%-71s %9d" % ("SRAM", sram))
+    print("%-71s %9d" % ("Headroom", headroom))
+    if headroom < 0:
+        print("Static buffers do not fit next to the framebuffer (%d bytes over)" % -headroom)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
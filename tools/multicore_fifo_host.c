@@ -0,0 +1,138 @@
+/*****************************************************************************
+* | File      	:   multicore_fifo_host.c
+* | Author      :   PicoFFT Project
+* | Function    :   Thread-based stand-in for the RP2350 inter-core FIFOs
+* | Info        :
+*   - The core number is thread-local: 0 for the thread that resets the
+*     FIFOs, 1 inside the launched entry
+*----------------
+******************************************************************************/
+
+#include "multicore_fifo_host.h"
+#include "fft_pipeline.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+// One receive FIFO per core
+typedef struct {
+    uint32_t words[MULTICORE_FIFO_HOST_DEPTH];
+    int head;
+    int count;
+    multicore_fifo_host_stats_t stats;
+    pthread_cond_t not_full;
+} multicore_fifo_host_t;
+
+static multicore_fifo_host_t s_fifos[2];
+static pthread_mutex_t s_fifo_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t s_core1_thread;
+static void (*s_core1_entry)(void);
+static _Thread_local int s_core = 0;
+
+// ========================================
+// 🔧 Internal Helpers
+// ========================================
+
+/**
+ * Core 1 thread body
+ */
+static void* _multicore_fifo_host_core1(void* arg) {
+    (void)arg;
+    s_core = 1;
+    s_core1_entry();
+    return NULL;
+}
+
+// ========================================
+// 🔧 Host FIFO API Implementation
+// ========================================
+
+/**
+ * Reset both FIFOs
+ */
+void multicore_fifo_host_reset(void) {
+    for (int core = 0; core < 2; core++) {
+        multicore_fifo_host_t* fifo = &s_fifos[core];
+        fifo->head = 0;
+        fifo->count = 0;
+        memset(&fifo->stats, 0, sizeof(fifo->stats));
+        pthread_cond_init(&fifo->not_full, NULL);
+    }
+    s_core = 0;
+}
+
+/**
+ * Wait until the core 1 entry returns
+ */
+void multicore_fifo_host_join(void) {
+    pthread_join(s_core1_thread, NULL);
+}
+
+/**
+ * Get the statistics of the FIFO read by one core
+ */
+void multicore_fifo_host_get_stats(int core, multicore_fifo_host_stats_t* stats) {
+    pthread_mutex_lock(&s_fifo_lock);
+    *stats = s_fifos[core].stats;
+    pthread_mutex_unlock(&s_fifo_lock);
+}
+
+// ========================================
+// 🔧 Core Port Implementation (host)
+// ========================================
+
+/**
+ * Start the producer loop on core 1 (a thread)
+ */
+void fft_pipeline_port_launch(void (*entry)(void)) {
+    s_core1_entry = entry;
+    pthread_create(&s_core1_thread, NULL, _multicore_fifo_host_core1, NULL);
+}
+
+/**
+ * Push one word to the other core's FIFO
+ */
+void fft_pipeline_port_push(uint32_t message) {
+    multicore_fifo_host_t* fifo = &s_fifos[1 - s_core];
+    
+    pthread_mutex_lock(&s_fifo_lock);
+    if (fifo->count == MULTICORE_FIFO_HOST_DEPTH) {
+        fifo->stats.blocked++;
+        while (fifo->count == MULTICORE_FIFO_HOST_DEPTH) {
+            pthread_cond_wait(&fifo->not_full, &s_fifo_lock);
+        }
+    }
+    fifo->words[(fifo->head + fifo->count) % MULTICORE_FIFO_HOST_DEPTH] = message;
+    fifo->count++;
+    fifo->stats.pushed++;
+    if (fifo->count > fifo->stats.max_depth) {
+        fifo->stats.max_depth = fifo->count;
+    }
+    pthread_mutex_unlock(&s_fifo_lock);
+}
+
+/**
+ * Pop one word from this core's FIFO without blocking
+ */
+bool fft_pipeline_port_pop(uint32_t* message) {
+    multicore_fifo_host_t* fifo = &s_fifos[s_core];
+    bool valid = false;
+    
+    pthread_mutex_lock(&s_fifo_lock);
+    if (fifo->count > 0) {
+        *message = fifo->words[fifo->head];
+        fifo->head = (fifo->head + 1) % MULTICORE_FIFO_HOST_DEPTH;
+        fifo->count--;
+        pthread_cond_signal(&fifo->not_full);
+        valid = true;
+    }
+    pthread_mutex_unlock(&s_fifo_lock);
+    return valid;
+}
+
+/**
+ * Pause briefly while waiting for the other core
+ */
+void fft_pipeline_port_idle(void) {
+    sched_yield();
+}
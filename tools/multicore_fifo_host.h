@@ -0,0 +1,49 @@
+/*****************************************************************************
+* | File      	:   multicore_fifo_host.h
+* | Author      :   PicoFFT Project
+* | Function    :   Thread-based stand-in for the RP2350 inter-core FIFOs
+* | Info        :
+*   - Implements the fft_pipeline.h core port with POSIX threads: the
+*     calling thread is core 0, fft_pipeline_port_launch() starts core 1
+*   - One bounded FIFO per receiving core, MULTICORE_FIFO_HOST_DEPTH words
+*     deep like the hardware; a push into a full FIFO blocks and is counted
+*   - Mutex hand-over gives the same ordering as the barrier + FIFO on the
+*     target, so thread sanitizer checks the slot ownership protocol
+*   - Host only (not part of the firmware build), compiled with
+*     -DFFT_PIPELINE_HOST_PORT next to fft_pipeline.c
+*----------------
+******************************************************************************/
+
+#ifndef __MULTICORE_FIFO_HOST_H
+#define __MULTICORE_FIFO_HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MULTICORE_FIFO_HOST_DEPTH 4         // Words per direction (RP2350 SIO FIFO)
+
+// FIFO statistics of one direction
+typedef struct {
+    uint32_t pushed;
+    uint32_t blocked;                       // Pushes that found the FIFO full
+    int max_depth;                          // Deepest fill level seen
+} multicore_fifo_host_stats_t;
+
+/**
+ * Reset both FIFOs (no core 1 thread may be running)
+ */
+void multicore_fifo_host_reset(void);
+
+/**
+ * Wait until the core 1 entry returns (host only: on the target it never does)
+ */
+void multicore_fifo_host_join(void);
+
+/**
+ * Get the statistics of the FIFO read by one core
+ * @param core Receiving core (0 or 1)
+ * @param stats Output
+ */
+void multicore_fifo_host_get_stats(int core, multicore_fifo_host_stats_t* stats);
+
+#endif // __MULTICORE_FIFO_HOST_H